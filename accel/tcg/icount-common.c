@@ -103,6 +103,18 @@ void icount_update(CPUState *cpu)
                          &timers_state.vm_clock_lock);
 }
 
+/*
+ * Enlarging the budget of the current slice makes the extra count show
+ * up as executed instructions in icount_get_executed(), while the
+ * decrementer that ends the TB is left alone.
+ */
+void icount_charge(CPUState *cpu, int64_t count)
+{
+    if (replay_mode == REPLAY_MODE_NONE) {
+        cpu->icount_budget += count;
+    }
+}
+
 static int64_t icount_get_raw_locked(void)
 {
     CPUState *cpu = current_cpu;
@@ -177,6 +177,9 @@ static int rr_cpu_count(void)
  * elsewhere.
  */
 
+/* set when the thread is recreated in a forked child */
+static bool rr_thread_after_fork;
+
 static void *rr_cpu_thread_fn(void *arg)
 {
     Notifier force_rcu;
@@ -186,7 +189,12 @@ static void *rr_cpu_thread_fn(void *arg)
     rcu_register_thread();
     force_rcu.notify = rr_force_rcu;
     rcu_add_force_rcu_notifier(&force_rcu);
-    tcg_register_thread();
+    if (rr_thread_after_fork) {
+        /* the only context still belongs to the thread lost in fork() */
+        tcg_register_thread_after_fork(0);
+    } else {
+        tcg_register_thread();
+    }
 
     bql_lock();
     qemu_thread_get_self(cpu->thread);
@@ -337,3 +345,18 @@ void rr_start_vcpu_thread(CPUState *cpu)
         cpu->created = true;
     }
 }
+
+void rr_restart_vcpu_thread(void)
+{
+    char thread_name[VCPU_THREAD_NAME_SIZE];
+
+    g_assert(tcg_enabled());
+
+    /* the condition may still count the waiter that existed in the parent */
+    qemu_cond_init(first_cpu->halt_cond);
+    rr_thread_after_fork = true;
+
+    snprintf(thread_name, VCPU_THREAD_NAME_SIZE, "ALL CPUs/TCG");
+    qemu_thread_create(first_cpu->thread, thread_name, rr_cpu_thread_fn,
+                       first_cpu, QEMU_THREAD_JOINABLE);
+}
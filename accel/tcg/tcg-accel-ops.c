@@ -204,6 +204,7 @@ static void tcg_accel_ops_init(AccelOpsClass *ops)
         ops->handle_interrupt = tcg_handle_interrupt;
     } else {
         ops->create_vcpu_thread = rr_start_vcpu_thread;
+        ops->restart_vcpu_threads = rr_restart_vcpu_thread;
         ops->kick_vcpu_thread = rr_kick_vcpu_thread;
 
         if (icount_enabled()) {
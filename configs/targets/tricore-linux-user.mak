@@ -0,0 +1,5 @@
+TARGET_ARCH=tricore
+TARGET_SYSTBL_ABI=common,32,tricore,time32,stat64,rlimit,renameat
+TARGET_SYSTBL=syscall.tbl
+TARGET_XML_FILES=gdb-xml/tricore-core.xml
+CONFIG_SEMIHOSTING=y
@@ -1 +1,2 @@
 TARGET_ARCH=tricore
+TARGET_XML_FILES=gdb-xml/tricore-core.xml
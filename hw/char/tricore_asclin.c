@@ -16,6 +16,7 @@
 #include "hw/registerfields.h"
 #include "chardev/char-fe.h"
 #include "chardev/char-serial.h"
+#include "sysemu/replay.h"
 #include "qemu/error-report.h"
 #include "migration/vmstate.h"
 #include "hw/char/tricore_asclin.h"
@@ -126,8 +127,11 @@ static gboolean uart_transmit(void *do_not_use, GIOCondition cond, void *opaque)
     /* qemu_log("QEMU->Host 0x%x\n", (int) s->txbuf); */
     ret = qemu_chr_fe_write_all(&s->chr, (uint8_t *) (&s->txbuf), 1);
     if (ret <= 0) {
-        s->watch_tag = qemu_chr_fe_add_watch(&s->chr, G_IO_OUT | G_IO_HUP,
-                uart_transmit, s);
+        /* with record/replay, the guest must not wait for the host */
+        if (replay_mode == REPLAY_MODE_NONE) {
+            s->watch_tag = qemu_chr_fe_add_watch(&s->chr, G_IO_OUT | G_IO_HUP,
+                    uart_transmit, s);
+        }
         if (!s->watch_tag) {
             /* Most common reason to be here is "no chardev backend":
              * just insta-drain the buffer, so the serial output
@@ -159,8 +163,11 @@ static gboolean uart_transmit_block(void *do_not_use, GIOCondition cond,
 
     ret = qemu_chr_fe_write_all(&s->chr, (uint8_t *) buf, length);
     if (ret <= 0) {
-        s->watch_tag = qemu_chr_fe_add_watch(&s->chr, G_IO_OUT | G_IO_HUP,
-                uart_transmit, s);
+        /* with record/replay, the guest must not wait for the host */
+        if (replay_mode == REPLAY_MODE_NONE) {
+            s->watch_tag = qemu_chr_fe_add_watch(&s->chr, G_IO_OUT | G_IO_HUP,
+                    uart_transmit, s);
+        }
         if (!s->watch_tag) {
             /*
              * Most common reason to be here is "no chardev backend":
@@ -456,8 +463,14 @@ static int asclin_uart_post_load(void *opaque, int version_id)
 {
     TriCoreASCLINState *s = TRICORE_ASCLIN(opaque);
 
+    if (s->rxbufwriteidx >= ASCLIN_RX_BUFFER ||
+        s->rxbufreadidx >= ASCLIN_RX_BUFFER) {
+        return -EINVAL;
+    }
+
     /* If we have a pending character, arrange to resend it. */
-    if ((s->regs[FLAGS] & MASK_FLAGS_TFL)) {
+    if ((s->regs[FLAGS] & MASK_FLAGS_TFL) && !s->watch_tag &&
+        replay_mode == REPLAY_MODE_NONE) {
         s->watch_tag = qemu_chr_fe_add_watch(&s->chr, G_IO_OUT | G_IO_HUP,
                 uart_transmit, s);
     }
@@ -467,11 +480,16 @@ static int asclin_uart_post_load(void *opaque, int version_id)
 
 static const VMStateDescription vmstate_asclin_uart = {
                 .name = "asclin-uart",
-                .version_id = 1,
+                .version_id = 2,
                 .minimum_version_id = 1,
                 .fields =
                     (VMStateField[]) {
                       VMSTATE_UINT32_ARRAY(regs, TriCoreASCLINState, ASCLIN_R_MAX),
+                      VMSTATE_UINT32_V(txbuf, TriCoreASCLINState, 2),
+                      VMSTATE_UINT8_ARRAY_V(rxbuf, TriCoreASCLINState,
+                                            ASCLIN_RX_BUFFER, 2),
+                      VMSTATE_UINT32_V(rxbufwriteidx, TriCoreASCLINState, 2),
+                      VMSTATE_UINT32_V(rxbufreadidx, TriCoreASCLINState, 2),
                       VMSTATE_END_OF_LIST() }, .post_load =
                        asclin_uart_post_load };
 
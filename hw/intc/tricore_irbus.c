@@ -15,10 +15,15 @@
 #include "qemu/log.h"
 #include "hw/sysbus.h"
 #include "hw/irq.h"
+#include "hw/qdev-properties.h"
 #include "qemu/main-loop.h"
+#include "qemu/timer.h"
+#include "sysemu/cpu-timers.h"
 #include "cpu.h"
 #include "qemu/error-report.h"
 #include "hw/intc/tricore_irbus.h"
+#include "migration/vmstate.h"
+#include "trace.h"
 
 enum {
     RESERVED = 0, RESERVED2, ASCLINUARTRX, ASCLINUARTTX, ASCLINUARTERR, STM
@@ -45,6 +50,14 @@ static const char *get_name_by_src(int srcnum)
         return "SRC_STMmSR0";
     case 0x35: /* SRC_STMmSR1 2 offset: 0x4A4 */
         return "SRC_STMmSR1";
+    case IR_SRC_GTM_TIM0_0 ... IR_SRC_GTM_TIM0_0 + 7:
+        return "SRC_GTMTIM0";
+    case IR_SRC_GTM_TOM0_0 ... IR_SRC_GTM_TOM0_0 + 7:
+        return "SRC_GTMTOM0";
+    case IR_SRC_GTM_ATOM0_0 ... IR_SRC_GTM_ATOM0_0 + 3:
+        return "SRC_GTMATOM0";
+    case IR_SRC_CAN0_INT0 ... IR_SRC_CAN0_INT0 + 15:
+        return "SRC_CAN0INT";
     case 254:
         return "RESET";
     default:
@@ -52,6 +65,135 @@ static const char *get_name_by_src(int srcnum)
     }
 }
 
+static int64_t tricore_irbus_icount(void)
+{
+    return icount_enabled() ? icount_get_raw() : 0;
+}
+
+/* a service request of srcnum became pending */
+static void tricore_irbus_request(TriCoreIRBUSState *s, int srcnum)
+{
+    uint32_t srpn = s->src_control_reg[srcnum] & IR_SRC_SRPN;
+
+    trace_tricore_irbus_request(srcnum, srpn);
+
+    if (s->irq_stats_enabled && s->irq_raise_ns[srpn] < 0) {
+        s->irq_raise_ns[srpn] = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+        s->irq_raise_icount[srpn] = tricore_irbus_icount();
+    }
+}
+
+static void tricore_irbus_isr_entry(TriCoreIRBUSState *s, uint32_t srpn,
+                                    uint32_t link, int64_t ns,
+                                    int64_t icount)
+{
+    TriCoreIRQStats *st = &s->irq_stats[srpn];
+    int64_t lat_ns = -1, lat_icount = -1;
+
+    st->entries++;
+    if (s->irq_raise_ns[srpn] >= 0) {
+        lat_ns = ns - s->irq_raise_ns[srpn];
+        lat_icount = icount - s->irq_raise_icount[srpn];
+        s->irq_raise_ns[srpn] = -1;
+
+        st->latency_samples++;
+        st->latency_ns_min = MIN(st->latency_ns_min, lat_ns);
+        st->latency_ns_max = MAX(st->latency_ns_max, lat_ns);
+        st->latency_ns_total += lat_ns;
+        st->latency_icount_max = MAX(st->latency_icount_max, lat_icount);
+        st->latency_icount_total += lat_icount;
+    }
+
+    if (s->irq_depth < IR_SRPN_COUNT) {
+        s->irq_frames[s->irq_depth++] = (TriCoreIRQFrame) {
+            .srpn = srpn,
+            .link = link,
+            .entry_ns = ns,
+            .entry_icount = icount,
+        };
+    }
+    st->max_nesting = MAX(st->max_nesting, s->irq_depth);
+
+    trace_tricore_irbus_isr_entry(srpn, lat_ns, lat_icount, s->irq_depth);
+}
+
+static void tricore_irbus_isr_exit(TriCoreIRBUSState *s, uint32_t link,
+                                   int64_t ns, int64_t icount)
+{
+    TriCoreIRQFrame *f;
+    TriCoreIRQStats *st;
+    int64_t dur_ns, dur_icount;
+    int i;
+
+    /*
+     * RFE from a trap handler does not return through an ISR's CSA. ISRs
+     * left without RFE, e.g. by an OS switching tasks, are dropped once
+     * an outer one returns.
+     */
+    for (i = s->irq_depth - 1; i >= 0; i--) {
+        if (s->irq_frames[i].link == link) {
+            break;
+        }
+    }
+    if (i < 0) {
+        return;
+    }
+    s->irq_depth = i;
+
+    f = &s->irq_frames[i];
+    st = &s->irq_stats[f->srpn];
+    dur_ns = ns - f->entry_ns;
+    dur_icount = icount - f->entry_icount;
+
+    st->returns++;
+    st->duration_ns_min = MIN(st->duration_ns_min, dur_ns);
+    st->duration_ns_max = MAX(st->duration_ns_max, dur_ns);
+    st->duration_ns_total += dur_ns;
+    st->duration_icount_max = MAX(st->duration_icount_max, dur_icount);
+    st->duration_icount_total += dur_icount;
+
+    trace_tricore_irbus_isr_exit(f->srpn, dur_ns, dur_icount, s->irq_depth);
+}
+
+/* installed as the CPU's irq_event hook, see TriCoreIRQEventFn */
+static void tricore_irbus_irq_event(void *opaque, bool entry, uint32_t srpn,
+                                    uint32_t pcxi)
+{
+    TriCoreIRBUSState *s = opaque;
+    int64_t ns, icount;
+
+    /* RFE runs without the BQL, the device side always holds it */
+    BQL_LOCK_GUARD();
+
+    ns = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+    icount = tricore_irbus_icount();
+    if (entry) {
+        tricore_irbus_isr_entry(s, srpn & IR_SRC_SRPN, pcxi & 0xfffff,
+                                ns, icount);
+    } else {
+        tricore_irbus_isr_exit(s, pcxi & 0xfffff, ns, icount);
+    }
+}
+
+void tricore_irbus_reset_irq_stats(TriCoreIRBUSState *s)
+{
+    for (int i = 0; i < IR_SRPN_COUNT; i++) {
+        s->irq_stats[i] = (TriCoreIRQStats) {
+            .latency_ns_min = UINT64_MAX,
+            .duration_ns_min = UINT64_MAX,
+        };
+    }
+}
+
+/* forget about pending requests and the ISRs the core is in */
+static void tricore_irbus_reset_irq_frames(TriCoreIRBUSState *s)
+{
+    for (int i = 0; i < IR_SRPN_COUNT; i++) {
+        s->irq_raise_ns[i] = -1;
+    }
+    s->irq_depth = 0;
+}
+
 static void irq_evaluate(void *opaque)
 {
     TriCoreIRBUSState *pv = opaque;
@@ -118,6 +260,9 @@ static void irq_handler(void *opaque, int srcnum, int level)
     }
     /* write back modified register */
     pv->src_control_reg[srcnum] = src_reg;
+    if (level) {
+        tricore_irbus_request(pv, srcnum);
+    }
 
     if (qemu_loglevel_mask(CPU_LOG_INT)) {
         qemu_log("tricore_irbus: SRC #%d (%s) level %d\n",
@@ -176,6 +321,18 @@ static void tricore_irbus_srvcontrolregs_write(void *opaque, hwaddr offset,
     case 0x129: /* SRC_STMmSR1 2 offset: 0x4A4 */
         srcnum = IR_SRC_STM2_SR1;
         break;
+    case 0x5E0 ... 0x5E7: /* SRC_GTMTIM0x offset: 0x1780 */
+        srcnum = IR_SRC_GTM_TIM0_0 + (reg_addr - 0x5E0);
+        break;
+    case 0x6E0 ... 0x6E7: /* SRC_GTMTOM0x offset: 0x1B80 */
+        srcnum = IR_SRC_GTM_TOM0_0 + (reg_addr - 0x6E0);
+        break;
+    case 0x6F0 ... 0x6F3: /* SRC_GTMATOM0x offset: 0x1BC0 */
+        srcnum = IR_SRC_GTM_ATOM0_0 + (reg_addr - 0x6F0);
+        break;
+    case 0x2D0 ... 0x2DF: /* SRC_CAN0INTx offset: 0xB40 */
+        srcnum = IR_SRC_CAN0_INT0 + (reg_addr - 0x2D0);
+        break;
     default:
         error_report(
                 "tricore_stm_srvreq_write: write access to unknown register 0x"
@@ -185,6 +342,7 @@ static void tricore_irbus_srvcontrolregs_write(void *opaque, hwaddr offset,
 
     if (srcnum >= 0) {
         uint32_t srcc = s->src_control_reg[srcnum];
+        bool requested;
 
         /* update the register content locally first */
         memcpy(((void *) &srcc) + (offset & 0x3), &value, size);
@@ -203,7 +361,12 @@ static void tricore_irbus_srvcontrolregs_write(void *opaque, hwaddr offset,
         }
         srcc &= ~(3 << 25);
 
+        requested = (srcc & IR_SRC_SRR) &&
+                    !(s->src_control_reg[srcnum] & IR_SRC_SRR);
         s->src_control_reg[srcnum] = srcc;
+        if (requested) {
+            tricore_irbus_request(s, srcnum);
+        }
 
         if (qemu_loglevel_mask(CPU_LOG_INT)) {
             qemu_log("tricore_irbus: SRC %s now %s (SRPN %d)\n",
@@ -243,8 +406,46 @@ static void tricore_irbus_realize(DeviceState *dev, Error **errp)
                 error_get_pretty(err));
         return;
     }
+
+    if (pv->irq_stats_enabled) {
+        CPUTriCoreState *env = &((TriCoreCPU *) (pv->cpu))->env;
+
+        tricore_irbus_reset_irq_stats(pv);
+        tricore_irbus_reset_irq_frames(pv);
+        env->irq_event = tricore_irbus_irq_event;
+        env->irq_event_opaque = pv;
+    }
 }
 
+static int tricore_irbus_post_load(void *opaque, int version_id)
+{
+    TriCoreIRBUSState *pv = opaque;
+
+    /* the ISRs in progress and pending requests are those of another run */
+    if (pv->irq_stats_enabled) {
+        tricore_irbus_reset_irq_frames(pv);
+    }
+    return 0;
+}
+
+static const VMStateDescription vmstate_tricore_irbus = {
+    .name = "tricore_irbus",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .post_load = tricore_irbus_post_load,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32_ARRAY(src_control_reg, TriCoreIRBUSState, IR_SRC_COUNT),
+        VMSTATE_UINT8_ARRAY(interruptstatusregs, TriCoreIRBUSState,
+                            IR_SRC_COUNT),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static Property tricore_irbus_properties[] = {
+    DEFINE_PROP_BOOL("irq-stats", TriCoreIRBUSState, irq_stats_enabled, false),
+    DEFINE_PROP_END_OF_LIST(),
+};
+
 static void tricore_irbus_class_init(ObjectClass *klass, void *data)
 {
     DeviceClass *dc = DEVICE_CLASS(klass);
@@ -252,6 +453,8 @@ static void tricore_irbus_class_init(ObjectClass *klass, void *data)
     /* Reason: needs to be wired up, e.g. by tricore_testboard_init() */
     dc->user_creatable = false;
     dc->realize = tricore_irbus_realize;
+    dc->vmsd = &vmstate_tricore_irbus;
+    device_class_set_props(dc, tricore_irbus_properties);
 }
 
 static TypeInfo tricore_irbus_info = { .name = "tricore_irbus", .parent =
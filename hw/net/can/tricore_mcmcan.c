@@ -0,0 +1,1110 @@
+/*
+ * QEMU model of the TriCore MCMCAN (M_CAN based) CAN controller.
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ * Each node is an M_CAN core attached to a QEMU CAN bus. The message RAM
+ * is shared by all nodes and mapped as plain RAM, frames are copied into
+ * it directly when they arrive. Interrupts are only evaluated once per
+ * main loop iteration, so a burst of frames (e.g. a replayed bus log)
+ * lands in the RX FIFO in one pass and raises a single interrupt.
+ * Bit timing is not modelled, frames are transmitted immediately.
+ */
+#include "qemu/osdep.h"
+#include "qemu/log.h"
+#include "qemu/main-loop.h"
+#include "qemu/timer.h"
+#include "qapi/error.h"
+#include "hw/registerfields.h"
+#include "hw/qdev-properties.h"
+#include "migration/vmstate.h"
+#include "sysemu/replay.h"
+#include "hw/net/tricore_mcmcan.h"
+
+/* module registers, relative to the end of the message RAM */
+REG32(CLC, 0x000)
+    FIELD(CLC, DISR, 0, 1)
+    FIELD(CLC, DISS, 1, 1)
+REG32(ID, 0x008)
+REG32(MCR, 0x030)
+
+/* TC3xx node registers */
+REG32(STARTADR, 0x000)
+REG32(ENDADR, 0x004)
+REG32(ISREG, 0x008)
+REG32(GRINT1, 0x00C)
+REG32(GRINT2, 0x010)
+
+/* M_CAN core */
+REG32(CREL, 0x100)
+REG32(ENDN, 0x104)
+REG32(DBTP, 0x10C)
+REG32(TEST, 0x110)
+    FIELD(TEST, LBCK, 4, 1)
+    FIELD(TEST, RX, 7, 1)
+REG32(RWD, 0x114)
+REG32(CCCR, 0x118)
+    FIELD(CCCR, INIT, 0, 1)
+    FIELD(CCCR, CCE, 1, 1)
+    FIELD(CCCR, CSA, 3, 1)
+    FIELD(CCCR, CSR, 4, 1)
+    FIELD(CCCR, TEST, 7, 1)
+    FIELD(CCCR, FDOE, 8, 1)
+    FIELD(CCCR, BRSE, 9, 1)
+REG32(NBTP, 0x11C)
+    FIELD(NBTP, NTSEG2, 0, 7)
+    FIELD(NBTP, NTSEG1, 8, 8)
+    FIELD(NBTP, NBRP, 16, 9)
+REG32(TSCC, 0x120)
+    FIELD(TSCC, TSS, 0, 2)
+    FIELD(TSCC, TCP, 16, 4)
+REG32(TSCV, 0x124)
+REG32(TOCC, 0x128)
+REG32(TOCV, 0x12C)
+REG32(ECR, 0x140)
+REG32(PSR, 0x144)
+REG32(TDCR, 0x148)
+REG32(IR, 0x150)
+REG32(IE, 0x154)
+REG32(ILS, 0x158)
+REG32(ILE, 0x15C)
+REG32(GFC, 0x180)
+    FIELD(GFC, RRFE, 0, 1)
+    FIELD(GFC, RRFS, 1, 1)
+    FIELD(GFC, ANFE, 2, 2)
+    FIELD(GFC, ANFS, 4, 2)
+REG32(SIDFC, 0x184)
+    FIELD(SIDFC, LSS, 16, 8)
+REG32(XIDFC, 0x188)
+    FIELD(XIDFC, LSE, 16, 7)
+REG32(XIDAM, 0x190)
+REG32(HPMS, 0x194)
+REG32(NDAT1, 0x198)
+REG32(NDAT2, 0x19C)
+REG32(RXF0C, 0x1A0)
+REG32(RXF0S, 0x1A4)
+REG32(RXF0A, 0x1A8)
+REG32(RXBC, 0x1AC)
+REG32(RXF1C, 0x1B0)
+REG32(RXF1S, 0x1B4)
+REG32(RXF1A, 0x1B8)
+REG32(RXESC, 0x1BC)
+    FIELD(RXESC, F0DS, 0, 3)
+    FIELD(RXESC, F1DS, 4, 3)
+    FIELD(RXESC, RBDS, 8, 3)
+REG32(TXBC, 0x1C0)
+    FIELD(TXBC, NDTB, 16, 6)
+    FIELD(TXBC, TFQS, 24, 6)
+    FIELD(TXBC, TFQM, 30, 1)
+REG32(TXFQS, 0x1C4)
+REG32(TXESC, 0x1C8)
+    FIELD(TXESC, TBDS, 0, 3)
+REG32(TXBRP, 0x1CC)
+REG32(TXBAR, 0x1D0)
+REG32(TXBCR, 0x1D4)
+REG32(TXBTO, 0x1D8)
+REG32(TXBCF, 0x1DC)
+REG32(TXBTIE, 0x1E0)
+REG32(TXBCIE, 0x1E4)
+REG32(TXEFC, 0x1F0)
+REG32(TXEFS, 0x1F4)
+REG32(TXEFA, 0x1F8)
+
+#define IR_RF0N (1 << 0)
+#define IR_RF0W (1 << 1)
+#define IR_RF0F (1 << 2)
+#define IR_RF0L (1 << 3)
+#define IR_RF1N (1 << 4)
+#define IR_RF1W (1 << 5)
+#define IR_RF1F (1 << 6)
+#define IR_RF1L (1 << 7)
+#define IR_HPM  (1 << 8)
+#define IR_TC   (1 << 9)
+#define IR_TCF  (1 << 10)
+#define IR_TFE  (1 << 11)
+#define IR_TEFN (1 << 12)
+#define IR_TEFW (1 << 13)
+#define IR_TEFF (1 << 14)
+#define IR_TEFL (1 << 15)
+#define IR_TSW  (1 << 16)
+#define IR_MRAF (1 << 17)
+#define IR_TOO  (1 << 18)
+#define IR_DRX  (1 << 19)
+#define IR_BEC  (1 << 20)
+#define IR_BEU  (1 << 21)
+#define IR_ELO  (1 << 22)
+#define IR_EP   (1 << 23)
+#define IR_EW   (1 << 24)
+#define IR_BO   (1 << 25)
+#define IR_WDI  (1 << 26)
+#define IR_PEA  (1 << 27)
+#define IR_PED  (1 << 28)
+#define IR_ARA  (1 << 29)
+
+/* first word of RX, TX and TX event elements */
+#define ELEM_ESI (1u << 31)
+#define ELEM_XTD (1 << 30)
+#define ELEM_RTR (1 << 29)
+/* second word */
+#define ELEM_ANMF (1u << 31)
+#define ELEM_EFC (1 << 23)
+#define ELEM_ET_TX (1 << 22)
+#define ELEM_FDF (1 << 21)
+#define ELEM_BRS (1 << 20)
+
+/* FIFO status registers share one layout for RX FIFOs and TX events */
+#define FIFO_STAT_FULL (1 << 24)
+#define FIFO_STAT_LOST (1 << 25)
+#define FIFO_CFG_OM (1u << 31)
+
+/* filter element configuration, identical for SFEC and EFEC */
+enum {
+    FEC_DISABLE,
+    FEC_FIFO0,
+    FEC_FIFO1,
+    FEC_REJECT,
+    FEC_PRIO,
+    FEC_PRIO_FIFO0,
+    FEC_PRIO_FIFO1,
+    FEC_RXBUF,
+};
+
+typedef struct MCMCANFifo {
+    int cfg;
+    int stat;
+    uint32_t max;
+    uint32_t ir_new;
+    uint32_t ir_wm;
+    uint32_t ir_full;
+    uint32_t ir_lost;
+} MCMCANFifo;
+
+static const MCMCANFifo mcmcan_rx_fifo[2] = {
+    { R_RXF0C, R_RXF0S, 64, IR_RF0N, IR_RF0W, IR_RF0F, IR_RF0L },
+    { R_RXF1C, R_RXF1S, 64, IR_RF1N, IR_RF1W, IR_RF1F, IR_RF1L },
+};
+
+static const MCMCANFifo mcmcan_tx_event_fifo = {
+    R_TXEFC, R_TXEFS, 32, IR_TEFN, IR_TEFW, IR_TEFF, IR_TEFL,
+};
+
+/*
+ * IR flags feeding the 16 interrupt groups, in the order of the routing
+ * fields in GRINT1 and GRINT2.
+ */
+static const uint32_t mcmcan_int_groups[16] = {
+    IR_MRAF | IR_ELO | IR_EP | IR_EW | IR_ARA,      /* ALRT */
+    IR_PEA | IR_PED,                                /* MOER */
+    IR_BEC | IR_BEU,                                /* SAFE */
+    IR_BO,                                          /* BOFF */
+    0,                                              /* LOI */
+    IR_DRX,                                         /* REINT */
+    IR_RF1W | IR_RF1F | IR_RF1L,                    /* RXF1F */
+    IR_RF0W | IR_RF0F | IR_RF0L,                    /* RXF0F */
+    IR_RF1N,                                        /* RXF1N */
+    IR_RF0N,                                        /* RXF0N */
+    IR_TSW | IR_TOO,                                /* RETI */
+    IR_TCF | IR_TFE,                                /* TRAQ */
+    IR_TC,                                          /* TRCO */
+    IR_WDI,                                         /* WATI */
+    IR_HPM,                                         /* HPE */
+    IR_TEFN | IR_TEFW | IR_TEFF | IR_TEFL,          /* TEFIFO */
+};
+
+static void mcmcan_update_irq(TriCoreMCMCANState *s)
+{
+    uint32_t lines = 0;
+
+    for (int i = 0; i < TRICORE_MCMCAN_NODES; i++) {
+        TriCoreMCMCANNode *n = &s->node[i];
+        uint32_t active = n->regs[R_IR] & n->regs[R_IE];
+
+        for (int g = 0; active && g < 16; g++) {
+            uint32_t grint = n->regs[g < 8 ? R_GRINT1 : R_GRINT2];
+
+            if (active & mcmcan_int_groups[g]) {
+                lines |= 1 << ((grint >> ((g % 8) * 4)) & 0xF);
+            }
+        }
+    }
+
+    for (int i = 0; i < TRICORE_MCMCAN_NUM_INT; i++) {
+        qemu_set_irq(s->irq[i], (lines >> i) & 1);
+    }
+}
+
+static bool mcmcan_node_active(TriCoreMCMCANNode *n)
+{
+    return !(n->mcmcan->CLC & R_CLC_DISS_MASK) &&
+           !(n->regs[R_CCCR] & R_CCCR_INIT_MASK);
+}
+
+/* data field size of an element, from the RXESC/TXESC encoding */
+static uint32_t mcmcan_data_size(uint32_t code)
+{
+    return code < 5 ? 8 + code * 4 : (code - 3) * 16;
+}
+
+static uint8_t *mcmcan_ram(TriCoreMCMCANNode *n, uint32_t addr, uint32_t len)
+{
+    TriCoreMCMCANState *s = n->mcmcan;
+
+    if (addr + len > TRICORE_MCMCAN_RAM_SIZE) {
+        qemu_log_mask(LOG_GUEST_ERROR, "tricore_mcmcan: message RAM access "
+                      "out of range at 0x%x\n", addr);
+        n->regs[R_IR] |= IR_MRAF;
+        return NULL;
+    }
+    return (uint8_t *)memory_region_get_ram_ptr(&s->msgram) + addr;
+}
+
+static uint32_t mcmcan_timestamp(TriCoreMCMCANNode *n)
+{
+    uint32_t tscc = n->regs[R_TSCC];
+    uint32_t nbtp = n->regs[R_NBTP];
+    uint64_t clocks;
+    int64_t now;
+
+    if (FIELD_EX32(tscc, TSCC, TSS) != 1) {
+        return 0;
+    }
+
+    /* the counter advances once every TCP + 1 nominal bit times */
+    clocks = (uint64_t)(FIELD_EX32(nbtp, NBTP, NBRP) + 1) *
+             (FIELD_EX32(nbtp, NBTP, NTSEG1) +
+              FIELD_EX32(nbtp, NBTP, NTSEG2) + 3) *
+             (FIELD_EX32(tscc, TSCC, TCP) + 1);
+    now = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+
+    return (muldiv64(now - n->ts_start_ns, n->mcmcan->freq_hz,
+                     NANOSECONDS_PER_SECOND) / clocks) & 0xFFFF;
+}
+
+static uint32_t mcmcan_frame_id(const qemu_can_frame *frame)
+{
+    uint32_t r0;
+
+    if (frame->can_id & QEMU_CAN_EFF_FLAG) {
+        r0 = ELEM_XTD | (frame->can_id & QEMU_CAN_EFF_MASK);
+    } else {
+        r0 = (frame->can_id & QEMU_CAN_SFF_MASK) << 18;
+    }
+    if (frame->can_id & QEMU_CAN_RTR_FLAG) {
+        r0 |= ELEM_RTR;
+    }
+    if (frame->flags & QEMU_CAN_FRMF_ESI) {
+        r0 |= ELEM_ESI;
+    }
+    return r0;
+}
+
+static void mcmcan_store_frame(TriCoreMCMCANNode *n, uint32_t addr,
+                               uint32_t dsize, const qemu_can_frame *frame,
+                               uint32_t r1)
+{
+    uint8_t *p = mcmcan_ram(n, addr, 8 + dsize);
+
+    if (!p) {
+        return;
+    }
+
+    r1 |= can_len2dlc(frame->can_dlc) << 16;
+    if (frame->flags & QEMU_CAN_FRMF_TYPE_FD) {
+        r1 |= ELEM_FDF;
+        if (frame->flags & QEMU_CAN_FRMF_BRS) {
+            r1 |= ELEM_BRS;
+        }
+    }
+
+    stl_le_p(p, mcmcan_frame_id(frame));
+    stl_le_p(p + 4, r1);
+    memcpy(p + 8, frame->data, MIN(frame->can_dlc, dsize));
+    memory_region_set_dirty(&n->mcmcan->msgram, addr, 8 + dsize);
+}
+
+static bool mcmcan_load_frame(TriCoreMCMCANNode *n, uint32_t addr,
+                              uint32_t dsize, qemu_can_frame *frame,
+                              uint32_t *t1)
+{
+    uint8_t *p = mcmcan_ram(n, addr, 8 + dsize);
+    uint32_t t0, dlc;
+
+    if (!p) {
+        return false;
+    }
+
+    t0 = ldl_le_p(p);
+    *t1 = ldl_le_p(p + 4);
+    dlc = (*t1 >> 16) & 0xF;
+
+    memset(frame, 0, sizeof(*frame));
+    if (t0 & ELEM_XTD) {
+        frame->can_id = (t0 & QEMU_CAN_EFF_MASK) | QEMU_CAN_EFF_FLAG;
+    } else {
+        frame->can_id = (t0 >> 18) & QEMU_CAN_SFF_MASK;
+    }
+    if (t0 & ELEM_RTR) {
+        frame->can_id |= QEMU_CAN_RTR_FLAG;
+    }
+
+    if ((*t1 & ELEM_FDF) && (n->regs[R_CCCR] & R_CCCR_FDOE_MASK)) {
+        frame->flags = QEMU_CAN_FRMF_TYPE_FD;
+        if ((*t1 & ELEM_BRS) && (n->regs[R_CCCR] & R_CCCR_BRSE_MASK)) {
+            frame->flags |= QEMU_CAN_FRMF_BRS;
+        }
+        frame->can_dlc = can_dlc2len(dlc);
+    } else {
+        frame->can_dlc = MIN(dlc, 8);
+    }
+    memcpy(frame->data, p + 8, MIN(frame->can_dlc, dsize));
+
+    return true;
+}
+
+/* claim the next element of a FIFO, returns false if the frame is lost */
+static bool mcmcan_fifo_put(TriCoreMCMCANNode *n, const MCMCANFifo *f,
+                            uint32_t esize, uint32_t *addr)
+{
+    uint32_t cfg = n->regs[f->cfg];
+    uint32_t stat = n->regs[f->stat];
+    uint32_t size = MIN((cfg >> 16) & 0x7F, f->max);
+    uint32_t wm = (cfg >> 24) & 0x7F;
+    uint32_t fl = stat & 0x7F;
+    uint32_t gi = (stat >> 8) & 0x3F;
+    uint32_t pi = (stat >> 16) & 0x3F;
+
+    if (!size) {
+        return false;
+    }
+
+    if (fl >= size) {
+        if (!(cfg & FIFO_CFG_OM)) {
+            n->regs[f->stat] |= FIFO_STAT_LOST;
+            n->regs[R_IR] |= f->ir_lost;
+            return false;
+        }
+        /* overwrite mode drops the oldest element */
+        gi = (gi + 1) % size;
+        fl--;
+    }
+
+    *addr = (cfg & 0xFFFC) + pi * esize;
+    pi = (pi + 1) % size;
+    fl++;
+
+    n->regs[R_IR] |= f->ir_new;
+    if (fl == wm) {
+        n->regs[R_IR] |= f->ir_wm;
+    }
+    if (fl == size) {
+        n->regs[R_IR] |= f->ir_full;
+    }
+    n->regs[f->stat] = (stat & FIFO_STAT_LOST) | fl | (gi << 8) | (pi << 16) |
+                       (fl == size ? FIFO_STAT_FULL : 0);
+    return true;
+}
+
+static void mcmcan_fifo_ack(TriCoreMCMCANNode *n, const MCMCANFifo *f,
+                            uint32_t ai)
+{
+    uint32_t stat = n->regs[f->stat];
+    uint32_t size = MIN((n->regs[f->cfg] >> 16) & 0x7F, f->max);
+    uint32_t fl = stat & 0x7F;
+    uint32_t gi = (stat >> 8) & 0x3F;
+    uint32_t num;
+
+    if (!fl || ai >= size) {
+        return;
+    }
+
+    /* acknowledging an element releases all older ones as well */
+    num = (ai + size - gi) % size + 1;
+    if (num > fl) {
+        return;
+    }
+    fl -= num;
+    gi = (ai + 1) % size;
+
+    n->regs[f->stat] = (stat & (FIFO_STAT_LOST | (0x3F << 16))) | fl |
+                       (gi << 8);
+}
+
+static bool mcmcan_match(uint32_t type, uint32_t id, uint32_t id1, uint32_t id2)
+{
+    switch (type) {
+    case 0: /* range */
+    case 3: /* range, XIDAM not applied */
+        return id >= id1 && id <= id2;
+    case 1: /* dual ID */
+        return id == id1 || id == id2;
+    case 2: /* classic filter and mask */
+        return (id & id2) == (id1 & id2);
+    default:
+        return false;
+    }
+}
+
+/*
+ * Run @frame through the standard or extended filter list. Returns the
+ * element configuration of the first matching filter or -1.
+ */
+static int mcmcan_filter(TriCoreMCMCANNode *n, const qemu_can_frame *frame,
+                         uint32_t *fidx, uint32_t *bufidx)
+{
+    uint32_t sidfc = n->regs[R_SIDFC];
+    uint32_t xidfc = n->regs[R_XIDFC];
+    uint8_t *p;
+
+    if (!(frame->can_id & QEMU_CAN_EFF_FLAG)) {
+        uint32_t id = frame->can_id & QEMU_CAN_SFF_MASK;
+        uint32_t lss = MIN(FIELD_EX32(sidfc, SIDFC, LSS), 128);
+
+        p = mcmcan_ram(n, sidfc & 0xFFFC, lss * 4);
+        for (uint32_t i = 0; p && i < lss; i++) {
+            uint32_t s0 = ldl_le_p(p + i * 4);
+            uint32_t sft = s0 >> 30;
+            uint32_t sfec = (s0 >> 27) & 7;
+            uint32_t id1 = (s0 >> 16) & 0x7FF;
+            uint32_t id2 = s0 & 0x7FF;
+
+            if (sfec == FEC_DISABLE) {
+                continue;
+            }
+            if (sfec == FEC_RXBUF ? id == id1 : mcmcan_match(sft, id, id1,
+                                                             id2)) {
+                *fidx = i;
+                *bufidx = id2 & 0x3F;
+                return sfec;
+            }
+        }
+    } else {
+        uint32_t id = frame->can_id & QEMU_CAN_EFF_MASK;
+        uint32_t lse = FIELD_EX32(xidfc, XIDFC, LSE);
+
+        p = mcmcan_ram(n, xidfc & 0xFFFC, lse * 8);
+        for (uint32_t i = 0; p && i < lse; i++) {
+            uint32_t f0 = ldl_le_p(p + i * 8);
+            uint32_t f1 = ldl_le_p(p + i * 8 + 4);
+            uint32_t eft = f1 >> 30;
+            uint32_t efec = f0 >> 29;
+            uint32_t id1 = f0 & QEMU_CAN_EFF_MASK;
+            uint32_t id2 = f1 & QEMU_CAN_EFF_MASK;
+            uint32_t idm = eft == 3 ? id : id & n->regs[R_XIDAM];
+
+            if (efec == FEC_DISABLE) {
+                continue;
+            }
+            if (efec == FEC_RXBUF ? id == id1 : mcmcan_match(eft, idm, id1,
+                                                             id2)) {
+                *fidx = i;
+                *bufidx = id2 & 0x3F;
+                return efec;
+            }
+        }
+    }
+
+    return -1;
+}
+
+static void mcmcan_rx_fifo_store(TriCoreMCMCANNode *n, int fifo,
+                                 const qemu_can_frame *frame, uint32_t r1)
+{
+    uint32_t code = fifo ? FIELD_EX32(n->regs[R_RXESC], RXESC, F1DS)
+                         : FIELD_EX32(n->regs[R_RXESC], RXESC, F0DS);
+    uint32_t dsize = mcmcan_data_size(code);
+    uint32_t addr;
+
+    if (mcmcan_fifo_put(n, &mcmcan_rx_fifo[fifo], 8 + dsize, &addr)) {
+        mcmcan_store_frame(n, addr, dsize, frame, r1);
+    }
+}
+
+static void mcmcan_node_rx(TriCoreMCMCANNode *n, const qemu_can_frame *frame)
+{
+    bool ext = frame->can_id & QEMU_CAN_EFF_FLAG;
+    uint32_t gfc = n->regs[R_GFC];
+    uint32_t ts = mcmcan_timestamp(n);
+    uint32_t fidx = 0, buf = 0, r1;
+    uint32_t dsize, addr;
+    int fec;
+
+    if (frame->can_id & QEMU_CAN_ERR_FLAG) {
+        return;
+    }
+    if ((frame->can_id & QEMU_CAN_RTR_FLAG) &&
+        (gfc & (ext ? R_GFC_RRFE_MASK : R_GFC_RRFS_MASK))) {
+        return;
+    }
+
+    fec = mcmcan_filter(n, frame, &fidx, &buf);
+    r1 = ts | (fidx << 24);
+    if (fec < 0) {
+        uint32_t anf = ext ? FIELD_EX32(gfc, GFC, ANFE)
+                           : FIELD_EX32(gfc, GFC, ANFS);
+
+        if (anf > 1) {
+            return;
+        }
+        fec = anf ? FEC_FIFO1 : FEC_FIFO0;
+        r1 = ts | ELEM_ANMF;
+    }
+
+    switch (fec) {
+    case FEC_FIFO0:
+    case FEC_FIFO1:
+        mcmcan_rx_fifo_store(n, fec - FEC_FIFO0, frame, r1);
+        break;
+    case FEC_PRIO:
+    case FEC_PRIO_FIFO0:
+    case FEC_PRIO_FIFO1:
+        /* MSI: 0 no FIFO, 2 FIFO 0, 3 FIFO 1 */
+        n->regs[R_HPMS] = (fidx << 8) | (ext ? 1 << 15 : 0) |
+                          (fec == FEC_PRIO ? 0 : (fec - FEC_PRIO + 1) << 6);
+        n->regs[R_IR] |= IR_HPM;
+        if (fec != FEC_PRIO) {
+            mcmcan_rx_fifo_store(n, fec - FEC_PRIO_FIFO0, frame, r1);
+        }
+        break;
+    case FEC_RXBUF:
+        dsize = mcmcan_data_size(FIELD_EX32(n->regs[R_RXESC], RXESC, RBDS));
+        addr = (n->regs[R_RXBC] & 0xFFFC) + buf * (8 + dsize);
+        mcmcan_store_frame(n, addr, dsize, frame, r1);
+        n->regs[buf < 32 ? R_NDAT1 : R_NDAT2] |= 1u << (buf % 32);
+        n->regs[R_IR] |= IR_DRX;
+        break;
+    default:
+        break;
+    }
+}
+
+/*
+ * Frames that arrive within one main loop iteration, e.g. a replayed bus
+ * log, are stored by tricore_mcmcan_receive() right away and raise a
+ * single interrupt from here.
+ */
+static void mcmcan_irq_bh(void *opaque)
+{
+    TriCoreMCMCANState *s = opaque;
+
+    s->irq_bh_pending = false;
+    mcmcan_update_irq(s);
+}
+
+/* TX buffers 0..NDTB-1 are dedicated, the FIFO/queue follows them */
+static void mcmcan_tx_fifo(TriCoreMCMCANNode *n, uint32_t *first,
+                           uint32_t *num)
+{
+    uint32_t txbc = n->regs[R_TXBC];
+
+    *first = MIN(FIELD_EX32(txbc, TXBC, NDTB), 32);
+    *num = MIN(FIELD_EX32(txbc, TXBC, TFQS), 32 - *first);
+}
+
+static uint32_t mcmcan_txfqs(TriCoreMCMCANNode *n)
+{
+    uint32_t first, num, fifo, pending, free, pi, gi;
+
+    mcmcan_tx_fifo(n, &first, &num);
+    if (!num) {
+        return 0;
+    }
+    fifo = MAKE_64BIT_MASK(first, num);
+    pending = n->regs[R_TXBRP] & fifo;
+
+    if (n->regs[R_TXBC] & R_TXBC_TFQM_MASK) {
+        free = ~pending & fifo;
+        pi = free ? ctz32(free) : 0;
+        return ctpop32(free) | (pi << 16) | (free ? 0 : 1 << 21);
+    }
+
+    gi = n->txf_gi;
+    pi = first + (gi - first + ctpop32(pending)) % num;
+    free = num - ctpop32(pending);
+    return free | (gi << 8) | (pi << 16) | (free ? 0 : 1 << 21);
+}
+
+static void mcmcan_tx_done(TriCoreMCMCANNode *n, uint32_t idx,
+                           const qemu_can_frame *frame, uint32_t t1)
+{
+    uint32_t first, num, addr;
+
+    n->regs[R_TXBRP] &= ~(1u << idx);
+    n->regs[R_TXBTO] |= 1u << idx;
+    if (n->regs[R_TXBTIE] & (1u << idx)) {
+        n->regs[R_IR] |= IR_TC;
+    }
+
+    if ((t1 & ELEM_EFC) &&
+        mcmcan_fifo_put(n, &mcmcan_tx_event_fifo, 8, &addr)) {
+        mcmcan_store_frame(n, addr, 0, frame, (t1 & 0xFF000000) | ELEM_ET_TX |
+                           mcmcan_timestamp(n));
+    }
+
+    mcmcan_tx_fifo(n, &first, &num);
+    if (idx >= first && idx < first + num &&
+        !(n->regs[R_TXBC] & R_TXBC_TFQM_MASK)) {
+        n->txf_gi = first + (idx - first + 1) % num;
+        if (!(n->regs[R_TXBRP] & MAKE_64BIT_MASK(first, num))) {
+            n->regs[R_IR] |= IR_TFE;
+        }
+    }
+}
+
+/* send all pending buffers to the bus in one go */
+static void mcmcan_tx_pending(TriCoreMCMCANNode *n)
+{
+    qemu_can_frame frames[32];
+    uint32_t t1[32], idx[32];
+    uint32_t pending = n->regs[R_TXBRP];
+    uint32_t dsize, tbsa;
+    int cnt = 0;
+
+    if (!pending || !mcmcan_node_active(n)) {
+        return;
+    }
+
+    dsize = mcmcan_data_size(FIELD_EX32(n->regs[R_TXESC], TXESC, TBDS));
+    tbsa = n->regs[R_TXBC] & 0xFFFC;
+
+    while (pending) {
+        uint32_t i = ctz32(pending);
+
+        pending &= pending - 1;
+        if (mcmcan_load_frame(n, tbsa + i * (8 + dsize), dsize, &frames[cnt],
+                              &t1[cnt])) {
+            idx[cnt++] = i;
+        }
+    }
+
+    if (n->bus_client.bus) {
+        can_bus_client_send(&n->bus_client, frames, cnt);
+    }
+
+    for (int i = 0; i < cnt; i++) {
+        if ((n->regs[R_CCCR] & R_CCCR_TEST_MASK) &&
+            (n->regs[R_TEST] & R_TEST_LBCK_MASK)) {
+            mcmcan_node_rx(n, &frames[i]);
+        }
+        mcmcan_tx_done(n, idx[i], &frames[i], t1[i]);
+    }
+}
+
+static void mcmcan_node_reset(TriCoreMCMCANNode *n)
+{
+    memset(n->regs, 0, sizeof(n->regs));
+    n->regs[R_CREL] = 0x32150320;
+    n->regs[R_ENDN] = 0x87654321;
+    n->regs[R_DBTP] = 0x00000A33;
+    n->regs[R_TEST] = R_TEST_RX_MASK;
+    n->regs[R_CCCR] = R_CCCR_INIT_MASK;
+    n->regs[R_NBTP] = 0x06000A03;
+    n->regs[R_TOCC] = 0xFFFF0000;
+    n->regs[R_TOCV] = 0x0000FFFF;
+    n->regs[R_PSR] = 0x00000707;
+    n->regs[R_XIDAM] = 0x1FFFFFFF;
+    n->txf_gi = 0;
+    n->ts_start_ns = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+    n->bus_client.fd_mode = false;
+}
+
+static uint32_t mcmcan_node_read(TriCoreMCMCANNode *n, hwaddr offset)
+{
+    switch (offset >> 2) {
+    case R_TSCV:
+        return mcmcan_timestamp(n);
+    case R_TXFQS:
+        return mcmcan_txfqs(n);
+    case R_TXBAR:
+    case R_TXBCR:
+        return 0;
+    default:
+        return n->regs[offset >> 2];
+    }
+}
+
+static void mcmcan_node_write(TriCoreMCMCANNode *n, hwaddr offset,
+                              uint32_t value)
+{
+    uint32_t reg = offset >> 2;
+    uint32_t cccr = n->regs[R_CCCR];
+    bool config = (cccr & R_CCCR_INIT_MASK) && (cccr & R_CCCR_CCE_MASK);
+    uint32_t cancel;
+
+    switch (reg) {
+    case R_STARTADR:
+    case R_ENDADR:
+    case R_GRINT1:
+    case R_GRINT2:
+    case R_IE:
+    case R_ILS:
+    case R_ILE:
+    case R_RWD:
+        n->regs[reg] = value;
+        break;
+    case R_CCCR:
+        /* configuration bits are only writable with CCE and INIT set */
+        if (!config) {
+            value = (value & (R_CCCR_INIT_MASK | R_CCCR_CCE_MASK |
+                              R_CCCR_CSR_MASK)) |
+                    (cccr & ~(R_CCCR_INIT_MASK | R_CCCR_CCE_MASK |
+                              R_CCCR_CSR_MASK));
+        }
+        if (value & R_CCCR_CSR_MASK) {
+            value |= R_CCCR_INIT_MASK | R_CCCR_CSA_MASK;
+        } else {
+            value &= ~R_CCCR_CSA_MASK;
+        }
+        if (!(value & R_CCCR_INIT_MASK) || !(cccr & R_CCCR_INIT_MASK)) {
+            value &= ~R_CCCR_CCE_MASK;
+        }
+        if (!(value & R_CCCR_TEST_MASK)) {
+            n->regs[R_TEST] = R_TEST_RX_MASK;
+        }
+        n->regs[R_CCCR] = value;
+        n->bus_client.fd_mode = value & R_CCCR_FDOE_MASK;
+        mcmcan_tx_pending(n);
+        break;
+    case R_TEST:
+        if (cccr & R_CCCR_TEST_MASK) {
+            n->regs[R_TEST] = (value & ~R_TEST_RX_MASK) | R_TEST_RX_MASK;
+        }
+        break;
+    case R_DBTP:
+    case R_NBTP:
+    case R_TSCC:
+    case R_TOCC:
+    case R_TDCR:
+    case R_GFC:
+    case R_SIDFC:
+    case R_XIDFC:
+    case R_XIDAM:
+    case R_RXBC:
+    case R_RXESC:
+    case R_TXESC:
+        if (!config) {
+            qemu_log_mask(LOG_GUEST_ERROR, "tricore_mcmcan: write to "
+                          "protected register 0x%" HWADDR_PRIx "\n", offset);
+            break;
+        }
+        n->regs[reg] = value;
+        break;
+    case R_RXF0C:
+    case R_RXF1C:
+    case R_TXEFC:
+    case R_TXBC:
+        if (!config) {
+            qemu_log_mask(LOG_GUEST_ERROR, "tricore_mcmcan: write to "
+                          "protected register 0x%" HWADDR_PRIx "\n", offset);
+            break;
+        }
+        n->regs[reg] = value;
+        /* reconfiguring a FIFO empties it */
+        if (reg == R_RXF0C) {
+            n->regs[R_RXF0S] = 0;
+        } else if (reg == R_RXF1C) {
+            n->regs[R_RXF1S] = 0;
+        } else if (reg == R_TXEFC) {
+            n->regs[R_TXEFS] = 0;
+        } else {
+            n->txf_gi = MIN(FIELD_EX32(value, TXBC, NDTB), 32);
+        }
+        break;
+    case R_TSCV:
+        n->ts_start_ns = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+        break;
+    case R_IR:
+    case R_NDAT1:
+    case R_NDAT2:
+        n->regs[reg] &= ~value;
+        break;
+    case R_RXF0A:
+        mcmcan_fifo_ack(n, &mcmcan_rx_fifo[0], value & 0x3F);
+        break;
+    case R_RXF1A:
+        mcmcan_fifo_ack(n, &mcmcan_rx_fifo[1], value & 0x3F);
+        break;
+    case R_TXEFA:
+        mcmcan_fifo_ack(n, &mcmcan_tx_event_fifo, value & 0x1F);
+        break;
+    case R_TXBAR: {
+        uint32_t first, num;
+
+        mcmcan_tx_fifo(n, &first, &num);
+        value &= first + num ? MAKE_64BIT_MASK(0, first + num) : 0;
+        n->regs[R_TXBTO] &= ~value;
+        n->regs[R_TXBCF] &= ~value;
+        n->regs[R_TXBRP] |= value;
+        mcmcan_tx_pending(n);
+        break;
+    }
+    case R_TXBCR:
+        cancel = value & n->regs[R_TXBRP];
+        n->regs[R_TXBRP] &= ~cancel;
+        n->regs[R_TXBCF] |= cancel;
+        if (cancel & n->regs[R_TXBCIE]) {
+            n->regs[R_IR] |= IR_TCF;
+        }
+        break;
+    case R_TXBTIE:
+    case R_TXBCIE:
+        n->regs[reg] = value;
+        break;
+    default:
+        qemu_log_mask(LOG_GUEST_ERROR, "tricore_mcmcan: write to read-only "
+                      "or unknown register 0x%" HWADDR_PRIx "\n", offset);
+        break;
+    }
+}
+
+static uint64_t tricore_mcmcan_read(void *opaque, hwaddr offset, unsigned size)
+{
+    TriCoreMCMCANState *s = opaque;
+    hwaddr rel;
+
+    if (offset >= TRICORE_MCMCAN_NODE_BASE - TRICORE_MCMCAN_RAM_SIZE) {
+        rel = offset - (TRICORE_MCMCAN_NODE_BASE - TRICORE_MCMCAN_RAM_SIZE);
+        if (rel / TRICORE_MCMCAN_NODE_STRIDE < TRICORE_MCMCAN_NODES &&
+            rel % TRICORE_MCMCAN_NODE_STRIDE < TRICORE_MCMCAN_NODE_R_MAX * 4) {
+            return mcmcan_node_read(&s->node[rel / TRICORE_MCMCAN_NODE_STRIDE],
+                                    rel % TRICORE_MCMCAN_NODE_STRIDE);
+        }
+    }
+
+    switch (offset) {
+    case A_CLC:
+        return s->CLC;
+    case A_ID:
+        return RESET_TRICORE_MCMCAN_ID;
+    case A_MCR:
+        return s->MCR;
+    default:
+        qemu_log_mask(LOG_UNIMP, "tricore_mcmcan: read from unimplemented "
+                      "register 0x%" HWADDR_PRIx "\n", offset);
+        return 0;
+    }
+}
+
+static void tricore_mcmcan_write(void *opaque, hwaddr offset, uint64_t value,
+                                 unsigned size)
+{
+    TriCoreMCMCANState *s = opaque;
+    hwaddr rel;
+
+    if (offset >= TRICORE_MCMCAN_NODE_BASE - TRICORE_MCMCAN_RAM_SIZE) {
+        rel = offset - (TRICORE_MCMCAN_NODE_BASE - TRICORE_MCMCAN_RAM_SIZE);
+        if (rel / TRICORE_MCMCAN_NODE_STRIDE < TRICORE_MCMCAN_NODES &&
+            rel % TRICORE_MCMCAN_NODE_STRIDE < TRICORE_MCMCAN_NODE_R_MAX * 4) {
+            mcmcan_node_write(&s->node[rel / TRICORE_MCMCAN_NODE_STRIDE],
+                              rel % TRICORE_MCMCAN_NODE_STRIDE, value);
+            mcmcan_update_irq(s);
+            return;
+        }
+    }
+
+    switch (offset) {
+    case A_CLC:
+        /* DISS follows DISR immediately */
+        s->CLC = (value & ~R_CLC_DISS_MASK) |
+                 FIELD_DP32(0, CLC, DISS, FIELD_EX32(value, CLC, DISR));
+        for (int i = 0; i < TRICORE_MCMCAN_NODES; i++) {
+            mcmcan_tx_pending(&s->node[i]);
+        }
+        mcmcan_update_irq(s);
+        break;
+    case A_MCR:
+        s->MCR = value;
+        break;
+    default:
+        qemu_log_mask(LOG_UNIMP, "tricore_mcmcan: write to unimplemented "
+                      "register 0x%" HWADDR_PRIx "\n", offset);
+        break;
+    }
+}
+
+static const MemoryRegionOps tricore_mcmcan_ops = {
+    .read = tricore_mcmcan_read,
+    .write = tricore_mcmcan_write,
+    .valid = { .min_access_size = 4, .max_access_size = 4, },
+    .endianness = DEVICE_NATIVE_ENDIAN
+};
+
+static bool tricore_mcmcan_can_receive(CanBusClientState *client)
+{
+    TriCoreMCMCANNode *n = container_of(client, TriCoreMCMCANNode, bus_client);
+
+    return mcmcan_node_active(n);
+}
+
+static ssize_t tricore_mcmcan_receive(CanBusClientState *client,
+                                      const qemu_can_frame *frames,
+                                      size_t frames_cnt)
+{
+    TriCoreMCMCANNode *n = container_of(client, TriCoreMCMCANNode, bus_client);
+    TriCoreMCMCANState *s = n->mcmcan;
+
+    /* a full RX FIFO drops or overwrites as configured, see RXFnC.FnOM */
+    for (size_t i = 0; i < frames_cnt; i++) {
+        mcmcan_node_rx(n, &frames[i]);
+    }
+
+    /* more frames of the same burst may follow before the bottom half */
+    if (!s->irq_bh_pending) {
+        s->irq_bh_pending = true;
+        replay_bh_schedule_event(s->irq_bh);
+    }
+    return 1;
+}
+
+static CanBusClientInfo tricore_mcmcan_bus_client_info = {
+    .can_receive = tricore_mcmcan_can_receive,
+    .receive = tricore_mcmcan_receive,
+};
+
+static void tricore_mcmcan_reset(DeviceState *dev)
+{
+    TriCoreMCMCANState *s = TRICORE_MCMCAN(dev);
+
+    s->CLC = RESET_TRICORE_MCMCAN_CLC;
+    s->MCR = 0;
+    for (int i = 0; i < TRICORE_MCMCAN_NODES; i++) {
+        mcmcan_node_reset(&s->node[i]);
+    }
+    mcmcan_update_irq(s);
+}
+
+static void tricore_mcmcan_realize(DeviceState *dev, Error **errp)
+{
+    TriCoreMCMCANState *s = TRICORE_MCMCAN(dev);
+
+    if (!memory_region_init_ram(&s->msgram, OBJECT(dev),
+                                "tricore_mcmcan.msgram",
+                                TRICORE_MCMCAN_RAM_SIZE, errp)) {
+        return;
+    }
+    memory_region_add_subregion(&s->iomem, 0, &s->msgram);
+
+    for (int i = 0; i < TRICORE_MCMCAN_NODES; i++) {
+        TriCoreMCMCANNode *n = &s->node[i];
+
+        n->mcmcan = s;
+        n->bus_client.info = &tricore_mcmcan_bus_client_info;
+        if (s->canbus[i] && can_bus_insert_client(s->canbus[i],
+                                                  &n->bus_client) < 0) {
+            error_setg(errp, "tricore_mcmcan: can not connect node %d", i);
+            return;
+        }
+    }
+
+    s->irq_bh = qemu_bh_new_guarded(mcmcan_irq_bh, s,
+                                    &dev->mem_reentrancy_guard);
+    tricore_mcmcan_reset(dev);
+}
+
+static void tricore_mcmcan_init(Object *obj)
+{
+    TriCoreMCMCANState *s = TRICORE_MCMCAN(obj);
+    SysBusDevice *sbd = SYS_BUS_DEVICE(obj);
+
+    memory_region_init(&s->iomem, obj, "tricore_mcmcan", TRICORE_MCMCAN_SIZE);
+    memory_region_init_io(&s->regs, obj, &tricore_mcmcan_ops, s,
+                          "tricore_mcmcan.regs",
+                          TRICORE_MCMCAN_SIZE - TRICORE_MCMCAN_RAM_SIZE);
+    memory_region_add_subregion(&s->iomem, TRICORE_MCMCAN_RAM_SIZE, &s->regs);
+    sysbus_init_mmio(sbd, &s->iomem);
+
+    for (int i = 0; i < TRICORE_MCMCAN_NUM_INT; i++) {
+        sysbus_init_irq(sbd, &s->irq[i]);
+    }
+}
+
+static int tricore_mcmcan_post_load(void *opaque, int version_id)
+{
+    TriCoreMCMCANState *s = opaque;
+
+    for (int i = 0; i < TRICORE_MCMCAN_NODES; i++) {
+        TriCoreMCMCANNode *n = &s->node[i];
+        uint32_t first, num;
+
+        /* the get index addresses a buffer of the configured TX FIFO */
+        mcmcan_tx_fifo(n, &first, &num);
+        if (num ? n->txf_gi < first || n->txf_gi >= first + num
+                : n->txf_gi != 0 && n->txf_gi != first) {
+            return -EINVAL;
+        }
+    }
+
+    /* an interrupt update may have been pending when the state was saved */
+    s->irq_bh_pending = true;
+    qemu_bh_schedule(s->irq_bh);
+    return 0;
+}
+
+static const VMStateDescription vmstate_tricore_mcmcan_node = {
+    .name = "tricore_mcmcan_node",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32_ARRAY(regs, TriCoreMCMCANNode,
+                             TRICORE_MCMCAN_NODE_R_MAX),
+        VMSTATE_UINT32(txf_gi, TriCoreMCMCANNode),
+        VMSTATE_INT64(ts_start_ns, TriCoreMCMCANNode),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static const VMStateDescription vmstate_tricore_mcmcan = {
+    .name = "tricore_mcmcan",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .post_load = tricore_mcmcan_post_load,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32(CLC, TriCoreMCMCANState),
+        VMSTATE_UINT32(MCR, TriCoreMCMCANState),
+        VMSTATE_STRUCT_ARRAY(node, TriCoreMCMCANState, TRICORE_MCMCAN_NODES,
+                             1, vmstate_tricore_mcmcan_node,
+                             TriCoreMCMCANNode),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static Property tricore_mcmcan_properties[] = {
+    DEFINE_PROP_UINT32("clock-frequency", TriCoreMCMCANState, freq_hz,
+                       RESET_TRICORE_MCMCAN_FREQUENCY),
+    DEFINE_PROP_LINK("canbus0", TriCoreMCMCANState, canbus[0], TYPE_CAN_BUS,
+                     CanBusState *),
+    DEFINE_PROP_LINK("canbus1", TriCoreMCMCANState, canbus[1], TYPE_CAN_BUS,
+                     CanBusState *),
+    DEFINE_PROP_LINK("canbus2", TriCoreMCMCANState, canbus[2], TYPE_CAN_BUS,
+                     CanBusState *),
+    DEFINE_PROP_LINK("canbus3", TriCoreMCMCANState, canbus[3], TYPE_CAN_BUS,
+                     CanBusState *),
+    DEFINE_PROP_END_OF_LIST(),
+};
+
+static void tricore_mcmcan_class_init(ObjectClass *klass, void *data)
+{
+    DeviceClass *dc = DEVICE_CLASS(klass);
+
+    device_class_set_props(dc, tricore_mcmcan_properties);
+    dc->legacy_reset = tricore_mcmcan_reset;
+    dc->realize = tricore_mcmcan_realize;
+    dc->vmsd = &vmstate_tricore_mcmcan;
+}
+
+static const TypeInfo tricore_mcmcan_info = {
+    .name = TYPE_TRICORE_MCMCAN,
+    .parent = TYPE_SYS_BUS_DEVICE,
+    .instance_size = sizeof(TriCoreMCMCANState),
+    .instance_init = tricore_mcmcan_init,
+    .class_init = tricore_mcmcan_class_init,
+};
+
+static void tricore_mcmcan_register_types(void)
+{
+    type_register_static(&tricore_mcmcan_info);
+}
+
+type_init(tricore_mcmcan_register_types)
@@ -0,0 +1,1102 @@
+/*
+ * QEMU model of the TriCore GTM (Generic Timer Module).
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ * Only a subset is modelled: the CMU clock tree, TBU channel 0, TOM and
+ * ATOM channels in PWM mode and TIM channels in TPWM/TIEM mode. Nothing is
+ * ticked, all counters are computed from QEMU_CLOCK_VIRTUAL on demand.
+ */
+#include "qemu/osdep.h"
+#include "qapi/error.h"
+#include "qemu/log.h"
+#include "hw/qdev-properties.h"
+#include "migration/vmstate.h"
+#include "hw/timer/tricore_gtm.h"
+
+enum {
+    GTM_TGC_GLB_CTRL,
+    GTM_TGC_ACT_TB,
+    GTM_TGC_FUPD_CTRL,
+    GTM_TGC_INT_TRIG,
+    GTM_TGC_ENDIS_CTRL,
+    GTM_TGC_ENDIS_STAT,
+    GTM_TGC_OUTEN_CTRL,
+    GTM_TGC_OUTEN_STAT,
+};
+
+/*
+ * Most enable bits are 2 bit fields: writing 0b10 enables, 0b01 disables,
+ * anything else keeps the state. Enabled fields read back as 0b11.
+ */
+static bool gtm_endis_field(uint32_t value, int field, bool cur)
+{
+    switch ((value >> (field * 2)) & 3) {
+    case 2:
+        return true;
+    case 1:
+        return false;
+    default:
+        return cur;
+    }
+}
+
+static uint32_t gtm_endis_update(uint32_t cur, uint32_t value, int fields)
+{
+    for (int i = 0; i < fields; i++) {
+        if (gtm_endis_field(value, i, cur & (3 << (i * 2)))) {
+            cur |= 3 << (i * 2);
+        } else {
+            cur &= ~(3 << (i * 2));
+        }
+    }
+    return cur;
+}
+
+/* CMU */
+
+static uint32_t gtm_cmu_gclk(TriCoreGTMState *s)
+{
+    uint32_t num = s->CMU_GCLK_NUM & 0xFFFFFF;
+    uint32_t den = s->CMU_GCLK_DEN & 0xFFFFFF;
+
+    if (!num || !den || den > num) {
+        return s->freq_hz;
+    }
+    return muldiv64(s->freq_hz, den, num);
+}
+
+static uint32_t gtm_cmu_clk(TriCoreGTMState *s, int n)
+{
+    if (!(s->CMU_CLK_EN & (3 << (n * 2)))) {
+        return 0;
+    }
+    return gtm_cmu_gclk(s) / ((s->CMU_CLK_CTRL[n] & 0xFFFFFF) + 1);
+}
+
+/* FXCLK0..4 divide the selected source by 1, 16, 256, 4096 and 65536 */
+static uint32_t gtm_cmu_fxclk(TriCoreGTMState *s, int n)
+{
+    uint32_t sel = s->CMU_FXCLK_CTRL & 0xF;
+    uint32_t src;
+
+    if (n >= GTM_CMU_FXCLK_NUM || !(s->CMU_CLK_EN & (3 << 22))) {
+        return 0;
+    }
+
+    if (sel == 0) {
+        src = gtm_cmu_gclk(s);
+    } else if (sel <= GTM_CMU_CLK_NUM) {
+        src = gtm_cmu_clk(s, sel - 1);
+    } else {
+        return 0;
+    }
+    return src >> (4 * n);
+}
+
+static uint64_t gtm_ticks(int64_t delta_ns, uint32_t freq)
+{
+    return muldiv64(delta_ns, freq, NANOSECONDS_PER_SECOND);
+}
+
+/* TOM/ATOM channels */
+
+static uint32_t gtm_ch_mask(TriCoreGTMChannel *ch)
+{
+    return ch->atom ? 0xFFFFFF : 0xFFFF;
+}
+
+static bool gtm_ch_pwm(TriCoreGTMChannel *ch)
+{
+    return !ch->atom ||
+           (ch->CTRL & MASK_GTM_ATOM_CTRL_MODE) == GTM_ATOM_MODE_SOMP;
+}
+
+static uint32_t gtm_ch_freq(TriCoreGTMChannel *ch)
+{
+    int src = (ch->CTRL & MASK_GTM_CTRL_CLK_SRC) >> 12;
+
+    if (ch->atom) {
+        return gtm_cmu_clk(ch->gtm, src);
+    }
+    return gtm_cmu_fxclk(ch->gtm, src);
+}
+
+static uint32_t gtm_ch_cn0(TriCoreGTMChannel *ch, int64_t now)
+{
+    uint64_t cn0;
+
+    if (!ch->enabled || !ch->freq) {
+        return ch->start_cn0;
+    }
+
+    cn0 = ch->start_cn0 + gtm_ticks(now - ch->start_ns, ch->freq);
+
+    /* CN0 restarts from 0 once it reaches CM0 */
+    if (ch->CM0 && ch->start_cn0 < ch->CM0 && cn0 >= ch->CM0) {
+        return (cn0 - ch->CM0) % ch->CM0;
+    }
+    return cn0 & gtm_ch_mask(ch);
+}
+
+static bool gtm_ch_level(TriCoreGTMChannel *ch, uint32_t cn0)
+{
+    bool sl = ch->CTRL & MASK_GTM_CTRL_SL;
+
+    if (!ch->enabled || !ch->outen || !gtm_ch_pwm(ch)) {
+        return !sl;
+    }
+    /* covers CM1 = 0 (0% duty) and CM1 >= CM0 (100% duty) as well */
+    return cn0 < ch->CM1 ? sl : !sl;
+}
+
+static void gtm_ch_update_irq(TriCoreGTMChannel *ch)
+{
+    bool level = (ch->IRQ_NOTIFY & ch->IRQ_EN) ||
+                 (ch->pair->IRQ_NOTIFY & ch->pair->IRQ_EN);
+
+    qemu_set_irq(*ch->irq, level);
+}
+
+static void gtm_ch_schedule(TriCoreGTMChannel *ch, int64_t now)
+{
+    uint32_t cn0 = gtm_ch_cn0(ch, now);
+    bool observed = *ch->out ||
+                    (ch->IRQ_EN & (MASK_GTM_IRQ_CCU0TC | MASK_GTM_IRQ_CCU1TC));
+    bool shadow = ch->upen && (ch->SR0 != ch->CM0 || ch->SR1 != ch->CM1);
+    uint32_t target;
+
+    timer_del(ch->timer);
+
+    if (!ch->enabled || !ch->freq || !gtm_ch_pwm(ch) || !ch->CM0 ||
+        cn0 >= ch->CM0 || !(observed || shadow)) {
+        return;
+    }
+
+    /* the counter wrapped while nobody was watching, start over from now */
+    if (ch->start_cn0 + gtm_ticks(now - ch->start_ns, ch->freq) >= ch->CM0) {
+        ch->start_cn0 = cn0;
+        ch->start_ns = now;
+    }
+
+    if (observed && cn0 < ch->CM1 && ch->CM1 < ch->CM0) {
+        target = ch->CM1;
+        ch->next_ccu = 1;
+    } else {
+        target = ch->CM0;
+        ch->next_ccu = 0;
+    }
+
+    ch->next_ns = ch->start_ns +
+                  DIV_ROUND_UP((uint64_t)(target - ch->start_cn0) *
+                               NANOSECONDS_PER_SECOND, ch->freq);
+    timer_mod(ch->timer, ch->next_ns);
+}
+
+static void gtm_ch_update(TriCoreGTMChannel *ch, int64_t now)
+{
+    bool level = gtm_ch_level(ch, gtm_ch_cn0(ch, now));
+
+    if (level != ch->level) {
+        ch->level = level;
+        qemu_set_irq(*ch->out, level);
+    }
+    gtm_ch_update_irq(ch);
+    gtm_ch_schedule(ch, now);
+}
+
+/* freeze the counter at @now before anything it depends on changes */
+static void gtm_ch_rebase(TriCoreGTMChannel *ch, int64_t now)
+{
+    ch->start_cn0 = gtm_ch_cn0(ch, now);
+    ch->start_ns = now;
+}
+
+static void gtm_ch_event(void *opaque)
+{
+    TriCoreGTMChannel *ch = opaque;
+
+    if (ch->next_ccu == 0) {
+        /* period end, the shadow registers are transferred */
+        ch->start_ns = ch->next_ns;
+        ch->start_cn0 = 0;
+        if (ch->upen) {
+            ch->CM0 = ch->SR0;
+            ch->CM1 = ch->SR1;
+        }
+        ch->IRQ_NOTIFY |= MASK_GTM_IRQ_CCU0TC;
+    } else {
+        ch->IRQ_NOTIFY |= MASK_GTM_IRQ_CCU1TC;
+    }
+
+    gtm_ch_update(ch, qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL));
+}
+
+static void gtm_ch_reset(TriCoreGTMChannel *ch)
+{
+    ch->RDADDR = 0;
+    ch->CTRL = 0;
+    ch->SR0 = 0;
+    ch->SR1 = 0;
+    ch->CM0 = 0;
+    ch->CM1 = 0;
+    ch->IRQ_NOTIFY = 0;
+    ch->IRQ_EN = 0;
+    ch->IRQ_MODE = 0;
+    ch->enabled = false;
+    ch->outen = false;
+    ch->upen = false;
+    ch->start_cn0 = 0;
+    ch->start_ns = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+    ch->freq = 0;
+
+    if (ch->timer) {
+        gtm_ch_update(ch, ch->start_ns);
+    }
+}
+
+static uint32_t gtm_ch_read(TriCoreGTMChannel *ch, int reg)
+{
+    int64_t now = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+
+    /* ATOM channels have RDADDR in front, TOM channels start with CTRL */
+    if (!ch->atom) {
+        reg += 4;
+    }
+
+    switch (reg) {
+    case 0x00:
+        return ch->RDADDR;
+    case 0x04:
+        return ch->CTRL;
+    case 0x08:
+        return ch->SR0;
+    case 0x0C:
+        return ch->SR1;
+    case 0x10:
+        return ch->CM0;
+    case 0x14:
+        return ch->CM1;
+    case 0x18:
+        return gtm_ch_cn0(ch, now);
+    case 0x1C:
+        return gtm_ch_level(ch, gtm_ch_cn0(ch, now));
+    case 0x20:
+        return ch->IRQ_NOTIFY;
+    case 0x24:
+        return ch->IRQ_EN;
+    case 0x2C:
+        return ch->IRQ_MODE;
+    default:
+        return 0;
+    }
+}
+
+static void gtm_ch_write(TriCoreGTMChannel *ch, int reg, uint32_t value)
+{
+    int64_t now = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+    uint32_t mask = gtm_ch_mask(ch);
+
+    if (!ch->atom) {
+        reg += 4;
+    }
+
+    gtm_ch_rebase(ch, now);
+
+    switch (reg) {
+    case 0x00:
+        ch->RDADDR = value;
+        break;
+    case 0x04:
+        ch->CTRL = value;
+        ch->freq = gtm_ch_freq(ch);
+        if (!gtm_ch_pwm(ch)) {
+            qemu_log_mask(LOG_UNIMP, "tricore_gtm: only SOMP mode is "
+                          "implemented for ATOM channels\n");
+        }
+        break;
+    case 0x08:
+        ch->SR0 = value & mask;
+        break;
+    case 0x0C:
+        ch->SR1 = value & mask;
+        break;
+    case 0x10:
+        ch->CM0 = value & mask;
+        break;
+    case 0x14:
+        ch->CM1 = value & mask;
+        break;
+    case 0x18:
+        ch->start_cn0 = value & mask;
+        break;
+    case 0x20:
+        ch->IRQ_NOTIFY &= ~value;
+        break;
+    case 0x24:
+        ch->IRQ_EN = value & (MASK_GTM_IRQ_CCU0TC | MASK_GTM_IRQ_CCU1TC);
+        break;
+    case 0x28: /* IRQ_FORCINT */
+        ch->IRQ_NOTIFY |= value & (MASK_GTM_IRQ_CCU0TC | MASK_GTM_IRQ_CCU1TC);
+        break;
+    case 0x2C:
+        ch->IRQ_MODE = value & 3;
+        break;
+    default:
+        break;
+    }
+
+    gtm_ch_update(ch, now);
+}
+
+/* TGC (TOM) and AGC (ATOM) global control of 8 channels */
+
+static uint32_t gtm_group_read(TriCoreGTMChannel *ch, TriCoreGTMTGC *g,
+                               int reg)
+{
+    uint32_t r = 0;
+
+    switch (reg) {
+    case GTM_TGC_GLB_CTRL:
+        for (int i = 0; i < 8; i++) {
+            r |= ch[i].upen ? 3 << (16 + i * 2) : 0;
+        }
+        return r;
+    case GTM_TGC_ACT_TB:
+        return g->ACT_TB;
+    case GTM_TGC_FUPD_CTRL:
+        return g->FUPD_CTRL;
+    case GTM_TGC_INT_TRIG:
+        return g->INT_TRIG;
+    case GTM_TGC_ENDIS_CTRL:
+        return g->ENDIS_CTRL;
+    case GTM_TGC_ENDIS_STAT:
+        for (int i = 0; i < 8; i++) {
+            r |= ch[i].enabled ? 3 << (i * 2) : 0;
+        }
+        return r;
+    case GTM_TGC_OUTEN_CTRL:
+        return g->OUTEN_CTRL;
+    case GTM_TGC_OUTEN_STAT:
+        for (int i = 0; i < 8; i++) {
+            r |= ch[i].outen ? 3 << (i * 2) : 0;
+        }
+        return r;
+    default:
+        return 0;
+    }
+}
+
+static void gtm_group_write(TriCoreGTMChannel *ch, TriCoreGTMTGC *g, int reg,
+                            uint32_t value)
+{
+    int64_t now = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+
+    switch (reg) {
+    case GTM_TGC_ACT_TB:
+        g->ACT_TB = value;
+        return;
+    case GTM_TGC_FUPD_CTRL:
+        g->FUPD_CTRL = value;
+        return;
+    case GTM_TGC_INT_TRIG:
+        g->INT_TRIG = value;
+        return;
+    case GTM_TGC_ENDIS_CTRL:
+        g->ENDIS_CTRL = gtm_endis_update(g->ENDIS_CTRL, value, 8);
+        return;
+    case GTM_TGC_OUTEN_CTRL:
+        g->OUTEN_CTRL = gtm_endis_update(g->OUTEN_CTRL, value, 8);
+        return;
+    default:
+        break;
+    }
+
+    for (int i = 0; i < 8; i++) {
+        TriCoreGTMChannel *c = &ch[i];
+
+        gtm_ch_rebase(c, now);
+
+        switch (reg) {
+        case GTM_TGC_GLB_CTRL:
+            if (value & (1 << (8 + i))) {
+                gtm_ch_reset(c);
+                break;
+            }
+            c->upen = gtm_endis_field(value >> 16, i, c->upen);
+
+            /* the host trigger applies all pending control updates */
+            if (value & MASK_GTM_TGC_HOST_TRIG) {
+                c->enabled = gtm_endis_field(g->ENDIS_CTRL, i, c->enabled);
+                c->outen = gtm_endis_field(g->OUTEN_CTRL, i, c->outen);
+                if (gtm_endis_field(g->FUPD_CTRL, i, false)) {
+                    c->CM0 = c->SR0;
+                    c->CM1 = c->SR1;
+                }
+                if (gtm_endis_field(g->FUPD_CTRL >> 16, i, false)) {
+                    c->start_cn0 = 0;
+                }
+            }
+            break;
+        case GTM_TGC_ENDIS_STAT:
+            c->enabled = gtm_endis_field(value, i, c->enabled);
+            break;
+        case GTM_TGC_OUTEN_STAT:
+            c->outen = gtm_endis_field(value, i, c->outen);
+            break;
+        }
+
+        gtm_ch_update(c, now);
+    }
+}
+
+/*
+ * TOM channels are 0x40 apart, the TGC registers live in the unused upper
+ * part of the first two channel slots of each group of 8 channels.
+ */
+static TriCoreGTMChannel *gtm_tom_decode(TriCoreGTMState *s, int tom,
+                                         hwaddr offset, TriCoreGTMTGC **g,
+                                         int *reg)
+{
+    int ch = offset / GTM_TOM_CH_STRIDE;
+    int r = offset % GTM_TOM_CH_STRIDE;
+
+    if (ch >= GTM_TOM_CHANNELS) {
+        return NULL;
+    }
+
+    if (r < 0x30) {
+        *g = NULL;
+        *reg = r;
+        return &s->tom[tom][ch];
+    }
+
+    if (ch % 8 > 1) {
+        return NULL;
+    }
+    *g = &s->tom_tgc[tom][ch / 8];
+    *reg = (ch % 8) * 4 + (r - 0x30) / 4;
+    return &s->tom[tom][ch & ~7];
+}
+
+/* the AGC orders its registers differently than the TGC */
+static const int gtm_agc_regs[] = {
+    GTM_TGC_GLB_CTRL, GTM_TGC_ENDIS_CTRL, GTM_TGC_ENDIS_STAT,
+    GTM_TGC_ACT_TB, GTM_TGC_OUTEN_CTRL, GTM_TGC_OUTEN_STAT,
+    GTM_TGC_FUPD_CTRL, GTM_TGC_INT_TRIG,
+};
+
+/* ATOM channels are 0x80 apart, the AGC sits behind channel 0 at 0x40 */
+static TriCoreGTMChannel *gtm_atom_decode(TriCoreGTMState *s, int atom,
+                                          hwaddr offset, TriCoreGTMTGC **g,
+                                          int *reg)
+{
+    int ch = offset / GTM_ATOM_CH_STRIDE;
+    int r = offset % GTM_ATOM_CH_STRIDE;
+
+    if (ch >= GTM_ATOM_CHANNELS) {
+        return NULL;
+    }
+
+    if (r < 0x30) {
+        *g = NULL;
+        *reg = r;
+        return &s->atom[atom][ch];
+    }
+
+    if (ch != 0 || r < 0x40 || r >= 0x60) {
+        return NULL;
+    }
+    *g = &s->atom_agc[atom];
+    *reg = gtm_agc_regs[(r - 0x40) / 4];
+    return &s->atom[atom][0];
+}
+
+/* TIM channels */
+
+static uint32_t gtm_tim_cnt(TriCoreGTMTIMChannel *t, int64_t now)
+{
+    int clk = (t->CTRL & MASK_GTM_TIM_CTRL_CLK_SEL) >> 24;
+    uint32_t freq = gtm_cmu_clk(t->gtm, clk);
+
+    if (!(t->CTRL & MASK_GTM_TIM_CTRL_EN) || !freq) {
+        return 0;
+    }
+    return gtm_ticks(now - t->start_ns, freq) & 0xFFFFFF;
+}
+
+static void gtm_tim_update_irq(TriCoreGTMTIMChannel *t)
+{
+    qemu_set_irq(t->irq, t->IRQ_NOTIFY & t->IRQ_EN);
+}
+
+static void gtm_tim_input(void *opaque, int n, int level)
+{
+    TriCoreGTMState *s = opaque;
+    TriCoreGTMTIMChannel *t = &s->tim[n / GTM_TIM_CHANNELS]
+                                     [n % GTM_TIM_CHANNELS];
+    int64_t now = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+    uint32_t cnt;
+
+    if (!!level == t->level) {
+        return;
+    }
+    t->level = level;
+
+    if (!(t->CTRL & MASK_GTM_TIM_CTRL_EN)) {
+        return;
+    }
+
+    cnt = gtm_tim_cnt(t, now);
+    t->ECNT = (t->ECNT + 1) & 0xFFFF;
+    if (!t->ECNT) {
+        t->IRQ_NOTIFY |= MASK_GTM_TIM_IRQ_ECNTOFL;
+    }
+
+    switch ((t->CTRL & MASK_GTM_TIM_CTRL_MODE) >> 1) {
+    case GTM_TIM_MODE_TPWM:
+        /* DSL selects whether the high or the low pulse is measured */
+        if (!!level == !!(t->CTRL & MASK_GTM_TIM_CTRL_DSL)) {
+            if (t->started) {
+                t->GPR0 = t->pulse;
+                t->GPR1 = cnt;
+                t->IRQ_NOTIFY |= MASK_GTM_TIM_IRQ_NEWVAL;
+            }
+            t->started = true;
+            t->start_ns = now;
+        } else {
+            t->pulse = cnt;
+            t->CNTS = cnt;
+        }
+        break;
+    case GTM_TIM_MODE_TIEM:
+        t->GPR0 = cnt;
+        t->GPR1 = t->ECNT;
+        t->IRQ_NOTIFY |= MASK_GTM_TIM_IRQ_NEWVAL;
+        break;
+    default:
+        qemu_log_mask(LOG_UNIMP, "tricore_gtm: TIM mode %d not implemented\n",
+                      (t->CTRL & MASK_GTM_TIM_CTRL_MODE) >> 1);
+        break;
+    }
+
+    gtm_tim_update_irq(t);
+}
+
+static uint32_t gtm_tim_read(TriCoreGTMTIMChannel *t, int reg)
+{
+    switch (reg) {
+    case 0x00:
+        return t->GPR0;
+    case 0x04:
+        return t->GPR1;
+    case 0x08:
+        return gtm_tim_cnt(t, qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL));
+    case 0x0C:
+        return t->ECNT;
+    case 0x10:
+        return t->CNTS;
+    case 0x24:
+        return t->CTRL;
+    case 0x2C:
+        return t->IRQ_NOTIFY;
+    case 0x30:
+        return t->IRQ_EN;
+    case 0x38:
+        return t->IRQ_MODE;
+    default:
+        return 0;
+    }
+}
+
+static void gtm_tim_write(TriCoreGTMTIMChannel *t, int reg, uint32_t value)
+{
+    switch (reg) {
+    case 0x24:
+        if ((value & MASK_GTM_TIM_CTRL_EN) &&
+            !(t->CTRL & MASK_GTM_TIM_CTRL_EN)) {
+            t->start_ns = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+            t->started = false;
+            t->ECNT = 0;
+        }
+        t->CTRL = value;
+        break;
+    case 0x2C:
+        t->IRQ_NOTIFY &= ~value;
+        break;
+    case 0x30:
+        t->IRQ_EN = value & 0x3F;
+        break;
+    case 0x34: /* IRQ_FORCINT */
+        t->IRQ_NOTIFY |= value & 0x3F;
+        break;
+    case 0x38:
+        t->IRQ_MODE = value & 3;
+        break;
+    default:
+        break;
+    }
+    gtm_tim_update_irq(t);
+}
+
+static void gtm_tim_reset(TriCoreGTMTIMChannel *t)
+{
+    t->GPR0 = 0;
+    t->GPR1 = 0;
+    t->ECNT = 0;
+    t->CNTS = 0;
+    t->CTRL = 0;
+    t->IRQ_NOTIFY = 0;
+    t->IRQ_EN = 0;
+    t->IRQ_MODE = 0;
+    t->started = false;
+    t->pulse = 0;
+    gtm_tim_update_irq(t);
+}
+
+/* CMU and TBU */
+
+static void gtm_clocks_changed(TriCoreGTMState *s)
+{
+    int64_t now = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+
+    for (int i = 0; i < s->num_tom; i++) {
+        for (int c = 0; c < GTM_TOM_CHANNELS; c++) {
+            gtm_ch_rebase(&s->tom[i][c], now);
+            s->tom[i][c].freq = gtm_ch_freq(&s->tom[i][c]);
+            gtm_ch_update(&s->tom[i][c], now);
+        }
+    }
+    for (int i = 0; i < s->num_atom; i++) {
+        for (int c = 0; c < GTM_ATOM_CHANNELS; c++) {
+            gtm_ch_rebase(&s->atom[i][c], now);
+            s->atom[i][c].freq = gtm_ch_freq(&s->atom[i][c]);
+            gtm_ch_update(&s->atom[i][c], now);
+        }
+    }
+}
+
+static uint32_t gtm_tbu_base(TriCoreGTMState *s)
+{
+    int clk = (s->TBU_CH0_CTRL >> 1) & 7;
+    uint32_t freq = gtm_cmu_clk(s, clk);
+
+    if (!(s->TBU_CHEN & 3) || !freq) {
+        return s->tbu_start_base;
+    }
+    return (s->tbu_start_base +
+            gtm_ticks(qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL) - s->tbu_start_ns,
+                      freq)) & 0xFFFFFF;
+}
+
+static void gtm_tbu_rebase(TriCoreGTMState *s)
+{
+    s->tbu_start_base = gtm_tbu_base(s);
+    s->tbu_start_ns = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+}
+
+static uint32_t gtm_top_read(TriCoreGTMState *s, hwaddr offset)
+{
+    switch (offset) {
+    case 0x000: /* GTM_REV */
+        return RESET_TRICORE_GTM_REV;
+    case GTM_CMU_BASE + 0x00:
+        return s->CMU_CLK_EN;
+    case GTM_CMU_BASE + 0x04:
+        return s->CMU_GCLK_NUM;
+    case GTM_CMU_BASE + 0x08:
+        return s->CMU_GCLK_DEN;
+    case GTM_CMU_BASE + 0x0C ... GTM_CMU_BASE + 0x28:
+        return s->CMU_CLK_CTRL[(offset - GTM_CMU_BASE - 0x0C) / 4];
+    case GTM_CMU_BASE + 0x44:
+        return s->CMU_FXCLK_CTRL;
+    case GTM_TBU_BASE + 0x00:
+        return s->TBU_CHEN;
+    case GTM_TBU_BASE + 0x04:
+        return s->TBU_CH0_CTRL;
+    case GTM_TBU_BASE + 0x08:
+        return gtm_tbu_base(s);
+    default:
+        qemu_log_mask(LOG_UNIMP, "tricore_gtm: read from unimplemented "
+                      "register 0x%" HWADDR_PRIx "\n", offset);
+        return 0;
+    }
+}
+
+static void gtm_top_write(TriCoreGTMState *s, hwaddr offset, uint32_t value)
+{
+    gtm_tbu_rebase(s);
+
+    switch (offset) {
+    case GTM_CMU_BASE + 0x00:
+        s->CMU_CLK_EN = gtm_endis_update(s->CMU_CLK_EN, value, 12);
+        break;
+    case GTM_CMU_BASE + 0x04:
+        s->CMU_GCLK_NUM = value & 0xFFFFFF;
+        break;
+    case GTM_CMU_BASE + 0x08:
+        s->CMU_GCLK_DEN = value & 0xFFFFFF;
+        break;
+    case GTM_CMU_BASE + 0x0C ... GTM_CMU_BASE + 0x28:
+        s->CMU_CLK_CTRL[(offset - GTM_CMU_BASE - 0x0C) / 4] = value & 0xFFFFFF;
+        break;
+    case GTM_CMU_BASE + 0x44:
+        s->CMU_FXCLK_CTRL = value & 0xF;
+        break;
+    case GTM_TBU_BASE + 0x00:
+        s->TBU_CHEN = gtm_endis_update(s->TBU_CHEN, value, 3);
+        return;
+    case GTM_TBU_BASE + 0x04:
+        s->TBU_CH0_CTRL = value & 0xF;
+        return;
+    case GTM_TBU_BASE + 0x08:
+        s->tbu_start_base = value & 0xFFFFFF;
+        return;
+    default:
+        qemu_log_mask(LOG_UNIMP, "tricore_gtm: write to unimplemented "
+                      "register 0x%" HWADDR_PRIx "\n", offset);
+        return;
+    }
+
+    gtm_clocks_changed(s);
+}
+
+static uint64_t tricore_gtm_read(void *opaque, hwaddr offset, unsigned size)
+{
+    TriCoreGTMState *s = opaque;
+    TriCoreGTMChannel *ch = NULL;
+    TriCoreGTMTGC *g;
+    hwaddr rel;
+    int idx, reg;
+
+    if (offset < GTM_TIM_BASE) {
+        return gtm_top_read(s, offset);
+    } else if (offset < GTM_TOM_BASE) {
+        idx = (offset - GTM_TIM_BASE) / GTM_MODULE_STRIDE;
+        rel = (offset - GTM_TIM_BASE) % GTM_MODULE_STRIDE;
+        if (idx < s->num_tim && rel / GTM_TIM_CH_STRIDE < GTM_TIM_CHANNELS) {
+            return gtm_tim_read(&s->tim[idx][rel / GTM_TIM_CH_STRIDE],
+                                rel % GTM_TIM_CH_STRIDE);
+        }
+    } else if (offset < GTM_ATOM_BASE) {
+        idx = (offset - GTM_TOM_BASE) / GTM_MODULE_STRIDE;
+        rel = (offset - GTM_TOM_BASE) % GTM_MODULE_STRIDE;
+        if (idx < s->num_tom) {
+            ch = gtm_tom_decode(s, idx, rel, &g, &reg);
+        }
+    } else {
+        idx = (offset - GTM_ATOM_BASE) / GTM_MODULE_STRIDE;
+        rel = (offset - GTM_ATOM_BASE) % GTM_MODULE_STRIDE;
+        if (idx < s->num_atom) {
+            ch = gtm_atom_decode(s, idx, rel, &g, &reg);
+        }
+    }
+
+    if (!ch) {
+        qemu_log_mask(LOG_UNIMP, "tricore_gtm: read from unimplemented "
+                      "register 0x%" HWADDR_PRIx "\n", offset);
+        return 0;
+    }
+    return g ? gtm_group_read(ch, g, reg) : gtm_ch_read(ch, reg);
+}
+
+static void tricore_gtm_write(void *opaque, hwaddr offset, uint64_t value,
+                              unsigned size)
+{
+    TriCoreGTMState *s = opaque;
+    TriCoreGTMChannel *ch = NULL;
+    TriCoreGTMTGC *g;
+    hwaddr rel;
+    int idx, reg;
+
+    if (offset < GTM_TIM_BASE) {
+        gtm_top_write(s, offset, value);
+        return;
+    } else if (offset < GTM_TOM_BASE) {
+        idx = (offset - GTM_TIM_BASE) / GTM_MODULE_STRIDE;
+        rel = (offset - GTM_TIM_BASE) % GTM_MODULE_STRIDE;
+        if (idx < s->num_tim && rel / GTM_TIM_CH_STRIDE < GTM_TIM_CHANNELS) {
+            gtm_tim_write(&s->tim[idx][rel / GTM_TIM_CH_STRIDE],
+                          rel % GTM_TIM_CH_STRIDE, value);
+            return;
+        }
+    } else if (offset < GTM_ATOM_BASE) {
+        idx = (offset - GTM_TOM_BASE) / GTM_MODULE_STRIDE;
+        rel = (offset - GTM_TOM_BASE) % GTM_MODULE_STRIDE;
+        if (idx < s->num_tom) {
+            ch = gtm_tom_decode(s, idx, rel, &g, &reg);
+        }
+    } else {
+        idx = (offset - GTM_ATOM_BASE) / GTM_MODULE_STRIDE;
+        rel = (offset - GTM_ATOM_BASE) % GTM_MODULE_STRIDE;
+        if (idx < s->num_atom) {
+            ch = gtm_atom_decode(s, idx, rel, &g, &reg);
+        }
+    }
+
+    if (!ch) {
+        qemu_log_mask(LOG_UNIMP, "tricore_gtm: write to unimplemented "
+                      "register 0x%" HWADDR_PRIx "\n", offset);
+        return;
+    }
+
+    if (g) {
+        gtm_group_write(ch, g, reg, value);
+    } else {
+        gtm_ch_write(ch, reg, value);
+    }
+}
+
+static const MemoryRegionOps tricore_gtm_ops = {
+    .read = tricore_gtm_read,
+    .write = tricore_gtm_write,
+    .valid = { .min_access_size = 4, .max_access_size = 4, },
+    .endianness = DEVICE_NATIVE_ENDIAN
+};
+
+static void tricore_gtm_reset(DeviceState *dev)
+{
+    TriCoreGTMState *s = TRICORE_GTM(dev);
+
+    s->CMU_CLK_EN = 0;
+    s->CMU_GCLK_NUM = RESET_TRICORE_GTM_CMU_GCLK;
+    s->CMU_GCLK_DEN = RESET_TRICORE_GTM_CMU_GCLK;
+    memset(s->CMU_CLK_CTRL, 0, sizeof(s->CMU_CLK_CTRL));
+    s->CMU_FXCLK_CTRL = 0;
+    s->TBU_CHEN = 0;
+    s->TBU_CH0_CTRL = 0;
+    s->tbu_start_base = 0;
+    s->tbu_start_ns = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+    memset(s->tom_tgc, 0, sizeof(s->tom_tgc));
+    memset(s->atom_agc, 0, sizeof(s->atom_agc));
+
+    for (int i = 0; i < s->num_tim; i++) {
+        for (int c = 0; c < GTM_TIM_CHANNELS; c++) {
+            gtm_tim_reset(&s->tim[i][c]);
+        }
+    }
+    for (int i = 0; i < s->num_tom; i++) {
+        for (int c = 0; c < GTM_TOM_CHANNELS; c++) {
+            gtm_ch_reset(&s->tom[i][c]);
+        }
+    }
+    for (int i = 0; i < s->num_atom; i++) {
+        for (int c = 0; c < GTM_ATOM_CHANNELS; c++) {
+            gtm_ch_reset(&s->atom[i][c]);
+        }
+    }
+}
+
+static void gtm_ch_init(TriCoreGTMState *s, TriCoreGTMChannel *ch,
+                        TriCoreGTMChannel *pair, bool atom, qemu_irq *out,
+                        qemu_irq *irq)
+{
+    ch->gtm = s;
+    ch->atom = atom;
+    ch->pair = pair;
+    ch->out = out;
+    ch->irq = irq;
+    ch->timer = timer_new_ns(QEMU_CLOCK_VIRTUAL, gtm_ch_event, ch);
+}
+
+/*
+ * Outputs: GPIO "tom-out" (16 per TOM) and "atom-out" (8 per ATOM).
+ * Inputs: GPIO "tim-in" (8 per TIM).
+ * Sysbus IRQs: one per TIM channel, then one per TOM and ATOM channel pair.
+ */
+static void tricore_gtm_realize(DeviceState *dev, Error **errp)
+{
+    TriCoreGTMState *s = TRICORE_GTM(dev);
+    SysBusDevice *sbd = SYS_BUS_DEVICE(dev);
+
+    if (s->num_tim > GTM_TIM_MAX || s->num_tom > GTM_TOM_MAX ||
+        s->num_atom > GTM_ATOM_MAX) {
+        error_setg(errp, "tricore_gtm: too many TIM/TOM/ATOM instances");
+        return;
+    }
+
+    for (int i = 0; i < s->num_tim; i++) {
+        for (int c = 0; c < GTM_TIM_CHANNELS; c++) {
+            s->tim[i][c].gtm = s;
+            sysbus_init_irq(sbd, &s->tim[i][c].irq);
+        }
+    }
+    for (int i = 0; i < s->num_tom; i++) {
+        for (int c = 0; c < GTM_TOM_CHANNELS; c++) {
+            gtm_ch_init(s, &s->tom[i][c], &s->tom[i][c ^ 1], false,
+                        &s->tom_out[i * GTM_TOM_CHANNELS + c],
+                        &s->tom_irq[i][c / 2]);
+        }
+        for (int p = 0; p < GTM_TOM_CHANNELS / 2; p++) {
+            sysbus_init_irq(sbd, &s->tom_irq[i][p]);
+        }
+    }
+    for (int i = 0; i < s->num_atom; i++) {
+        for (int c = 0; c < GTM_ATOM_CHANNELS; c++) {
+            gtm_ch_init(s, &s->atom[i][c], &s->atom[i][c ^ 1], true,
+                        &s->atom_out[i * GTM_ATOM_CHANNELS + c],
+                        &s->atom_irq[i][c / 2]);
+        }
+        for (int p = 0; p < GTM_ATOM_CHANNELS / 2; p++) {
+            sysbus_init_irq(sbd, &s->atom_irq[i][p]);
+        }
+    }
+
+    qdev_init_gpio_in_named(dev, gtm_tim_input, "tim-in",
+                            s->num_tim * GTM_TIM_CHANNELS);
+    qdev_init_gpio_out_named(dev, s->tom_out, "tom-out",
+                             s->num_tom * GTM_TOM_CHANNELS);
+    qdev_init_gpio_out_named(dev, s->atom_out, "atom-out",
+                             s->num_atom * GTM_ATOM_CHANNELS);
+
+    sysbus_init_mmio(sbd, &s->iomem);
+    tricore_gtm_reset(dev);
+}
+
+static void tricore_gtm_init(Object *obj)
+{
+    TriCoreGTMState *s = TRICORE_GTM(obj);
+
+    memory_region_init_io(&s->iomem, OBJECT(s), &tricore_gtm_ops, s,
+                          "tricore_gtm", TRICORE_GTM_SIZE);
+}
+
+/* only the channels of the configured instances have a timer */
+static bool gtm_ch_timer_exists(void *opaque, int version_id)
+{
+    TriCoreGTMChannel *ch = opaque;
+
+    return ch->timer != NULL;
+}
+
+static const VMStateDescription vmstate_tricore_gtm_ch = {
+    .name = "tricore_gtm_ch",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32(RDADDR, TriCoreGTMChannel),
+        VMSTATE_UINT32(CTRL, TriCoreGTMChannel),
+        VMSTATE_UINT32(SR0, TriCoreGTMChannel),
+        VMSTATE_UINT32(SR1, TriCoreGTMChannel),
+        VMSTATE_UINT32(CM0, TriCoreGTMChannel),
+        VMSTATE_UINT32(CM1, TriCoreGTMChannel),
+        VMSTATE_UINT32(IRQ_NOTIFY, TriCoreGTMChannel),
+        VMSTATE_UINT32(IRQ_EN, TriCoreGTMChannel),
+        VMSTATE_UINT32(IRQ_MODE, TriCoreGTMChannel),
+        VMSTATE_BOOL(enabled, TriCoreGTMChannel),
+        VMSTATE_BOOL(outen, TriCoreGTMChannel),
+        VMSTATE_BOOL(upen, TriCoreGTMChannel),
+        VMSTATE_BOOL(level, TriCoreGTMChannel),
+        VMSTATE_TIMER_PTR_TEST(timer, TriCoreGTMChannel, gtm_ch_timer_exists),
+        VMSTATE_INT64(start_ns, TriCoreGTMChannel),
+        VMSTATE_INT64(next_ns, TriCoreGTMChannel),
+        VMSTATE_UINT32(start_cn0, TriCoreGTMChannel),
+        VMSTATE_UINT32(freq, TriCoreGTMChannel),
+        VMSTATE_UINT32(next_ccu, TriCoreGTMChannel),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static const VMStateDescription vmstate_tricore_gtm_tim = {
+    .name = "tricore_gtm_tim",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32(GPR0, TriCoreGTMTIMChannel),
+        VMSTATE_UINT32(GPR1, TriCoreGTMTIMChannel),
+        VMSTATE_UINT32(ECNT, TriCoreGTMTIMChannel),
+        VMSTATE_UINT32(CNTS, TriCoreGTMTIMChannel),
+        VMSTATE_UINT32(CTRL, TriCoreGTMTIMChannel),
+        VMSTATE_UINT32(IRQ_NOTIFY, TriCoreGTMTIMChannel),
+        VMSTATE_UINT32(IRQ_EN, TriCoreGTMTIMChannel),
+        VMSTATE_UINT32(IRQ_MODE, TriCoreGTMTIMChannel),
+        VMSTATE_BOOL(level, TriCoreGTMTIMChannel),
+        VMSTATE_BOOL(started, TriCoreGTMTIMChannel),
+        VMSTATE_INT64(start_ns, TriCoreGTMTIMChannel),
+        VMSTATE_UINT32(pulse, TriCoreGTMTIMChannel),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static const VMStateDescription vmstate_tricore_gtm_tgc = {
+    .name = "tricore_gtm_tgc",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32(ACT_TB, TriCoreGTMTGC),
+        VMSTATE_UINT32(FUPD_CTRL, TriCoreGTMTGC),
+        VMSTATE_UINT32(INT_TRIG, TriCoreGTMTGC),
+        VMSTATE_UINT32(ENDIS_CTRL, TriCoreGTMTGC),
+        VMSTATE_UINT32(OUTEN_CTRL, TriCoreGTMTGC),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static const VMStateDescription vmstate_tricore_gtm = {
+    .name = "tricore_gtm",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32(CMU_CLK_EN, TriCoreGTMState),
+        VMSTATE_UINT32(CMU_GCLK_NUM, TriCoreGTMState),
+        VMSTATE_UINT32(CMU_GCLK_DEN, TriCoreGTMState),
+        VMSTATE_UINT32_ARRAY(CMU_CLK_CTRL, TriCoreGTMState, GTM_CMU_CLK_NUM),
+        VMSTATE_UINT32(CMU_FXCLK_CTRL, TriCoreGTMState),
+        VMSTATE_UINT32(TBU_CHEN, TriCoreGTMState),
+        VMSTATE_UINT32(TBU_CH0_CTRL, TriCoreGTMState),
+        VMSTATE_UINT32(tbu_start_base, TriCoreGTMState),
+        VMSTATE_INT64(tbu_start_ns, TriCoreGTMState),
+        VMSTATE_STRUCT_2DARRAY(tim, TriCoreGTMState, GTM_TIM_MAX,
+                               GTM_TIM_CHANNELS, 1, vmstate_tricore_gtm_tim,
+                               TriCoreGTMTIMChannel),
+        VMSTATE_STRUCT_2DARRAY(tom, TriCoreGTMState, GTM_TOM_MAX,
+                               GTM_TOM_CHANNELS, 1, vmstate_tricore_gtm_ch,
+                               TriCoreGTMChannel),
+        VMSTATE_STRUCT_2DARRAY(atom, TriCoreGTMState, GTM_ATOM_MAX,
+                               GTM_ATOM_CHANNELS, 1, vmstate_tricore_gtm_ch,
+                               TriCoreGTMChannel),
+        VMSTATE_STRUCT_2DARRAY(tom_tgc, TriCoreGTMState, GTM_TOM_MAX,
+                               GTM_TOM_CHANNELS / 8, 1,
+                               vmstate_tricore_gtm_tgc, TriCoreGTMTGC),
+        VMSTATE_STRUCT_ARRAY(atom_agc, TriCoreGTMState, GTM_ATOM_MAX, 1,
+                             vmstate_tricore_gtm_tgc, TriCoreGTMTGC),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static Property tricore_gtm_properties[] = {
+    DEFINE_PROP_UINT32("clock-frequency", TriCoreGTMState, freq_hz,
+                       RESET_TRICORE_GTM_FREQUENCY),
+    DEFINE_PROP_UINT32("num-tim", TriCoreGTMState, num_tim, 6),
+    DEFINE_PROP_UINT32("num-tom", TriCoreGTMState, num_tom, 3),
+    DEFINE_PROP_UINT32("num-atom", TriCoreGTMState, num_atom, 9),
+    DEFINE_PROP_END_OF_LIST(),
+};
+
+static void tricore_gtm_class_init(ObjectClass *klass, void *data)
+{
+    DeviceClass *dc = DEVICE_CLASS(klass);
+
+    device_class_set_props(dc, tricore_gtm_properties);
+    dc->legacy_reset = tricore_gtm_reset;
+    dc->realize = tricore_gtm_realize;
+    dc->vmsd = &vmstate_tricore_gtm;
+}
+
+static const TypeInfo tricore_gtm_info = {
+    .name = TYPE_TRICORE_GTM,
+    .parent = TYPE_SYS_BUS_DEVICE,
+    .instance_size = sizeof(TriCoreGTMState),
+    .instance_init = tricore_gtm_init,
+    .class_init = tricore_gtm_class_init,
+};
+
+static void tricore_gtm_register_types(void)
+{
+    type_register_static(&tricore_gtm_info);
+}
+
+type_init(tricore_gtm_register_types)
@@ -19,6 +19,7 @@
 #include "sysemu/sysemu.h"
 #include "hw/ptimer.h"
 #include "hw/irq.h"
+#include "migration/vmstate.h"
 #include <math.h>
 
 enum {
@@ -185,7 +186,8 @@ static uint64_t tricore_stm_get_tim_update_regs(TriCoreSTMState *s,
     uint64_t ticks = 0x0;
 
     /* Time in ns is converted to time in s. */
-    ticks = (qemu_clock_get_ns(QEMU_CLOCK_HOST) / (1000000000 / s->freq_hz));
+    ticks = (qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL) /
+             (1000000000 / s->freq_hz));
 
     r = (uint32_t) (ticks >> timshift);
 
@@ -353,10 +355,24 @@ static void tricore_stm_init(Object *obj)
 
 static Property tricore_stm_properties[] = { DEFINE_PROP_END_OF_LIST() };
 
+static const VMStateDescription vmstate_tricore_stm = {
+    .name = "tricore_stm",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32_ARRAY(regs, TriCoreSTMState, STM_R_MAX),
+        VMSTATE_UINT32(freq_hz, TriCoreSTMState),
+        VMSTATE_UINT64(tim_counter, TriCoreSTMState),
+        VMSTATE_PTIMER(ptimer, TriCoreSTMState),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
 static void tricore_stm_class_init(ObjectClass *klass, void *data)
 {
     DeviceClass *dc = DEVICE_CLASS(klass);
     device_class_set_props(dc, tricore_stm_properties);
+    dc->vmsd = &vmstate_tricore_stm;
     // dc->reset = tricore_stm_reset; // Deprecated
     dc->legacy_reset = tricore_stm_reset;// TODO: Temporarry workaround. See qdev_core.h L 155
     dc->realize = tricore_stm_realize;
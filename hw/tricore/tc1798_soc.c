@@ -161,6 +161,10 @@ static void tc1798_soc_init_memory_mapping(DeviceState *dev_soc)
     // make_alias(&s->psprX, "LOCAL.PSPR", &c0->pspr, map[TC1798_PSPRX].base);
     // make_alias(&s->dsprX, "LOCAL.DSPR", &c0->dspr, map[TC1798_DSPRX].base);
 
+    /* the translator accesses the scratchpads without the TLB */
+    tricore_cpu_add_spr_window(&s->cpu, map[TC1798_DSPR0].base, &c0->dspr);
+    tricore_cpu_add_spr_window(&s->cpu, map[TC1798_PSPR0].base, &c0->pspr);
+
     make_ram(&f->pflash0_c, "PF0", map[TC1798_PFLASH0_C].base, map[TC1798_PFLASH0_C].size);
     make_ram(&f->pflash1_c, "PF1", map[TC1798_PFLASH1_C].base, map[TC1798_PFLASH1_C].size);
     make_ram(&f->dflash0,   "DF0", map[TC1798_DFLASH0].base, map[TC1798_DFLASH0].size);
@@ -68,6 +68,7 @@ const MemmapEntry tc27xd_soc_memmap[] = {
     [TC27XD_SFR]       = { 0xF0000000,                  0x0 },
     [TC27XD_STM]       = { 0xF0000000,                  0x0 },
     [TC27XD_ASCLIN]    = { 0xF0000600,                  0x0 },
+    [TC27XD_GTM]       = { 0xF0100000,                  0x0 },
     [TC27XD_SCU]       = { 0xF0036000,                  0x0 },
     [TC27XD_IRBUS]     = { 0xF0038000,                  0x0 },
 };
@@ -145,6 +146,12 @@ static void tc27xd_soc_init_memory_mapping(DeviceState *dev_soc)
     make_alias(&s->psprX, "LOCAL.PSPR", &c0->pspr, map[TC27XD_PSPRX].base);
     make_alias(&s->dsprX, "LOCAL.DSPR", &c0->dspr, map[TC27XD_DSPRX].base);
 
+    /* the translator accesses the scratchpads without the TLB */
+    tricore_cpu_add_spr_window(&s->cpu, map[TC27XD_DSPRX].base, &c0->dspr);
+    tricore_cpu_add_spr_window(&s->cpu, map[TC27XD_DSPR0].base, &c0->dspr);
+    tricore_cpu_add_spr_window(&s->cpu, map[TC27XD_PSPRX].base, &c0->pspr);
+    tricore_cpu_add_spr_window(&s->cpu, map[TC27XD_PSPR0].base, &c0->pspr);
+
     make_ram(&f->pflash0_c, "PF0", map[TC27XD_PFLASH0_C].base, map[TC27XD_PFLASH0_C].size);
     make_ram(&f->pflash1_c, "PF1", map[TC27XD_PFLASH1_C].base, map[TC27XD_PFLASH1_C].size);
     make_ram(&f->dflash0,   "DF0", map[TC27XD_DFLASH0].base, map[TC27XD_DFLASH0].size);
@@ -189,6 +196,7 @@ static void tc27xd_soc_realize(DeviceState *dev_soc, Error **errp)
     s->scu = TRICORE_SCU(object_new(TYPE_TRICORE_SCU));
     s->stm = TRICORE_STM(object_new(TYPE_TRICORE_STM));
     s->sfr = TRICORE_SFR(object_new(TYPE_TRICORE_SFR));
+    s->gtm = TRICORE_GTM(object_new(TYPE_TRICORE_GTM));
     
     /* setup links*/
     object_property_add_const_link(OBJECT(s->irbus), "cpu", OBJECT(&s->cpu));
@@ -203,6 +211,7 @@ static void tc27xd_soc_realize(DeviceState *dev_soc, Error **errp)
     sysbus_realize_and_unref(SYS_BUS_DEVICE(s->scu), &error_fatal);
     sysbus_realize_and_unref(SYS_BUS_DEVICE(s->stm), &error_fatal);
     sysbus_realize_and_unref(SYS_BUS_DEVICE(s->asclin), &error_fatal);
+    sysbus_realize_and_unref(SYS_BUS_DEVICE(s->gtm), &error_fatal);
 
     /* attach interrupt router to the CPUs interrupt line */
     sysbus_connect_irq(SYS_BUS_DEVICE(s->irbus), 0, s->cpu_irq[0]);
@@ -218,6 +227,23 @@ static void tc27xd_soc_realize(DeviceState *dev_soc, Error **errp)
     /* wire up STM interrupts */
     sysbus_connect_irq(SYS_BUS_DEVICE(s->stm), 0, s->irq[IR_SRC_STM0_SR0]);
 
+    /* wire up GTM interrupts, only TIM0, TOM0 and ATOM0 are routed */
+    for (int i = 0; i < GTM_TIM_CHANNELS; i++) {
+        sysbus_connect_irq(SYS_BUS_DEVICE(s->gtm), i,
+                           s->irq[IR_SRC_GTM_TIM0_0 + i]);
+    }
+    for (int i = 0; i < GTM_TOM_CHANNELS / 2; i++) {
+        sysbus_connect_irq(SYS_BUS_DEVICE(s->gtm),
+                           s->gtm->num_tim * GTM_TIM_CHANNELS + i,
+                           s->irq[IR_SRC_GTM_TOM0_0 + i]);
+    }
+    for (int i = 0; i < GTM_ATOM_CHANNELS / 2; i++) {
+        sysbus_connect_irq(SYS_BUS_DEVICE(s->gtm),
+                           s->gtm->num_tim * GTM_TIM_CHANNELS +
+                           s->gtm->num_tom * GTM_TOM_CHANNELS / 2 + i,
+                           s->irq[IR_SRC_GTM_ATOM0_0 + i]);
+    }
+
     /* wire up SCU interrupts */
     sysbus_connect_irq(SYS_BUS_DEVICE(s->scu), 0, s->irq[IR_SRC_RESET]);
 
@@ -228,6 +254,7 @@ static void tc27xd_soc_realize(DeviceState *dev_soc, Error **errp)
     memory_region_add_subregion(sysmem, sc->memmap[TC27XD_VIRT].base, &s->virt->iomem);
     memory_region_add_subregion(sysmem, sc->memmap[TC27XD_SCU].base, &s->scu->iomem);
     memory_region_add_subregion(sysmem, sc->memmap[TC27XD_STM].base, &s->stm->iomem);
+    memory_region_add_subregion(sysmem, sc->memmap[TC27XD_GTM].base, &s->gtm->iomem);
 }
 
 static void tc27xd_soc_reset(DeviceState *dev_soc)
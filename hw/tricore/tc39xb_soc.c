@@ -25,6 +25,7 @@
 #include "hw/loader.h"
 #include "qemu/units.h"
 #include "hw/misc/unimp.h"
+#include "hw/qdev-properties.h"
 
 #include "hw/tricore/tc39xb_soc.h"
 #include "hw/tricore/triboard.h"
@@ -125,10 +126,100 @@ const MemmapEntry tc39xb_soc_memmap[] = {
     [TC39XB_SFR]       = { 0xF0000000,                  0x0 },
     [TC39XB_STM]       = { 0xF0000000,                  0x0 },
     [TC39XB_ASCLIN]    = { 0xF0000600,                  0x0 },
+    [TC39XB_GTM]       = { 0xF0100000,                  0x0 },
+    [TC39XB_MCMCAN0]   = { 0xF0200000,                  0x0 },
     [TC39XB_SCU]       = { 0xF0036000,                  0x0 },
     [TC39XB_IRBUS]     = { 0xF0038000,                  0x0 },
 };
 
+/*
+ * SRI stall cycles as seen by a TC1.6.2P core running at fCPU = fSRI.
+ * Local scratchpad accesses are single cycle, everything that crosses
+ * the crossbar pays the arbitration and slave latency. Writes are
+ * buffered and therefore mostly hidden.
+ */
+static const TriCoreSRICosts tc39xb_sri_costs = {
+    .read = {
+        [TRICORE_SRI_LOCAL_DSPR]  = 0,
+        [TRICORE_SRI_LOCAL_PSPR]  = 1,
+        [TRICORE_SRI_REMOTE_DSPR] = 6,
+        [TRICORE_SRI_REMOTE_PSPR] = 6,
+        [TRICORE_SRI_LOCAL_DLMU]  = 1,
+        [TRICORE_SRI_REMOTE_DLMU] = 6,
+        [TRICORE_SRI_LMU]         = 6,
+        [TRICORE_SRI_PFLASH]      = 8,
+        [TRICORE_SRI_DFLASH]      = 20,
+        [TRICORE_SRI_SPB]         = 8,
+        [TRICORE_SRI_OTHER]       = 6,
+    },
+    .write = {
+        [TRICORE_SRI_LOCAL_DSPR]  = 0,
+        [TRICORE_SRI_LOCAL_PSPR]  = 0,
+        [TRICORE_SRI_REMOTE_DSPR] = 2,
+        [TRICORE_SRI_REMOTE_PSPR] = 2,
+        [TRICORE_SRI_LOCAL_DLMU]  = 0,
+        [TRICORE_SRI_REMOTE_DLMU] = 2,
+        [TRICORE_SRI_LMU]         = 2,
+        [TRICORE_SRI_PFLASH]      = 8,
+        [TRICORE_SRI_DFLASH]      = 20,
+        [TRICORE_SRI_SPB]         = 4,
+        [TRICORE_SRI_OTHER]       = 2,
+    },
+};
+
+/* decode an address into its SRI target, following tc39xb_soc_memmap */
+static TriCoreSRITarget tc39xb_sri_classify(uint32_t addr, int *owner)
+{
+    uint32_t offset = addr & 0x0FFFFFFF;
+
+    *owner = -1;
+
+    switch (addr >> 28) {
+    case 0x1:
+        *owner = 5;
+        break;
+    case 0x3:
+    case 0x4:
+    case 0x5:
+    case 0x6:
+    case 0x7:
+        *owner = 7 - (addr >> 28);
+        break;
+    case 0x8:
+    case 0xA:
+        if (offset < 0x01000000) {
+            return TRICORE_SRI_PFLASH;
+        }
+        if (offset >= 0x0F000000 && offset < 0x0FE00000) {
+            return TRICORE_SRI_DFLASH;
+        }
+        return TRICORE_SRI_OTHER;
+    case 0x9:
+    case 0xB:
+        if (offset < 0x00040000) {
+            *owner = offset >> 16;
+            return TRICORE_SRI_LOCAL_DLMU;
+        }
+        if (offset >= 0x00100000 && offset < 0x00120000) {
+            *owner = 4 + ((offset >> 16) & 1);
+            return TRICORE_SRI_LOCAL_DLMU;
+        }
+        return TRICORE_SRI_LMU;
+    case 0xC:
+        return TRICORE_SRI_LOCAL_PSPR;
+    case 0xD:
+        return TRICORE_SRI_LOCAL_DSPR;
+    case 0xF:
+        return TRICORE_SRI_SPB;
+    default:
+        return TRICORE_SRI_OTHER;
+    }
+
+    /* core local memories: DSPR below 1 MiB, PSPR above */
+    return offset < 0x00100000 ? TRICORE_SRI_LOCAL_DSPR
+                               : TRICORE_SRI_LOCAL_PSPR;
+}
+
 /*
  * Initialize the auxiliary ROM region @mr and map it into
  * the memory map at @base.
@@ -225,6 +316,12 @@ static void tc39x_soc_init_memory_mapping(DeviceState *dev_soc)
     make_alias(&s->psprX, "LOCAL.PSPR", &c0->pspr, map[TC39XB_PSPRX].base);
     make_alias(&s->dsprX, "LOCAL.DSPR", &c0->dspr, map[TC39XB_DSPRX].base);
 
+    /* the translator accesses the scratchpads without the TLB */
+    tricore_cpu_add_spr_window(&s->cpu, map[TC39XB_DSPRX].base, &c0->dspr);
+    tricore_cpu_add_spr_window(&s->cpu, map[TC39XB_DSPR0].base, &c0->dspr);
+    tricore_cpu_add_spr_window(&s->cpu, map[TC39XB_PSPRX].base, &c0->pspr);
+    tricore_cpu_add_spr_window(&s->cpu, map[TC39XB_PSPR0].base, &c0->pspr);
+
     make_ram(&c0->pflash_c, "PF0", map[TC39XB_PFLASH0_C].base, map[TC39XB_PFLASH0_C].size);
     make_ram(&c1->pflash_c, "PF1", map[TC39XB_PFLASH1_C].base, map[TC39XB_PFLASH1_C].size);
     make_ram(&c2->pflash_c, "PF2", map[TC39XB_PFLASH2_C].base, map[TC39XB_PFLASH2_C].size);
@@ -282,6 +379,16 @@ static void tc39x_soc_realize(DeviceState *dev_soc, Error **errp)
 
     tc39x_soc_init_memory_mapping(dev_soc);
 
+    if (s->sri_timing) {
+        if (!sc->sri_costs) {
+            error_setg(errp, "%s: no SRI timing model available", sc->name);
+            return;
+        }
+        tricore_sri_init(&s->sri, sc->sri_costs, tc39xb_sri_classify,
+                         sc->num_cpus);
+        tricore_sri_attach_cpu(&s->sri, &s->cpu);
+    }
+
     /* now init peripherals */
     MemoryRegion *sysmem = get_system_memory();
 
@@ -295,12 +402,23 @@ static void tc39x_soc_realize(DeviceState *dev_soc, Error **errp)
     s->scu = TRICORE_SCU(object_new(TYPE_TRICORE_SCU));
     s->stm = TRICORE_STM(object_new(TYPE_TRICORE_STM));
     s->sfr = TRICORE_SFR(object_new(TYPE_TRICORE_SFR));
+    s->gtm = TRICORE_GTM(object_new(TYPE_TRICORE_GTM));
+    s->mcmcan = TRICORE_MCMCAN(object_new(TYPE_TRICORE_MCMCAN));
 
     /* setup links*/
     object_property_add_const_link(OBJECT(s->irbus), "cpu", OBJECT(&s->cpu));
     object_property_add_const_link(OBJECT(s->scu), "cpu", OBJECT(&s->cpu));
     object_property_add_const_link(OBJECT(s->stm), "scu", OBJECT(s->scu));
     qdev_prop_set_chr(DEVICE(s->asclin), "chardev", serial_hd(0));
+    qdev_prop_set_uint32(DEVICE(s->gtm), "num-tim", 8);
+    qdev_prop_set_uint32(DEVICE(s->gtm), "num-tom", 6);
+    qdev_prop_set_uint32(DEVICE(s->gtm), "num-atom", 12);
+    for (int i = 0; i < TRICORE_MCMCAN_NODES; i++) {
+        g_autofree char *name = g_strdup_printf("canbus%d", i);
+
+        object_property_set_link(OBJECT(s->mcmcan), name,
+                                 OBJECT(s->canbus[i]), &error_fatal);
+    }
 
     /* realize devices */
     sysbus_realize_and_unref(SYS_BUS_DEVICE(s->sfr), &error_fatal);
@@ -309,6 +427,8 @@ static void tc39x_soc_realize(DeviceState *dev_soc, Error **errp)
     sysbus_realize_and_unref(SYS_BUS_DEVICE(s->virt), &error_fatal);
     sysbus_realize_and_unref(SYS_BUS_DEVICE(s->scu), &error_fatal);
     sysbus_realize_and_unref(SYS_BUS_DEVICE(s->asclin), &error_fatal);
+    sysbus_realize_and_unref(SYS_BUS_DEVICE(s->gtm), &error_fatal);
+    sysbus_realize_and_unref(SYS_BUS_DEVICE(s->mcmcan), &error_fatal);
 
     /* attach interrupt router to the CPUs interrupt line */
     sysbus_connect_irq(SYS_BUS_DEVICE(s->irbus), 0, s->cpu_irq[0]);
@@ -324,6 +444,29 @@ static void tc39x_soc_realize(DeviceState *dev_soc, Error **errp)
     /* wire up STM interrupts */
     sysbus_connect_irq(SYS_BUS_DEVICE(s->stm), 0, s->irq[IR_SRC_STM0_SR0]);
 
+    /* wire up GTM interrupts, only TIM0, TOM0 and ATOM0 are routed */
+    for (int i = 0; i < GTM_TIM_CHANNELS; i++) {
+        sysbus_connect_irq(SYS_BUS_DEVICE(s->gtm), i,
+                           s->irq[IR_SRC_GTM_TIM0_0 + i]);
+    }
+    for (int i = 0; i < GTM_TOM_CHANNELS / 2; i++) {
+        sysbus_connect_irq(SYS_BUS_DEVICE(s->gtm),
+                           s->gtm->num_tim * GTM_TIM_CHANNELS + i,
+                           s->irq[IR_SRC_GTM_TOM0_0 + i]);
+    }
+    for (int i = 0; i < GTM_ATOM_CHANNELS / 2; i++) {
+        sysbus_connect_irq(SYS_BUS_DEVICE(s->gtm),
+                           s->gtm->num_tim * GTM_TIM_CHANNELS +
+                           s->gtm->num_tom * GTM_TOM_CHANNELS / 2 + i,
+                           s->irq[IR_SRC_GTM_ATOM0_0 + i]);
+    }
+
+    /* wire up MCMCAN interrupts */
+    for (int i = 0; i < TRICORE_MCMCAN_NUM_INT; i++) {
+        sysbus_connect_irq(SYS_BUS_DEVICE(s->mcmcan), i,
+                           s->irq[IR_SRC_CAN0_INT0 + i]);
+    }
+
     /* wire up SCU interrupts */
     sysbus_connect_irq(SYS_BUS_DEVICE(s->scu), 0, s->irq[IR_SRC_RESET]);
 
@@ -334,6 +477,18 @@ static void tc39x_soc_realize(DeviceState *dev_soc, Error **errp)
     memory_region_add_subregion(sysmem, sc->memmap[TC39XB_VIRT].base, &s->virt->iomem);
     memory_region_add_subregion(sysmem, sc->memmap[TC39XB_SCU].base, &s->scu->iomem);
     memory_region_add_subregion(sysmem, sc->memmap[TC39XB_STM].base, &s->stm->iomem);
+    memory_region_add_subregion(sysmem, sc->memmap[TC39XB_GTM].base, &s->gtm->iomem);
+    memory_region_add_subregion(sysmem, sc->memmap[TC39XB_MCMCAN0].base, &s->mcmcan->iomem);
+}
+
+static char *tc39x_soc_get_sri_histogram(Object *obj, Error **errp)
+{
+    TC39XBSoCState *s = TC39XB_SOC(obj);
+
+    if (!s->sri_timing) {
+        return g_strdup("");
+    }
+    return tricore_sri_format_histogram(&s->sri);
 }
 
 static void tc39x_soc_init(Object *obj)
@@ -342,9 +497,20 @@ static void tc39x_soc_init(Object *obj)
     TC39XBSoCClass *sc = TC39XB_SOC_GET_CLASS(s);
 
     object_initialize_child(obj, "tc37x", &s->cpu, sc->cpu_type);
+    object_property_add_str(obj, "sri-histogram",
+                            tc39x_soc_get_sri_histogram, NULL);
 }
 
 static Property tc39x_soc_properties[] = {
+    DEFINE_PROP_BOOL("sri-timing", TC39XBSoCState, sri_timing, false),
+    DEFINE_PROP_LINK("canbus0", TC39XBSoCState, canbus[0], TYPE_CAN_BUS,
+                     CanBusState *),
+    DEFINE_PROP_LINK("canbus1", TC39XBSoCState, canbus[1], TYPE_CAN_BUS,
+                     CanBusState *),
+    DEFINE_PROP_LINK("canbus2", TC39XBSoCState, canbus[2], TYPE_CAN_BUS,
+                     CanBusState *),
+    DEFINE_PROP_LINK("canbus3", TC39XBSoCState, canbus[3], TYPE_CAN_BUS,
+                     CanBusState *),
     DEFINE_PROP_END_OF_LIST(),
 };
 
@@ -364,6 +530,7 @@ static void tc397b_soc_class_init(ObjectClass *oc, void *data)
     sc->cpu_type     = TRICORE_CPU_TYPE_NAME("tc37x");
     sc->memmap       = tc39xb_soc_memmap;
     sc->num_cpus     = 1;
+    sc->sri_costs    = &tc39xb_sri_costs;
 }
 
 static const TypeInfo tc39x_soc_types[] = {
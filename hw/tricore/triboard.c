@@ -99,12 +99,27 @@ static int tricore_load_brom(MemoryRegion *boot_rom)
     return 0;
 }
 
+static void triboard_forkserver_setup(MachineState *machine)
+{
+    TriBoardMachineState *ms = TRIBOARD_MACHINE(machine);
+
+    if (ms->forkserver.path) {
+        tricore_forkserver_setup(&ms->forkserver, &error_fatal);
+    }
+}
+
 static void triboard_machine_tc39xb_init(MachineState *machine)
 {
     TriBoardMachineState *ms = TRIBOARD_MACHINE(machine);
     TriBoardMachineClass *amc = TRIBOARD_MACHINE_GET_CLASS(machine);
 
     object_initialize_child(OBJECT(machine), "tc39xb_soc", &ms->tc39xb_soc, amc->soc_name);
+    for (int i = 0; i < TRICORE_MCMCAN_NODES; i++) {
+        g_autofree char *name = g_strdup_printf("canbus%d", i);
+
+        object_property_set_link(OBJECT(&ms->tc39xb_soc), name,
+                                 OBJECT(ms->canbus[i]), &error_fatal);
+    }
     sysbus_realize(SYS_BUS_DEVICE(&ms->tc39xb_soc), &error_fatal);
 
     if (machine->kernel_filename) {
@@ -117,6 +132,8 @@ static void triboard_machine_tc39xb_init(MachineState *machine)
         CPUTriCoreState *env = &cpu->env;
         env->PC_entry = brom->addr;
     }
+
+    triboard_forkserver_setup(machine);
 }
 
 static void triboard_machine_tc397b_class_init(ObjectClass *oc,
@@ -131,6 +148,19 @@ static void triboard_machine_tc397b_class_init(ObjectClass *oc,
     amc->soc_name   = "tc397b-soc";
 };
 
+static void triboard_machine_tc397b_instance_init(Object *obj)
+{
+    TriBoardMachineState *ms = TRIBOARD_MACHINE(obj);
+
+    for (int i = 0; i < TRICORE_MCMCAN_NODES; i++) {
+        g_autofree char *name = g_strdup_printf("canbus%d", i);
+
+        object_property_add_link(obj, name, TYPE_CAN_BUS,
+                                 (Object **)&ms->canbus[i],
+                                 object_property_allow_set_link, 0);
+    }
+}
+
 static void triboard_machine_tc27xd_init(MachineState *machine)
 {
     TriBoardMachineState *ms = TRIBOARD_MACHINE(machine);
@@ -149,6 +179,8 @@ static void triboard_machine_tc27xd_init(MachineState *machine)
         CPUTriCoreState *env = &cpu->env;
         env->PC_entry = brom->addr;
     }
+
+    triboard_forkserver_setup(machine);
 }
 
 static void triboard_machine_tc277d_class_init(ObjectClass *oc,
@@ -181,6 +213,8 @@ static void triboard_machine_tc1798_init(MachineState *machine)
         CPUTriCoreState *env = &cpu->env;
         env->PC_entry = brom->addr;
     }
+
+    triboard_forkserver_setup(machine);
 }
 
 static void triboard_machine_tc1798_class_init(ObjectClass *oc,
@@ -195,11 +229,50 @@ static void triboard_machine_tc1798_class_init(ObjectClass *oc,
     amc->soc_name   = "tc1798-instance-soc";
 }
 
+static char *triboard_get_fork_server(Object *obj, Error **errp)
+{
+    TriBoardMachineState *ms = TRIBOARD_MACHINE(obj);
+
+    return g_strdup(ms->forkserver.path);
+}
+
+static void triboard_set_fork_server(Object *obj, const char *value,
+                                     Error **errp)
+{
+    TriBoardMachineState *ms = TRIBOARD_MACHINE(obj);
+
+    g_free(ms->forkserver.path);
+    ms->forkserver.path = g_strdup(value);
+}
+
+static void triboard_machine_instance_init(Object *obj)
+{
+    TriBoardMachineState *ms = TRIBOARD_MACHINE(obj);
+
+    tricore_forkserver_init(&ms->forkserver);
+
+    object_property_add_str(obj, "fork-server", triboard_get_fork_server,
+                            triboard_set_fork_server);
+    object_property_set_description(obj, "fork-server",
+        "Unix socket to serve, forks a child of the set up machine per request");
+    object_property_add_uint64_ptr(obj, "fork-input",
+                                   &ms->forkserver.input_addr,
+                                   OBJ_PROP_FLAG_READWRITE);
+    object_property_set_description(obj, "fork-input",
+        "Guest address the fork-server stores the request input at");
+    object_property_add_uint32_ptr(obj, "fork-input-max",
+                                   &ms->forkserver.input_max,
+                                   OBJ_PROP_FLAG_READWRITE);
+    object_property_set_description(obj, "fork-input-max",
+        "Maximum size in bytes of a fork-server request input");
+}
+
 static const TypeInfo triboard_machine_types[] = {
     {
         .name           = TYPE_TRIBOARD_MACHINE,
         .parent         = TYPE_MACHINE,
         .instance_size  = sizeof(TriBoardMachineState),
+        .instance_init  = triboard_machine_instance_init,
         .class_size     = sizeof(TriBoardMachineClass),
         .abstract       = true,
     }, {
@@ -213,6 +286,7 @@ static const TypeInfo triboard_machine_types[] = {
     }, {
         .name           = MACHINE_TYPE_NAME("KIT_AURIX_TC397B_TRB"),
         .parent         = TYPE_TRIBOARD_MACHINE,
+        .instance_init  = triboard_machine_tc397b_instance_init,
         .class_init     = triboard_machine_tc397b_class_init,
     }, 
 };
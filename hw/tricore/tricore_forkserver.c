@@ -0,0 +1,297 @@
+/*
+ * TriCore fork-server for the TriBoard machines.
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ */
+
+#include "qemu/osdep.h"
+#include "qemu/units.h"
+#include "qemu/bswap.h"
+#include "qemu/error-report.h"
+#include "qemu/main-loop.h"
+#include "qemu/sockets.h"
+#include "qemu/rcu.h"
+#include "qapi/error.h"
+#include "chardev/char.h"
+#include "exec/address-spaces.h"
+#include "sysemu/cpus.h"
+#include "sysemu/runstate.h"
+#include "sysemu/sysemu.h"
+#include "hw/tricore/tricore_forkserver.h"
+
+#ifndef _WIN32
+static void tricore_forkserver_request(void *opaque);
+static void tricore_forkserver_child_exit(void *opaque);
+
+static bool tricore_forkserver_write(int fd, uint32_t value)
+{
+    uint32_t value_le = cpu_to_le32(value);
+
+    return qemu_write_full(fd, &value_le, sizeof(value_le)) ==
+           sizeof(value_le);
+}
+
+/* the client went away or the server cannot go on, shut the parent down */
+static void tricore_forkserver_close(TriCoreForkServer *fs)
+{
+    if (fs->conn_fd >= 0) {
+        qemu_set_fd_handler(fs->conn_fd, NULL, NULL, NULL);
+        close(fs->conn_fd);
+        fs->conn_fd = -1;
+    } else {
+        qemu_set_fd_handler(fs->listen_fd, NULL, NULL, NULL);
+    }
+    close(fs->listen_fd);
+    fs->listen_fd = -1;
+    unlink(fs->path);
+
+    qemu_system_shutdown_request(SHUTDOWN_CAUSE_HOST_SIGNAL);
+}
+
+/* runs in the child, which only has the thread that called fork() */
+static void tricore_forkserver_child(TriCoreForkServer *fs)
+{
+    uint32_t len = le32_to_cpu(fs->len_le);
+
+    fs->is_child = true;
+    qemu_set_fd_handler(fs->conn_fd, NULL, NULL, NULL);
+    close(fs->conn_fd);
+    close(fs->listen_fd);
+
+    /*
+     * rcu_init_child() has dropped the registrations of the parent's other
+     * threads, including the vCPU thread, and recreated the call_rcu thread.
+     * The vCPU thread recreated here registers itself again.
+     */
+    cpus_get_accel()->restart_vcpu_threads();
+
+    if (fs->input_addr) {
+        address_space_write(&address_space_memory, fs->input_addr,
+                            MEMTXATTRS_UNSPECIFIED, &fs->len_le,
+                            sizeof(fs->len_le));
+        address_space_write(&address_space_memory, fs->input_addr + 4,
+                            MEMTXATTRS_UNSPECIFIED, fs->input, len);
+    }
+
+    vm_start();
+}
+
+static void tricore_forkserver_fork(TriCoreForkServer *fs)
+{
+    int fds[2];
+    pid_t pid;
+
+    /* the read end sees EOF once the child, which holds the write end, ends */
+    if (!g_unix_open_pipe(fds, FD_CLOEXEC, NULL)) {
+        error_report("fork-server: cannot create pipe: %s", strerror(errno));
+        tricore_forkserver_close(fs);
+        return;
+    }
+
+    pid = fork();
+    if (pid < 0) {
+        error_report("fork-server: fork failed: %s", strerror(errno));
+        close(fds[0]);
+        close(fds[1]);
+        tricore_forkserver_close(fs);
+        return;
+    }
+    if (pid == 0) {
+        close(fds[0]);
+        tricore_forkserver_child(fs);
+        return;
+    }
+
+    close(fds[1]);
+    fs->child_pid = pid;
+    fs->child_fd = fds[0];
+
+    if (!tricore_forkserver_write(fs->conn_fd, pid)) {
+        kill(pid, SIGKILL);
+    }
+
+    /* requests are served one at a time */
+    qemu_set_fd_handler(fs->conn_fd, NULL, NULL, NULL);
+    qemu_set_fd_handler(fs->child_fd, tricore_forkserver_child_exit, NULL,
+                        fs);
+}
+
+static void tricore_forkserver_child_exit(void *opaque)
+{
+    TriCoreForkServer *fs = opaque;
+    int status;
+    char c;
+
+    /* nothing is written to the pipe, it only reports EOF */
+    if (read(fs->child_fd, &c, 1) < 0 && errno == EINTR) {
+        return;
+    }
+    qemu_set_fd_handler(fs->child_fd, NULL, NULL, NULL);
+    close(fs->child_fd);
+    fs->child_fd = -1;
+
+    while (waitpid(fs->child_pid, &status, 0) < 0) {
+        if (errno != EINTR) {
+            status = -1;
+            break;
+        }
+    }
+    fs->child_pid = 0;
+
+    if (!tricore_forkserver_write(fs->conn_fd, status)) {
+        tricore_forkserver_close(fs);
+        return;
+    }
+    qemu_set_fd_handler(fs->conn_fd, tricore_forkserver_request, NULL, fs);
+}
+
+/* collects <len> <input> from the client without blocking the main loop */
+static void tricore_forkserver_request(void *opaque)
+{
+    TriCoreForkServer *fs = opaque;
+    uint32_t len = le32_to_cpu(fs->len_le);
+    uint8_t *buf;
+    size_t want;
+    ssize_t ret;
+
+    if (fs->pos < sizeof(fs->len_le)) {
+        buf = (uint8_t *)&fs->len_le + fs->pos;
+        want = sizeof(fs->len_le) - fs->pos;
+    } else {
+        buf = fs->input + fs->pos - sizeof(fs->len_le);
+        want = len + sizeof(fs->len_le) - fs->pos;
+    }
+
+    ret = read(fs->conn_fd, buf, want);
+    if (ret < 0 && (errno == EINTR || errno == EAGAIN)) {
+        return;
+    }
+    if (ret <= 0) {
+        tricore_forkserver_close(fs);
+        return;
+    }
+    fs->pos += ret;
+
+    if (fs->pos == sizeof(fs->len_le)) {
+        len = le32_to_cpu(fs->len_le);
+        if (len > fs->input_max) {
+            error_report("fork-server: input of %u bytes exceeds the "
+                         "maximum of %u", len, fs->input_max);
+            tricore_forkserver_close(fs);
+            return;
+        }
+    }
+    if (fs->pos < sizeof(fs->len_le) + len) {
+        return;
+    }
+
+    fs->pos = 0;
+    tricore_forkserver_fork(fs);
+}
+
+static void tricore_forkserver_accept(void *opaque)
+{
+    TriCoreForkServer *fs = opaque;
+    int fd;
+
+    fd = qemu_accept(fs->listen_fd, NULL, NULL);
+    if (fd < 0) {
+        if (errno != EINTR && errno != EAGAIN) {
+            error_report("fork-server: accept failed: %s", strerror(errno));
+            tricore_forkserver_close(fs);
+        }
+        return;
+    }
+
+    /* one client per server, it ends when the client goes away */
+    qemu_set_fd_handler(fs->listen_fd, NULL, NULL, NULL);
+    fs->conn_fd = fd;
+    qemu_set_fd_handler(fs->conn_fd, tricore_forkserver_request, NULL, fs);
+}
+
+/* only the children run the guest, the parent has to keep its state */
+static void tricore_forkserver_vm_state_change(void *opaque, bool running,
+                                               RunState state)
+{
+    TriCoreForkServer *fs = opaque;
+
+    if (running && !fs->is_child) {
+        error_report("fork-server: the serving process cannot run the guest");
+        exit(1);
+    }
+}
+
+/*
+ * A child inherits every fd of the parent. With a monitor, serial port or
+ * any other backend open, parent and children would serve the same socket
+ * or stdio at once.
+ */
+static int tricore_forkserver_check_chardev(Object *obj, void *opaque)
+{
+    Error **errp = opaque;
+
+    if (!object_dynamic_cast(obj, TYPE_CHARDEV_NULL)) {
+        error_setg(errp, "fork-server needs the null backend for every "
+                   "chardev, '%s' is not", CHARDEV(obj)->label);
+        return 1;
+    }
+    return 0;
+}
+
+void tricore_forkserver_setup(TriCoreForkServer *fs, Error **errp)
+{
+    const AccelOpsClass *ops = cpus_get_accel();
+
+    if (!ops || !ops->restart_vcpu_threads) {
+        error_setg(errp, "fork-server needs single threaded TCG");
+        return;
+    }
+
+    if (!fs->input_max) {
+        error_setg(errp, "fork-input-max must not be 0");
+        return;
+    }
+
+    if (object_child_foreach(container_get(object_get_root(), "/chardevs"),
+                             tricore_forkserver_check_chardev, errp)) {
+        return;
+    }
+
+    fs->listen_fd = unix_listen(fs->path, errp);
+    if (fs->listen_fd < 0) {
+        return;
+    }
+    fs->input = g_malloc(fs->input_max);
+
+    /*
+     * The machine stays in the prelaunch state, every child starts from the
+     * same virtual time. The main loop keeps running and serves the
+     * socket from fd handlers.
+     */
+    autostart = 0;
+    qemu_set_fd_handler(fs->listen_fd, tricore_forkserver_accept, NULL, fs);
+
+    /* -daemonize disables the RCU fork handlers the children rely on */
+    rcu_enable_atfork();
+
+    fs->vmse = qemu_add_vm_change_state_handler(
+        tricore_forkserver_vm_state_change, fs);
+}
+#else
+void tricore_forkserver_setup(TriCoreForkServer *fs, Error **errp)
+{
+    error_setg(errp, "fork-server is not supported on this host");
+}
+#endif
+
+void tricore_forkserver_init(TriCoreForkServer *fs)
+{
+    fs->input_max = TRICORE_FORKSERVER_INPUT_MAX;
+    fs->listen_fd = -1;
+    fs->conn_fd = -1;
+    fs->child_fd = -1;
+}
@@ -0,0 +1,117 @@
+/*
+ * QMP commands of the TriCore machines.
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ */
+
+#include "qemu/osdep.h"
+#include "qapi/error.h"
+#include "qapi/qapi-commands-misc-target.h"
+#include "hw/sysbus.h"
+#include "hw/intc/tricore_irbus.h"
+#include "cpu.h"
+
+#include CONFIG_DEVICES
+
+TriCoreIrqStatsList *qmp_query_tricore_irq_stats(bool has_reset, bool reset,
+                                                 Error **errp)
+{
+#ifdef CONFIG_TRICORE_IRBUS
+    TriCoreIRBUSState *s;
+    TriCoreIrqStatsList *list = NULL;
+
+    s = (TriCoreIRBUSState *)object_resolve_path_type("", TYPE_TRICORE_IRBUS,
+                                                      NULL);
+    if (!s) {
+        error_setg(errp, "this machine has no TriCore interrupt router");
+        return NULL;
+    }
+    if (!s->irq_stats_enabled) {
+        error_setg(errp, "interrupt statistics are disabled");
+        error_append_hint(errp, "Use -global tricore_irbus.irq-stats=on\n");
+        return NULL;
+    }
+
+    for (int srpn = IR_SRPN_COUNT - 1; srpn >= 0; srpn--) {
+        TriCoreIRQStats *st = &s->irq_stats[srpn];
+        TriCoreIrqStats *info;
+
+        if (!st->entries) {
+            continue;
+        }
+        info = g_new0(TriCoreIrqStats, 1);
+        info->srpn = srpn;
+        info->entries = st->entries;
+        info->returns = st->returns;
+        info->max_nesting = st->max_nesting;
+        info->latency_samples = st->latency_samples;
+        info->latency_ns_min = st->latency_samples ? st->latency_ns_min : 0;
+        info->latency_ns_max = st->latency_ns_max;
+        info->latency_ns_total = st->latency_ns_total;
+        info->latency_icount_max = st->latency_icount_max;
+        info->latency_icount_total = st->latency_icount_total;
+        info->duration_ns_min = st->returns ? st->duration_ns_min : 0;
+        info->duration_ns_max = st->duration_ns_max;
+        info->duration_ns_total = st->duration_ns_total;
+        info->duration_icount_max = st->duration_icount_max;
+        info->duration_icount_total = st->duration_icount_total;
+        QAPI_LIST_PREPEND(list, info);
+    }
+
+    if (has_reset && reset) {
+        tricore_irbus_reset_irq_stats(s);
+    }
+    return list;
+#else
+    error_setg(errp, "this machine has no TriCore interrupt router");
+    return NULL;
+#endif
+}
+
+TriCoreDecodeStatsList *qmp_query_tricore_decode_stats(bool has_reset,
+                                                       bool reset,
+                                                       Error **errp)
+{
+    TriCoreDecodeStatsList *list = NULL;
+    uint64_t count[TRICORE_FMT_COUNT] = { 0 };
+    bool enabled = false;
+    CPUState *cs;
+
+    CPU_FOREACH(cs) {
+        TriCoreCPU *cpu = TRICORE_CPU(cs);
+
+        if (!cpu->decode_stats) {
+            continue;
+        }
+        enabled = true;
+        for (int fmt = 0; fmt < TRICORE_FMT_COUNT; fmt++) {
+            count[fmt] += cpu->decode_count[fmt];
+        }
+        if (has_reset && reset) {
+            memset(cpu->decode_count, 0, sizeof(cpu->decode_count));
+        }
+    }
+
+    if (!enabled) {
+        error_setg(errp, "instruction format statistics are disabled");
+        error_append_hint(errp, "Use -global tricore-cpu.decode-stats=on\n");
+        return NULL;
+    }
+
+    for (int fmt = TRICORE_FMT_COUNT - 1; fmt >= 0; fmt--) {
+        TriCoreDecodeStats *info;
+
+        if (!count[fmt]) {
+            continue;
+        }
+        info = g_new0(TriCoreDecodeStats, 1);
+        info->format = g_strdup(tricore_insn_format_name(fmt));
+        info->count = count[fmt];
+        QAPI_LIST_PREPEND(list, info);
+    }
+    return list;
+}
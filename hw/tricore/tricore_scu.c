@@ -13,7 +13,10 @@
 #include "qapi/error.h"
 #include "hw/sysbus.h"
 #include "hw/qdev-properties.h"
+#include "migration/vmstate.h"
+#include "hw/nmi.h"
 #include "hw/tricore/tricore_scu.h"
+#include "sysemu/watchdog.h"
 #include "target/tricore/cpu.h"
 #include <stdio.h>
 #include "qemu/error-report.h"
@@ -190,6 +193,222 @@ static void tricore_scu_establish_configuration(TriCoreSCUState *s)
     }
 }
 
+/*
+ * Watchdog timers. The counter is not ticked, instead the overflow is
+ * computed from the SPB clock and armed on QEMU_CLOCK_VIRTUAL, so that
+ * expiry only depends on simulated time.
+ */
+static uint32_t tricore_scu_wdt_divider(TriCoreSCUWDTState *w)
+{
+    if (w->CON1 & MASK_WDTCON1_IR1) {
+        return 64;
+    } else if (w->CON1 & MASK_WDTCON1_IR0) {
+        return 256;
+    }
+    return 16384;
+}
+
+static uint32_t tricore_scu_wdt_freq(TriCoreSCUState *s)
+{
+    uint32_t fspb = tricore_scu_get_spbclock(s);
+
+    return fspb ? fspb : SCU_FBACKUP;
+}
+
+static uint32_t tricore_scu_wdt_count(TriCoreSCUState *s,
+                                      TriCoreSCUWDTState *w)
+{
+    uint64_t ticks;
+
+    if (!w->running) {
+        return w->start_count;
+    }
+
+    ticks = muldiv64(qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL) - w->start_ns,
+                     tricore_scu_wdt_freq(s), NANOSECONDS_PER_SECOND) /
+            tricore_scu_wdt_divider(w);
+
+    return MIN(w->start_count + ticks, 0xFFFF);
+}
+
+static void tricore_scu_wdt_start(TriCoreSCUState *s, TriCoreSCUWDTState *w,
+                                  uint32_t count)
+{
+    uint64_t ticks = 0x10000 - count;
+
+    w->running = true;
+    w->start_ns = qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL);
+    w->start_count = count;
+
+    /* rounded up, so that tricore_scu_wdt_count() reads 0xFFFF on expiry */
+    if (s->watchdog) {
+        timer_mod(w->timer, w->start_ns +
+                  muldiv64_round_up(ticks * tricore_scu_wdt_divider(w),
+                                    NANOSECONDS_PER_SECOND,
+                                    tricore_scu_wdt_freq(s)));
+    }
+}
+
+static void tricore_scu_wdt_stop(TriCoreSCUState *s, TriCoreSCUWDTState *w)
+{
+    w->start_count = tricore_scu_wdt_count(s, w);
+    w->running = false;
+
+    if (w->timer) {
+        timer_del(w->timer);
+    }
+}
+
+/* CSFRs marked E() in csfr.h.inc follow the ENDINIT bit of the CPU0 WDT */
+static void tricore_scu_wdt_update_endinit(TriCoreSCUState *s)
+{
+    if (s->cpu) {
+        CPUTriCoreState *env = &((TriCoreCPU *) (s->cpu))->env;
+        env->endinit = s->wdt[TRICORE_SCU_WDT_CPU0].CON0 &
+                       MASK_WDTCON0_ENDINIT;
+    }
+}
+
+/* reload the counter after a valid modify access */
+static void tricore_scu_wdt_service(TriCoreSCUState *s, TriCoreSCUWDTState *w)
+{
+    w->SR &= ~(MASK_WDTSR_TO | MASK_WDTSR_DS | MASK_WDTSR_IS0 |
+               MASK_WDTSR_IS1);
+    if (w->CON1 & MASK_WDTCON1_IR0) {
+        w->SR |= MASK_WDTSR_IS0;
+    }
+    if (w->CON1 & MASK_WDTCON1_IR1) {
+        w->SR |= MASK_WDTSR_IS1;
+    }
+
+    if (!(w->CON0 & MASK_WDTCON0_ENDINIT)) {
+        /* time-out mode, also entered from disabled mode */
+        w->SR |= MASK_WDTSR_TO;
+        tricore_scu_wdt_start(s, w, WDT_TIMEOUT_COUNT);
+    } else if (w->CON1 & MASK_WDTCON1_DR) {
+        w->SR |= MASK_WDTSR_DS;
+        tricore_scu_wdt_stop(s, w);
+    } else {
+        tricore_scu_wdt_start(s, w, w->CON0 >> 16);
+    }
+
+    tricore_scu_wdt_update_endinit(s);
+}
+
+static void tricore_scu_wdt_write_con0(TriCoreSCUState *s,
+                                       TriCoreSCUWDTState *w, uint32_t value)
+{
+    /* PW[7:2] reads back inverted, the password is the un-inverted value */
+    uint32_t password = (w->CON0 ^ MASK_WDTCON0_PW_INV) & MASK_WDTCON0_PW;
+
+    if (w->CON0 & MASK_WDTCON0_LCK) {
+        /*
+         * password access: ENDINIT = 1, LCK = 0, PW and REL unchanged. It
+         * switches to time-out mode, so the modify access that must be the
+         * next write has to follow before the time-out expires.
+         */
+        if ((value & MASK_WDTCON0_ENDINIT) && !(value & MASK_WDTCON0_LCK)
+            && (value & MASK_WDTCON0_PW) == password
+            && (value & MASK_WDTCON0_REL) == (w->CON0 & MASK_WDTCON0_REL)) {
+            w->CON0 &= ~MASK_WDTCON0_LCK;
+            if (!(w->SR & MASK_WDTSR_TO)) {
+                w->SR = (w->SR & ~MASK_WDTSR_DS) | MASK_WDTSR_TO;
+                tricore_scu_wdt_start(s, w, WDT_TIMEOUT_COUNT);
+            }
+            return;
+        }
+    } else if ((value & MASK_WDTCON0_LCK)
+               && (value & MASK_WDTCON0_PW) == password) {
+        /* modify access, only accepted right after the password access */
+        w->CON0 = (value ^ MASK_WDTCON0_PW_INV) | MASK_WDTCON0_LCK;
+        tricore_scu_wdt_service(s, w);
+        return;
+    }
+
+    qemu_log_mask(LOG_GUEST_ERROR,
+                  "tricore_scu: invalid watchdog access 0x%08x\n", value);
+    w->SR |= MASK_WDTSR_AE | MASK_WDTSR_TO;
+    w->CON0 |= MASK_WDTCON0_LCK;
+    tricore_scu_wdt_start(s, w, WDT_TIMEOUT_COUNT);
+}
+
+static void tricore_scu_wdt_write_con1(TriCoreSCUWDTState *w, uint32_t value)
+{
+    /* CON1 is itself ENDINIT protected, it is applied on the next service */
+    if (w->CON0 & MASK_WDTCON0_ENDINIT) {
+        qemu_log_mask(LOG_GUEST_ERROR,
+                      "tricore_scu: WDTCON1 write with ENDINIT set\n");
+        return;
+    }
+    w->CON1 = value & (MASK_WDTCON1_IR0 | MASK_WDTCON1_DR | MASK_WDTCON1_IR1);
+}
+
+static uint32_t tricore_scu_wdt_read_sr(TriCoreSCUState *s,
+                                        TriCoreSCUWDTState *w)
+{
+    return (w->SR & ~MASK_WDTSR_TIM) | (tricore_scu_wdt_count(s, w) << 16);
+}
+
+static void tricore_scu_wdt_reset(TriCoreSCUState *s)
+{
+    for (int i = 0; i < TRICORE_SCU_WDT_NUM; i++) {
+        TriCoreSCUWDTState *w = &s->wdt[i];
+
+        w->CON0 = i == TRICORE_SCU_WDT_CPU0 ? RESET_TRICORE_WDTCPU0CON0
+                                             : RESET_TRICORE_WDTSCON0;
+        w->CON1 = i == TRICORE_SCU_WDT_CPU0 ? RESET_TRICORE_WDTCPU0CON1
+                                             : RESET_TRICORE_WDTSCON1;
+        w->SR = RESET_TRICORE_WDTSR;
+
+        /* after reset the WDT runs in time-out mode with ENDINIT cleared */
+        if (w->timer) {
+            tricore_scu_wdt_start(s, w, WDT_TIMEOUT_COUNT);
+        } else {
+            w->running = false;
+            w->start_count = WDT_TIMEOUT_COUNT;
+        }
+    }
+
+    tricore_scu_wdt_update_endinit(s);
+}
+
+/* an application reset also restarts the watchdogs */
+static void tricore_scu_request_reset(TriCoreSCUState *s)
+{
+    CPUTriCoreState *env = &((TriCoreCPU *) (s->cpu))->env;
+    env->reset_pending = 1;
+
+    tricore_scu_wdt_reset(s);
+    qemu_irq_raise(s->reset_line);
+}
+
+static void tricore_scu_wdt_expired(void *opaque)
+{
+    TriCoreSCUState *s = opaque;
+
+    for (int i = 0; i < TRICORE_SCU_WDT_NUM; i++) {
+        TriCoreSCUWDTState *w = &s->wdt[i];
+
+        if (w->running && tricore_scu_wdt_count(s, w) >= 0xFFFF) {
+            w->SR |= MASK_WDTSR_OE;
+            tricore_scu_wdt_stop(s, w);
+        }
+    }
+
+    qemu_log_mask(LOG_GUEST_ERROR, "tricore_scu: watchdog expired\n");
+
+    /*
+     * The default -action watchdog=reset goes through the same path as a
+     * software reset, everything else (e.g. inject-nmi, poweroff for CI
+     * runs) is left to the generic watchdog code.
+     */
+    if (get_watchdog_action() == WATCHDOG_ACTION_RESET) {
+        tricore_scu_request_reset(s);
+    } else {
+        watchdog_perform_action();
+    }
+}
+
 static void tricore_scu_write(void *opaque, hwaddr offset, uint64_t value,
         unsigned size)
 {
@@ -270,11 +489,8 @@ static void tricore_scu_write(void *opaque, hwaddr offset, uint64_t value,
         
     case 0x60: /* SWRSTCON */
         if(value & 2) {
-            CPUTriCoreState *env = &((TriCoreCPU *) (s->cpu))->env;
-            env->reset_pending = 1;
-            
             qemu_log("tricore_scu_write: Software reset requested\n");
-            qemu_irq_raise(s->reset_line);
+            tricore_scu_request_reset(s);
         }
         break;
     case 0x80:
@@ -295,12 +511,24 @@ static void tricore_scu_write(void *opaque, hwaddr offset, uint64_t value,
         /* Workaround: Normally it should take a while to raise VCOLOCK. */
         s->PLLSTAT |= MASK_PLLSTAT_VCOLOCK;
         break;
-    case 0xf0:
-        /* SCU_WDTS_CON0 */
-        memcpy(&(s->WDTSCON1) + (offset & 0x3), &value, size);
-        break;
-    case 0x100:
-        memcpy(&(s->WDTCPU0CON0) + (offset & 0x3), &value, size);
+    case 0xf0: /* WDTS_CON0 */
+    case 0x100: /* WDTCPU0_CON0 */
+    case 0xf4: /* WDTS_CON1 */
+    case 0x104: /* WDTCPU0_CON1 */
+        if (size != 4) {
+            qemu_log_mask(LOG_GUEST_ERROR,
+                          "tricore_scu: watchdog needs 32 bit accesses\n");
+            break;
+        }
+        if (reg_addr == 0xf0 || reg_addr == 0x100) {
+            tricore_scu_wdt_write_con0(s, &s->wdt[reg_addr == 0xf0 ?
+                                       TRICORE_SCU_WDT_SAFETY :
+                                       TRICORE_SCU_WDT_CPU0], value);
+        } else {
+            tricore_scu_wdt_write_con1(&s->wdt[reg_addr == 0xf4 ?
+                                       TRICORE_SCU_WDT_SAFETY :
+                                       TRICORE_SCU_WDT_CPU0], value);
+        }
         break;
     default:
         break;
@@ -358,11 +586,22 @@ static uint64_t tricore_scu_read(void *opaque, hwaddr offset, unsigned size)
         r = s->CCUCON[1];
         break;
     case 0xf0:
-        /* SCU_WDTS_CON0 */
-        r = s->WDTSCON1;
+        r = s->wdt[TRICORE_SCU_WDT_SAFETY].CON0;
+        break;
+    case 0xf4:
+        r = s->wdt[TRICORE_SCU_WDT_SAFETY].CON1;
+        break;
+    case 0xf8:
+        r = tricore_scu_wdt_read_sr(s, &s->wdt[TRICORE_SCU_WDT_SAFETY]);
         break;
     case 0x100:
-        r = s->WDTCPU0CON0;
+        r = s->wdt[TRICORE_SCU_WDT_CPU0].CON0;
+        break;
+    case 0x104:
+        r = s->wdt[TRICORE_SCU_WDT_CPU0].CON1;
+        break;
+    case 0x108:
+        r = tricore_scu_wdt_read_sr(s, &s->wdt[TRICORE_SCU_WDT_CPU0]);
         break;
     case 0x140:
         r = 0x47477172 | (1 << 31);
@@ -416,9 +655,7 @@ static void tricore_scu_reset(DeviceState *dev)
     /* Disable FINDIS. */
     s->PLLSTAT = (s->PLLSTAT & ~MASK_PLLSTAT_FINDIS) | 0x0;
 
-    s->WDTCPU0CON0 = RESET_TRICORE_WDTCPU0CON0;
-    s->WDTSCON0 = RESET_TRICORE_WDTSCON0;
-    s->WDTSCON1 = RESET_TRICORE_WDTSCON1;
+    tricore_scu_wdt_reset(s);
 }
 
 static const MemoryRegionOps tricore_scu_ops = {
@@ -452,24 +689,89 @@ static void tricore_scu_realize(DeviceState *dev, Error **errp)
                 error_get_pretty(err));
         return;
     }
+
+    for (int i = 0; i < TRICORE_SCU_WDT_NUM; i++) {
+        s->wdt[i].timer = timer_new_ns(QEMU_CLOCK_VIRTUAL,
+                                       tricore_scu_wdt_expired, s);
+    }
+    tricore_scu_wdt_reset(s);
+}
+
+static void tricore_scu_nmi(NMIState *n, int cpu_index, Error **errp)
+{
+    TriCoreSCUState *s = TRICORE_SCU(n);
+
+    cpu_interrupt(CPU(s->cpu), CPU_INTERRUPT_NMI);
 }
 
-static Property tricore_scu_properties[] = { DEFINE_PROP_END_OF_LIST() };
+static int tricore_scu_post_load(void *opaque, int version_id)
+{
+    TriCoreSCUState *s = opaque;
+
+    tricore_scu_wdt_update_endinit(s);
+    return 0;
+}
+
+static const VMStateDescription vmstate_tricore_scu_wdt = {
+    .name = "tricore_scu_wdt",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32(CON0, TriCoreSCUWDTState),
+        VMSTATE_UINT32(CON1, TriCoreSCUWDTState),
+        VMSTATE_UINT32(SR, TriCoreSCUWDTState),
+        VMSTATE_TIMER_PTR(timer, TriCoreSCUWDTState),
+        VMSTATE_BOOL(running, TriCoreSCUWDTState),
+        VMSTATE_INT64(start_ns, TriCoreSCUWDTState),
+        VMSTATE_UINT32(start_count, TriCoreSCUWDTState),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static const VMStateDescription vmstate_tricore_scu = {
+    .name = "tricore_scu",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .post_load = tricore_scu_post_load,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32(mode, TriCoreSCUState),
+        VMSTATE_UINT32(OSCCON, TriCoreSCUState),
+        VMSTATE_UINT32(PLLSTAT, TriCoreSCUState),
+        VMSTATE_UINT32_ARRAY(PLLCON, TriCoreSCUState, 3),
+        VMSTATE_UINT32(PLLERAYSTAT, TriCoreSCUState),
+        VMSTATE_UINT32_ARRAY(PLLERAYCON, TriCoreSCUState, 2),
+        VMSTATE_UINT32_ARRAY(CCUCON, TriCoreSCUState, 9),
+        VMSTATE_UINT32(FDR, TriCoreSCUState),
+        VMSTATE_UINT32(EXTCON, TriCoreSCUState),
+        VMSTATE_STRUCT_ARRAY(wdt, TriCoreSCUState, TRICORE_SCU_WDT_NUM, 1,
+                             vmstate_tricore_scu_wdt, TriCoreSCUWDTState),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static Property tricore_scu_properties[] = {
+    DEFINE_PROP_BOOL("watchdog", TriCoreSCUState, watchdog, false),
+    DEFINE_PROP_END_OF_LIST(),
+};
 
 static void tricore_scu_class_init(ObjectClass *klass, void *data)
 {
     DeviceClass *dc = DEVICE_CLASS(klass);
+    NMIClass *nc = NMI_CLASS(klass);
 
     device_class_set_props(dc, tricore_scu_properties);
     // dc->reset = tricore_scu_reset; // Deprecated
     dc->legacy_reset = tricore_scu_reset;// TODO: Temporarry workaround. See qdev_core.h L 155
     dc->realize = tricore_scu_realize;
+    dc->vmsd = &vmstate_tricore_scu;
+    nc->nmi_monitor_handler = tricore_scu_nmi;
 }
 
 static const TypeInfo tricore_scu_info = {
         .name = TYPE_TRICORE_SCU, .parent = TYPE_SYS_BUS_DEVICE,
         .instance_size = sizeof(TriCoreSCUState), .instance_init =
-                tricore_scu_init, .class_init = tricore_scu_class_init, };
+                tricore_scu_init, .class_init = tricore_scu_class_init,
+        .interfaces = (InterfaceInfo[]) { { TYPE_NMI }, { } }, };
 
 static void tricore_scu_register_types(void)
 {
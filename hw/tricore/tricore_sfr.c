@@ -11,6 +11,7 @@
 
 #include "qemu/osdep.h"
 #include "hw/sysbus.h"
+#include "migration/vmstate.h"
 #include "hw/tricore/tricore_sfr.h"
 #include <stdio.h>
 #include <inttypes.h>
@@ -111,11 +112,30 @@ static void tricore_sfr_init(Object *obj)
     }
 }
 
+static const VMStateDescription vmstate_tricore_sfr = {
+    .name = "tricore_sfr",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32_ARRAY(regs, TriCoreSFRState,
+                             TRICORE_SFR_SIZE / sizeof(uint32_t)),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static void tricore_sfr_class_init(ObjectClass *klass, void *data)
+{
+    DeviceClass *dc = DEVICE_CLASS(klass);
+
+    dc->vmsd = &vmstate_tricore_sfr;
+}
+
 static const TypeInfo tricore_sfr_info = {
 	.name = TYPE_TRICORE_SFR,
     .parent = TYPE_SYS_BUS_DEVICE,
 	.instance_size = sizeof(TriCoreSFRState),
 	.instance_init = tricore_sfr_init,
+	.class_init = tricore_sfr_class_init,
 };
 
 static void tricore_sfr_register_types(void)
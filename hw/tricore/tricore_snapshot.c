@@ -0,0 +1,152 @@
+/*
+ * In-process snapshots of TriCore machines.
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ */
+
+#include "qemu/osdep.h"
+#include "qapi/error.h"
+#include "exec/ramblock.h"
+#include "exec/ram_addr.h"
+#include "exec/exec-all.h"
+#include "io/channel-buffer.h"
+#include "migration/qemu-file.h"
+#include "migration/savevm.h"
+#include "hw/tricore/tricore_snapshot.h"
+
+/* dirty bits are tested for this many pages at once before going per page */
+#define SNAPSHOT_CHUNK_PAGES 64
+
+static int tricore_snapshot_add_block(RAMBlock *rb, void *opaque)
+{
+    TriCoreSnapshot *snap = opaque;
+    TriCoreSnapshotBlock blk = {
+        .rb = rb,
+        .offset = qemu_ram_get_offset(rb),
+        .size = qemu_ram_get_used_length(rb),
+    };
+
+    blk.data = g_memdup2(qemu_ram_get_host_addr(rb), blk.size);
+    memory_region_set_log(rb->mr, true, DIRTY_MEMORY_VGA);
+    cpu_physical_memory_test_and_clear_dirty(blk.offset, blk.size,
+                                             DIRTY_MEMORY_VGA);
+    g_array_append_val(snap->blocks, blk);
+
+    return 0;
+}
+
+static uint64_t tricore_snapshot_restore_block(TriCoreSnapshotBlock *blk)
+{
+    uint8_t *host = qemu_ram_get_host_addr(blk->rb);
+    ram_addr_t chunk = SNAPSHOT_CHUNK_PAGES * TARGET_PAGE_SIZE;
+    uint64_t pages = 0;
+
+    for (ram_addr_t off = 0; off < blk->size; off += chunk) {
+        ram_addr_t len = MIN(chunk, blk->size - off);
+
+        if (!cpu_physical_memory_get_dirty(blk->offset + off, len,
+                                           DIRTY_MEMORY_VGA)) {
+            continue;
+        }
+
+        for (ram_addr_t p = off; p < off + len; p += TARGET_PAGE_SIZE) {
+            ram_addr_t plen = MIN(TARGET_PAGE_SIZE, blk->size - p);
+
+            if (!cpu_physical_memory_test_and_clear_dirty(blk->offset + p,
+                                                          plen,
+                                                          DIRTY_MEMORY_VGA)) {
+                continue;
+            }
+            memcpy(host + p, blk->data + p, plen);
+            /* code translated from the modified page is stale now */
+            tb_invalidate_phys_range(blk->offset + p,
+                                     blk->offset + p + plen - 1);
+            pages++;
+        }
+    }
+
+    return pages;
+}
+
+TriCoreSnapshot *tricore_snapshot_take(Error **errp)
+{
+    TriCoreSnapshot *snap = g_new0(TriCoreSnapshot, 1);
+    QIOChannelBuffer *bioc;
+    QEMUFile *f;
+    int ret;
+
+    snap->blocks = g_array_new(false, false, sizeof(TriCoreSnapshotBlock));
+    qemu_ram_foreach_block(tricore_snapshot_add_block, snap);
+
+    bioc = qio_channel_buffer_new(4096);
+    f = qemu_file_new_output(QIO_CHANNEL(bioc));
+    ret = qemu_save_device_state(f);
+    qemu_fflush(f);
+
+    snap->devices = g_memdup2(bioc->data, bioc->usage);
+    snap->devices_size = bioc->usage;
+
+    qemu_fclose(f);
+    object_unref(OBJECT(bioc));
+
+    if (ret < 0) {
+        error_setg(errp, "saving the device state failed: %d", ret);
+        tricore_snapshot_free(snap);
+        return NULL;
+    }
+
+    return snap;
+}
+
+int tricore_snapshot_restore(TriCoreSnapshot *snap, Error **errp)
+{
+    QIOChannelBuffer *bioc;
+    QEMUFile *f;
+    int ret;
+
+    snap->restored_pages = 0;
+    for (guint b = 0; b < snap->blocks->len; b++) {
+        snap->restored_pages += tricore_snapshot_restore_block(
+            &g_array_index(snap->blocks, TriCoreSnapshotBlock, b));
+    }
+
+    /*
+     * A fresh channel and file per restore, closing the file frees the
+     * channel's buffer, so it reads from a copy of the saved stream.
+     */
+    bioc = qio_channel_buffer_new(snap->devices_size);
+    memcpy(bioc->data, snap->devices, snap->devices_size);
+    bioc->usage = snap->devices_size;
+    f = qemu_file_new_input(QIO_CHANNEL(bioc));
+    object_unref(OBJECT(bioc));
+
+    /* skip the file header qemu_save_device_state() puts in front */
+    qemu_get_be32(f);
+    qemu_get_be32(f);
+    ret = qemu_load_device_state(f);
+    qemu_fclose(f);
+    if (ret < 0) {
+        error_setg(errp, "restoring the device state failed: %d", ret);
+    }
+
+    return ret;
+}
+
+void tricore_snapshot_free(TriCoreSnapshot *snap)
+{
+    for (guint b = 0; b < snap->blocks->len; b++) {
+        TriCoreSnapshotBlock *blk = &g_array_index(snap->blocks,
+                                                   TriCoreSnapshotBlock, b);
+
+        memory_region_set_log(blk->rb->mr, false, DIRTY_MEMORY_VGA);
+        g_free(blk->data);
+    }
+    g_array_free(snap->blocks, true);
+
+    g_free(snap->devices);
+    g_free(snap);
+}
@@ -0,0 +1,117 @@
+/*
+ * QEMU TriCore SRI crossbar timing model.
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ */
+
+#include "qemu/osdep.h"
+#include "hw/tricore/tricore_sri.h"
+
+static const char *const tricore_sri_target_names[TRICORE_SRI_TARGET_COUNT] = {
+    [TRICORE_SRI_LOCAL_DSPR]  = "local-dspr",
+    [TRICORE_SRI_LOCAL_PSPR]  = "local-pspr",
+    [TRICORE_SRI_REMOTE_DSPR] = "remote-dspr",
+    [TRICORE_SRI_REMOTE_PSPR] = "remote-pspr",
+    [TRICORE_SRI_LOCAL_DLMU]  = "local-dlmu",
+    [TRICORE_SRI_REMOTE_DLMU] = "remote-dlmu",
+    [TRICORE_SRI_LMU]         = "lmu",
+    [TRICORE_SRI_PFLASH]      = "pflash",
+    [TRICORE_SRI_DFLASH]      = "dflash",
+    [TRICORE_SRI_SPB]         = "spb",
+    [TRICORE_SRI_OTHER]       = "other",
+};
+
+/* scratchpads and DLMUs owned by another core are reached over the SRI */
+static TriCoreSRITarget tricore_sri_relative(TriCoreSRITarget target,
+                                             int owner, uint32_t core)
+{
+    if (owner < 0 || (uint32_t)owner == core) {
+        return target;
+    }
+
+    switch (target) {
+    case TRICORE_SRI_LOCAL_DSPR:
+        return TRICORE_SRI_REMOTE_DSPR;
+    case TRICORE_SRI_LOCAL_PSPR:
+        return TRICORE_SRI_REMOTE_PSPR;
+    case TRICORE_SRI_LOCAL_DLMU:
+        return TRICORE_SRI_REMOTE_DLMU;
+    default:
+        return target;
+    }
+}
+
+static uint32_t tricore_sri_access(void *opaque, uint32_t core, uint32_t addr,
+                                   uint32_t size, bool is_write)
+{
+    TriCoreSRIState *s = opaque;
+    TriCoreSRITarget target;
+    uint32_t cycles;
+    int owner = -1;
+
+    if (core >= s->num_cores) {
+        return 0;
+    }
+
+    target = tricore_sri_relative(s->classify(addr, &owner), owner, core);
+    cycles = is_write ? s->costs->write[target] : s->costs->read[target];
+
+    /* 64 bit accesses are split into two SRI transactions */
+    if (size > 4) {
+        cycles *= 2;
+    }
+
+    s->accesses[core][target]++;
+    s->stall_cycles[core][target] += cycles;
+
+    return cycles;
+}
+
+void tricore_sri_init(TriCoreSRIState *s, const TriCoreSRICosts *costs,
+                      TriCoreSRIClassifyFn classify, uint32_t num_cores)
+{
+    assert(num_cores <= TRICORE_SRI_MAX_CORES);
+
+    s->costs = costs;
+    s->classify = classify;
+    s->num_cores = num_cores;
+    tricore_sri_reset_stats(s);
+}
+
+void tricore_sri_attach_cpu(TriCoreSRIState *s, TriCoreCPU *cpu)
+{
+    CPUTriCoreState *env = &cpu->env;
+
+    env->bus_timing_opaque = s;
+    env->bus_timing = tricore_sri_access;
+}
+
+void tricore_sri_reset_stats(TriCoreSRIState *s)
+{
+    memset(s->accesses, 0, sizeof(s->accesses));
+    memset(s->stall_cycles, 0, sizeof(s->stall_cycles));
+}
+
+char *tricore_sri_format_histogram(TriCoreSRIState *s)
+{
+    GString *buf = g_string_new(NULL);
+
+    for (uint32_t core = 0; core < s->num_cores; core++) {
+        for (int t = 0; t < TRICORE_SRI_TARGET_COUNT; t++) {
+            if (!s->accesses[core][t]) {
+                continue;
+            }
+            g_string_append_printf(buf, "cpu%u %-12s accesses %" PRIu64
+                                   " stall-cycles %" PRIu64 "\n",
+                                   core, tricore_sri_target_names[t],
+                                   s->accesses[core][t],
+                                   s->stall_cycles[core][t]);
+        }
+    }
+
+    return g_string_free(buf, false);
+}
@@ -29,6 +29,10 @@
 #include "hw/tricore/tricore.h"
 #include "hw/tricore/tricore_testdevice.h"
 #include "qemu/error-report.h"
+#include "qemu/timer.h"
+#include "qapi/visitor.h"
+#include "qemu/main-loop.h"
+#include "hw/tricore/tricore_snapshot.h"
 
 
 /* Board init.  */
@@ -53,8 +57,233 @@ static void tricore_load_kernel(CPUTriCoreState *env)
 
 }
 
+/*
+ * Batch mode: run a list of test ELFs in one process. The machine state is
+ * captured once after board init and restored before each test, the test
+ * device reports results to us instead of terminating QEMU.
+ */
+typedef struct TTBBatchResult {
+    bool passed;
+    bool timeout;
+    uint32_t value;
+    int64_t time_us;
+} TTBBatchResult;
+
+typedef struct TTBBatch {
+    char *list;
+    char *junit;
+    uint32_t timeout_ms;
+
+    char **tests;
+    TTBBatchResult *results;
+    uint32_t num_tests;
+    uint32_t idx;
+    /* a test is running, results are accepted */
+    bool running;
+    int64_t start_us;
+    QEMUTimer *timer;
+
+    TriCoreCPU *cpu;
+    TriCoreSnapshot *snapshot;
+} TTBBatch;
+
+#define TYPE_TRICORE_TESTBOARD_MACHINE MACHINE_TYPE_NAME("tricore_testboard")
+OBJECT_DECLARE_SIMPLE_TYPE(TriCoreTestBoardMachineState,
+                           TRICORE_TESTBOARD_MACHINE)
+
+struct TriCoreTestBoardMachineState {
+    MachineState parent;
+
+    TTBBatch batch;
+};
+
+static void ttb_batch_write_junit(TTBBatch *b, uint32_t failures,
+                                  int64_t total_us)
+{
+    GString *xml = g_string_new(NULL);
+    g_autoptr(GError) err = NULL;
+
+    g_string_append_printf(xml, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                           "<testsuite name=\"tricore_testboard\" tests=\"%u\""
+                           " failures=\"%u\" time=\"%.6f\">\n",
+                           b->num_tests, failures, total_us / 1e6);
+    for (uint32_t i = 0; i < b->num_tests; i++) {
+        TTBBatchResult *r = &b->results[i];
+        g_autofree char *name = g_markup_escape_text(b->tests[i], -1);
+
+        g_string_append_printf(xml, "  <testcase name=\"%s\" time=\"%.6f\"",
+                               name, r->time_us / 1e6);
+        if (r->passed) {
+            g_string_append(xml, "/>\n");
+        } else if (r->timeout) {
+            g_string_append(xml, ">\n    <failure message=\"timeout\"/>\n"
+                            "  </testcase>\n");
+        } else {
+            g_string_append_printf(xml, ">\n    <failure message=\"exit "
+                                   "value 0x%x\"/>\n  </testcase>\n",
+                                   r->value);
+        }
+    }
+    g_string_append(xml, "</testsuite>\n");
+
+    if (!g_file_set_contents(b->junit, xml->str, xml->len, &err)) {
+        error_report("cannot write junit file '%s': %s", b->junit,
+                     err->message);
+    }
+    g_string_free(xml, true);
+}
+
+static void ttb_batch_finish(TTBBatch *b)
+{
+    uint32_t failures = 0;
+    int64_t total_us = 0;
+
+    for (uint32_t i = 0; i < b->num_tests; i++) {
+        TTBBatchResult *r = &b->results[i];
+
+        total_us += r->time_us;
+        if (!r->passed) {
+            failures++;
+            if (r->timeout) {
+                error_report("%s: timeout", b->tests[i]);
+            } else {
+                error_report("%s: failed with 0x%x", b->tests[i], r->value);
+            }
+        }
+    }
+
+    if (b->junit) {
+        ttb_batch_write_junit(b, failures, total_us);
+    }
+    info_report("batch: %u tests, %u passed, %u failed",
+                b->num_tests, b->num_tests - failures, failures);
+
+    exit(failures ? 1 : 0);
+}
+
+/* runs with all vCPUs stopped, so RAM and CPU state can be replaced */
+static void ttb_batch_start_next(CPUState *cs, run_on_cpu_data data)
+{
+    TTBBatch *b = data.host_ptr;
+    CPUTriCoreState *env = &b->cpu->env;
+    uint64_t entry;
+    ssize_t size;
+
+    bql_lock();
+
+    if (!b->snapshot) {
+        b->snapshot = tricore_snapshot_take(&error_fatal);
+    } else {
+        tricore_snapshot_restore(b->snapshot, &error_fatal);
+    }
+
+    for (; b->idx < b->num_tests; b->idx++) {
+        cpu_reset(CPU(b->cpu));
+        size = load_elf_ram_sym(b->tests[b->idx], NULL, NULL, NULL, &entry,
+                                NULL, NULL, NULL, 0, EM_TRICORE, 1, 0,
+                                NULL, false, NULL);
+        if (size > 0) {
+            break;
+        }
+        error_report("cannot load test '%s'", b->tests[b->idx]);
+        b->results[b->idx].value = UINT32_MAX;
+    }
+
+    if (b->idx == b->num_tests) {
+        ttb_batch_finish(b);
+        return;
+    }
+
+    /* loading the image invalidated any code translated from it */
+    env->PC = entry;
+
+    b->start_us = g_get_monotonic_time();
+    if (b->timeout_ms) {
+        timer_mod(b->timer, qemu_clock_get_ms(QEMU_CLOCK_VIRTUAL) +
+                  b->timeout_ms);
+    }
+    b->running = true;
+
+    bql_unlock();
+}
+
+static void ttb_batch_complete(TTBBatch *b, bool passed, bool timeout,
+                               uint32_t value)
+{
+    TTBBatchResult *r = &b->results[b->idx];
+
+    if (!b->running) {
+        return;
+    }
+    b->running = false;
+    timer_del(b->timer);
+
+    r->passed = passed;
+    r->timeout = timeout;
+    r->value = value;
+    r->time_us = g_get_monotonic_time() - b->start_us;
+    b->idx++;
+
+    async_safe_run_on_cpu(CPU(b->cpu), ttb_batch_start_next,
+                          RUN_ON_CPU_HOST_PTR(b));
+}
+
+static void ttb_batch_result(void *opaque, uint32_t value)
+{
+    ttb_batch_complete(opaque, value == 0, false, value);
+}
+
+static void ttb_batch_timeout(void *opaque)
+{
+    ttb_batch_complete(opaque, false, true, 0);
+}
+
+static void ttb_batch_init(TTBBatch *b, TriCoreCPU *cpu,
+                           TriCoreTestDeviceState *test_dev)
+{
+    g_autofree char *contents = NULL;
+    g_autoptr(GError) err = NULL;
+    g_auto(GStrv) lines = NULL;
+    GPtrArray *tests = g_ptr_array_new();
+
+    if (!g_file_get_contents(b->list, &contents, NULL, &err)) {
+        error_report("cannot read batch list '%s': %s", b->list,
+                     err->message);
+        exit(1);
+    }
+
+    lines = g_strsplit(contents, "\n", -1);
+    for (int i = 0; lines[i]; i++) {
+        char *line = g_strstrip(lines[i]);
+
+        if (*line && *line != '#') {
+            g_ptr_array_add(tests, g_strdup(line));
+        }
+    }
+    b->num_tests = tests->len;
+    g_ptr_array_add(tests, NULL);
+    b->tests = (char **)g_ptr_array_free(tests, false);
+
+    if (!b->num_tests) {
+        error_report("batch list '%s' is empty", b->list);
+        exit(1);
+    }
+
+    b->results = g_new0(TTBBatchResult, b->num_tests);
+    b->cpu = cpu;
+    b->timer = timer_new_ms(QEMU_CLOCK_VIRTUAL, ttb_batch_timeout, b);
+
+    test_dev->result = ttb_batch_result;
+    test_dev->result_opaque = b;
+
+    /* the first call takes the snapshot and loads the first test */
+    async_safe_run_on_cpu(CPU(cpu), ttb_batch_start_next,
+                          RUN_ON_CPU_HOST_PTR(b));
+}
+
 static void tricore_testboard_init(MachineState *machine, int board_id)
 {
+    TriCoreTestBoardMachineState *ms = TRICORE_TESTBOARD_MACHINE(machine);
     TriCoreCPU *cpu;
     CPUTriCoreState *env;
     TriCoreTestDeviceState *test_dev;
@@ -96,7 +325,13 @@ static void tricore_testboard_init(MachineState *machine, int board_id)
     tricoretb_binfo.ram_size = machine->ram_size;
     tricoretb_binfo.kernel_filename = machine->kernel_filename;
 
-    if (machine->kernel_filename) {
+    if (ms->batch.list) {
+        if (machine->kernel_filename) {
+            error_report("batch mode cannot be combined with -kernel");
+            exit(1);
+        }
+        ttb_batch_init(&ms->batch, cpu, test_dev);
+    } else if (machine->kernel_filename) {
         tricore_load_kernel(env);
     }
 }
@@ -106,11 +341,80 @@ static void tricoreboard_init(MachineState *machine)
     tricore_testboard_init(machine, 0x183);
 }
 
-static void ttb_machine_init(MachineClass *mc)
+static char *ttb_get_batch(Object *obj, Error **errp)
 {
+    TriCoreTestBoardMachineState *ms = TRICORE_TESTBOARD_MACHINE(obj);
+
+    return g_strdup(ms->batch.list);
+}
+
+static void ttb_set_batch(Object *obj, const char *value, Error **errp)
+{
+    TriCoreTestBoardMachineState *ms = TRICORE_TESTBOARD_MACHINE(obj);
+
+    g_free(ms->batch.list);
+    ms->batch.list = g_strdup(value);
+}
+
+static char *ttb_get_junit(Object *obj, Error **errp)
+{
+    TriCoreTestBoardMachineState *ms = TRICORE_TESTBOARD_MACHINE(obj);
+
+    return g_strdup(ms->batch.junit);
+}
+
+static void ttb_set_junit(Object *obj, const char *value, Error **errp)
+{
+    TriCoreTestBoardMachineState *ms = TRICORE_TESTBOARD_MACHINE(obj);
+
+    g_free(ms->batch.junit);
+    ms->batch.junit = g_strdup(value);
+}
+
+static void ttb_get_batch_timeout(Object *obj, Visitor *v, const char *name,
+                                  void *opaque, Error **errp)
+{
+    TriCoreTestBoardMachineState *ms = TRICORE_TESTBOARD_MACHINE(obj);
+
+    visit_type_uint32(v, name, &ms->batch.timeout_ms, errp);
+}
+
+static void ttb_set_batch_timeout(Object *obj, Visitor *v, const char *name,
+                                  void *opaque, Error **errp)
+{
+    TriCoreTestBoardMachineState *ms = TRICORE_TESTBOARD_MACHINE(obj);
+
+    visit_type_uint32(v, name, &ms->batch.timeout_ms, errp);
+}
+
+static void ttb_machine_class_init(ObjectClass *oc, void *data)
+{
+    MachineClass *mc = MACHINE_CLASS(oc);
+
     mc->desc = "a minimal TriCore board";
     mc->init = tricoreboard_init;
     mc->default_cpu_type = TRICORE_CPU_TYPE_NAME("tc1796");
+
+    object_class_property_add_str(oc, "batch", ttb_get_batch, ttb_set_batch);
+    object_class_property_set_description(oc, "batch",
+        "File listing test ELFs to run one after another, one per line");
+    object_class_property_add_str(oc, "junit", ttb_get_junit, ttb_set_junit);
+    object_class_property_set_description(oc, "junit",
+        "Write the batch results as JUnit XML to this file");
+    object_class_property_add(oc, "batch-timeout", "uint32",
+                              ttb_get_batch_timeout, ttb_set_batch_timeout,
+                              NULL, NULL);
+    object_class_property_set_description(oc, "batch-timeout",
+        "Per test timeout in ms of virtual time, 0 disables it");
 }
 
-DEFINE_MACHINE("tricore_testboard", ttb_machine_init)
+static const TypeInfo ttb_machine_types[] = {
+    {
+        .name           = TYPE_TRICORE_TESTBOARD_MACHINE,
+        .parent         = TYPE_MACHINE,
+        .instance_size  = sizeof(TriCoreTestBoardMachineState),
+        .class_init     = ttb_machine_class_init,
+    },
+};
+
+DEFINE_TYPES(ttb_machine_types)
@@ -24,6 +24,13 @@
 static void tricore_testdevice_write(void *opaque, hwaddr offset,
                                       uint64_t value, unsigned size)
 {
+    TriCoreTestDeviceState *s = opaque;
+
+    if (s->result) {
+        s->result(s->result_opaque, value);
+        return;
+    }
+
     if (value != 0) {
         qemu_log_mask(LOG_GUEST_ERROR, "Test %" PRIu64 " failed!\n", value);
     }
@@ -11,32 +11,180 @@
 
 #include "qemu/osdep.h"
 #include "hw/sysbus.h"
+#include "target/tricore/cpu.h"
+#include "hw/qdev-properties-system.h"
+#include "migration/vmstate.h"
 #include "hw/tricore/tricore_virt.h"
+#include "exec/address-spaces.h"
+#include "qemu/main-loop.h"
+#include "sysemu/replay.h"
 #include <stdio.h>
 #include <inttypes.h>
 #include "qemu/log.h"
+#include "qemu/error-report.h"
+
+static void tricore_virt_output(TriCoreVIRTState *s, const uint8_t *buf,
+                                int len)
+{
+    if (qemu_chr_fe_backend_connected(&s->chr)) {
+        qemu_chr_fe_write_all(&s->chr, buf, len);
+    } else {
+        fwrite(buf, 1, len, stdout);
+    }
+}
+
+/* hand everything between tail and head over to the backend */
+static void tricore_virt_ring_drain(TriCoreVIRTState *s)
+{
+    AddressSpace *as = &address_space_memory;
+    MemTxAttrs attrs = MEMTXATTRS_UNSPECIFIED;
+    MemTxResult res, r;
+    uint32_t base, size, head, tail, len;
+    uint8_t buf[1024];
+
+    if (!s->ring_desc) {
+        return;
+    }
+
+    base = address_space_ldl_le(as, s->ring_desc + VIRT_RING_BASE, attrs,
+                                &res);
+    size = address_space_ldl_le(as, s->ring_desc + VIRT_RING_SIZE, attrs,
+                                &r);
+    res |= r;
+    head = address_space_ldl_le(as, s->ring_desc + VIRT_RING_HEAD, attrs,
+                                &r);
+    res |= r;
+    tail = address_space_ldl_le(as, s->ring_desc + VIRT_RING_TAIL, attrs,
+                                &r);
+    res |= r;
+
+    if (res != MEMTX_OK) {
+        qemu_log_mask(LOG_GUEST_ERROR, "tricore_virt: cannot read output "
+                      "ring descriptor at 0x%08x\n", s->ring_desc);
+        return;
+    }
+
+    if (!size || head >= size || tail >= size) {
+        qemu_log_mask(LOG_GUEST_ERROR, "tricore_virt: invalid output ring "
+                      "(size %u head %u tail %u)\n", size, head, tail);
+        return;
+    }
+
+    while (tail != head) {
+        len = MIN(head > tail ? head - tail : size - tail, sizeof(buf));
+        if (address_space_read(as, base + tail, attrs, buf, len)
+            != MEMTX_OK) {
+            qemu_log_mask(LOG_GUEST_ERROR, "tricore_virt: cannot read output "
+                          "ring at 0x%08x\n", base + tail);
+            break;
+        }
+        tricore_virt_output(s, buf, len);
+        tail = (tail + len) % size;
+    }
+
+    address_space_stl_le(as, s->ring_desc + VIRT_RING_TAIL, tail, attrs,
+                         NULL);
+    if (!qemu_chr_fe_backend_connected(&s->chr)) {
+        fflush(stdout);
+    }
+}
+
+static void tricore_virt_ring_bh(void *opaque)
+{
+    tricore_virt_ring_drain(opaque);
+}
+
+static void tricore_virt_wakeup(void *opaque)
+{
+    TriCoreVIRTState *s = opaque;
+
+    if (s->sleep_cpu) {
+        /* the halt request may not have been processed yet */
+        cpu_reset_interrupt(s->sleep_cpu, CPU_INTERRUPT_HALT);
+        s->sleep_cpu->halted = 0;
+        qemu_cpu_kick(s->sleep_cpu);
+        s->sleep_cpu = NULL;
+    }
+}
+
+/* runs with the vCPUs stopped, the guest continues from the new state */
+static void tricore_virt_snapshot(CPUState *cs, run_on_cpu_data data)
+{
+    TriCoreVIRTState *s = data.host_ptr;
+    Error *err = NULL;
+
+    bql_lock();
+    if (s->snapshot_op == VIRT_SNAPSHOT_TAKE) {
+        if (s->snapshot) {
+            tricore_snapshot_free(s->snapshot);
+        }
+        s->snapshot = tricore_snapshot_take(&err);
+    } else if (s->snapshot) {
+        tricore_snapshot_restore(s->snapshot, &err);
+    }
+    bql_unlock();
+
+    if (err) {
+        error_report_err(err);
+        exit(1);
+    }
+}
 
 static void tricore_virt_write(void *opaque, hwaddr offset, uint64_t value,
         unsigned size)
 {
+    TriCoreVIRTState *s = opaque;
+    uint8_t ch = value;
+
     switch (offset) {
+    case 0x0008:
+        s->ring_desc = value;
+        return;
+
+    case 0x000C:
+        /* the drain updates the tail in guest memory */
+        replay_bh_schedule_event(s->ring_bh);
+        return;
+
     case 0x0020:
+        /* keep the order with output still sitting in the ring */
+        tricore_virt_ring_drain(s);
         if (value != 0) {
-            fputc((char) value, stdout);
-        } else {
+            tricore_virt_output(s, &ch, 1);
+        } else if (!qemu_chr_fe_backend_connected(&s->chr)) {
             fflush(stdout);
         }
         return;
 
     case 0x0024:
-        if (value > 0) {
-            usleep(1000 * value);
-        } else {
-            usleep(1);
+        /*
+         * Sleep in virtual time: halt the CPU until the timer fires, so
+         * the vCPU thread idles and icount can warp over the delay.
+         */
+        if (current_cpu) {
+            s->sleep_cpu = current_cpu;
+            timer_mod(s->sleep_timer,
+                      qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL) +
+                      (value > 0 ? value * SCALE_MS : SCALE_US));
+            cpu_interrupt(current_cpu, CPU_INTERRUPT_HALT);
+        }
+        return;
+
+    case 0x002C:
+        /*
+         * The state is taken or restored once the current TB is left, so
+         * the guest should branch right after the write.
+         */
+        if (current_cpu && (value == VIRT_SNAPSHOT_TAKE ||
+                            value == VIRT_SNAPSHOT_RESTORE)) {
+            s->snapshot_op = value;
+            async_safe_run_on_cpu(current_cpu, tricore_virt_snapshot,
+                                  RUN_ON_CPU_HOST_PTR(s));
         }
         return;
 
     case 0x0028:
+        tricore_virt_ring_drain(s);
         printf(
             "tricore_virt_write: Target code wants to exit emulator with return code %d\n",
             (uint32_t)value);
@@ -50,6 +198,8 @@ static void tricore_virt_write(void *opaque, hwaddr offset, uint64_t value,
 
 static uint64_t tricore_virt_read(void *opaque, hwaddr offset, unsigned size)
 {
+    TriCoreVIRTState *s = opaque;
+
     switch (offset) {
     case 0x0000:
         return 0x00000100;
@@ -57,6 +207,12 @@ static uint64_t tricore_virt_read(void *opaque, hwaddr offset, unsigned size)
     case 0x0004:
         return 0x5533EE33;
 
+    case 0x0008:
+        return s->ring_desc;
+
+    case 0x002C:
+        return s->snapshot ? s->snapshot->restored_pages : 0;
+
     default:
         break;
     }
@@ -79,11 +235,66 @@ static void tricore_virt_init(Object *obj)
             "tricore_virt", 0x00000040);
 }
 
+static void tricore_virt_realize(DeviceState *dev, Error **errp)
+{
+    TriCoreVIRTState *s = TRICORE_VIRT(dev);
+
+    s->ring_bh = qemu_bh_new_guarded(tricore_virt_ring_bh, s,
+                                     &dev->mem_reentrancy_guard);
+    s->sleep_timer = timer_new_ns(QEMU_CLOCK_VIRTUAL, tricore_virt_wakeup, s);
+}
+
+static void tricore_virt_reset(DeviceState *dev)
+{
+    TriCoreVIRTState *s = TRICORE_VIRT(dev);
+
+    s->ring_desc = 0;
+    timer_del(s->sleep_timer);
+    tricore_virt_wakeup(s);
+}
+
+static int tricore_virt_post_load(void *opaque, int version_id)
+{
+    TriCoreVIRTState *s = opaque;
+
+    /* the boards have a single CPU, its halted state is part of the CPU */
+    s->sleep_cpu = timer_pending(s->sleep_timer) ? first_cpu : NULL;
+    return 0;
+}
+
+static const VMStateDescription vmstate_tricore_virt = {
+    .name = "tricore_virt",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .post_load = tricore_virt_post_load,
+    .fields = (const VMStateField[]) {
+        VMSTATE_UINT32(ring_desc, TriCoreVIRTState),
+        VMSTATE_TIMER_PTR(sleep_timer, TriCoreVIRTState),
+        VMSTATE_END_OF_LIST()
+    }
+};
+
+static Property tricore_virt_properties[] = {
+    DEFINE_PROP_CHR("chardev", TriCoreVIRTState, chr),
+    DEFINE_PROP_END_OF_LIST(),
+};
+
+static void tricore_virt_class_init(ObjectClass *klass, void *data)
+{
+    DeviceClass *dc = DEVICE_CLASS(klass);
+
+    device_class_set_props(dc, tricore_virt_properties);
+    dc->realize = tricore_virt_realize;
+    dc->legacy_reset = tricore_virt_reset;
+    dc->vmsd = &vmstate_tricore_virt;
+}
+
 static const TypeInfo tricore_virt_info = {
 	.name = TYPE_TRICORE_VIRT,
     .parent = TYPE_SYS_BUS_DEVICE,
 	.instance_size = sizeof(TriCoreVIRTState),
 	.instance_init = tricore_virt_init,
+    .class_init = tricore_virt_class_init,
 };
 
 static void tricore_virt_register_types(void)
@@ -34,9 +34,46 @@
 #define IR_SRC_STM1_SR1    106
 #define IR_SRC_STM2_SR0    107
 #define IR_SRC_STM2_SR1    108
+#define IR_SRC_GTM_TIM0_0  112
+#define IR_SRC_GTM_TOM0_0  120
+#define IR_SRC_GTM_ATOM0_0 128
+#define IR_SRC_CAN0_INT0   136
 #define IR_SRC_RESET       254
 
+#define IR_SRPN_COUNT      256
 
+/*
+ * Interrupt statistics of one SRPN. Latencies run from the service
+ * request to the ISR entry, durations from the entry to the RFE that
+ * returns from the ISR. Times are in virtual ns, instruction counts are
+ * only taken with -icount.
+ */
+typedef struct TriCoreIRQStats {
+    uint64_t entries;
+    uint64_t returns;
+    uint32_t max_nesting;
+
+    uint64_t latency_samples;
+    uint64_t latency_ns_min;
+    uint64_t latency_ns_max;
+    uint64_t latency_ns_total;
+    uint64_t latency_icount_max;
+    uint64_t latency_icount_total;
+
+    uint64_t duration_ns_min;
+    uint64_t duration_ns_max;
+    uint64_t duration_ns_total;
+    uint64_t duration_icount_max;
+    uint64_t duration_icount_total;
+} TriCoreIRQStats;
+
+/* an ISR the core is in, identified by the CSA its entry saved */
+typedef struct TriCoreIRQFrame {
+    uint32_t srpn;
+    uint32_t link;
+    int64_t entry_ns;
+    int64_t entry_icount;
+} TriCoreIRQFrame;
 
 typedef struct TriCoreIRBUSState {
     SysBusDevice parent_obj;
@@ -45,6 +82,16 @@ typedef struct TriCoreIRBUSState {
     uint32_t src_control_reg[IR_SRC_COUNT];
     uint8_t interruptstatusregs[IR_SRC_COUNT];
     qemu_irq parent_irq;
+
+    /* interrupt statistics, only kept with the irq-stats property set */
+    bool irq_stats_enabled;
+    TriCoreIRQStats irq_stats[IR_SRPN_COUNT];
+    int64_t irq_raise_ns[IR_SRPN_COUNT];
+    int64_t irq_raise_icount[IR_SRPN_COUNT];
+    TriCoreIRQFrame irq_frames[IR_SRPN_COUNT];
+    uint32_t irq_depth;
 } TriCoreIRBUSState;
 
+void tricore_irbus_reset_irq_stats(TriCoreIRBUSState *s);
+
 #endif
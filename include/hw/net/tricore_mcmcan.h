@@ -0,0 +1,71 @@
+/*
+ * QEMU model of the TriCore MCMCAN (M_CAN based) CAN controller.
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ */
+
+#ifndef HW_TRICORE_MCMCAN_H
+#define HW_TRICORE_MCMCAN_H
+
+#include "hw/sysbus.h"
+#include "hw/irq.h"
+#include "net/can_emu.h"
+
+#define TYPE_TRICORE_MCMCAN "tricore_mcmcan"
+#define TRICORE_MCMCAN(obj) \
+   OBJECT_CHECK(TriCoreMCMCANState, (obj), TYPE_TRICORE_MCMCAN)
+
+#define TRICORE_MCMCAN_NODES 4
+#define TRICORE_MCMCAN_NUM_INT 16
+#define TRICORE_MCMCAN_SIZE 0x10000
+#define TRICORE_MCMCAN_RAM_SIZE 0x8000
+#define TRICORE_MCMCAN_NODE_BASE 0x8100
+#define TRICORE_MCMCAN_NODE_STRIDE 0x400
+#define TRICORE_MCMCAN_NODE_R_MAX (0x200 / 4)
+
+#define RESET_TRICORE_MCMCAN_CLC 0x00000003
+#define RESET_TRICORE_MCMCAN_ID 0x00B9C000
+#define RESET_TRICORE_MCMCAN_FREQUENCY 80000000
+
+typedef struct TriCoreMCMCANNode {
+    struct TriCoreMCMCANState *mcmcan;
+    CanBusClientState bus_client;
+
+    /* TC3xx node registers at 0x000, the M_CAN core at 0x100 */
+    uint32_t regs[TRICORE_MCMCAN_NODE_R_MAX];
+
+    /* get index of the TX FIFO, in absolute buffer numbers */
+    uint32_t txf_gi;
+    int64_t ts_start_ns;
+} TriCoreMCMCANNode;
+
+typedef struct TriCoreMCMCANState {
+    /* <private> */
+    SysBusDevice parent_obj;
+
+    /* <public> */
+    MemoryRegion iomem;
+    MemoryRegion regs;
+    /* plain RAM, the CPU accesses it without trapping into the model */
+    MemoryRegion msgram;
+
+    uint32_t CLC;
+    uint32_t MCR;
+
+    TriCoreMCMCANNode node[TRICORE_MCMCAN_NODES];
+
+    /* frames received within one main loop iteration raise one interrupt */
+    QEMUBH *irq_bh;
+    bool irq_bh_pending;
+    qemu_irq irq[TRICORE_MCMCAN_NUM_INT];
+
+    /* properties */
+    CanBusState *canbus[TRICORE_MCMCAN_NODES];
+    uint32_t freq_hz;
+} TriCoreMCMCANState;
+
+#endif
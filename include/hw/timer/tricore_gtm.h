@@ -0,0 +1,173 @@
+/*
+ * QEMU model of the TriCore GTM (Generic Timer Module).
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ */
+
+#ifndef HW_TRICORE_GTM_H
+#define HW_TRICORE_GTM_H
+
+#include "hw/sysbus.h"
+#include "hw/irq.h"
+#include "qemu/timer.h"
+
+#define TYPE_TRICORE_GTM "tricore_gtm"
+#define TRICORE_GTM(obj) \
+   OBJECT_CHECK(TriCoreGTMState, (obj), TYPE_TRICORE_GTM)
+
+#define TRICORE_GTM_SIZE 0x20000
+
+/* upper limits, the number of instances is set through properties */
+#define GTM_TIM_MAX 8
+#define GTM_TOM_MAX 6
+#define GTM_ATOM_MAX 12
+#define GTM_TIM_CHANNELS 8
+#define GTM_TOM_CHANNELS 16
+#define GTM_ATOM_CHANNELS 8
+#define GTM_CMU_CLK_NUM 8
+#define GTM_CMU_FXCLK_NUM 5
+
+/* module offsets and strides */
+#define GTM_CMU_BASE 0x300
+#define GTM_TBU_BASE 0x400
+#define GTM_TIM_BASE 0x1000
+#define GTM_TOM_BASE 0x8000
+#define GTM_ATOM_BASE 0xD000
+#define GTM_MODULE_STRIDE 0x800
+#define GTM_TIM_CH_STRIDE 0x80
+#define GTM_TOM_CH_STRIDE 0x40
+#define GTM_ATOM_CH_STRIDE 0x80
+
+#define MASK_GTM_CTRL_SL 0x00000800
+#define MASK_GTM_CTRL_CLK_SRC 0x00007000
+#define MASK_GTM_ATOM_CTRL_MODE 0x00000003
+#define GTM_ATOM_MODE_SOMP 2
+#define MASK_GTM_IRQ_CCU0TC 0x1
+#define MASK_GTM_IRQ_CCU1TC 0x2
+#define MASK_GTM_TGC_HOST_TRIG 0x00000001
+#define MASK_GTM_TGC_RST_CH 0x0000FF00
+
+#define MASK_GTM_TIM_CTRL_EN 0x00000001
+#define MASK_GTM_TIM_CTRL_MODE 0x0000000E
+#define MASK_GTM_TIM_CTRL_DSL 0x00000080
+#define MASK_GTM_TIM_CTRL_CLK_SEL 0x07000000
+#define GTM_TIM_MODE_TPWM 0
+#define GTM_TIM_MODE_TIEM 2
+#define MASK_GTM_TIM_IRQ_NEWVAL 0x1
+#define MASK_GTM_TIM_IRQ_ECNTOFL 0x2
+
+#define RESET_TRICORE_GTM_REV 0x00000000
+#define RESET_TRICORE_GTM_CMU_GCLK 0x1
+#define RESET_TRICORE_GTM_FREQUENCY 100000000
+
+/*
+ * TOM and ATOM channels in PWM mode. The counter is never ticked: CN0 is
+ * derived from QEMU_CLOCK_VIRTUAL relative to (start_ns, start_cn0), and
+ * the timer is only armed for the next compare event somebody observes,
+ * i.e. an enabled interrupt, a connected output or a pending shadow
+ * register transfer.
+ */
+typedef struct TriCoreGTMChannel {
+    struct TriCoreGTMState *gtm;
+    bool atom;
+
+    uint32_t RDADDR;
+    uint32_t CTRL;
+    uint32_t SR0;
+    uint32_t SR1;
+    uint32_t CM0;
+    uint32_t CM1;
+    uint32_t IRQ_NOTIFY;
+    uint32_t IRQ_EN;
+    uint32_t IRQ_MODE;
+
+    bool enabled;
+    bool outen;
+    bool upen;
+    bool level;
+
+    QEMUTimer *timer;
+    int64_t start_ns;
+    int64_t next_ns;
+    uint32_t start_cn0;
+    uint32_t freq;
+    uint32_t next_ccu;
+
+    qemu_irq *out;
+    qemu_irq *irq;
+    struct TriCoreGTMChannel *pair;
+} TriCoreGTMChannel;
+
+/* TIM channels only react on edges of their input line */
+typedef struct TriCoreGTMTIMChannel {
+    struct TriCoreGTMState *gtm;
+
+    uint32_t GPR0;
+    uint32_t GPR1;
+    uint32_t ECNT;
+    uint32_t CNTS;
+    uint32_t CTRL;
+    uint32_t IRQ_NOTIFY;
+    uint32_t IRQ_EN;
+    uint32_t IRQ_MODE;
+
+    bool level;
+    bool started;
+    int64_t start_ns;
+    uint32_t pulse;
+
+    qemu_irq irq;
+} TriCoreGTMTIMChannel;
+
+typedef struct TriCoreGTMTGC {
+    uint32_t ACT_TB;
+    uint32_t FUPD_CTRL;
+    uint32_t INT_TRIG;
+    uint32_t ENDIS_CTRL;
+    uint32_t OUTEN_CTRL;
+} TriCoreGTMTGC;
+
+typedef struct TriCoreGTMState {
+    /* <private> */
+    SysBusDevice parent_obj;
+
+    /* <public> */
+    MemoryRegion iomem;
+
+    /* CMU */
+    uint32_t CMU_CLK_EN;
+    uint32_t CMU_GCLK_NUM;
+    uint32_t CMU_GCLK_DEN;
+    uint32_t CMU_CLK_CTRL[GTM_CMU_CLK_NUM];
+    uint32_t CMU_FXCLK_CTRL;
+
+    /* TBU, only channel 0 is modelled */
+    uint32_t TBU_CHEN;
+    uint32_t TBU_CH0_CTRL;
+    uint32_t tbu_start_base;
+    int64_t tbu_start_ns;
+
+    TriCoreGTMTIMChannel tim[GTM_TIM_MAX][GTM_TIM_CHANNELS];
+    TriCoreGTMChannel tom[GTM_TOM_MAX][GTM_TOM_CHANNELS];
+    TriCoreGTMChannel atom[GTM_ATOM_MAX][GTM_ATOM_CHANNELS];
+    TriCoreGTMTGC tom_tgc[GTM_TOM_MAX][GTM_TOM_CHANNELS / 8];
+    TriCoreGTMTGC atom_agc[GTM_ATOM_MAX];
+
+    /* channel pairs share one service request, as on hardware */
+    qemu_irq tom_irq[GTM_TOM_MAX][GTM_TOM_CHANNELS / 2];
+    qemu_irq atom_irq[GTM_ATOM_MAX][GTM_ATOM_CHANNELS / 2];
+    qemu_irq tom_out[GTM_TOM_MAX * GTM_TOM_CHANNELS];
+    qemu_irq atom_out[GTM_ATOM_MAX * GTM_ATOM_CHANNELS];
+
+    /* properties */
+    uint32_t freq_hz;
+    uint32_t num_tim;
+    uint32_t num_tom;
+    uint32_t num_atom;
+} TriCoreGTMState;
+
+#endif
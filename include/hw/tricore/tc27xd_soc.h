@@ -33,6 +33,7 @@
 #include "hw/tricore/tricore_sfr.h"
 #include "hw/intc/tricore_irbus.h"
 #include "hw/timer/tricore_stm.h"
+#include "hw/timer/tricore_gtm.h"
 #include "hw/char/tricore_asclin.h"
 #include "hw/tricore/tc_soc.h"
 
@@ -88,6 +89,7 @@ typedef struct TC27XDSoCState {
     TriCoreVIRTState *virt;
     TriCoreSCUState *scu;
     TriCoreSTMState *stm;
+    TriCoreGTMState *gtm;
     TriCoreASCLINState *asclin;
     TriCoreSFRState *sfr;
 
@@ -141,6 +143,7 @@ enum {
     TC27XD_SCU,
     TC27XD_STM,
     TC27XD_ASCLIN,
+    TC27XD_GTM,
 };
 
 #endif
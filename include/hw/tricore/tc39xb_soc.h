@@ -31,8 +31,11 @@
 #include "hw/tricore/tricore_ir.h"
 #include "hw/tricore/tricore_scu.h"
 #include "hw/tricore/tricore_sfr.h"
+#include "hw/tricore/tricore_sri.h"
 #include "hw/intc/tricore_irbus.h"
 #include "hw/timer/tricore_stm.h"
+#include "hw/timer/tricore_gtm.h"
+#include "hw/net/tricore_mcmcan.h"
 #include "hw/char/tricore_asclin.h"
 #include "hw/tricore/tc_soc.h"
 
@@ -109,12 +112,19 @@ typedef struct TC39XBSoCState {
     TriCoreVIRTState *virt;
     TriCoreSCUState *scu;
     TriCoreSTMState *stm;
+    TriCoreGTMState *gtm;
+    TriCoreMCMCANState *mcmcan;
     TriCoreSFRState *sfr;
     TriCoreASCLINState *asclin;
 
     qemu_irq irq[IR_SRC_COUNT];
     qemu_irq *cpu_irq;
 
+    /* optional SRI crossbar timing model */
+    bool sri_timing;
+    TriCoreSRIState sri;
+
+    CanBusState *canbus[TRICORE_MCMCAN_NODES];
 
 } TC39XBSoCState;
 
@@ -125,6 +135,7 @@ typedef struct TC39XBSoCClass {
     const char *cpu_type;
     const MemmapEntry *memmap;
     uint32_t num_cpus;
+    const TriCoreSRICosts *sri_costs;
 } TC39XBSoCClass;
 
 enum {
@@ -159,6 +170,8 @@ enum {
     TC39XB_SCU,
     TC39XB_STM,
     TC39XB_ASCLIN,
+    TC39XB_GTM,
+    TC39XB_MCMCAN0,
 };
 
 #endif
@@ -28,6 +28,7 @@
 #include "hw/tricore/tc1798_soc.h"
 #include "hw/tricore/tc27xd_soc.h"
 #include "hw/tricore/tc39xb_soc.h"
+#include "hw/tricore/tricore_forkserver.h"
 
 #define TYPE_TRIBOARD_MACHINE MACHINE_TYPE_NAME("triboard")
 typedef struct TriBoardMachineState TriBoardMachineState;
@@ -42,6 +43,10 @@ struct TriBoardMachineState {
     TC1798SoCState tc1798_soc;
     TC27XDSoCState tc27xd_soc;
     TC39XBSoCState tc39xb_soc;
+
+    CanBusState *canbus[TRICORE_MCMCAN_NODES];
+
+    TriCoreForkServer forkserver;
 };
 
 struct TriBoardMachineClass {
@@ -0,0 +1,61 @@
+/*
+ * TriCore fork-server for the TriBoard machines.
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ */
+
+#ifndef HW_TRICORE_FORKSERVER_H
+#define HW_TRICORE_FORKSERVER_H
+
+#include "sysemu/runstate.h"
+
+#define TRICORE_FORKSERVER_INPUT_MAX (64 * KiB)
+
+/*
+ * The machine is built and the firmware loaded once, then it stays in the
+ * prelaunch state while the main loop keeps running. A single client
+ * connects to a unix socket and the server forks one copy-on-write child
+ * per request, which starts the VM. The children inherit all fds, so every
+ * chardev, including those of monitors and serial ports, must use the null
+ * backend, e.g. -nodefaults -serial null.
+ *
+ * Protocol, all words are 32 bit little endian:
+ *   client: <len> <len bytes of input>
+ *   server: <pid of the child>
+ *   server: <wait status of the child, see waitpid(2)>
+ *
+ * If an input address is configured, the child stores <len> at that guest
+ * address and the input right behind it before the CPU starts. This can
+ * be plain RAM the firmware parses from, e.g. an RX buffer element in the
+ * MCMCAN message RAM, so the input is in place independent of any host
+ * timing. With -icount the guest runs deterministically from there. A child
+ * ends when the guest exits QEMU, e.g. through the virt device. The server
+ * exits when the client closes the connection.
+ */
+typedef struct TriCoreForkServer {
+    /* properties */
+    char *path;
+    uint64_t input_addr;
+    uint32_t input_max;
+
+    int listen_fd;
+    int conn_fd;
+    /* request being received, the length word first */
+    uint32_t len_le;
+    uint8_t *input;
+    uint32_t pos;
+    /* child serving the last request, its pipe reports its exit */
+    pid_t child_pid;
+    int child_fd;
+    bool is_child;
+    VMChangeStateEntry *vmse;
+} TriCoreForkServer;
+
+void tricore_forkserver_init(TriCoreForkServer *fs);
+void tricore_forkserver_setup(TriCoreForkServer *fs, Error **errp);
+
+#endif
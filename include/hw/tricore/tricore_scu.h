@@ -15,6 +15,7 @@
 #include "hw/sysbus.h"
 #include "hw/hw.h"
 #include "hw/irq.h"
+#include "qemu/timer.h"
 
 #define TYPE_TRICORE_SCU "tricore_scu"
 #define TRICORE_SCU(obj) \
@@ -44,6 +45,22 @@
 #define MASK_PLLSTAT_VCOBYST 0x1
 #define MASK_PLLSTAT_VCOLOCK 0x00000004
 #define MASK_PLLSTAT_FINDIS 0x00000008
+#define MASK_WDTCON0_ENDINIT 0x00000001
+#define MASK_WDTCON0_LCK 0x00000002
+#define MASK_WDTCON0_PW 0x0000FFFC
+#define MASK_WDTCON0_REL 0xFFFF0000
+#define MASK_WDTCON0_PW_INV 0x000000FC
+#define MASK_WDTCON1_IR0 0x00000004
+#define MASK_WDTCON1_DR 0x00000008
+#define MASK_WDTCON1_IR1 0x00000020
+#define MASK_WDTSR_AE 0x00000001
+#define MASK_WDTSR_OE 0x00000002
+#define MASK_WDTSR_IS0 0x00000004
+#define MASK_WDTSR_DS 0x00000008
+#define MASK_WDTSR_TO 0x00000010
+#define MASK_WDTSR_IS1 0x00000020
+#define MASK_WDTSR_TIM 0xFFFF0000
+#define WDT_TIMEOUT_COUNT 0xFFFC
 #define SCU_FBACKUP 100000000
 #define SCU_XTAL1 20000000
 
@@ -70,11 +87,29 @@
 #define RESET_TRICORE_WDTSCON0 0xFFFC000E
 #define RESET_TRICORE_WDTSCON1 0x0
 #define RESET_TRICORE_WDTCPU0CON0 0xFFFC000E
+#define RESET_TRICORE_WDTCPU0CON1 0x0
+#define RESET_TRICORE_WDTSR 0xFFFC0010
 
 typedef enum {
     TRICORE_SCU_NORMAL, TRICORE_SCU_FREERUNNING, TRICORE_SCU_PRESCALER
 } TriCore_SCU_Mode_Type;
 
+typedef enum {
+    TRICORE_SCU_WDT_CPU0, TRICORE_SCU_WDT_SAFETY, TRICORE_SCU_WDT_NUM
+} TriCore_SCU_WDT_Type;
+
+typedef struct {
+    uint32_t CON0;
+    uint32_t CON1;
+    uint32_t SR;
+
+    /* the counter runs from start_count at start_ns up to the overflow */
+    QEMUTimer *timer;
+    bool running;
+    int64_t start_ns;
+    uint32_t start_count;
+} TriCoreSCUWDTState;
+
 typedef struct {
     /* <private> */
     SysBusDevice parent_obj;
@@ -96,9 +131,10 @@ typedef struct {
     uint32_t EXTCON;
 
     /* SCU registers */
-    uint32_t WDTSCON0;
-    uint32_t WDTSCON1;
-    uint32_t WDTCPU0CON0;
+    TriCoreSCUWDTState wdt[TRICORE_SCU_WDT_NUM];
+
+    /* properties */
+    bool watchdog;
 
 } TriCoreSCUState;
 
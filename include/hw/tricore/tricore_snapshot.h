@@ -0,0 +1,47 @@
+/*
+ * In-process snapshots of TriCore machines.
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ */
+
+#ifndef HW_TRICORE_SNAPSHOT_H
+#define HW_TRICORE_SNAPSHOT_H
+
+#include "exec/cpu-common.h"
+
+typedef struct TriCoreSnapshotBlock {
+    RAMBlock *rb;
+    ram_addr_t offset;
+    ram_addr_t size;
+    uint8_t *data;
+} TriCoreSnapshotBlock;
+
+/*
+ * A copy of all RAM blocks and the vmstate of all devices, including
+ * the CPUs. While a snapshot exists, writes to RAM are logged through the
+ * DIRTY_MEMORY_VGA client, so a restore only copies back the target pages
+ * written since the snapshot was taken or last restored.
+ *
+ * Both functions must be called with all vCPUs stopped, e.g. from a safe
+ * work item, and with the BQL held.
+ */
+typedef struct TriCoreSnapshot {
+    GArray *blocks;
+
+    /* the stream qemu_save_device_state() wrote */
+    uint8_t *devices;
+    size_t devices_size;
+
+    /* pages copied back by the last restore */
+    uint64_t restored_pages;
+} TriCoreSnapshot;
+
+TriCoreSnapshot *tricore_snapshot_take(Error **errp);
+int tricore_snapshot_restore(TriCoreSnapshot *snap, Error **errp);
+void tricore_snapshot_free(TriCoreSnapshot *snap);
+
+#endif
@@ -0,0 +1,65 @@
+/*
+ * QEMU TriCore SRI crossbar timing model.
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or later.
+ * See the COPYING file in the top-level directory.
+ *
+ */
+
+#ifndef HW_TRICORE_SRI_H
+#define HW_TRICORE_SRI_H
+
+#include "target/tricore/cpu.h"
+
+#define TRICORE_SRI_MAX_CORES 6
+
+/*
+ * Access targets as seen from the accessing core. Scratchpads and DLMUs
+ * are split into local and remote, as the crossbar only adds latency
+ * when a core leaves its own tile.
+ */
+typedef enum {
+    TRICORE_SRI_LOCAL_DSPR,
+    TRICORE_SRI_LOCAL_PSPR,
+    TRICORE_SRI_REMOTE_DSPR,
+    TRICORE_SRI_REMOTE_PSPR,
+    TRICORE_SRI_LOCAL_DLMU,
+    TRICORE_SRI_REMOTE_DLMU,
+    TRICORE_SRI_LMU,
+    TRICORE_SRI_PFLASH,
+    TRICORE_SRI_DFLASH,
+    TRICORE_SRI_SPB,
+    TRICORE_SRI_OTHER,
+    TRICORE_SRI_TARGET_COUNT
+} TriCoreSRITarget;
+
+/* stall cycles per access, in CPU clock cycles */
+typedef struct {
+    uint8_t read[TRICORE_SRI_TARGET_COUNT];
+    uint8_t write[TRICORE_SRI_TARGET_COUNT];
+} TriCoreSRICosts;
+
+/*
+ * SoC specific address decoder: returns the target type of @addr and
+ * stores the core owning it in @owner, or -1 for shared targets.
+ */
+typedef TriCoreSRITarget (*TriCoreSRIClassifyFn)(uint32_t addr, int *owner);
+
+typedef struct {
+    const TriCoreSRICosts *costs;
+    TriCoreSRIClassifyFn classify;
+    uint32_t num_cores;
+
+    uint64_t accesses[TRICORE_SRI_MAX_CORES][TRICORE_SRI_TARGET_COUNT];
+    uint64_t stall_cycles[TRICORE_SRI_MAX_CORES][TRICORE_SRI_TARGET_COUNT];
+} TriCoreSRIState;
+
+void tricore_sri_init(TriCoreSRIState *s, const TriCoreSRICosts *costs,
+                      TriCoreSRIClassifyFn classify, uint32_t num_cores);
+void tricore_sri_attach_cpu(TriCoreSRIState *s, TriCoreCPU *cpu);
+void tricore_sri_reset_stats(TriCoreSRIState *s);
+char *tricore_sri_format_histogram(TriCoreSRIState *s);
+
+#endif
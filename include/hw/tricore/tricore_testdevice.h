@@ -24,10 +24,16 @@
 #define TRICORE_TESTDEVICE(obj) \
     OBJECT_CHECK(TriCoreTestDeviceState, (obj), TYPE_TRICORE_TESTDEVICE)
 
+/* called with the value written by the test instead of exiting QEMU */
+typedef void (*TriCoreTestResultFn)(void *opaque, uint32_t value);
+
 typedef struct {
     SysBusDevice parent_obj;
 
     MemoryRegion iomem;
+
+    TriCoreTestResultFn result;
+    void *result_opaque;
 } TriCoreTestDeviceState;
 
 #endif
@@ -15,12 +15,32 @@
 
 #include "hw/sysbus.h"
 #include "hw/hw.h"
+#include "chardev/char-fe.h"
+#include "qemu/timer.h"
+#include "hw/tricore/tricore_snapshot.h"
 
 #define TYPE_TRICORE_VIRT "tricore_virt"
 #define TRICORE_VIRT(obj) \
    OBJECT_CHECK(TriCoreVIRTState, (obj), TYPE_TRICORE_VIRT)
 #define NUM_CORES 1
 
+/*
+ * Output ring descriptor in guest memory, all fields little endian:
+ *   +0x0 base  address of the data buffer
+ *   +0x4 size  size of the data buffer in bytes
+ *   +0x8 head  write offset, advanced by the guest
+ *   +0xC tail  read offset, advanced by QEMU once the data is drained
+ * The ring is empty when head == tail.
+ */
+#define VIRT_RING_BASE 0x0
+#define VIRT_RING_SIZE 0x4
+#define VIRT_RING_HEAD 0x8
+#define VIRT_RING_TAIL 0xC
+
+/* values written to the snapshot register */
+#define VIRT_SNAPSHOT_TAKE    1
+#define VIRT_SNAPSHOT_RESTORE 2
+
 typedef struct {
     /* <private> */
     SysBusDevice parent_obj;
@@ -28,6 +48,15 @@ typedef struct {
     /* <public> */
     MemoryRegion iomem;
 
+    CharBackend chr;
+    uint32_t ring_desc;
+    QEMUBH *ring_bh;
+
+    QEMUTimer *sleep_timer;
+    CPUState *sleep_cpu;
+
+    TriCoreSnapshot *snapshot;
+    uint32_t snapshot_op;
 } TriCoreVIRTState;
 
 #endif
@@ -0,0 +1,60 @@
+/*
+ * IEEE 802.3 CRC-32 and table driven CRCs of arbitrary width
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef QEMU_CRC32_H
+#define QEMU_CRC32_H
+
+/**
+ * crc32_ieee:
+ * @crc: CRC of the preceding data, 0 to start
+ * @buf: data
+ * @len: length of @buf in bytes
+ *
+ * Computes the reflected CRC-32 of polynomial 0x04c11db7 over @buf, with
+ * the same result as zlib's crc32(). Uses the host's CRC or carry-less
+ * multiply instructions where available.
+ */
+uint32_t crc32_ieee(uint32_t crc, const void *buf, size_t len);
+
+/*
+ * Selects the next slower implementation of crc32_ieee(), returns false
+ * if there is none. For the tests and benchmarks only.
+ */
+bool test_crc32_ieee_next_accel(void);
+
+/*
+ * Table for a CRC of @width bits which shifts in the data MSB first,
+ * without inverting or reflecting anything.
+ */
+typedef struct CRCTable {
+    uint32_t tab[256];
+    unsigned width;
+    uint32_t poly;
+} CRCTable;
+
+/**
+ * crc_table_init:
+ * @t: table to fill
+ * @width: width of the CRC, 1 to 32
+ * @poly: generator polynomial without the x^@width term
+ */
+void crc_table_init(CRCTable *t, unsigned width, uint32_t poly);
+
+/**
+ * crc_table_update:
+ * @t: table of the CRC
+ * @crc: CRC of the preceding data
+ * @data: data, in the low @bits bits
+ * @bits: number of data bits, 1 to 32
+ *
+ * Returns the CRC after shifting in @data MSB first.
+ */
+uint32_t crc_table_update(const CRCTable *t, uint32_t crc, uint32_t data,
+                          unsigned bits);
+
+#endif
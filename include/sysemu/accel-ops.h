@@ -38,6 +38,11 @@ struct AccelOpsClass {
     void (*cpu_reset_hold)(CPUState *cpu);
 
     void (*create_vcpu_thread)(CPUState *cpu); /* MANDATORY NON-NULL */
+    /*
+     * Recreate the vcpu threads in a child process after fork(), which
+     * only copies the calling thread. Optional, used by a fork-server.
+     */
+    void (*restart_vcpu_threads)(void);
     void (*kick_vcpu_thread)(CPUState *cpu);
     bool (*cpu_thread_is_idle)(CPUState *cpu);
 
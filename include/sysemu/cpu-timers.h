@@ -43,6 +43,14 @@ extern ICountMode use_icount;
  */
 void icount_update(CPUState *cpu);
 
+/*
+ * Charge @count extra instructions to the running vCPU, e.g. for stall
+ * cycles of a target bus model. They advance the icount at the next
+ * icount_update() without moving the exit of the current TB. Ignored
+ * under record/replay, which positions its events by the icount.
+ */
+void icount_charge(CPUState *cpu, int64_t count);
+
 /* get raw icount value */
 int64_t icount_get_raw(void);
 
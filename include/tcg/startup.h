@@ -45,6 +45,17 @@ void tcg_init(size_t tb_size, int splitwx, unsigned max_cpus);
  */
 void tcg_register_thread(void);
 
+/**
+ * tcg_register_thread_after_fork: Take over the context of a lost thread
+ * @n: index of the context in tcg_ctxs[]
+ *
+ * fork() only duplicates the calling thread. A thread created in the
+ * child to replace a TCG thread of the parent reuses that thread's
+ * context, which was copied along with the rest of the heap, as all
+ * tcg_max_ctxs contexts have been handed out already. System mode only.
+ */
+void tcg_register_thread_after_fork(unsigned int n);
+
 /**
  * tcg_prologue_init(): Generate the code for the TCG prologue
  *
@@ -1998,6 +1998,20 @@ static inline void init_thread(struct target_pt_regs *regs,
 
 #endif /* TARGET_HEXAGON */
 
+#ifdef TARGET_TRICORE
+
+#define ELF_CLASS       ELFCLASS32
+#define ELF_ARCH        EM_TRICORE
+
+static inline void init_thread(struct target_pt_regs *regs,
+                               struct image_info *infop)
+{
+    regs->pc = infop->entry;
+    regs->sp = infop->start_stack;
+}
+
+#endif /* TARGET_TRICORE */
+
 #ifndef ELF_BASE_PLATFORM
 #define ELF_BASE_PLATFORM (NULL)
 #endif
@@ -74,7 +74,8 @@
     || defined(TARGET_M68K)                                             \
     || defined(TARGET_S390X) || defined(TARGET_OPENRISC)                \
     || defined(TARGET_RISCV)                                            \
-    || defined(TARGET_XTENSA) || defined(TARGET_LOONGARCH64)
+    || defined(TARGET_XTENSA) || defined(TARGET_LOONGARCH64)            \
+    || defined(TARGET_TRICORE)
 
 #define TARGET_IOC_SIZEBITS     14
 #define TARGET_IOC_DIRBITS      2
@@ -1975,7 +1976,8 @@ struct target_stat64  {
 };
 
 #elif defined(TARGET_OPENRISC) \
-    || defined(TARGET_RISCV) || defined(TARGET_HEXAGON) || defined(TARGET_LOONGARCH)
+    || defined(TARGET_RISCV) || defined(TARGET_HEXAGON) || defined(TARGET_LOONGARCH) \
+    || defined(TARGET_TRICORE)
 
 /* These are the asm-generic versions of the stat and stat64 structures */
 
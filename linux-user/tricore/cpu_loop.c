@@ -0,0 +1,150 @@
+/*
+ *  qemu user cpu loop
+ *
+ *  Copyright (c) 2003-2008 Fabrice Bellard
+ *  Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "qemu/osdep.h"
+#include "qemu.h"
+#include "user-internals.h"
+#include "user-mmap.h"
+#include "qemu/error-report.h"
+#include "cpu_loop-common.h"
+#include "signal-common.h"
+
+/* the signal a trap other than SYSCALL raises */
+static void tricore_trap_signal(CPUTriCoreState *env)
+{
+    switch (env->trap_class) {
+    case TRAPC_PROT:
+        if (env->trap_tin == TIN1_PRIV) {
+            force_sig_fault(TARGET_SIGILL, TARGET_ILL_PRVOPC, env->PC);
+        } else {
+            force_sig_fault(TARGET_SIGSEGV, TARGET_SEGV_ACCERR, env->PC);
+        }
+        break;
+    case TRAPC_INSN_ERR:
+        switch (env->trap_tin) {
+        case TIN2_OPD:
+            force_sig_fault(TARGET_SIGILL, TARGET_ILL_ILLOPN, env->PC);
+            break;
+        case TIN2_ALN:
+            force_sig_fault(TARGET_SIGBUS, TARGET_BUS_ADRALN, env->PC);
+            break;
+        case TIN2_MEM:
+            force_sig_fault(TARGET_SIGSEGV, TARGET_SEGV_MAPERR, env->PC);
+            break;
+        default:
+            force_sig_fault(TARGET_SIGILL, TARGET_ILL_ILLOPC, env->PC);
+            break;
+        }
+        break;
+    case TRAPC_SYSBUS:
+        force_sig_fault(TARGET_SIGBUS, TARGET_BUS_ADRERR, env->PC);
+        break;
+    case TRAPC_ASSERT:
+        force_sig_fault(TARGET_SIGFPE, TARGET_FPE_INTOVF, env->PC);
+        break;
+    default:
+        /* the context management traps mean the CSA list is exhausted */
+        force_sig_fault(TARGET_SIGSEGV, TARGET_SEGV_MAPERR, env->PC);
+        break;
+    }
+}
+
+void cpu_loop(CPUTriCoreState *env)
+{
+    CPUState *cs = env_cpu(env);
+    int trapnr;
+    abi_long ret;
+
+    for (;;) {
+        cpu_exec_start(cs);
+        trapnr = cpu_exec(cs);
+        cpu_exec_end(cs);
+        process_queued_cpu_work(cs);
+
+        switch (trapnr) {
+        case EXCP_TRAP:
+            if (env->trap_class != TRAPC_SYSCALL) {
+                tricore_trap_signal(env);
+                break;
+            }
+            env->PC += 4;
+            ret = do_syscall(env, env->trap_tin,
+                             env->gpr_d[4], env->gpr_d[5],
+                             env->gpr_d[6], env->gpr_d[7],
+                             env->gpr_d[2], env->gpr_d[3], 0, 0);
+            if (ret == -QEMU_ERESTARTSYS) {
+                env->PC -= 4;
+            } else if (ret != -QEMU_ESIGRETURN) {
+                env->gpr_d[2] = ret;
+            }
+            break;
+        case EXCP_SEMIHOST:
+            tricore_semihosting(env);
+            break;
+        case EXCP_INTERRUPT:
+            /* just indicate that signals should be handled asap */
+            break;
+        case EXCP_DEBUG:
+            force_sig_fault(TARGET_SIGTRAP, TARGET_TRAP_BRKPT, env->PC);
+            break;
+        case EXCP_ATOMIC:
+            cpu_exec_step_atomic(cs);
+            break;
+        default:
+            EXCP_DUMP(env, "\nqemu: unhandled CPU exception %#x - aborting\n",
+                      trapnr);
+            exit(EXIT_FAILURE);
+        }
+        process_pending_signals(env);
+    }
+}
+
+void target_cpu_copy_regs(CPUArchState *env, struct target_pt_regs *regs)
+{
+    abi_ulong csa;
+    uint32_t link = 0;
+    int i;
+
+    env->PC = regs->pc;
+    env->gpr_a[10] = regs->sp;
+
+    /*
+     * Link the default CSAs into the free list, back to front. LCX stays
+     * 0, FCU signals the end of the list and there is no FCD.
+     */
+    csa = target_mmap(TRICORE_CSA_BASE, TRICORE_CSA_COUNT * 64,
+                      PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                      -1, 0);
+    if (csa != TRICORE_CSA_BASE) {
+        error_report("tricore: cannot map the CSA area at 0x%x",
+                     TRICORE_CSA_BASE);
+        exit(EXIT_FAILURE);
+    }
+    for (i = TRICORE_CSA_COUNT - 1; i >= 0; i--) {
+        abi_ulong ea = csa + i * 64;
+
+        put_user_u32(link, ea);
+        link = ((ea >> 12) & MASK_FCX_FCXS) | ((ea >> 6) & MASK_FCX_FCXO);
+    }
+    env->FCX = link;
+    env->LCX = 0;
+    env->PCXI = 0;
+}
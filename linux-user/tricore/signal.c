@@ -0,0 +1,222 @@
+/*
+ *  Emulation of Linux signals
+ *
+ *  Copyright (c) 2003 Fabrice Bellard
+ *  Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program; if not, see <http://www.gnu.org/licenses/>.
+ */
+#include "qemu/osdep.h"
+#include "qemu.h"
+#include "user-internals.h"
+#include "signal-common.h"
+#include "linux-user/trace.h"
+
+typedef struct target_sigcontext {
+    abi_ulong d[16];
+    abi_ulong a[16];
+    abi_ulong pc;
+    abi_ulong psw;
+    abi_ulong pcxi;
+    abi_ulong fcx;
+} target_sigcontext;
+
+typedef struct target_ucontext {
+    abi_ulong tuc_flags;
+    abi_ulong tuc_link;
+    target_stack_t tuc_stack;
+    target_sigcontext tuc_mcontext;
+    target_sigset_t tuc_sigmask;   /* mask last for extensibility */
+} target_ucontext;
+
+typedef struct target_rt_sigframe {
+    struct target_siginfo info;
+    target_ucontext uc;
+} target_rt_sigframe;
+
+static void setup_sigcontext(target_sigcontext *sc, CPUTriCoreState *env)
+{
+    int i;
+
+    for (i = 0; i < 16; ++i) {
+        __put_user(env->gpr_d[i], &sc->d[i]);
+        __put_user(env->gpr_a[i], &sc->a[i]);
+    }
+    __put_user(env->PC, &sc->pc);
+    __put_user(psw_read(env), &sc->psw);
+    __put_user(env->PCXI, &sc->pcxi);
+    __put_user(env->FCX, &sc->fcx);
+}
+
+static void restore_sigcontext(CPUTriCoreState *env, target_sigcontext *sc)
+{
+    int i;
+    abi_ulong v;
+
+    for (i = 0; i < 16; ++i) {
+        __get_user(env->gpr_d[i], &sc->d[i]);
+        __get_user(env->gpr_a[i], &sc->a[i]);
+    }
+    __get_user(env->PC, &sc->pc);
+    __get_user(v, &sc->psw);
+    psw_write(env, v);
+    __get_user(env->PCXI, &sc->pcxi);
+    __get_user(env->FCX, &sc->fcx);
+    tricore_gaddr_update(env);
+}
+
+static inline abi_ulong get_sigframe(struct target_sigaction *ka,
+                                     CPUTriCoreState *env,
+                                     size_t frame_size)
+{
+    abi_ulong sp = get_sp_from_cpustate(env);
+
+    sp = target_sigsp(sp, ka);
+    sp -= frame_size;
+    sp = QEMU_ALIGN_DOWN(sp, 8);
+
+    return sp;
+}
+
+/*
+ * Enter the handler the way CALL does: save the upper context in the
+ * next free CSA and link it into PCXI, so that the RET of the handler
+ * lands in the trampoline with A10 pointing at the frame.
+ */
+static bool tricore_signal_call(CPUTriCoreState *env, abi_ulong ret_addr)
+{
+    abi_ulong ea;
+    uint32_t new_fcx;
+    uint32_t psw;
+
+    if (!(env->FCX & (MASK_FCX_FCXS | MASK_FCX_FCXO))) {
+        return false;
+    }
+    ea = ((env->FCX & MASK_FCX_FCXS) << 12) +
+         ((env->FCX & MASK_FCX_FCXO) << 6);
+    psw = psw_read(env);
+    if (get_user_u32(new_fcx, ea) ||
+        put_user_u32(env->PCXI, ea) ||
+        put_user_u32(psw, ea + 4) ||
+        put_user_u32(env->gpr_a[10], ea + 8) ||
+        put_user_u32(env->gpr_a[11], ea + 12) ||
+        put_user_u32(env->gpr_d[8], ea + 16) ||
+        put_user_u32(env->gpr_d[9], ea + 20) ||
+        put_user_u32(env->gpr_d[10], ea + 24) ||
+        put_user_u32(env->gpr_d[11], ea + 28) ||
+        put_user_u32(env->gpr_a[12], ea + 32) ||
+        put_user_u32(env->gpr_a[13], ea + 36) ||
+        put_user_u32(env->gpr_a[14], ea + 40) ||
+        put_user_u32(env->gpr_a[15], ea + 44) ||
+        put_user_u32(env->gpr_d[12], ea + 48) ||
+        put_user_u32(env->gpr_d[13], ea + 52) ||
+        put_user_u32(env->gpr_d[14], ea + 56) ||
+        put_user_u32(env->gpr_d[15], ea + 60)) {
+        return false;
+    }
+
+    env->PCXI = (env->PCXI & 0xfff00000) | (env->FCX & 0xfffff);
+    pcxi_set_ul(env, 1);
+    env->FCX = (env->FCX & 0xfff00000) | (new_fcx & 0xfffff);
+    env->gpr_a[11] = ret_addr;
+
+    /* a fresh call depth count for the handler */
+    psw = (psw & ~MASK_PSW_CDC) | MASK_PSW_CDE | 1;
+    psw_write(env, psw);
+    return true;
+}
+
+void setup_rt_frame(int sig, struct target_sigaction *ka,
+                    target_siginfo_t *info,
+                    target_sigset_t *set, CPUTriCoreState *env)
+{
+    abi_ulong frame_addr;
+    target_rt_sigframe *frame;
+    int i;
+
+    frame_addr = get_sigframe(ka, env, sizeof(*frame));
+    trace_user_setup_rt_frame(env, frame_addr);
+    if (!lock_user_struct(VERIFY_WRITE, frame, frame_addr, 0)) {
+        goto give_sigsegv;
+    }
+
+    if (ka->sa_flags & SA_SIGINFO) {
+        frame->info = *info;
+    }
+
+    __put_user(0, &frame->uc.tuc_flags);
+    __put_user(0, &frame->uc.tuc_link);
+
+    target_save_altstack(&frame->uc.tuc_stack, env);
+    setup_sigcontext(&frame->uc.tuc_mcontext, env);
+    for (i = 0; i < TARGET_NSIG_WORDS; ++i) {
+        __put_user(set->sig[i], &frame->uc.tuc_sigmask.sig[i]);
+    }
+    unlock_user_struct(frame, frame_addr, 1);
+
+    /* Set up registers for signal handler */
+    env->gpr_a[10] = frame_addr;
+    if (!tricore_signal_call(env, default_rt_sigreturn)) {
+        force_sigsegv(sig);
+        return;
+    }
+    env->gpr_d[4] = sig;
+    env->gpr_a[4] = frame_addr + offsetof(target_rt_sigframe, info);
+    env->gpr_a[5] = frame_addr + offsetof(target_rt_sigframe, uc);
+    env->PC = ka->_sa_handler;
+    return;
+
+give_sigsegv:
+    force_sigsegv(sig);
+}
+
+long do_rt_sigreturn(CPUTriCoreState *env)
+{
+    abi_ulong frame_addr = get_sp_from_cpustate(env);
+    target_rt_sigframe *frame;
+    sigset_t set;
+
+    trace_user_do_rt_sigreturn(env, frame_addr);
+    if (frame_addr & 7) {
+        goto badframe;
+    }
+    if (!lock_user_struct(VERIFY_READ, frame, frame_addr, 1)) {
+        goto badframe;
+    }
+
+    target_to_host_sigset(&set, &frame->uc.tuc_sigmask);
+    set_sigmask(&set);
+
+    restore_sigcontext(env, &frame->uc.tuc_mcontext);
+    target_restore_altstack(&frame->uc.tuc_stack, env);
+
+    unlock_user_struct(frame, frame_addr, 0);
+    return -QEMU_ESIGRETURN;
+
+ badframe:
+    force_sig(TARGET_SIGSEGV);
+    return -QEMU_ESIGRETURN;
+}
+
+void setup_sigtramp(abi_ulong sigtramp_page)
+{
+    uint32_t *tramp = lock_user(VERIFY_WRITE, sigtramp_page, 4, 0);
+    assert(tramp != NULL);
+
+    /* This is syscall #__NR_rt_sigreturn */
+    __put_user(0x008000ad | (TARGET_NR_rt_sigreturn << 12), tramp);
+
+    default_rt_sigreturn = sigtramp_page;
+    unlock_user(tramp, sigtramp_page, 4);
+}
@@ -0,0 +1 @@
+#include "../generic/sockbits.h"
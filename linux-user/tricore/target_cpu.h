@@ -0,0 +1,36 @@
+/*
+ * TriCore specific CPU ABI and functions for linux-user
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TRICORE_TARGET_CPU_H
+#define TRICORE_TARGET_CPU_H
+
+static inline void cpu_clone_regs_child(CPUTriCoreState *env,
+                                        target_ulong newsp, unsigned flags)
+{
+    if (newsp) {
+        env->gpr_a[10] = newsp;
+    }
+    env->gpr_d[2] = 0;
+}
+
+static inline void cpu_clone_regs_parent(CPUTriCoreState *env, unsigned flags)
+{
+}
+
+/* the EABI leaves A[8] to the system, it holds the thread pointer */
+static inline void cpu_set_tls(CPUTriCoreState *env, target_ulong newtls)
+{
+    env->gpr_a[8] = newtls;
+    tricore_gaddr_update(env);
+}
+
+static inline abi_ulong get_sp_from_cpustate(CPUTriCoreState *state)
+{
+    return state->gpr_a[10];
+}
+#endif
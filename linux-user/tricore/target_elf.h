@@ -0,0 +1,13 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TRICORE_TARGET_ELF_H
+#define TRICORE_TARGET_ELF_H
+
+/* TriCore 1.6.2 is a superset of the older cores for user code */
+static inline const char *cpu_get_model(uint32_t eflags)
+{
+    return "tc37x";
+}
+#endif
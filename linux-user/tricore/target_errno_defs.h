@@ -0,0 +1,7 @@
+#ifndef TRICORE_TARGET_ERRNO_DEFS_H
+#define TRICORE_TARGET_ERRNO_DEFS_H
+
+/* Target uses generic errno */
+#include "../generic/target_errno_defs.h"
+
+#endif
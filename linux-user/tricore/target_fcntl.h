@@ -0,0 +1,8 @@
+/*
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TRICORE_TARGET_FCNTL_H
+#define TRICORE_TARGET_FCNTL_H
+#include "../generic/fcntl.h"
+#endif
@@ -0,0 +1,10 @@
+/*
+ * There is no TriCore Linux. Segment 2 is unused by the AURIX memory map,
+ * mmap() and the stack start behind the default CSA area at its bottom,
+ * see TRICORE_CSA_BASE.
+ */
+#define TASK_UNMAPPED_BASE      0x20400000
+
+#define ELF_ET_DYN_BASE         0x20800000
+
+#include "../generic/target_mman.h"
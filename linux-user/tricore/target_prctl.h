@@ -0,0 +1 @@
+/* No special prctl support required. */
@@ -0,0 +1 @@
+/* No target-specific /proc support */
@@ -0,0 +1 @@
+#include "../generic/target_resource.h"
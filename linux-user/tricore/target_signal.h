@@ -0,0 +1,8 @@
+#ifndef TRICORE_TARGET_SIGNAL_H
+#define TRICORE_TARGET_SIGNAL_H
+
+#include "../generic/signal.h"
+
+#define TARGET_ARCH_HAS_SIGTRAMP_PAGE 1
+
+#endif /* TRICORE_TARGET_SIGNAL_H */
@@ -0,0 +1 @@
+#include "../generic/target_structs.h"
@@ -0,0 +1,42 @@
+/*
+ * TriCore specific CPU ABI for linux-user
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#ifndef TRICORE_TARGET_SYSCALL_H
+#define TRICORE_TARGET_SYSCALL_H
+
+/*
+ * There is no TriCore Linux, this is the ABI of bare-metal programs which
+ * implement their C library system calls on top of the runner:
+ *
+ * - "syscall #nr" calls the asm-generic system call nr, so only the calls
+ *   up to 255 are reachable
+ * - the arguments are in D4-D7, D2 and D3, 64 bit arguments in an even
+ *   register pair like E4
+ * - the result or a negative errno is returned in D2
+ * - signal handlers are entered like a CALL and return with RET
+ */
+struct target_pt_regs {
+    abi_ulong pc;
+    abi_ulong sp;
+};
+
+#define UNAME_MACHINE "tricore"
+#define UNAME_MINIMUM_RELEASE "4.15.0"
+
+#define TARGET_MCL_CURRENT 1
+#define TARGET_MCL_FUTURE  2
+#define TARGET_MCL_ONFAULT 4
+
+/*
+ * Default free CSA list for programs whose startup code does not link
+ * one into FCX. A CSA can only be addressed in the first 4MB of a segment.
+ */
+#define TRICORE_CSA_BASE   0x20000000
+#define TRICORE_CSA_COUNT  256
+
+#endif /* TRICORE_TARGET_SYSCALL_H */
@@ -0,0 +1 @@
+#include "../generic/termbits.h"
@@ -163,6 +163,9 @@ static inline int regpairs_aligned(CPUArchState *cpu_env, int num)
 static inline int regpairs_aligned(CPUArchState *cpu_env, int num) { return 1; }
 #elif defined(TARGET_HEXAGON)
 static inline int regpairs_aligned(CPUArchState *cpu_env, int num) { return 1; }
+#elif defined(TARGET_TRICORE)
+/* 64 bit arguments go in an even/odd pair of data registers */
+static inline int regpairs_aligned(CPUArchState *cpu_env, int num) { return 1; }
 #else
 static inline int regpairs_aligned(CPUArchState *cpu_env, int num) { return 0; }
 #endif
@@ -22,8 +22,20 @@
 #include "cpu.h"
 #include "exec/exec-all.h"
 #include "qemu/error-report.h"
+#include "qemu/cutils.h"
 #include "tcg/debug-assert.h"
+#include "tcg/tcg.h"
 #include "qemu/log.h"
+#include "hw/qdev-properties.h"
+#include "sysemu/replay.h"
+#include "qemu/lockable.h"
+#ifndef CONFIG_USER_ONLY
+#include "exec/memory.h"
+#include "exec/address-spaces.h"
+#endif
+#ifndef _WIN32
+#include <sys/shm.h>
+#endif
 
 static inline void set_feature(CPUTriCoreState *env, int feature)
 {
@@ -69,12 +81,21 @@ static void tricore_cpu_reset_hold(Object *obj, ResetType type)
     }
 
     cpu_state_reset(cpu_env(cs));
+    cpu_env(cs)->cov_prev_loc = 0;
+    cpu_env(cs)->dbg_after = 0;
+    cpu_env(cs)->dbg_skip_pc = 1;
+    tricore_debug_update(cpu_env(cs));
 }
 
-// TODO: Implement this
 static bool tricore_cpu_has_work(CPUState *cs)
 {
-    return true;
+    CPUTriCoreState *env = cpu_env(cs);
+
+    if (env->reset_pending || (cs->interrupt_request & CPU_INTERRUPT_NMI)) {
+        return true;
+    }
+    return (cs->interrupt_request & CPU_INTERRUPT_HARD) &&
+           (env->ICR & MASK_ICR_IE_1_6);
 }
 
 static int tricore_cpu_mmu_index(CPUState *cs, bool ifetch)
@@ -82,6 +103,7 @@ static int tricore_cpu_mmu_index(CPUState *cs, bool ifetch)
     return 0;
 }
 
+#ifndef CONFIG_USER_ONLY
 static bool tricore_cpu_exec_interrupt(CPUState *cs, int interrupt_request)
 {
     TriCoreCPU *cpu = TRICORE_CPU(cs);
@@ -95,6 +117,13 @@ static bool tricore_cpu_exec_interrupt(CPUState *cs, int interrupt_request)
         return true;
     }
 
+    /* NMI traps are taken regardless of ICR.IE */
+    if (interrupt_request & CPU_INTERRUPT_NMI) {
+        cpu_reset_interrupt(cs, CPU_INTERRUPT_NMI);
+        tricore_cpu_enter_trap(env, TRAPC_NMI, TIN7_NMI, 0);
+        return true;
+    }
+
     if ((interrupt_request & CPU_INTERRUPT_HARD)
             && (env->ICR & (MASK_ICR_IE_1_6)) >> 15) {
         cs->exception_index = EXCP_IRQ;
@@ -103,6 +132,179 @@ static bool tricore_cpu_exec_interrupt(CPUState *cs, int interrupt_request)
     }
     return false;
 }
+#endif
+
+#ifndef CONFIG_USER_ONLY
+/* serialises the updates of TriCoreSPRWindow.code and spr_st */
+static QemuMutex spr_lock;
+
+static void __attribute__((constructor)) tricore_spr_init(void)
+{
+    qemu_mutex_init(&spr_lock);
+}
+
+/*
+ * Stores bypass the dirty tracking and the invalidation of translated code.
+ * They go through the TLB while the RAM is dirty logged, e.g. for a
+ * snapshot or migration, and once code was translated from the RAM.
+ */
+static void tricore_spr_update(void)
+{
+    CPUState *cs;
+
+    CPU_FOREACH(cs) {
+        TriCoreCPU *cpu = TRICORE_CPU(cs);
+
+        for (unsigned i = 0; i < cpu->spr_count; i++) {
+            TriCoreSPRWindow *w = &cpu->spr[i];
+            uint8_t log = memory_region_get_dirty_log_mask(w->mr) &
+                          ~(1 << DIRTY_MEMORY_CODE);
+
+            qatomic_set(&cpu->env.spr_st[i],
+                        w->code || log ? NULL : cpu->env.spr_ld[i]);
+        }
+    }
+}
+
+static void tricore_spr_log_change(MemoryListener *listener,
+                                   MemoryRegionSection *section,
+                                   int old_val, int new_val)
+{
+    QEMU_LOCK_GUARD(&spr_lock);
+    tricore_spr_update();
+}
+
+static bool tricore_spr_log_global_start(MemoryListener *listener,
+                                         Error **errp)
+{
+    QEMU_LOCK_GUARD(&spr_lock);
+    tricore_spr_update();
+    return true;
+}
+
+static void tricore_spr_log_global_stop(MemoryListener *listener)
+{
+    QEMU_LOCK_GUARD(&spr_lock);
+    tricore_spr_update();
+}
+
+static MemoryListener tricore_spr_listener = {
+    .name = "tricore-spr",
+    .log_start = tricore_spr_log_change,
+    .log_stop = tricore_spr_log_change,
+    .log_global_start = tricore_spr_log_global_start,
+    .log_global_stop = tricore_spr_log_global_stop,
+};
+
+void tricore_cpu_add_spr_window(TriCoreCPU *cpu, uint32_t base,
+                                MemoryRegion *mr)
+{
+    static bool listening;
+    TriCoreSPRWindow *w;
+
+    if (!cpu->spr_direct) {
+        return;
+    }
+    assert(cpu->spr_count < TRICORE_SPR_WINDOWS);
+    assert(memory_region_is_ram(mr));
+
+    WITH_QEMU_LOCK_GUARD(&spr_lock) {
+        w = &cpu->spr[cpu->spr_count];
+        w->base = base;
+        w->size = memory_region_size(mr);
+        w->mr = mr;
+        w->code = false;
+        cpu->env.spr_ld[cpu->spr_count] = memory_region_get_ram_ptr(mr);
+        cpu->spr_count++;
+        tricore_spr_update();
+    }
+
+    if (!listening) {
+        memory_listener_register(&tricore_spr_listener, &address_space_memory);
+        listening = true;
+    }
+}
+
+/*
+ * Called before translating code at the RAM address @addr. If the code is
+ * in a scratchpad, its stores stop bypassing the TLB on all windows onto
+ * that RAM.
+ */
+void tricore_spr_translate(ram_addr_t addr)
+{
+    CPUState *cs;
+    MemoryRegion *mr = NULL;
+
+    CPU_FOREACH(cs) {
+        TriCoreCPU *cpu = TRICORE_CPU(cs);
+
+        for (unsigned i = 0; i < cpu->spr_count && !mr; i++) {
+            TriCoreSPRWindow *w = &cpu->spr[i];
+
+            if (!w->code &&
+                addr - memory_region_get_ram_addr(w->mr) < w->size) {
+                mr = w->mr;
+            }
+        }
+    }
+    if (!mr) {
+        return;
+    }
+
+    QEMU_LOCK_GUARD(&spr_lock);
+    CPU_FOREACH(cs) {
+        TriCoreCPU *cpu = TRICORE_CPU(cs);
+
+        for (unsigned i = 0; i < cpu->spr_count; i++) {
+            if (cpu->spr[i].mr == mr) {
+                cpu->spr[i].code = true;
+            }
+        }
+    }
+    tricore_spr_update();
+}
+#endif
+
+/*
+ * The bitmap is shared with an AFL compatible fuzzer, which passes the id
+ * of its shared memory segment in __AFL_SHM_ID. Without it the bitmap is
+ * private to this process.
+ */
+static uint8_t *tricore_cpu_coverage_attach(const char *shm_id, Error **errp)
+{
+#ifndef _WIN32
+    void *area;
+    int id;
+
+    if (qemu_strtoi(shm_id, NULL, 10, &id) < 0 || id < 0) {
+        error_setg(errp, "invalid coverage bitmap id '%s'", shm_id);
+        return NULL;
+    }
+
+    area = shmat(id, NULL, 0);
+    if (area == (void *)-1) {
+        error_setg_errno(errp, errno, "cannot attach coverage bitmap %s",
+                         shm_id);
+        return NULL;
+    }
+    return area;
+#else
+    error_setg(errp, "shared coverage bitmaps are not supported on this host");
+    return NULL;
+#endif
+}
+
+static bool tricore_cpu_coverage_init(TriCoreCPU *cpu, Error **errp)
+{
+    const char *shm_id = getenv("__AFL_SHM_ID");
+
+    if (shm_id) {
+        cpu->cov_area = tricore_cpu_coverage_attach(shm_id, errp);
+    } else {
+        cpu->cov_area = g_malloc0(TRICORE_COV_MAP_SIZE);
+    }
+    return cpu->cov_area != NULL;
+}
 
 static void tricore_cpu_realizefn(DeviceState *dev, Error **errp)
 {
@@ -133,6 +335,25 @@ static void tricore_cpu_realizefn(DeviceState *dev, Error **errp)
     if (tricore_has_feature(env, TRICORE_FEATURE_131)) {
         set_feature(env, TRICORE_FEATURE_13);
     }
+
+    tricore_cpu_register_gdb_regs(cs);
+
+    /* the cycle estimate is charged by a single 64 bit add per TB */
+    if (cpu->pipeline_timing && TCG_TARGET_REG_BITS != 64) {
+        error_setg(errp, "TriCore: pipeline-timing needs a 64 bit host");
+        return;
+    }
+
+    /* the cycle estimate would shift replay events, see helper_bus_access */
+    if (cpu->pipeline_timing && replay_mode != REPLAY_MODE_NONE) {
+        warn_report("TriCore: pipeline-timing is ignored with record/replay");
+        cpu->pipeline_timing = false;
+    }
+
+    if (cpu->edge_coverage && !tricore_cpu_coverage_init(cpu, errp)) {
+        return;
+    }
+
     cpu_reset(cs);
     qemu_init_vcpu(cs);
 
@@ -187,11 +408,13 @@ static void tc37x_initfn(Object *obj)
 }
 
 
+#ifndef CONFIG_USER_ONLY
 #include "hw/core/sysemu-cpu-ops.h"
 
 static const struct SysemuCPUOps tricore_sysemu_ops = {
     .get_phys_page_debug = tricore_cpu_get_phys_page_debug,
 };
+#endif
 
 #include "hw/core/tcg-cpu-ops.h"
 
@@ -199,10 +422,22 @@ static const TCGCPUOps tricore_tcg_ops = {
     .initialize = tricore_tcg_init,
     .synchronize_from_tb = tricore_cpu_synchronize_from_tb,
     .restore_state_to_opc = tricore_restore_state_to_opc,
+    .debug_excp_handler = tricore_cpu_debug_excp_handler,
+#ifndef CONFIG_USER_ONLY
     .tlb_fill = tricore_cpu_tlb_fill,
     .do_interrupt = tricore_cpu_do_interrupt,
     .cpu_exec_interrupt = tricore_cpu_exec_interrupt,
     .cpu_exec_halt = tricore_cpu_has_work,
+#endif /* !CONFIG_USER_ONLY */
+};
+
+static Property tricore_cpu_properties[] = {
+    DEFINE_PROP_BOOL("pipeline-timing", TriCoreCPU, pipeline_timing, false),
+    DEFINE_PROP_BOOL("edge-coverage", TriCoreCPU, edge_coverage, false),
+    DEFINE_PROP_BOOL("decode-stats", TriCoreCPU, decode_stats, false),
+    DEFINE_PROP_BOOL("global-addr-const", TriCoreCPU, gaddr_const, false),
+    DEFINE_PROP_BOOL("spr-direct", TriCoreCPU, spr_direct, false),
+    DEFINE_PROP_END_OF_LIST(),
 };
 
 static void tricore_cpu_class_init(ObjectClass *c, void *data)
@@ -214,6 +449,10 @@ static void tricore_cpu_class_init(ObjectClass *c, void *data)
 
     device_class_set_parent_realize(dc, tricore_cpu_realizefn,
                                     &mcc->parent_realize);
+    device_class_set_props(dc, tricore_cpu_properties);
+#ifndef CONFIG_USER_ONLY
+    dc->vmsd = &vmstate_tricore_cpu;
+#endif
 
     resettable_class_set_parent_phases(rc, NULL, tricore_cpu_reset_hold, NULL,
                                        &mcc->parent_phases);
@@ -223,13 +462,15 @@ static void tricore_cpu_class_init(ObjectClass *c, void *data)
 
     cc->gdb_read_register = tricore_cpu_gdb_read_register;
     cc->gdb_write_register = tricore_cpu_gdb_write_register;
-    cc->gdb_num_core_regs = 44;
+    cc->gdb_core_xml_file = "tricore-core.xml";
     cc->gdb_arch_name = tricore_gdb_arch_name;
 
     cc->dump_state = tricore_cpu_dump_state;
     cc->set_pc = tricore_cpu_set_pc;
     cc->get_pc = tricore_cpu_get_pc;
+#ifndef CONFIG_USER_ONLY
     cc->sysemu_ops = &tricore_sysemu_ops;
+#endif
     cc->tcg_ops = &tricore_tcg_ops;
 }
 
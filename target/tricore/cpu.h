@@ -23,9 +23,51 @@
 #include "cpu-qom.h"
 #include "hw/registerfields.h"
 #include "exec/cpu-defs.h"
+#include "exec/gdbstub.h"
 #include "qemu/cpu-float.h"
 #include "tricore-defs.h"
 
+/*
+ * Optional bus timing model hook. Called for every guest data access with
+ * the accessing core, address, size in bytes and direction; returns the
+ * number of stall cycles the access costs.
+ */
+typedef uint32_t (*TriCoreBusTimingFn)(void *opaque, uint32_t core,
+                                       uint32_t addr, uint32_t size,
+                                       bool is_write);
+
+/*
+ * Optional interrupt instrumentation hook. Called with entry set when the
+ * core enters the ISR of priority srpn, and for every RFE with the current
+ * CCPN. pcxi is the PCXI behind the entry or in front of the RFE, so both
+ * carry the link to the CSA the entry saved.
+ */
+typedef void (*TriCoreIRQEventFn)(void *opaque, bool entry, uint32_t srpn,
+                                  uint32_t pcxi);
+
+/* number of TRnEVT/TRnADR trigger register pairs */
+#define TRICORE_DBG_TRIGGERS 8
+
+/* size of the AFL compatible edge coverage bitmap */
+#define TRICORE_COV_MAP_SIZE (1 << 16)
+
+/*
+ * Scratchpad RAM windows, which the translator accesses through a host
+ * pointer instead of the softmmu TLB, see tricore_cpu_add_spr_window().
+ */
+#define TRICORE_SPR_WINDOWS 4
+
+typedef struct TriCoreSPRWindow {
+    uint32_t base;
+    uint32_t size;
+    MemoryRegion *mr;
+    /* code was translated from the RAM, stores must invalidate it */
+    bool code;
+} TriCoreSPRWindow;
+
+#define BUS_ACCESS_SIZE_MASK 0xff
+#define BUS_ACCESS_WRITE     0x100
+
 typedef struct CPUArchState {
     /* GPR Register */
     uint32_t gpr_a[16];
@@ -56,11 +98,94 @@ typedef struct CPUArchState {
 
     uint32_t irq_pending;
     uint32_t reset_pending;
+    /* ENDINIT of the CPU watchdog, mirrored by the SCU */
+    uint32_t endinit;
+    /* edge coverage, hashed location of the previous TB */
+    uint32_t cov_prev_loc;
+    /* on-chip debug triggers, see tricore_debug_update() */
+    uint32_t dbg_code_triggers;
+    uint32_t dbg_after;
+    uint32_t dbg_skip_pc;
+    /* A0, A1, A8 and A9 of the TBs to run, see tricore_gaddr_update() */
+    uint32_t gaddr_key;
 
     /* Internal CPU feature flags.  */
     uint64_t features;
+
+    /* Bus timing model, installed by the SoC before translation starts */
+    TriCoreBusTimingFn bus_timing;
+    void *bus_timing_opaque;
+
+    /* Interrupt instrumentation, installed by the interrupt router */
+    TriCoreIRQEventFn irq_event;
+    void *irq_event_opaque;
+
+    /*
+     * Host addresses of the scratchpad windows for loads and for stores.
+     * spr_st is NULL while stores must go through the TLB.
+     */
+    uint8_t *spr_ld[TRICORE_SPR_WINDOWS];
+    uint8_t *spr_st[TRICORE_SPR_WINDOWS];
+
+#ifdef CONFIG_USER_ONLY
+    /* trap of the last EXCP_TRAP, see cpu_loop() */
+    uint32_t trap_class;
+    uint32_t trap_tin;
+#endif
 } CPUTriCoreState;
 
+/*
+ * Instruction formats, which the major opcode determines. Counted at
+ * translation time if the decode-stats property is set.
+ */
+typedef enum TriCoreInsnFormat {
+    TRICORE_FMT_INVALID,
+    /* 16 bit */
+    TRICORE_FMT_SB,
+    TRICORE_FMT_SBC,
+    TRICORE_FMT_SBR,
+    TRICORE_FMT_SBRN,
+    TRICORE_FMT_SC,
+    TRICORE_FMT_SLR,
+    TRICORE_FMT_SLRO,
+    TRICORE_FMT_SR,
+    TRICORE_FMT_SRC,
+    TRICORE_FMT_SRO,
+    TRICORE_FMT_SRR,
+    TRICORE_FMT_SRRS,
+    TRICORE_FMT_SSR,
+    TRICORE_FMT_SSRO,
+    /* 32 bit */
+    TRICORE_FMT_ABS,
+    TRICORE_FMT_ABSB,
+    TRICORE_FMT_B,
+    TRICORE_FMT_BIT,
+    TRICORE_FMT_BO,
+    TRICORE_FMT_BOL,
+    TRICORE_FMT_BRC,
+    TRICORE_FMT_BRN,
+    TRICORE_FMT_BRR,
+    TRICORE_FMT_RC,
+    TRICORE_FMT_RCPW,
+    TRICORE_FMT_RCR,
+    TRICORE_FMT_RCRR,
+    TRICORE_FMT_RCRW,
+    TRICORE_FMT_RLC,
+    TRICORE_FMT_RR,
+    TRICORE_FMT_RR1,
+    TRICORE_FMT_RR2,
+    TRICORE_FMT_RRPW,
+    TRICORE_FMT_RRR,
+    TRICORE_FMT_RRR1,
+    TRICORE_FMT_RRR2,
+    TRICORE_FMT_RRRR,
+    TRICORE_FMT_RRRW,
+    TRICORE_FMT_SYS,
+    TRICORE_FMT_COUNT
+} TriCoreInsnFormat;
+
+const char *tricore_insn_format_name(TriCoreInsnFormat fmt);
+
 /**
  * TriCoreCPU:
  * @env: #CPUTriCoreState
@@ -71,6 +196,32 @@ struct ArchCPU {
     CPUState parent_obj;
 
     CPUTriCoreState env;
+
+    /* scale icount by estimated pipeline cycles instead of insns */
+    bool pipeline_timing;
+
+    /* count TB to TB edges in cov_area, see gen_edge_coverage() */
+    bool edge_coverage;
+    uint8_t *cov_area;
+
+    /* CSFRs outside the core feature, indices into the csfr.h.inc table */
+    GDBFeature gdb_csfr_feature;
+    uint16_t *gdb_csfr_map;
+
+    /* watchpoints of the armed data triggers */
+    CPUWatchpoint *dbg_wp[TRICORE_DBG_TRIGGERS];
+
+    /* fold A0, A1, A8 and A9 into the TBs, see tricore_gaddr_update() */
+    bool gaddr_const;
+
+    /* scratchpad windows, see tricore_cpu_add_spr_window() */
+    bool spr_direct;
+    unsigned spr_count;
+    TriCoreSPRWindow spr[TRICORE_SPR_WINDOWS];
+
+    /* instructions translated per format, written by the vCPU thread */
+    bool decode_stats;
+    uint64_t decode_count[TRICORE_FMT_COUNT];
 };
 
 struct TriCoreCPUClass {
@@ -80,7 +231,9 @@ struct TriCoreCPUClass {
     ResettablePhases parent_phases;
 };
 
+#ifndef CONFIG_USER_ONLY
 hwaddr tricore_cpu_get_phys_page_debug(CPUState *cpu, vaddr addr);
+#endif
 void tricore_cpu_dump_state(CPUState *cpu, FILE *f, int flags);
 
 FIELD(PCXI, PCPN_13, 24, 8)
@@ -113,6 +266,8 @@ void icr_set_ccpn(CPUTriCoreState *env, uint32_t val);
 void icr_set_ie(CPUTriCoreState *env, uint32_t val);
 
 #define EXCP_IRQ      2
+#define EXCP_TRAP     3 /* user mode only, a trap left cpu_exec() */
+#define EXCP_SEMIHOST 4 /* user mode only, DEBUG as a semihosting call */
 
 #define MASK_PSW_USB 0xff000000
 #define MASK_USB_C   0x80000000
@@ -150,6 +305,30 @@ void icr_set_ie(CPUTriCoreState *env, uint32_t val);
 #define MASK_DBGSR_PEVT 0x40
 #define MASK_DBGSR_EVTSRC 0x1f00
 
+/* DBGSR.EVTSRC values */
+#define DBG_EVTSRC_EXEVT 0x00
+#define DBG_EVTSRC_CREVT 0x02
+#define DBG_EVTSRC_SWEVT 0x03
+#define DBG_EVTSRC_TR0   0x10
+
+/* layout shared by EXEVT, CREVT, SWEVT and TRnEVT */
+FIELD(DBGEVT, EVTA, 0, 3)
+FIELD(DBGEVT, BBM, 3, 1)
+/* TRnEVT only */
+FIELD(DBGEVT, TYP, 12, 1)
+FIELD(DBGEVT, RNG, 13, 1)
+FIELD(DBGEVT, AST, 27, 1)
+FIELD(DBGEVT, ALD, 28, 1)
+
+/* debug event actions in DBGEVT.EVTA */
+#define DBGEVT_EVTA_NONE    0
+#define DBGEVT_EVTA_BRKOUT  1
+#define DBGEVT_EVTA_HALT    2
+#define DBGEVT_EVTA_TRAP    3
+#define DBGEVT_EVTA_INT     4
+
+#define MASK_DBGTCR_DTA 0x1
+
 #define BITPOS_ICR_IE_1_3 8
 #define BITPOS_ICR_IE_1_6 15
 #define MASK_ICR_PIPN 0x00ff0000
@@ -260,19 +439,65 @@ uint32_t psw_read(CPUTriCoreState *env);
 void psw_write(CPUTriCoreState *env, uint32_t val);
 int tricore_cpu_gdb_read_register(CPUState *cs, GByteArray *mem_buf, int n);
 int tricore_cpu_gdb_write_register(CPUState *cs, uint8_t *mem_buf, int n);
+void tricore_cpu_register_gdb_regs(CPUState *cs);
 
 void fpu_set_state(CPUTriCoreState *env);
 
+#ifndef CONFIG_USER_ONLY
+extern const VMStateDescription vmstate_tricore_cpu;
+#endif
+
 #define MMU_USER_IDX 2
 
 #include "exec/cpu-all.h"
 
 FIELD(TB_FLAGS, PRIV, 0, 2)
+FIELD(TB_FLAGS, GADDR, 2, 8)
+FIELD(TB_FLAGS, SPR, 10, 1)
 
 void cpu_state_reset(CPUTriCoreState *s);
 void tricore_tcg_init(void);
+#ifndef CONFIG_USER_ONLY
 void tricore_cpu_do_interrupt(CPUState *cs);
+void tricore_semihosting(CPUTriCoreState *env);
+#endif
+void tricore_cpu_enter_trap(CPUTriCoreState *env, uint32_t class, int tin,
+                            uint32_t fcd_pc);
 void tricore_check_interrupts(CPUTriCoreState *cs);
+uint32_t tricore_ctx_ldl(CPUTriCoreState *env, uint32_t addr);
+void tricore_ctx_stl(CPUTriCoreState *env, uint32_t addr, uint32_t val);
+
+/*
+ * The global address registers A0, A1, A8 and A9 are set once by the
+ * startup code. With the global-addr-const property each distinct set of
+ * their values gets a key in TB_FLAGS.GADDR, and the translator folds the
+ * values of the key into the addresses. Key 0 means not specialised.
+ */
+#define TRICORE_GADDR_KEYS 255
+void tricore_gaddr_update(CPUTriCoreState *env);
+const uint32_t *tricore_gaddr_values(uint32_t key);
+
+#ifndef CONFIG_USER_ONLY
+/*
+ * Adds the window at @base onto the RAM region @mr, which the SoC maps
+ * there. All CPUs must add the same windows in the same order, as the TBs
+ * are shared, and every alias of the RAM the guest uses should be added.
+ */
+void tricore_cpu_add_spr_window(TriCoreCPU *cpu, uint32_t base,
+                                MemoryRegion *mr);
+void tricore_spr_translate(ram_addr_t addr);
+#endif
+
+/* writes to these CSFRs change the armed debug triggers */
+static inline bool tricore_is_debug_csfr(uint32_t addr)
+{
+    return addr == 0xfd00 || (addr >= 0xf000 && addr <= 0xf03c);
+}
+uint32_t tricore_debug_trevt(CPUTriCoreState *env, int n);
+uint32_t tricore_debug_tradr(CPUTriCoreState *env, int n);
+void tricore_debug_update(CPUTriCoreState *env);
+int tricore_debug_code_trigger(CPUTriCoreState *env, uint32_t pc);
+void tricore_cpu_debug_excp_handler(CPUState *cs);
 
 static inline void cpu_get_tb_cpu_state(CPUTriCoreState *env, vaddr *pc,
                                         uint64_t *cs_base, uint32_t *flags)
@@ -283,14 +508,21 @@ static inline void cpu_get_tb_cpu_state(CPUTriCoreState *env, vaddr *pc,
 
     new_flags |= FIELD_DP32(new_flags, TB_FLAGS, PRIV,
             extract32(env->PSW, 10, 2));
+    new_flags = FIELD_DP32(new_flags, TB_FLAGS, GADDR, env->gaddr_key);
+    /* watchpoints need every access to go through the TLB */
+    new_flags = FIELD_DP32(new_flags, TB_FLAGS, SPR,
+                           env_archcpu(env)->spr_count &&
+                           QTAILQ_EMPTY(&env_cpu(env)->watchpoints));
     *flags = new_flags;
 }
 
 #define CPU_RESOLVING_TYPE TYPE_TRICORE_CPU
 
 /* helpers.c */
+#ifndef CONFIG_USER_ONLY
 bool tricore_cpu_tlb_fill(CPUState *cs, vaddr address, int size,
                           MMUAccessType access_type, int mmu_idx,
                           bool probe, uintptr_t retaddr);
+#endif
 
 #endif /* TRICORE_CPU_H */
@@ -0,0 +1,282 @@
+/*
+ *  TriCore on-chip debug triggers.
+ *
+ *  Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "qemu/osdep.h"
+#include "qemu/log.h"
+#include "qemu/main-loop.h"
+#include "cpu.h"
+#include "exec/helper-proto.h"
+#include "exec/exec-all.h"
+#include "exec/cpu_ldst.h"
+#include "exec/tb-flush.h"
+
+/*
+ * Code triggers (TRnEVT.TYP = 0) are matched at translation time: the
+ * translator emits a call to helper_debug_trigger() in front of each
+ * instruction a trigger covers, so code without a trigger runs at full
+ * speed. Data triggers (TYP = 1) become BP_CPU watchpoints, which only
+ * slow down the accesses to the pages they cover.
+ *
+ * An event that breaks before the instruction (BBM = 1) is taken by the
+ * helper. Otherwise the helper raises CPU_INTERRUPT_DEBUG, the instruction
+ * ends its TB and the event is taken by tricore_cpu_debug_excp_handler()
+ * before the next TB, which is also where data watchpoints end up.
+ */
+
+static const struct {
+    uint16_t evt;
+    uint16_t adr;
+} tricore_debug_tr[TRICORE_DBG_TRIGGERS] = {
+#define TR(N) \
+    { offsetof(CPUTriCoreState, TR##N##EVT), \
+      offsetof(CPUTriCoreState, TR##N##ADR) }
+    TR(0), TR(1), TR(2), TR(3), TR(4), TR(5), TR(6), TR(7),
+#undef TR
+};
+
+uint32_t tricore_debug_trevt(CPUTriCoreState *env, int n)
+{
+    return *(uint32_t *)((uint8_t *)env + tricore_debug_tr[n].evt);
+}
+
+uint32_t tricore_debug_tradr(CPUTriCoreState *env, int n)
+{
+    return *(uint32_t *)((uint8_t *)env + tricore_debug_tr[n].adr);
+}
+
+/* an even trigger with RNG set covers [TRnADR, TRn+1ADR) */
+static bool tricore_debug_is_range(CPUTriCoreState *env, int n)
+{
+    return !(n & 1) && n + 1 < TRICORE_DBG_TRIGGERS &&
+           FIELD_EX32(tricore_debug_trevt(env, n), DBGEVT, RNG);
+}
+
+/* recompute the armed triggers after a write to DBGSR or TRnEVT/TRnADR */
+void tricore_debug_update(CPUTriCoreState *env)
+{
+    TriCoreCPU *cpu = env_archcpu(env);
+    CPUState *cs = CPU(cpu);
+    uint32_t code = 0;
+    int n;
+
+    for (n = 0; n < TRICORE_DBG_TRIGGERS; n++) {
+        if (cpu->dbg_wp[n]) {
+            cpu_watchpoint_remove_by_ref(cs, cpu->dbg_wp[n]);
+            cpu->dbg_wp[n] = NULL;
+        }
+    }
+
+    if ((env->DBGSR & MASK_DBGSR_DE) &&
+        tricore_has_feature(env, TRICORE_FEATURE_16)) {
+        for (n = 0; n < TRICORE_DBG_TRIGGERS; n++) {
+            uint32_t evt = tricore_debug_trevt(env, n);
+            uint32_t adr = tricore_debug_tradr(env, n);
+            vaddr len = 1;
+            int flags = BP_CPU;
+
+            if (FIELD_EX32(evt, DBGEVT, EVTA) == DBGEVT_EVTA_NONE) {
+                continue;
+            }
+            if (!FIELD_EX32(evt, DBGEVT, TYP)) {
+                code |= 1 << n;
+            } else {
+                if (FIELD_EX32(evt, DBGEVT, ALD)) {
+                    flags |= BP_MEM_READ;
+                }
+                if (FIELD_EX32(evt, DBGEVT, AST)) {
+                    flags |= BP_MEM_WRITE;
+                }
+                if (tricore_debug_is_range(env, n)) {
+                    len = tricore_debug_tradr(env, n + 1) - adr;
+                }
+                if ((flags & BP_MEM_ACCESS) && len) {
+                    cpu_watchpoint_insert(cs, adr, len, flags,
+                                          &cpu->dbg_wp[n]);
+                }
+            }
+            /* the upper bound of a range is not a trigger of its own */
+            if (tricore_debug_is_range(env, n)) {
+                n++;
+            }
+        }
+    }
+
+    /* code triggers are part of the translated code */
+    if (code || env->dbg_code_triggers) {
+        tb_flush(cs);
+    }
+    env->dbg_code_triggers = code;
+}
+
+/* the armed code trigger covering pc or -1, called by the translator */
+int tricore_debug_code_trigger(CPUTriCoreState *env, uint32_t pc)
+{
+    for (int n = 0; n < TRICORE_DBG_TRIGGERS; n++) {
+        uint32_t adr = tricore_debug_tradr(env, n);
+
+        if (!(env->dbg_code_triggers & (1 << n))) {
+            continue;
+        }
+        if (tricore_debug_is_range(env, n)) {
+            if (pc >= adr && pc < tricore_debug_tradr(env, n + 1)) {
+                return n;
+            }
+        } else if (pc == adr) {
+            return n;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Breakpoint trap: the debug monitor at DMS is entered with the context
+ * saved to DCX. RFM returns to the address in A[11].
+ */
+static void tricore_debug_trap(CPUTriCoreState *env)
+{
+    /* M(DCX, 4 * word) = {PCXI, PSW, A[10], A[11]}; */
+    tricore_ctx_stl(env, env->DCX, env->PCXI);
+    tricore_ctx_stl(env, env->DCX + 4, psw_read(env));
+    tricore_ctx_stl(env, env->DCX + 8, env->gpr_a[10]);
+    tricore_ctx_stl(env, env->DCX + 12, env->gpr_a[11]);
+
+    pcxi_set_pie(env, icr_get_ie(env));
+    pcxi_set_pcpn(env, icr_get_ccpn(env));
+    icr_set_ie(env, 0);
+
+    env->gpr_a[11] = env->PC;
+    env->PSW = deposit32(env->PSW, 10, 2, TRICORE_PRIV_SM);
+    env->PSW &= ~MASK_PSW_PRS;
+    if (tricore_has_feature(env, TRICORE_FEATURE_131)) {
+        env->DBGTCR |= MASK_DBGTCR_DTA;
+    }
+    env->PC = env->DMS;
+}
+
+/*
+ * Take the action of event register evt, the core stops at or returns to
+ * pc. Only returns if the action has no effect on the core. ra is the
+ * host return address when called from a helper, 0 otherwise.
+ */
+static void tricore_debug_event(CPUTriCoreState *env, uint32_t src,
+                                uint32_t evt, uint32_t pc, uintptr_t ra)
+{
+    CPUState *cs = env_cpu(env);
+
+    env->DBGSR = deposit32(env->DBGSR, 8, 5, src);
+
+    switch (FIELD_EX32(evt, DBGEVT, EVTA)) {
+    case DBGEVT_EVTA_HALT:
+        if (ra) {
+            cpu_restore_state(cs, ra);
+        }
+        env->PC = pc;
+        cs->exception_index = EXCP_DEBUG;
+        cpu_loop_exit(cs);
+    case DBGEVT_EVTA_TRAP:
+        if (ra) {
+            cpu_restore_state(cs, ra);
+        }
+        env->PC = pc;
+        tricore_debug_trap(env);
+        cs->exception_index = -1;
+        cpu_loop_exit(cs);
+    case DBGEVT_EVTA_INT:
+        qemu_log_mask(LOG_UNIMP, "debug event 0x%x: breakpoint interrupts "
+                      "are not supported\n", src);
+        break;
+    default:
+        /* BRKOUT has no receiver, the remaining actions are reserved */
+        break;
+    }
+}
+
+void helper_debug_update(CPUTriCoreState *env)
+{
+    tricore_debug_update(env);
+}
+
+/* emitted in front of the instruction at pc, which code trigger n covers */
+void helper_debug_trigger(CPUTriCoreState *env, uint32_t n, uint32_t pc)
+{
+    uint32_t evt = tricore_debug_trevt(env, n);
+
+    if (!FIELD_EX32(evt, DBGEVT, BBM)) {
+        env->dbg_after = n + 1;
+        bql_lock();
+        cpu_interrupt(env_cpu(env), CPU_INTERRUPT_DEBUG);
+        bql_unlock();
+        return;
+    }
+
+    /* resuming from the event at pc, the instruction executes this time */
+    if (env->dbg_skip_pc == pc) {
+        env->dbg_skip_pc = 1;
+        return;
+    }
+
+    env->dbg_skip_pc = pc;
+    tricore_debug_event(env, DBG_EVTSRC_TR0 + n, evt, pc, GETPC());
+    env->dbg_skip_pc = 1;
+}
+
+/* DEBUG instruction, a NOP unless debug mode is enabled */
+void helper_debug(CPUTriCoreState *env, uint32_t next_pc)
+{
+    if (env->DBGSR & MASK_DBGSR_DE) {
+        tricore_debug_event(env, DBG_EVTSRC_SWEVT, env->SWEVT, next_pc,
+                            GETPC());
+    }
+}
+
+void tricore_cpu_debug_excp_handler(CPUState *cs)
+{
+    TriCoreCPU *cpu = TRICORE_CPU(cs);
+    CPUTriCoreState *env = &cpu->env;
+    CPUWatchpoint *wp = cs->watchpoint_hit;
+    int n;
+
+    if (wp) {
+        /* watchpoints of the gdbstub are reported to gdb */
+        if (!(wp->flags & BP_CPU)) {
+            return;
+        }
+        cs->watchpoint_hit = NULL;
+        wp->flags &= ~BP_WATCHPOINT_HIT;
+        for (n = 0; n < TRICORE_DBG_TRIGGERS; n++) {
+            if (cpu->dbg_wp[n] == wp) {
+                break;
+            }
+        }
+        if (n == TRICORE_DBG_TRIGGERS) {
+            return;
+        }
+    } else if (env->dbg_after) {
+        n = env->dbg_after - 1;
+        env->dbg_after = 0;
+    } else {
+        return;
+    }
+
+    /* the instruction has executed, PC points behind it */
+    tricore_debug_event(env, DBG_EVTSRC_TR0 + n, tricore_debug_trevt(env, n),
+                        env->PC, 0);
+    cs->exception_index = -1;
+    cpu_loop_exit(cs);
+}
@@ -18,6 +18,8 @@
  */
 
 #include "qemu/osdep.h"
+#include <float.h>
+#include <math.h>
 #include "cpu.h"
 #include "exec/helper-proto.h"
 #include "fpu/softfloat.h"
@@ -117,13 +119,159 @@ static void f_update_psw_flags(CPUTriCoreState *env, uint8_t flags)
     env->FPU_FS = some_excp;
 }
 
-#define FADD_SUB(op)                                                           \
+/*
+ * Host FPU fast path for ADD.F, SUB.F, MUL.F, DIV.F, MADD.F and MSUB.F
+ *
+ * softfloat's own hardfloat code is never used for TriCore: it requires
+ * the inexact flag to be set already, and it rejects flush-to-zero mode.
+ * Instead the operation is done on the host in double precision, where
+ * it is either exact or, for ADD.F/SUB.F/DIV.F, rounded once, which
+ * still rounds to the correct float32 result. Denormal inputs are
+ * replaced by zeros (DAZ) up front. NaN and infinite inputs, results
+ * that may be tiny or overflow and MADD.F/MSUB.F sums which are not exact
+ * in double precision go to softfloat. Only round to nearest even is
+ * handled, as that is the mode the host FPU runs in.
+ */
+#if FLT_EVAL_METHOD == 0 && !defined(__FAST_MATH__)
+# define F_FAST_PATH 1
+#else
+# define F_FAST_PATH 0
+#endif
+
+typedef union {
+    uint32_t s;
+    float h;
+} f_host32;
+
+static inline bool f_fast_enabled(CPUTriCoreState *env)
+{
+    return F_FAST_PATH &&
+        get_float_rounding_mode(&env->fp_status) == float_round_nearest_even;
+}
+
+/* the operand as a double, false for NaN and infinity */
+static inline bool f_fast_arg(uint32_t r, double *d)
+{
+    f_host32 u = { .s = r };
+
+    if (float32_is_zero_or_denormal(make_float32(r))) {
+        *d = (r >> 31) ? -0.0 : 0.0;
+        return true;
+    }
+    if (!float32_is_normal(make_float32(r))) {
+        return false;
+    }
+    *d = u.h;
+    return true;
+}
+
+/* whether s = a + b is exact, see Knuth's TwoSum */
+static inline bool f_fast_sum_exact(double a, double b, double s)
+{
+    double bv = s - a;
+
+    return (a - (s - bv)) + (b - bv) == 0;
+}
+
+/*
+ * Round d to float32 and update the PSW like softfloat would. inexact is
+ * set if d is known to differ from the exact result. Otherwise the result
+ * is inexact if d is not a float32, which also holds for a quotient
+ * rounded to double: it only equals a float32 if the exact quotient does.
+ */
+static inline bool f_fast_result(CPUTriCoreState *env, double d,
+                                 bool inexact, uint32_t *res)
+{
+    f_host32 u;
+
+    if (d != 0 && fabs(d) <= FLT_MIN) {
+        return false;
+    }
+    u.h = d;
+    if (isinf(u.h)) {
+        return false;
+    }
+    if (inexact || u.h != d) {
+        f_update_psw_flags(env, float_flag_inexact);
+    } else {
+        env->FPU_FS = 0;
+    }
+    *res = u.s;
+    return true;
+}
+
+static bool f_fast_add(CPUTriCoreState *env, uint32_t r1, uint32_t r2,
+                       bool sub, uint32_t *res)
+{
+    double a, b, s;
+
+    if (!f_fast_enabled(env) || !f_fast_arg(r1, &a) || !f_fast_arg(r2, &b)) {
+        return false;
+    }
+    if (sub) {
+        b = -b;
+    }
+    s = a + b;
+    return f_fast_result(env, s, !f_fast_sum_exact(a, b, s), res);
+}
+
+static bool f_fast_mul(CPUTriCoreState *env, uint32_t r1, uint32_t r2,
+                       uint32_t *res)
+{
+    double a, b;
+
+    if (!f_fast_enabled(env) || !f_fast_arg(r1, &a) || !f_fast_arg(r2, &b)) {
+        return false;
+    }
+    /* 24 x 24 bit significands, the product is exact */
+    return f_fast_result(env, a * b, false, res);
+}
+
+static bool f_fast_div(CPUTriCoreState *env, uint32_t r1, uint32_t r2,
+                       uint32_t *res)
+{
+    double a, b;
+
+    if (!f_fast_enabled(env) || !f_fast_arg(r1, &a) || !f_fast_arg(r2, &b) ||
+        b == 0) {
+        return false;
+    }
+    return f_fast_result(env, a / b, false, res);
+}
+
+static bool f_fast_muladd(CPUTriCoreState *env, uint32_t r1, uint32_t r2,
+                          uint32_t r3, bool negate_product, uint32_t *res)
+{
+    double a, b, c, p, s;
+
+    if (!f_fast_enabled(env) || !f_fast_arg(r1, &a) || !f_fast_arg(r2, &b) ||
+        !f_fast_arg(r3, &c)) {
+        return false;
+    }
+    p = a * b;
+    if (negate_product) {
+        p = -p;
+    }
+    s = p + c;
+    /* a sum rounded in double precision would be rounded twice */
+    if (!f_fast_sum_exact(p, c, s)) {
+        return false;
+    }
+    return f_fast_result(env, s, false, res);
+}
+
+#define FADD_SUB(op, sub)                                                      \
 uint32_t helper_f##op(CPUTriCoreState *env, uint32_t r1, uint32_t r2)          \
 {                                                                              \
     float32 arg1 = make_float32(r1);                                           \
     float32 arg2 = make_float32(r2);                                           \
     uint32_t flags;                                                            \
     float32 f_result;                                                          \
+    uint32_t result;                                                           \
+                                                                               \
+    if (f_fast_add(env, r2, r1, sub, &result)) {                               \
+        return result;                                                         \
+    }                                                                          \
                                                                                \
     f_result = float32_##op(arg2, arg1, &env->fp_status);                      \
     flags = f_get_excp_flags(env);                                             \
@@ -141,8 +289,8 @@ uint32_t helper_f##op(CPUTriCoreState *env, uint32_t r1, uint32_t r2)          \
     }                                                                          \
     return (uint32_t)f_result;                                                 \
 }
-FADD_SUB(add)
-FADD_SUB(sub)
+FADD_SUB(add, false)
+FADD_SUB(sub, true)
 
 uint32_t helper_fmul(CPUTriCoreState *env, uint32_t r1, uint32_t r2)
 {
@@ -150,6 +298,11 @@ uint32_t helper_fmul(CPUTriCoreState *env, uint32_t r1, uint32_t r2)
     float32 arg1 = make_float32(r1);
     float32 arg2 = make_float32(r2);
     float32 f_result;
+    uint32_t result;
+
+    if (f_fast_mul(env, r1, r2, &result)) {
+        return result;
+    }
 
     f_result = float32_mul(arg1, arg2, &env->fp_status);
 
@@ -257,6 +410,11 @@ uint32_t helper_fdiv(CPUTriCoreState *env, uint32_t r1, uint32_t r2)
     float32 arg1 = make_float32(r1);
     float32 arg2 = make_float32(r2);
     float32 f_result;
+    uint32_t result;
+
+    if (f_fast_div(env, r1, r2, &result)) {
+        return result;
+    }
 
     f_result = float32_div(arg1, arg2 , &env->fp_status);
 
@@ -285,6 +443,11 @@ uint32_t helper_fmadd(CPUTriCoreState *env, uint32_t r1,
     float32 arg2 = make_float32(r2);
     float32 arg3 = make_float32(r3);
     float32 f_result;
+    uint32_t result;
+
+    if (f_fast_muladd(env, r1, r2, r3, false, &result)) {
+        return result;
+    }
 
     f_result = float32_muladd(arg1, arg2, arg3, 0, &env->fp_status);
 
@@ -311,6 +474,11 @@ uint32_t helper_fmsub(CPUTriCoreState *env, uint32_t r1,
     float32 arg2 = make_float32(r2);
     float32 arg3 = make_float32(r3);
     float32 f_result;
+    uint32_t result;
+
+    if (f_fast_muladd(env, r1, r2, r3, true, &result)) {
+        return result;
+    }
 
     f_result = float32_muladd(arg1, arg2, arg3, float_muladd_negate_product,
                               &env->fp_status);
@@ -19,6 +19,7 @@
 
 #include "qemu/osdep.h"
 #include "gdbstub/helpers.h"
+#include "gdbstub/commands.h"
 #include "cpu.h"
 
 
@@ -130,8 +131,165 @@ int tricore_cpu_gdb_write_register(CPUState *cs, uint8_t *mem_buf, int n)
         env->gpr_d[n] = tmp;
     } else if (n < 32) { /* address registers */
         env->gpr_a[n - 16] = tmp;
+        tricore_gaddr_update(env);
     } else {
         tricore_cpu_gdb_write_csfr(env, n, tmp);
     }
     return 4;
 }
+
+/* every CSFR of csfr.h.inc, the ones in the core feature are skipped */
+typedef struct TriCoreGDBCSFR {
+    const char *name;
+    uint32_t addr;
+    size_t offset;
+    int feature;
+    bool writable;
+    /* feature removes the register instead of introducing it */
+    bool removed;
+} TriCoreGDBCSFR;
+
+#define R(ADDR, NAME, FEATURE) \
+    { #NAME, ADDR, offsetof(CPUTriCoreState, NAME), FEATURE, false },
+#define A(ADDR, NAME, FEATURE) \
+    { #NAME, ADDR, offsetof(CPUTriCoreState, NAME), FEATURE, true },
+#define E(ADDR, NAME, FEATURE) A(ADDR, NAME, FEATURE)
+#define T(ADDR, NAME, FEATURE) \
+    { #NAME, ADDR, offsetof(CPUTriCoreState, NAME), FEATURE, true, true },
+static const TriCoreGDBCSFR tricore_gdb_csfrs[] = {
+#include "csfr.h.inc"
+};
+#undef R
+#undef A
+#undef E
+#undef T
+
+static bool tricore_gdb_csfr_in_core(uint32_t addr)
+{
+    switch (addr) {
+    case 0xfe00: /* PCXI */
+    case 0xfe08: /* PC */
+    case 0xfe14: /* SYSCON */
+    case 0xfe20: /* BIV */
+    case 0xfe24: /* BTV */
+    case 0xfe28: /* ISP */
+    case 0xfe2c: /* ICR */
+    case 0xfe38: /* FCX */
+    case 0xfe3c: /* LCX */
+        return true;
+    default:
+        return false;
+    }
+}
+
+static uint32_t *tricore_gdb_csfr_ptr(CPUState *cs, int n,
+                                      const TriCoreGDBCSFR **def)
+{
+    TriCoreCPU *cpu = TRICORE_CPU(cs);
+
+    *def = &tricore_gdb_csfrs[cpu->gdb_csfr_map[n]];
+    return (uint32_t *)((uint8_t *)&cpu->env + (*def)->offset);
+}
+
+static int tricore_gdb_get_csfr(CPUState *cs, GByteArray *buf, int n)
+{
+    const TriCoreGDBCSFR *def;
+
+    return gdb_get_reg32(buf, *tricore_gdb_csfr_ptr(cs, n, &def));
+}
+
+static int tricore_gdb_set_csfr(CPUState *cs, uint8_t *buf, int n)
+{
+    const TriCoreGDBCSFR *def;
+    uint32_t *ptr = tricore_gdb_csfr_ptr(cs, n, &def);
+
+    /* like the debug interface, ENDINIT does not apply here */
+    if (def->writable) {
+        *ptr = ldl_le_p(buf);
+        if (tricore_is_debug_csfr(def->addr)) {
+            tricore_debug_update(cpu_env(cs));
+        }
+    }
+    return 4;
+}
+
+/* CSAs per reply, each takes 136 hex digits: its link and its 16 words */
+#define TRICORE_GDB_CSA_PER_PACKET 28
+
+/*
+ * qqemu.tricore.csa:<link> returns the context save areas starting at the
+ * PCXI value <link> in one packet. The reply starts with 'l' when the end
+ * of the list was reached and with 'm' when the client has to continue at
+ * word 0 of the last CSA. Each CSA is sent as its link followed by its 16
+ * words, all as 8 digit hex numbers.
+ */
+static void handle_query_csa(GArray *params, void *user_ctx)
+{
+    CPUState *cs = user_ctx;
+    uint32_t link = gdb_get_cmd_param(params, 0)->val_ul;
+    g_autoptr(GString) reply = g_string_new("l");
+    uint32_t csa[16];
+
+    for (int n = 0; link & (R_PCXI_PCXS_MASK | R_PCXI_PCXO_MASK); n++) {
+        uint32_t ea = (FIELD_EX32(link, PCXI, PCXS) << 28) |
+                      (FIELD_EX32(link, PCXI, PCXO) << 6);
+
+        if (n == TRICORE_GDB_CSA_PER_PACKET) {
+            reply->str[0] = 'm';
+            break;
+        }
+        if (cpu_memory_rw_debug(cs, ea, csa, sizeof(csa), false)) {
+            gdb_put_packet("E14");
+            return;
+        }
+
+        g_string_append_printf(reply, "%08x", link);
+        for (int i = 0; i < ARRAY_SIZE(csa); i++) {
+            g_string_append_printf(reply, "%08x", le32_to_cpu(csa[i]));
+        }
+        link = le32_to_cpu(csa[0]);
+    }
+
+    gdb_put_packet(reply->str);
+}
+
+static const GdbCmdParseEntry tricore_gdb_query_csa = {
+    .handler = handle_query_csa,
+    .cmd = "qemu.tricore.csa:",
+    .cmd_startswith = true,
+    .schema = "l0",
+    .need_cpu_context = true,
+};
+
+void tricore_cpu_register_gdb_regs(CPUState *cs)
+{
+    g_autoptr(GPtrArray) query_table = g_ptr_array_new();
+    TriCoreCPU *cpu = TRICORE_CPU(cs);
+    CPUTriCoreState *env = &cpu->env;
+    GDBFeatureBuilder builder;
+    int reg = 0;
+
+    cpu->gdb_csfr_map = g_new(uint16_t, ARRAY_SIZE(tricore_gdb_csfrs));
+    gdb_feature_builder_init(&builder, &cpu->gdb_csfr_feature,
+                             "org.qemu.gdb.tricore.csfr", "tricore-csfr.xml",
+                             cs->gdb_num_regs);
+
+    for (int i = 0; i < ARRAY_SIZE(tricore_gdb_csfrs); i++) {
+        const TriCoreGDBCSFR *def = &tricore_gdb_csfrs[i];
+
+        if (tricore_gdb_csfr_in_core(def->addr) ||
+            tricore_has_feature(env, def->feature) == def->removed) {
+            continue;
+        }
+        cpu->gdb_csfr_map[reg] = i;
+        gdb_feature_builder_append_reg(&builder, g_ascii_strdown(def->name, -1),
+                                       32, reg++, "uint32", "system");
+    }
+
+    gdb_feature_builder_end(&builder);
+    gdb_register_coprocessor(cs, tricore_gdb_get_csfr, tricore_gdb_set_csfr,
+                             &cpu->gdb_csfr_feature, 0);
+
+    g_ptr_array_add(query_table, (gpointer)&tricore_gdb_query_csa);
+    gdb_extend_query_table(query_table);
+}
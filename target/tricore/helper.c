@@ -17,6 +17,7 @@
 
 #include "qemu/osdep.h"
 #include "qemu/log.h"
+#include "qemu/lockable.h"
 #include "hw/registerfields.h"
 #include "cpu.h"
 #include "exec/exec-all.h"
@@ -24,6 +25,7 @@
 #include "fpu/softfloat-helpers.h"
 #include "qemu/qemu-print.h"
 
+#ifndef CONFIG_USER_ONLY
 enum {
     TLBRET_DIRTY = -4,
     TLBRET_INVALID = -3,
@@ -95,6 +97,7 @@ bool tricore_cpu_tlb_fill(CPUState *cs, vaddr address, int size,
         cpu_loop_exit_restore(cs, retaddr);
     }
 }
+#endif
 
 void fpu_set_state(CPUTriCoreState *env)
 {
@@ -145,6 +148,65 @@ void psw_write(CPUTriCoreState *env, uint32_t val)
     fpu_set_state(env);
 }
 
+/*
+ * The sets of A0, A1, A8 and A9 seen by all CPUs, key n is entry n - 1.
+ * Entries never change once added, so they are read without the lock.
+ */
+static struct {
+    QemuMutex lock;
+    unsigned count;
+    uint32_t regs[TRICORE_GADDR_KEYS][4];
+} gaddr_tab;
+
+static void __attribute__((constructor)) tricore_gaddr_init(void)
+{
+    qemu_mutex_init(&gaddr_tab.lock);
+}
+
+const uint32_t *tricore_gaddr_values(uint32_t key)
+{
+    assert(key >= 1 && key <= TRICORE_GADDR_KEYS);
+    return gaddr_tab.regs[key - 1];
+}
+
+/*
+ * Called whenever A0, A1, A8 or A9 may have changed. The TBs of the old
+ * key stay valid for the old values, so there is nothing to flush. Once
+ * the table is full, new values run unspecialised.
+ */
+void tricore_gaddr_update(CPUTriCoreState *env)
+{
+    uint32_t regs[4] = {
+        env->gpr_a[0], env->gpr_a[1], env->gpr_a[8], env->gpr_a[9]
+    };
+    unsigned i;
+
+    if (!env_archcpu(env)->gaddr_const) {
+        env->gaddr_key = 0;
+        return;
+    }
+    if (env->gaddr_key &&
+        !memcmp(regs, tricore_gaddr_values(env->gaddr_key), sizeof(regs))) {
+        return;
+    }
+
+    QEMU_LOCK_GUARD(&gaddr_tab.lock);
+    for (i = 0; i < gaddr_tab.count; i++) {
+        if (!memcmp(regs, gaddr_tab.regs[i], sizeof(regs))) {
+            break;
+        }
+    }
+    if (i == TRICORE_GADDR_KEYS) {
+        env->gaddr_key = 0;
+        return;
+    }
+    if (i == gaddr_tab.count) {
+        memcpy(gaddr_tab.regs[i], regs, sizeof(regs));
+        gaddr_tab.count++;
+    }
+    env->gaddr_key = i + 1;
+}
+
 #define FIELD_GETTER_WITH_FEATURE(NAME, REG, FIELD, FEATURE)     \
 uint32_t NAME(CPUTriCoreState *env)                             \
 {                                                                \
@@ -37,16 +37,10 @@ DEF_HELPER_3(absdif_ssov, i32, env, i32, i32)
 DEF_HELPER_4(madd32_ssov, i32, env, i32, i32, i32)
 DEF_HELPER_4(madd32_suov, i32, env, i32, i32, i32)
 DEF_HELPER_4(madd64_ssov, i64, env, i32, i64, i32)
-DEF_HELPER_5(madd64_q_ssov, i64, env, i64, i32, i32, i32)
-DEF_HELPER_3(madd32_q_add_ssov, i32, env, i64, i64)
-DEF_HELPER_5(maddr_q_ssov, i32, env, i32, i32, i32, i32)
 DEF_HELPER_4(madd64_suov, i64, env, i32, i64, i32)
 DEF_HELPER_4(msub32_ssov, i32, env, i32, i32, i32)
 DEF_HELPER_4(msub32_suov, i32, env, i32, i32, i32)
 DEF_HELPER_4(msub64_ssov, i64, env, i32, i64, i32)
-DEF_HELPER_5(msub64_q_ssov, i64, env, i64, i32, i32, i32)
-DEF_HELPER_3(msub32_q_sub_ssov, i32, env, i64, i64)
-DEF_HELPER_5(msubr_q_ssov, i32, env, i32, i32, i32, i32)
 DEF_HELPER_4(msub64_suov, i64, env, i32, i64, i32)
 DEF_HELPER_3(absdif_h_ssov, i32, env, i32, i32)
 DEF_HELPER_2(abs_ssov, i32, env, i32)
@@ -129,10 +123,6 @@ DEF_HELPER_FLAGS_2(dvstep, TCG_CALL_NO_RWG_SE, i64, i64, i32)
 DEF_HELPER_FLAGS_2(dvstep_u, TCG_CALL_NO_RWG_SE, i64, i64, i32)
 DEF_HELPER_3(divide, i64, env, i32, i32)
 DEF_HELPER_3(divide_u, i64, env, i32, i32)
-/* mulh */
-DEF_HELPER_FLAGS_5(mul_h, TCG_CALL_NO_RWG_SE, i64, i32, i32, i32, i32, i32)
-DEF_HELPER_FLAGS_5(mulm_h, TCG_CALL_NO_RWG_SE, i64, i32, i32, i32, i32, i32)
-DEF_HELPER_FLAGS_5(mulr_h, TCG_CALL_NO_RWG_SE, i32, i32, i32, i32, i32, i32)
 /* crc32 */
 DEF_HELPER_FLAGS_2(crc32b, TCG_CALL_NO_RWG_SE, i32, i32, i32)
 DEF_HELPER_FLAGS_2(crc32_be, TCG_CALL_NO_RWG_SE, i32, i32, i32)
@@ -158,5 +148,14 @@ DEF_HELPER_2(circ_update, i32, i32, i32)
 /* PSW cache helper */
 DEF_HELPER_2(psw_write, void, env, i32)
 DEF_HELPER_1(psw_read, i32, env)
+/* Global address register specialisation */
+DEF_HELPER_FLAGS_1(gaddr_update, TCG_CALL_NO_WG, void, env)
+/* Bus timing model */
+DEF_HELPER_FLAGS_3(bus_access, TCG_CALL_NO_RWG, void, env, i32, i32)
 /* Exceptions */
 DEF_HELPER_3(raise_exception_sync, noreturn, env, i32, i32)
+/* On-chip debug triggers */
+DEF_HELPER_1(debug_update, void, env)
+DEF_HELPER_3(debug_trigger, void, env, i32, i32)
+DEF_HELPER_2(debug, void, env, i32)
+DEF_HELPER_1(semihosting, void, env)
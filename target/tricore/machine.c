@@ -0,0 +1,86 @@
+/*
+ *  TriCore CPU migration state.
+ *
+ *  Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "qemu/osdep.h"
+#include "cpu.h"
+#include "migration/cpu.h"
+
+static int tricore_env_post_load(void *opaque, int version_id)
+{
+    CPUTriCoreState *env = opaque;
+
+    /* the softfloat rounding mode is derived from PSW.RM */
+    fpu_set_state(env);
+    /* so are the debug watchpoints from DBGSR and TRnEVT/TRnADR */
+    tricore_debug_update(env);
+    /* the keys are local to this process */
+    tricore_gaddr_update(env);
+    return 0;
+}
+
+static const VMStateField vmstate_env_fields[] = {
+    VMSTATE_UINT32_ARRAY(gpr_a, CPUTriCoreState, 16),
+    VMSTATE_UINT32_ARRAY(gpr_d, CPUTriCoreState, 16),
+
+    VMSTATE_UINT32(PSW, CPUTriCoreState),
+    VMSTATE_UINT32(PSW_USB_C, CPUTriCoreState),
+    VMSTATE_UINT32(PSW_USB_V, CPUTriCoreState),
+    VMSTATE_UINT32(PSW_USB_SV, CPUTriCoreState),
+    VMSTATE_UINT32(PSW_USB_AV, CPUTriCoreState),
+    VMSTATE_UINT32(PSW_USB_SAV, CPUTriCoreState),
+    VMSTATE_UINT32(PC_entry, CPUTriCoreState),
+
+#define R(ADDR, NAME, FEATURE) VMSTATE_UINT32(NAME, CPUTriCoreState),
+#define A(ADDR, NAME, FEATURE) VMSTATE_UINT32(NAME, CPUTriCoreState),
+#define E(ADDR, NAME, FEATURE) VMSTATE_UINT32(NAME, CPUTriCoreState),
+#include "csfr.h.inc"
+#undef R
+#undef A
+#undef E
+
+    VMSTATE_UINT32(irq_pending, CPUTriCoreState),
+    VMSTATE_UINT32(reset_pending, CPUTriCoreState),
+    VMSTATE_UINT32(endinit, CPUTriCoreState),
+    VMSTATE_UINT32(cov_prev_loc, CPUTriCoreState),
+    VMSTATE_UINT32(dbg_after, CPUTriCoreState),
+    VMSTATE_UINT32(dbg_skip_pc, CPUTriCoreState),
+
+    VMSTATE_END_OF_LIST()
+};
+
+static const VMStateDescription vmstate_env = {
+    .name = "env",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .post_load = tricore_env_post_load,
+    .fields = vmstate_env_fields,
+};
+
+static const VMStateField vmstate_cpu_fields[] = {
+    VMSTATE_CPU(),
+    VMSTATE_STRUCT(env, TriCoreCPU, 1, vmstate_env, CPUTriCoreState),
+    VMSTATE_END_OF_LIST()
+};
+
+const VMStateDescription vmstate_tricore_cpu = {
+    .name = "cpu",
+    .version_id = 1,
+    .minimum_version_id = 1,
+    .fields = vmstate_cpu_fields,
+};
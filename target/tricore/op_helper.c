@@ -21,19 +21,15 @@
 #include "exec/helper-proto.h"
 #include "exec/exec-all.h"
 #include "exec/cpu_ldst.h"
-#include <zlib.h> /* for crc32 */
+#include "sysemu/cpu-timers.h"
+#include "qemu/crc32.h"
 
 
 /* Exception helpers */
 
-static G_NORETURN
-void raise_exception_sync_internal(CPUTriCoreState *env, uint32_t class, int tin,
-                                   uintptr_t pc, uint32_t fcd_pc)
+void tricore_cpu_enter_trap(CPUTriCoreState *env, uint32_t class, int tin,
+                            uint32_t fcd_pc)
 {
-    CPUState *cs = env_cpu(env);
-    /* in case we come from a helper-call we need to restore the PC */
-    cpu_restore_state(cs, pc);
-
     /* Tin is loaded into d[15] */
     env->gpr_d[15] = tin;
 
@@ -91,7 +87,24 @@ void raise_exception_sync_internal(CPUTriCoreState *env, uint32_t class, int tin
     pcxi_set_pcpn(env, icr_get_ccpn(env));
     /* Update PC using the trap vector table */
     env->PC = env->BTV | (class << 5);
+}
+
+static G_NORETURN
+void raise_exception_sync_internal(CPUTriCoreState *env, uint32_t class, int tin,
+                                   uintptr_t pc, uint32_t fcd_pc)
+{
+    CPUState *cs = env_cpu(env);
+    /* in case we come from a helper-call we need to restore the PC */
+    cpu_restore_state(cs, pc);
 
+#ifdef CONFIG_USER_ONLY
+    /* there is no trap table, cpu_loop() makes a syscall or signal of it */
+    env->trap_class = class;
+    env->trap_tin = tin;
+    cs->exception_index = EXCP_TRAP;
+#else
+    tricore_cpu_enter_trap(env, class, tin, fcd_pc);
+#endif
     cpu_loop_exit(cs);
 }
 
@@ -725,131 +738,6 @@ uint64_t helper_madd64_ssov(CPUTriCoreState *env, target_ulong r1,
     return ret;
 }
 
-uint32_t
-helper_madd32_q_add_ssov(CPUTriCoreState *env, uint64_t r1, uint64_t r2)
-{
-    int64_t result;
-
-    result = (r1 + r2);
-
-    env->PSW_USB_AV = (result ^ result * 2u);
-    env->PSW_USB_SAV |= env->PSW_USB_AV;
-
-    /* we do the saturation by hand, since we produce an overflow on the host
-       if the mul before was (0x80000000 * 0x80000000) << 1). If this is the
-       case, we flip the saturated value. */
-    if (r2 == 0x8000000000000000LL) {
-        if (result > 0x7fffffffLL) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            result = INT32_MIN;
-        } else if (result < -0x80000000LL) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            result = INT32_MAX;
-        } else {
-            env->PSW_USB_V = 0;
-        }
-    } else {
-        if (result > 0x7fffffffLL) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            result = INT32_MAX;
-        } else if (result < -0x80000000LL) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            result = INT32_MIN;
-        } else {
-            env->PSW_USB_V = 0;
-        }
-    }
-    return (uint32_t)result;
-}
-
-uint64_t helper_madd64_q_ssov(CPUTriCoreState *env, uint64_t r1, uint32_t r2,
-                              uint32_t r3, uint32_t n)
-{
-    int64_t t1 = (int64_t)r1;
-    int64_t t2 = sextract64(r2, 0, 32);
-    int64_t t3 = sextract64(r3, 0, 32);
-    int64_t result, mul;
-    int64_t ovf;
-
-    mul = (t2 * t3) << n;
-    result = mul + t1;
-
-    env->PSW_USB_AV = (result ^ result * 2u) >> 32;
-    env->PSW_USB_SAV |= env->PSW_USB_AV;
-
-    ovf = (result ^ mul) & ~(mul ^ t1);
-    /* we do the saturation by hand, since we produce an overflow on the host
-       if the mul was (0x80000000 * 0x80000000) << 1). If this is the
-       case, we flip the saturated value. */
-    if ((r2 == 0x80000000) && (r3 == 0x80000000) && (n == 1)) {
-        if (ovf >= 0) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            /* ext_ret > MAX_INT */
-            if (mul < 0) {
-                result = INT64_MAX;
-            /* ext_ret < MIN_INT */
-            } else {
-               result = INT64_MIN;
-            }
-        } else {
-            env->PSW_USB_V = 0;
-        }
-    } else {
-        if (ovf < 0) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            /* ext_ret > MAX_INT */
-            if (mul >= 0) {
-                result = INT64_MAX;
-            /* ext_ret < MIN_INT */
-            } else {
-               result = INT64_MIN;
-            }
-        } else {
-            env->PSW_USB_V = 0;
-        }
-    }
-    return (uint64_t)result;
-}
-
-uint32_t helper_maddr_q_ssov(CPUTriCoreState *env, uint32_t r1, uint32_t r2,
-                             uint32_t r3, uint32_t n)
-{
-    int64_t t1 = sextract64(r1, 0, 32);
-    int64_t t2 = sextract64(r2, 0, 32);
-    int64_t t3 = sextract64(r3, 0, 32);
-    int64_t mul, ret;
-
-    if ((t2 == -0x8000ll) && (t3 == -0x8000ll) && (n == 1)) {
-        mul = 0x7fffffff;
-    } else {
-        mul = (t2 * t3) << n;
-    }
-
-    ret = t1 + mul + 0x8000;
-
-    env->PSW_USB_AV = ret ^ ret * 2u;
-    env->PSW_USB_SAV |= env->PSW_USB_AV;
-
-    if (ret > 0x7fffffffll) {
-        env->PSW_USB_V = (1 << 31);
-        env->PSW_USB_SV |= env->PSW_USB_V;
-        ret = INT32_MAX;
-    } else if (ret < -0x80000000ll) {
-        env->PSW_USB_V = (1 << 31);
-        env->PSW_USB_SV |= env->PSW_USB_V;
-        ret = INT32_MIN;
-    } else {
-        env->PSW_USB_V = 0;
-    }
-    return ret & 0xffff0000ll;
-}
-
 uint64_t helper_madd64_suov(CPUTriCoreState *env, target_ulong r1,
                             uint64_t r2, target_ulong r3)
 {
@@ -971,134 +859,6 @@ uint64_t helper_msub64_suov(CPUTriCoreState *env, target_ulong r1,
     return ret;
 }
 
-uint32_t
-helper_msub32_q_sub_ssov(CPUTriCoreState *env, uint64_t r1, uint64_t r2)
-{
-    int64_t result;
-    int64_t t1 = (int64_t)r1;
-    int64_t t2 = (int64_t)r2;
-
-    result = t1 - t2;
-
-    env->PSW_USB_AV = (result ^ result * 2u);
-    env->PSW_USB_SAV |= env->PSW_USB_AV;
-
-    /* we do the saturation by hand, since we produce an overflow on the host
-       if the mul before was (0x80000000 * 0x80000000) << 1). If this is the
-       case, we flip the saturated value. */
-    if (r2 == 0x8000000000000000LL) {
-        if (result > 0x7fffffffLL) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            result = INT32_MIN;
-        } else if (result < -0x80000000LL) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            result = INT32_MAX;
-        } else {
-            env->PSW_USB_V = 0;
-        }
-    } else {
-        if (result > 0x7fffffffLL) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            result = INT32_MAX;
-        } else if (result < -0x80000000LL) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            result = INT32_MIN;
-        } else {
-            env->PSW_USB_V = 0;
-        }
-    }
-    return (uint32_t)result;
-}
-
-uint64_t helper_msub64_q_ssov(CPUTriCoreState *env, uint64_t r1, uint32_t r2,
-                              uint32_t r3, uint32_t n)
-{
-    int64_t t1 = (int64_t)r1;
-    int64_t t2 = sextract64(r2, 0, 32);
-    int64_t t3 = sextract64(r3, 0, 32);
-    int64_t result, mul;
-    int64_t ovf;
-
-    mul = (t2 * t3) << n;
-    result = t1 - mul;
-
-    env->PSW_USB_AV = (result ^ result * 2u) >> 32;
-    env->PSW_USB_SAV |= env->PSW_USB_AV;
-
-    ovf = (result ^ t1) & (t1 ^ mul);
-    /* we do the saturation by hand, since we produce an overflow on the host
-       if the mul before was (0x80000000 * 0x80000000) << 1). If this is the
-       case, we flip the saturated value. */
-    if (mul == 0x8000000000000000LL) {
-        if (ovf >= 0) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            /* ext_ret > MAX_INT */
-            if (mul >= 0) {
-                result = INT64_MAX;
-            /* ext_ret < MIN_INT */
-            } else {
-               result = INT64_MIN;
-            }
-        } else {
-            env->PSW_USB_V = 0;
-        }
-    } else {
-        if (ovf < 0) {
-            env->PSW_USB_V = (1 << 31);
-            env->PSW_USB_SV = (1 << 31);
-            /* ext_ret > MAX_INT */
-            if (mul < 0) {
-                result = INT64_MAX;
-            /* ext_ret < MIN_INT */
-            } else {
-               result = INT64_MIN;
-            }
-        } else {
-            env->PSW_USB_V = 0;
-        }
-    }
-
-    return (uint64_t)result;
-}
-
-uint32_t helper_msubr_q_ssov(CPUTriCoreState *env, uint32_t r1, uint32_t r2,
-                             uint32_t r3, uint32_t n)
-{
-    int64_t t1 = sextract64(r1, 0, 32);
-    int64_t t2 = sextract64(r2, 0, 32);
-    int64_t t3 = sextract64(r3, 0, 32);
-    int64_t mul, ret;
-
-    if ((t2 == -0x8000ll) && (t3 == -0x8000ll) && (n == 1)) {
-        mul = 0x7fffffff;
-    } else {
-        mul = (t2 * t3) << n;
-    }
-
-    ret = t1 - mul + 0x8000;
-
-    env->PSW_USB_AV = ret ^ ret * 2u;
-    env->PSW_USB_SAV |= env->PSW_USB_AV;
-
-    if (ret > 0x7fffffffll) {
-        env->PSW_USB_V = (1 << 31);
-        env->PSW_USB_SV |= env->PSW_USB_V;
-        ret = INT32_MAX;
-    } else if (ret < -0x80000000ll) {
-        env->PSW_USB_V = (1 << 31);
-        env->PSW_USB_SV |= env->PSW_USB_V;
-        ret = INT32_MIN;
-    } else {
-        env->PSW_USB_V = 0;
-    }
-    return ret & 0xffff0000ll;
-}
-
 uint32_t helper_abs_b(CPUTriCoreState *env, target_ulong arg)
 {
     int32_t b, i;
@@ -2215,90 +1975,19 @@ uint64_t helper_divide_u(CPUTriCoreState *env, uint32_t r1, uint32_t r2)
     return ((uint64_t)remainder << 32) | quotient;
 }
 
-uint64_t helper_mul_h(uint32_t arg00, uint32_t arg01,
-                      uint32_t arg10, uint32_t arg11, uint32_t n)
-{
-    uint32_t result0, result1;
-
-    int32_t sc1 = ((arg00 & 0xffff) == 0x8000) &&
-                  ((arg10 & 0xffff) == 0x8000) && (n == 1);
-    int32_t sc0 = ((arg01 & 0xffff) == 0x8000) &&
-                  ((arg11 & 0xffff) == 0x8000) && (n == 1);
-    if (sc1) {
-        result1 = 0x7fffffff;
-    } else {
-        result1 = (((uint32_t)(arg00 * arg10)) << n);
-    }
-    if (sc0) {
-        result0 = 0x7fffffff;
-    } else {
-        result0 = (((uint32_t)(arg01 * arg11)) << n);
-    }
-    return (((uint64_t)result1 << 32)) | result0;
-}
-
-uint64_t helper_mulm_h(uint32_t arg00, uint32_t arg01,
-                       uint32_t arg10, uint32_t arg11, uint32_t n)
-{
-    uint64_t ret;
-    int64_t result0, result1;
-
-    int32_t sc1 = ((arg00 & 0xffff) == 0x8000) &&
-                  ((arg10 & 0xffff) == 0x8000) && (n == 1);
-    int32_t sc0 = ((arg01 & 0xffff) == 0x8000) &&
-                  ((arg11 & 0xffff) == 0x8000) && (n == 1);
-
-    if (sc1) {
-        result1 = 0x7fffffff;
-    } else {
-        result1 = (((int32_t)arg00 * (int32_t)arg10) << n);
-    }
-    if (sc0) {
-        result0 = 0x7fffffff;
-    } else {
-        result0 = (((int32_t)arg01 * (int32_t)arg11) << n);
-    }
-    ret = (result1 + result0);
-    ret = ret << 16;
-    return ret;
-}
-uint32_t helper_mulr_h(uint32_t arg00, uint32_t arg01,
-                       uint32_t arg10, uint32_t arg11, uint32_t n)
-{
-    uint32_t result0, result1;
-
-    int32_t sc1 = ((arg00 & 0xffff) == 0x8000) &&
-                  ((arg10 & 0xffff) == 0x8000) && (n == 1);
-    int32_t sc0 = ((arg01 & 0xffff) == 0x8000) &&
-                  ((arg11 & 0xffff) == 0x8000) && (n == 1);
-
-    if (sc1) {
-        result1 = 0x7fffffff;
-    } else {
-        result1 = ((arg00 * arg10) << n) + 0x8000;
-    }
-    if (sc0) {
-        result0 = 0x7fffffff;
-    } else {
-        result0 = ((arg01 * arg11) << n) + 0x8000;
-    }
-    return (result1 & 0xffff0000) | (result0 >> 16);
-}
-
 uint32_t helper_crc32b(uint32_t arg0, uint32_t arg1)
 {
     uint8_t buf[1] = { arg0 & 0xff };
 
-    return crc32(arg1, buf, 1);
+    return crc32_ieee(arg1, buf, 1);
 }
 
-
 uint32_t helper_crc32_be(uint32_t arg0, uint32_t arg1)
 {
     uint8_t buf[4];
     stl_be_p(buf, arg0);
 
-    return crc32(arg1, buf, 4);
+    return crc32_ieee(arg1, buf, 4);
 }
 
 uint32_t helper_crc32_le(uint32_t arg0, uint32_t arg1)
@@ -2306,37 +1995,14 @@ uint32_t helper_crc32_le(uint32_t arg0, uint32_t arg1)
     uint8_t buf[4];
     stl_le_p(buf, arg0);
 
-    return crc32(arg1, buf, 4);
-}
-
-static uint32_t crc_div(uint32_t crc_in, uint32_t data, uint32_t gen,
-                        uint32_t n, uint32_t m)
-{
-    uint32_t i;
-
-    data = data << n;
-    for (i = 0; i < m; i++) {
-        if (crc_in & (1u << (n - 1))) {
-            crc_in <<= 1;
-            if (data & (1u << (m - 1))) {
-                crc_in++;
-            }
-            crc_in ^= gen;
-        } else {
-            crc_in <<= 1;
-            if (data & (1u << (m - 1))) {
-                crc_in++;
-            }
-        }
-        data <<= 1;
-    }
-
-    return crc_in;
+    return crc32_ieee(arg1, buf, 4);
 }
 
 uint32_t helper_crcn(uint32_t arg0, uint32_t arg1, uint32_t arg2)
 {
-    uint32_t crc_out, crc_in;
+    /* firmware tends to stick to one polynomial */
+    static __thread CRCTable crcn_table;
+    uint32_t crc_out;
     uint32_t n = extract32(arg0, 12, 4) + 1;
     uint32_t gen = extract32(arg0, 16, n);
     uint32_t inv = extract32(arg0, 9, 1);
@@ -2357,13 +2023,10 @@ uint32_t helper_crcn(uint32_t arg0, uint32_t arg1, uint32_t arg2)
         seed = ~seed;
     }
 
-    if (m > n) {
-        crc_in = (data >> (m - n)) ^ seed;
-    } else {
-        crc_in = (data << (n - m)) ^ seed;
+    if (crcn_table.width != n || crcn_table.poly != gen) {
+        crc_table_init(&crcn_table, n, gen);
     }
-
-    crc_out = crc_div(crc_in, data, gen, n, m);
+    crc_out = crc_table_update(&crcn_table, seed, data, m);
 
     if (inv) {
         crc_out = ~crc_out;
@@ -2459,88 +2122,127 @@ static bool cdc_zero(target_ulong *psw)
     return count == 0;
 }
 
+/* Bus timing model */
+
+static void tricore_bus_access(CPUTriCoreState *env, uint32_t addr,
+                               uint32_t size, bool is_write)
+{
+    CPUState *cs = env_cpu(env);
+    uint32_t cycles;
+
+    cycles = env->bus_timing(env->bus_timing_opaque, cs->cpu_index, addr,
+                             size, is_write);
+    if (cycles && icount_enabled()) {
+        icount_charge(cs, cycles);
+    }
+}
+
+/*
+ * Context words moved by the helpers themselves (CSA lists, the DCX area
+ * of the debug monitor) go past the translator, so they are reported to
+ * the bus timing model here, once the access has succeeded.
+ */
+uint32_t tricore_ctx_ldl(CPUTriCoreState *env, uint32_t addr)
+{
+    uint32_t val = cpu_ldl_data(env, addr);
+
+    if (env->bus_timing) {
+        tricore_bus_access(env, addr, 4, false);
+    }
+    return val;
+}
+
+void tricore_ctx_stl(CPUTriCoreState *env, uint32_t addr, uint32_t val)
+{
+    cpu_stl_data(env, addr, val);
+    if (env->bus_timing) {
+        tricore_bus_access(env, addr, 4, true);
+    }
+}
+
 static void save_context_upper(CPUTriCoreState *env, target_ulong ea)
 {
-    cpu_stl_data(env, ea, env->PCXI);
-    cpu_stl_data(env, ea+4, psw_read(env));
-    cpu_stl_data(env, ea+8, env->gpr_a[10]);
-    cpu_stl_data(env, ea+12, env->gpr_a[11]);
-    cpu_stl_data(env, ea+16, env->gpr_d[8]);
-    cpu_stl_data(env, ea+20, env->gpr_d[9]);
-    cpu_stl_data(env, ea+24, env->gpr_d[10]);
-    cpu_stl_data(env, ea+28, env->gpr_d[11]);
-    cpu_stl_data(env, ea+32, env->gpr_a[12]);
-    cpu_stl_data(env, ea+36, env->gpr_a[13]);
-    cpu_stl_data(env, ea+40, env->gpr_a[14]);
-    cpu_stl_data(env, ea+44, env->gpr_a[15]);
-    cpu_stl_data(env, ea+48, env->gpr_d[12]);
-    cpu_stl_data(env, ea+52, env->gpr_d[13]);
-    cpu_stl_data(env, ea+56, env->gpr_d[14]);
-    cpu_stl_data(env, ea+60, env->gpr_d[15]);
+    tricore_ctx_stl(env, ea, env->PCXI);
+    tricore_ctx_stl(env, ea + 4, psw_read(env));
+    tricore_ctx_stl(env, ea + 8, env->gpr_a[10]);
+    tricore_ctx_stl(env, ea + 12, env->gpr_a[11]);
+    tricore_ctx_stl(env, ea + 16, env->gpr_d[8]);
+    tricore_ctx_stl(env, ea + 20, env->gpr_d[9]);
+    tricore_ctx_stl(env, ea + 24, env->gpr_d[10]);
+    tricore_ctx_stl(env, ea + 28, env->gpr_d[11]);
+    tricore_ctx_stl(env, ea + 32, env->gpr_a[12]);
+    tricore_ctx_stl(env, ea + 36, env->gpr_a[13]);
+    tricore_ctx_stl(env, ea + 40, env->gpr_a[14]);
+    tricore_ctx_stl(env, ea + 44, env->gpr_a[15]);
+    tricore_ctx_stl(env, ea + 48, env->gpr_d[12]);
+    tricore_ctx_stl(env, ea + 52, env->gpr_d[13]);
+    tricore_ctx_stl(env, ea + 56, env->gpr_d[14]);
+    tricore_ctx_stl(env, ea + 60, env->gpr_d[15]);
 }
 
 static void save_context_lower(CPUTriCoreState *env, target_ulong ea)
 {
-    cpu_stl_data(env, ea, env->PCXI);
-    cpu_stl_data(env, ea+4, env->gpr_a[11]);
-    cpu_stl_data(env, ea+8, env->gpr_a[2]);
-    cpu_stl_data(env, ea+12, env->gpr_a[3]);
-    cpu_stl_data(env, ea+16, env->gpr_d[0]);
-    cpu_stl_data(env, ea+20, env->gpr_d[1]);
-    cpu_stl_data(env, ea+24, env->gpr_d[2]);
-    cpu_stl_data(env, ea+28, env->gpr_d[3]);
-    cpu_stl_data(env, ea+32, env->gpr_a[4]);
-    cpu_stl_data(env, ea+36, env->gpr_a[5]);
-    cpu_stl_data(env, ea+40, env->gpr_a[6]);
-    cpu_stl_data(env, ea+44, env->gpr_a[7]);
-    cpu_stl_data(env, ea+48, env->gpr_d[4]);
-    cpu_stl_data(env, ea+52, env->gpr_d[5]);
-    cpu_stl_data(env, ea+56, env->gpr_d[6]);
-    cpu_stl_data(env, ea+60, env->gpr_d[7]);
+    tricore_ctx_stl(env, ea, env->PCXI);
+    tricore_ctx_stl(env, ea + 4, env->gpr_a[11]);
+    tricore_ctx_stl(env, ea + 8, env->gpr_a[2]);
+    tricore_ctx_stl(env, ea + 12, env->gpr_a[3]);
+    tricore_ctx_stl(env, ea + 16, env->gpr_d[0]);
+    tricore_ctx_stl(env, ea + 20, env->gpr_d[1]);
+    tricore_ctx_stl(env, ea + 24, env->gpr_d[2]);
+    tricore_ctx_stl(env, ea + 28, env->gpr_d[3]);
+    tricore_ctx_stl(env, ea + 32, env->gpr_a[4]);
+    tricore_ctx_stl(env, ea + 36, env->gpr_a[5]);
+    tricore_ctx_stl(env, ea + 40, env->gpr_a[6]);
+    tricore_ctx_stl(env, ea + 44, env->gpr_a[7]);
+    tricore_ctx_stl(env, ea + 48, env->gpr_d[4]);
+    tricore_ctx_stl(env, ea + 52, env->gpr_d[5]);
+    tricore_ctx_stl(env, ea + 56, env->gpr_d[6]);
+    tricore_ctx_stl(env, ea + 60, env->gpr_d[7]);
 }
 
 static void restore_context_upper(CPUTriCoreState *env, target_ulong ea,
                                   target_ulong *new_PCXI, target_ulong *new_PSW)
 {
-    *new_PCXI = cpu_ldl_data(env, ea);
-    *new_PSW = cpu_ldl_data(env, ea+4);
-    env->gpr_a[10] = cpu_ldl_data(env, ea+8);
-    env->gpr_a[11] = cpu_ldl_data(env, ea+12);
-    env->gpr_d[8]  = cpu_ldl_data(env, ea+16);
-    env->gpr_d[9]  = cpu_ldl_data(env, ea+20);
-    env->gpr_d[10] = cpu_ldl_data(env, ea+24);
-    env->gpr_d[11] = cpu_ldl_data(env, ea+28);
-    env->gpr_a[12] = cpu_ldl_data(env, ea+32);
-    env->gpr_a[13] = cpu_ldl_data(env, ea+36);
-    env->gpr_a[14] = cpu_ldl_data(env, ea+40);
-    env->gpr_a[15] = cpu_ldl_data(env, ea+44);
-    env->gpr_d[12] = cpu_ldl_data(env, ea+48);
-    env->gpr_d[13] = cpu_ldl_data(env, ea+52);
-    env->gpr_d[14] = cpu_ldl_data(env, ea+56);
-    env->gpr_d[15] = cpu_ldl_data(env, ea+60);
+    *new_PCXI = tricore_ctx_ldl(env, ea);
+    *new_PSW = tricore_ctx_ldl(env, ea + 4);
+    env->gpr_a[10] = tricore_ctx_ldl(env, ea + 8);
+    env->gpr_a[11] = tricore_ctx_ldl(env, ea + 12);
+    env->gpr_d[8]  = tricore_ctx_ldl(env, ea + 16);
+    env->gpr_d[9]  = tricore_ctx_ldl(env, ea + 20);
+    env->gpr_d[10] = tricore_ctx_ldl(env, ea + 24);
+    env->gpr_d[11] = tricore_ctx_ldl(env, ea + 28);
+    env->gpr_a[12] = tricore_ctx_ldl(env, ea + 32);
+    env->gpr_a[13] = tricore_ctx_ldl(env, ea + 36);
+    env->gpr_a[14] = tricore_ctx_ldl(env, ea + 40);
+    env->gpr_a[15] = tricore_ctx_ldl(env, ea + 44);
+    env->gpr_d[12] = tricore_ctx_ldl(env, ea + 48);
+    env->gpr_d[13] = tricore_ctx_ldl(env, ea + 52);
+    env->gpr_d[14] = tricore_ctx_ldl(env, ea + 56);
+    env->gpr_d[15] = tricore_ctx_ldl(env, ea + 60);
 }
 
 static void restore_context_lower(CPUTriCoreState *env, target_ulong ea,
                                   target_ulong *ra, target_ulong *pcxi)
 {
-    *pcxi = cpu_ldl_data(env, ea);
-    *ra = cpu_ldl_data(env, ea+4);
-    env->gpr_a[2] = cpu_ldl_data(env, ea+8);
-    env->gpr_a[3] = cpu_ldl_data(env, ea+12);
-    env->gpr_d[0] = cpu_ldl_data(env, ea+16);
-    env->gpr_d[1] = cpu_ldl_data(env, ea+20);
-    env->gpr_d[2] = cpu_ldl_data(env, ea+24);
-    env->gpr_d[3] = cpu_ldl_data(env, ea+28);
-    env->gpr_a[4] = cpu_ldl_data(env, ea+32);
-    env->gpr_a[5] = cpu_ldl_data(env, ea+36);
-    env->gpr_a[6] = cpu_ldl_data(env, ea+40);
-    env->gpr_a[7] = cpu_ldl_data(env, ea+44);
-    env->gpr_d[4] = cpu_ldl_data(env, ea+48);
-    env->gpr_d[5] = cpu_ldl_data(env, ea+52);
-    env->gpr_d[6] = cpu_ldl_data(env, ea+56);
-    env->gpr_d[7] = cpu_ldl_data(env, ea+60);
-}
-
+    *pcxi = tricore_ctx_ldl(env, ea);
+    *ra = tricore_ctx_ldl(env, ea + 4);
+    env->gpr_a[2] = tricore_ctx_ldl(env, ea + 8);
+    env->gpr_a[3] = tricore_ctx_ldl(env, ea + 12);
+    env->gpr_d[0] = tricore_ctx_ldl(env, ea + 16);
+    env->gpr_d[1] = tricore_ctx_ldl(env, ea + 20);
+    env->gpr_d[2] = tricore_ctx_ldl(env, ea + 24);
+    env->gpr_d[3] = tricore_ctx_ldl(env, ea + 28);
+    env->gpr_a[4] = tricore_ctx_ldl(env, ea + 32);
+    env->gpr_a[5] = tricore_ctx_ldl(env, ea + 36);
+    env->gpr_a[6] = tricore_ctx_ldl(env, ea + 40);
+    env->gpr_a[7] = tricore_ctx_ldl(env, ea + 44);
+    env->gpr_d[4] = tricore_ctx_ldl(env, ea + 48);
+    env->gpr_d[5] = tricore_ctx_ldl(env, ea + 52);
+    env->gpr_d[6] = tricore_ctx_ldl(env, ea + 56);
+    env->gpr_d[7] = tricore_ctx_ldl(env, ea + 60);
+}
+
+#ifndef CONFIG_USER_ONLY
 void tricore_cpu_do_interrupt(CPUState *cs)
 {
     TriCoreCPU *cpu = TRICORE_CPU(cs);
@@ -2579,7 +2281,7 @@ void tricore_cpu_do_interrupt(CPUState *cs)
     ea = ((env->FCX & MASK_FCX_FCXS) << 12) + ((env->FCX & MASK_FCX_FCXO) << 6);
 
     /* new_FCX = M(EA, word); */
-    new_FCX = cpu_ldl_data(env, ea);
+    new_FCX = tricore_ctx_ldl(env, ea);
 
     helper_stucx(env, ea);
 
@@ -2658,7 +2360,13 @@ void tricore_cpu_do_interrupt(CPUState *cs)
     env->PCXI = (env->PCXI & 0xfff00000) | (env->FCX & 0xfffff);
     /* FCX[19: 0] = new_FCX[19: 0]; */
     env->FCX = (env->FCX & 0xfff00000) | (new_FCX & 0xfffff);
+
+    if (unlikely(env->irq_event)) {
+        env->irq_event(env->irq_event_opaque, true, icr_get_ccpn(env),
+                       env->PCXI);
+    }
 }
+#endif
 
 void helper_call(CPUTriCoreState *env, uint32_t next_pc)
 {
@@ -2695,7 +2403,7 @@ void helper_call(CPUTriCoreState *env, uint32_t next_pc)
     ea = ((env->FCX & MASK_FCX_FCXS) << 12) +
          ((env->FCX & MASK_FCX_FCXO) << 6);
     /* new_FCX = M(EA, word); */
-    new_FCX = cpu_ldl_data(env, ea);
+    new_FCX = tricore_ctx_ldl(env, ea);
     /* M(EA, 16 * word) = {PCXI, PSW, A[10], A[11], D[8], D[9], D[10], D[11],
                            A[12], A[13], A[14], A[15], D[12], D[13], D[14],
                            D[15]}; */
@@ -2761,7 +2469,7 @@ void helper_ret(CPUTriCoreState *env)
         A[13], A[14], A[15], D[12], D[13], D[14], D[15]} = M(EA, 16 * word); */
     restore_context_upper(env, ea, &new_PCXI, &new_PSW);
     /* M(EA, word) = FCX; */
-    cpu_stl_data(env, ea, env->FCX);
+    tricore_ctx_stl(env, ea, env->FCX);
     /* FCX[19: 0] = PCXI[19: 0]; */
     env->FCX = (env->FCX & 0xfff00000) + (env->PCXI & 0x000fffff);
     /* PCXI = new_PCXI; */
@@ -2791,7 +2499,7 @@ void helper_bisr(CPUTriCoreState *env, uint32_t const9)
     ea = ((env->FCX & 0xf0000) << 12) + ((env->FCX & 0xffff) << 6);
 
     /* new_FCX = M(EA, word); */
-    new_FCX = cpu_ldl_data(env, ea);
+    new_FCX = tricore_ctx_ldl(env, ea);
     /* M(EA, 16 * word) = {PCXI, A[11], A[2], A[3], D[0], D[1], D[2], D[3], A[4]
                            , A[5], A[6], A[7], D[4], D[5], D[6], D[7]}; */
     save_context_lower(env, ea);
@@ -2840,6 +2548,11 @@ void helper_rfe(CPUTriCoreState *env)
         /* raise NEST trap */
         raise_exception_sync_helper(env, TRAPC_CTX_MNG, TIN3_NEST, GETPC());
     }
+    /* RFE ends the TB, so the hook may read the instruction count */
+    if (unlikely(env->irq_event)) {
+        env->irq_event(env->irq_event_opaque, false, icr_get_ccpn(env),
+                       env->PCXI);
+    }
     env->PC = env->gpr_a[11] & ~0x1;
     /* ICR.IE = PCXI.PIE; */
     icr_set_ie(env, pcxi_get_pie(env));
@@ -2855,7 +2568,7 @@ void helper_rfe(CPUTriCoreState *env)
       A[13], A[14], A[15], D[12], D[13], D[14], D[15]} = M(EA, 16 * word); */
     restore_context_upper(env, ea, &new_PCXI, &new_PSW);
     /* M(EA, word) = FCX;*/
-    cpu_stl_data(env, ea, env->FCX);
+    tricore_ctx_stl(env, ea, env->FCX);
     /* FCX[19: 0] = PCXI[19: 0]; */
     env->FCX = (env->FCX & 0xfff00000) + (env->PCXI & 0x000fffff);
     /* PCXI = new_PCXI; */
@@ -2873,10 +2586,10 @@ void helper_rfm(CPUTriCoreState *env)
     icr_set_ccpn(env, pcxi_get_pcpn(env));
 
     /* {PCXI, PSW, A[10], A[11]} = M(DCX, 4 * word); */
-    env->PCXI = cpu_ldl_data(env, env->DCX);
-    psw_write(env, cpu_ldl_data(env, env->DCX+4));
-    env->gpr_a[10] = cpu_ldl_data(env, env->DCX+8);
-    env->gpr_a[11] = cpu_ldl_data(env, env->DCX+12);
+    env->PCXI = tricore_ctx_ldl(env, env->DCX);
+    psw_write(env, tricore_ctx_ldl(env, env->DCX + 4));
+    env->gpr_a[10] = tricore_ctx_ldl(env, env->DCX + 8);
+    env->gpr_a[11] = tricore_ctx_ldl(env, env->DCX + 12);
 
     if (tricore_has_feature(env, TRICORE_FEATURE_131)) {
         env->DBGTCR = 0;
@@ -2923,7 +2636,7 @@ void helper_svlcx(CPUTriCoreState *env)
     ea = ((env->FCX & MASK_FCX_FCXS) << 12) +
          ((env->FCX & MASK_FCX_FCXO) << 6);
     /* new_FCX = M(EA, word); */
-    new_FCX = cpu_ldl_data(env, ea);
+    new_FCX = tricore_ctx_ldl(env, ea);
     /* M(EA, 16 * word) = {PCXI, PSW, A[10], A[11], D[8], D[9], D[10], D[11],
                            A[12], A[13], A[14], A[15], D[12], D[13], D[14],
                            D[15]}; */
@@ -2966,7 +2679,7 @@ void helper_svucx(CPUTriCoreState *env)
     ea = ((env->FCX & MASK_FCX_FCXS) << 12) +
          ((env->FCX & MASK_FCX_FCXO) << 6);
     /* new_FCX = M(EA, word); */
-    new_FCX = cpu_ldl_data(env, ea);
+    new_FCX = tricore_ctx_ldl(env, ea);
     /* M(EA, 16 * word) = {PCXI, PSW, A[10], A[11], D[8], D[9], D[10], D[11],
                            A[12], A[13], A[14], A[15], D[12], D[13], D[14],
                            D[15]}; */
@@ -3016,9 +2729,9 @@ void helper_rslcx(CPUTriCoreState *env)
         A[13], A[14], A[15], D[12], D[13], D[14], D[15]} = M(EA, 16 * word); */
     restore_context_lower(env, ea, &env->gpr_a[11], &new_PCXI);
     /* M(EA, word) = FCX; */
-    cpu_stl_data(env, ea, env->FCX);
+    tricore_ctx_stl(env, ea, env->FCX);
     /* M(EA, word) = FCX; */
-    cpu_stl_data(env, ea, env->FCX);
+    tricore_ctx_stl(env, ea, env->FCX);
     /* FCX[19: 0] = PCXI[19: 0]; */
     env->FCX = (env->FCX & 0xfff00000) + (env->PCXI & 0x000fffff);
     /* PCXI = new_PCXI; */
@@ -3034,3 +2747,32 @@ uint32_t helper_psw_read(CPUTriCoreState *env)
 {
     return psw_read(env);
 }
+
+void helper_gaddr_update(CPUTriCoreState *env)
+{
+    tricore_gaddr_update(env);
+}
+
+/* DEBUG with semihosting enabled, PC already points behind it */
+void helper_semihosting(CPUTriCoreState *env)
+{
+#ifdef CONFIG_USER_ONLY
+    /* cpu_loop() makes the call, outside of cpu_exec() */
+    CPUState *cs = env_cpu(env);
+
+    cs->exception_index = EXCP_SEMIHOST;
+    cpu_loop_exit(cs);
+#else
+    tricore_semihosting(env);
+#endif
+}
+
+/*
+ * Stall cycles advance QEMU_CLOCK_VIRTUAL through icount_charge(), which
+ * leaves the exit of the running TB where it is.
+ */
+void helper_bus_access(CPUTriCoreState *env, uint32_t addr, uint32_t info)
+{
+    tricore_bus_access(env, addr, info & BUS_ACCESS_SIZE_MASK,
+                       (info & BUS_ACCESS_WRITE) != 0);
+}
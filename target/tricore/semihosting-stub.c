@@ -0,0 +1,15 @@
+/*
+ * TriCore semihosting stub
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "qemu/osdep.h"
+#include "cpu.h"
+
+void tricore_semihosting(CPUTriCoreState *env)
+{
+    g_assert_not_reached();
+}
@@ -31,6 +31,7 @@
 #include "tricore-opcodes.h"
 #include "exec/translator.h"
 #include "exec/log.h"
+#include "semihosting/semihost.h"
 
 #define HELPER_H "helper.h"
 #include "exec/helper-info.c.inc"
@@ -78,6 +79,35 @@ typedef struct DisasContext {
     int priv;
     uint64_t features;
     uint32_t icr_ie_mask, icr_ie_offset;
+    bool bus_timing;
+    /* pipeline timing model, see tricore_insn_cost() */
+    bool pipeline_timing;
+    bool prev_ip;
+    uint32_t cycles;
+    TCGOp *cycles_op;
+    /* edge coverage bitmap, NULL if disabled */
+    uint8_t *cov_area;
+    /* armed debug code triggers, see tricore_debug_update() */
+    uint32_t dbg_code_triggers;
+    /* per format counters, NULL unless decode-stats is set */
+    uint64_t *decode_count;
+    /* instructions after this one it covers, see tricore_dv_fusion() */
+    int fused;
+    /* A0, A1, A8 and A9 of a specialised TB, see gen_base_offset() */
+    const uint32_t *gaddr;
+    bool gaddr_track;
+    bool gaddr_dirty;
+    /* the instruction writes one of them, see dest_a() */
+    bool gaddr_written;
+    /* scratchpad windows, NULL if not used, see gen_spr_access() */
+    const TriCoreSPRWindow *spr;
+    unsigned spr_count;
+    /* window of the stack and the last A10 based address */
+    int sp_win;
+    TCGv sp_addr;
+    /* the last constant address and its value, see gen_const_addr() */
+    TCGv const_addr;
+    uint32_t const_val;
 } DisasContext;
 
 static int has_feature(DisasContext *ctx, int feature)
@@ -133,50 +163,118 @@ void tricore_cpu_dump_state(CPUState *cs, FILE *f, int flags)
     gen_helper_##name(tcg_env, helper_tmp);                       \
     } while (0)
 
-#define GEN_HELPER_LL(name, ret, arg0, arg1, n) do {         \
-    TCGv arg00 = tcg_temp_new();                             \
-    TCGv arg01 = tcg_temp_new();                             \
-    TCGv arg11 = tcg_temp_new();                             \
-    tcg_gen_sari_tl(arg00, arg0, 16);                        \
-    tcg_gen_ext16s_tl(arg01, arg0);                          \
-    tcg_gen_ext16s_tl(arg11, arg1);                          \
-    gen_helper_##name(ret, arg00, arg01, arg11, arg11, n);   \
+#define GEN_MUL_LL(name, ret, arg0, arg1, n) do {        \
+    TCGv arg00 = tcg_temp_new();                         \
+    TCGv arg01 = tcg_temp_new();                         \
+    TCGv arg11 = tcg_temp_new();                         \
+    tcg_gen_sari_tl(arg00, arg0, 16);                    \
+    tcg_gen_ext16s_tl(arg01, arg0);                      \
+    tcg_gen_ext16s_tl(arg11, arg1);                      \
+    gen_##name(ret, arg00, arg01, arg11, arg11, n);      \
 } while (0)
 
-#define GEN_HELPER_LU(name, ret, arg0, arg1, n) do {         \
-    TCGv arg00 = tcg_temp_new();                             \
-    TCGv arg01 = tcg_temp_new();                             \
-    TCGv arg10 = tcg_temp_new();                             \
-    TCGv arg11 = tcg_temp_new();                             \
-    tcg_gen_sari_tl(arg00, arg0, 16);                        \
-    tcg_gen_ext16s_tl(arg01, arg0);                          \
-    tcg_gen_sari_tl(arg11, arg1, 16);                        \
-    tcg_gen_ext16s_tl(arg10, arg1);                          \
-    gen_helper_##name(ret, arg00, arg01, arg10, arg11, n);   \
+#define GEN_MUL_LU(name, ret, arg0, arg1, n) do {        \
+    TCGv arg00 = tcg_temp_new();                         \
+    TCGv arg01 = tcg_temp_new();                         \
+    TCGv arg10 = tcg_temp_new();                         \
+    TCGv arg11 = tcg_temp_new();                         \
+    tcg_gen_sari_tl(arg00, arg0, 16);                    \
+    tcg_gen_ext16s_tl(arg01, arg0);                      \
+    tcg_gen_sari_tl(arg11, arg1, 16);                    \
+    tcg_gen_ext16s_tl(arg10, arg1);                      \
+    gen_##name(ret, arg00, arg01, arg10, arg11, n);      \
 } while (0)
 
-#define GEN_HELPER_UL(name, ret, arg0, arg1, n) do {         \
-    TCGv arg00 = tcg_temp_new();                             \
-    TCGv arg01 = tcg_temp_new();                             \
-    TCGv arg10 = tcg_temp_new();                             \
-    TCGv arg11 = tcg_temp_new();                             \
-    tcg_gen_sari_tl(arg00, arg0, 16);                        \
-    tcg_gen_ext16s_tl(arg01, arg0);                          \
-    tcg_gen_sari_tl(arg10, arg1, 16);                        \
-    tcg_gen_ext16s_tl(arg11, arg1);                          \
-    gen_helper_##name(ret, arg00, arg01, arg10, arg11, n);   \
+#define GEN_MUL_UL(name, ret, arg0, arg1, n) do {        \
+    TCGv arg00 = tcg_temp_new();                         \
+    TCGv arg01 = tcg_temp_new();                         \
+    TCGv arg10 = tcg_temp_new();                         \
+    TCGv arg11 = tcg_temp_new();                         \
+    tcg_gen_sari_tl(arg00, arg0, 16);                    \
+    tcg_gen_ext16s_tl(arg01, arg0);                      \
+    tcg_gen_sari_tl(arg10, arg1, 16);                    \
+    tcg_gen_ext16s_tl(arg11, arg1);                      \
+    gen_##name(ret, arg00, arg01, arg10, arg11, n);      \
 } while (0)
 
-#define GEN_HELPER_UU(name, ret, arg0, arg1, n) do {         \
-    TCGv arg00 = tcg_temp_new();                             \
-    TCGv arg01 = tcg_temp_new();                             \
-    TCGv arg11 = tcg_temp_new();                             \
-    tcg_gen_sari_tl(arg01, arg0, 16);                        \
-    tcg_gen_ext16s_tl(arg00, arg0);                          \
-    tcg_gen_sari_tl(arg11, arg1, 16);                        \
-    gen_helper_##name(ret, arg00, arg01, arg11, arg11, n);   \
+#define GEN_MUL_UU(name, ret, arg0, arg1, n) do {        \
+    TCGv arg00 = tcg_temp_new();                         \
+    TCGv arg01 = tcg_temp_new();                         \
+    TCGv arg11 = tcg_temp_new();                         \
+    tcg_gen_sari_tl(arg01, arg0, 16);                    \
+    tcg_gen_ext16s_tl(arg00, arg0);                      \
+    tcg_gen_sari_tl(arg11, arg1, 16);                    \
+    gen_##name(ret, arg00, arg01, arg11, arg11, n);      \
 } while (0)
 
+/*
+ * Q format multiply of two halfwords, 0x8000 * 0x8000 << 1 saturates to
+ * 0x7fffffff. No other product gives 0x80000000 after the shift.
+ */
+static void gen_mul_h_q16(TCGv ret, TCGv arg0, TCGv arg1, uint32_t n)
+{
+    tcg_gen_mul_tl(ret, arg0, arg1);
+    tcg_gen_shli_tl(ret, ret, n);
+    if (n == 1) {
+        TCGv temp = tcg_temp_new();
+
+        tcg_gen_setcondi_tl(TCG_COND_EQ, temp, ret, 0x80000000);
+        tcg_gen_sub_tl(ret, ret, temp);
+    }
+}
+
+static void gen_mul_h(TCGv_i64 ret, TCGv arg00, TCGv arg01,
+                      TCGv arg10, TCGv arg11, uint32_t n)
+{
+    TCGv result0 = tcg_temp_new();
+    TCGv result1 = tcg_temp_new();
+
+    gen_mul_h_q16(result1, arg00, arg10, n);
+    gen_mul_h_q16(result0, arg01, arg11, n);
+    tcg_gen_concat_i32_i64(ret, result0, result1);
+}
+
+static void gen_mulm_h(TCGv_i64 ret, TCGv arg00, TCGv arg01,
+                       TCGv arg10, TCGv arg11, uint32_t n)
+{
+    TCGv temp = tcg_temp_new();
+    TCGv_i64 t1 = tcg_temp_new_i64();
+
+    gen_mul_h_q16(temp, arg00, arg10, n);
+    tcg_gen_ext_i32_i64(t1, temp);
+    gen_mul_h_q16(temp, arg01, arg11, n);
+    tcg_gen_ext_i32_i64(ret, temp);
+    tcg_gen_add_i64(ret, ret, t1);
+    tcg_gen_shli_i64(ret, ret, 16);
+}
+
+/* the saturated product is not rounded */
+static void gen_mulr_h_q16(TCGv ret, TCGv arg0, TCGv arg1, uint32_t n)
+{
+    TCGv temp = tcg_temp_new();
+
+    tcg_gen_mul_tl(temp, arg0, arg1);
+    tcg_gen_shli_tl(temp, temp, n);
+    tcg_gen_addi_tl(ret, temp, 0x8000);
+    if (n == 1) {
+        tcg_gen_movcond_tl(TCG_COND_EQ, ret, temp,
+                           tcg_constant_tl(0x80000000),
+                           tcg_constant_tl(0x7fffffff), ret);
+    }
+}
+
+static void gen_mulr_h(TCGv ret, TCGv arg00, TCGv arg01,
+                       TCGv arg10, TCGv arg11, uint32_t n)
+{
+    TCGv result0 = tcg_temp_new();
+    TCGv result1 = tcg_temp_new();
+
+    gen_mulr_h_q16(result1, arg00, arg10, n);
+    gen_mulr_h_q16(result0, arg01, arg11, n);
+    tcg_gen_shri_tl(result0, result0, 16);
+    tcg_gen_deposit_tl(ret, result1, result0, 0, 16);
+}
+
 #define GEN_HELPER_RRR(name, rl, rh, al1, ah1, arg2) do {    \
     TCGv_i64 ret = tcg_temp_new_i64();                       \
     TCGv_i64 arg1 = tcg_temp_new_i64();                      \
@@ -208,20 +306,283 @@ static inline void generate_trap(DisasContext *ctx, int class, int tin);
 
 /* Functions for load/save to/from memory */
 
+/*
+ * All guest data accesses are funneled through the gen_qemu_* wrappers, so
+ * that an optional bus timing model installed by the SoC sees every access.
+ * The model is told after the access, an access that faults costs nothing.
+ */
+static void gen_bus_access(DisasContext *ctx, TCGv addr, MemOp mop,
+                           bool is_write)
+{
+    if (ctx->bus_timing) {
+        uint32_t info = memop_size(mop) | (is_write ? BUS_ACCESS_WRITE : 0);
+        gen_helper_bus_access(tcg_env, addr, tcg_constant_i32(info));
+    }
+}
+
+/* A load may overwrite its own address, the bus model needs a copy */
+static TCGv gen_bus_addr(DisasContext *ctx, TCGv ret, TCGv addr)
+{
+    TCGv copy;
+
+    if (!ctx->bus_timing || ret != addr) {
+        return addr;
+    }
+    copy = tcg_temp_new();
+    tcg_gen_mov_tl(copy, addr);
+    return copy;
+}
+
+/*
+ * Constant addresses, from ABS addressing or gen_base_offset(), go through
+ * here, so that gen_spr_access() knows their value. TCG constants are
+ * interned, the same TCGv always holds the same value.
+ */
+static TCGv gen_const_addr(DisasContext *ctx, uint32_t addr)
+{
+    ctx->const_addr = tcg_constant_tl(addr);
+    ctx->const_val = addr;
+    return ctx->const_addr;
+}
+
+/* Returns the scratchpad window holding all of addr .. addr + size - 1 */
+static int spr_window(DisasContext *ctx, uint32_t addr, uint32_t size)
+{
+    for (int i = 0; i < ctx->spr_count; i++) {
+        if (addr - ctx->spr[i].base <= ctx->spr[i].size - size) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/*
+ * Scratchpad fast path: an access at a constant address in a window, or
+ * based on A10 while the stack is in a window, uses the host address of
+ * the window instead of the TLB. Emits the checks and returns the host
+ * pointer and offset for the direct access, or NULL if the access must
+ * use the TLB. The checks branch to *slow, NULL if there are none.
+ */
+static TCGv_ptr gen_spr_access(DisasContext *ctx, TCGv addr, MemOp mop,
+                               bool is_write, intptr_t *ofs,
+                               TCGLabel **slow)
+{
+    uint32_t size = memop_size(mop);
+    intptr_t host_ofs = is_write ? offsetof(CPUTriCoreState, spr_st)
+                                 : offsetof(CPUTriCoreState, spr_ld);
+    TCGv_ptr host, off_ptr;
+    TCGv off = NULL;
+    int i;
+
+    *slow = NULL;
+    /* plugins and big endian hosts, where MO_LE swaps, need the TLB */
+    if (!ctx->spr || ctx->base.plugin_enabled || (mop & MO_BSWAP)) {
+        return NULL;
+    }
+
+    if (addr == ctx->const_addr) {
+        i = spr_window(ctx, ctx->const_val, size);
+        if (i < 0) {
+            return NULL;
+        }
+        *ofs = ctx->const_val - ctx->spr[i].base;
+    } else if (ctx->sp_win >= 0 &&
+               (addr == cpu_gpr_a[10] || addr == ctx->sp_addr)) {
+        i = ctx->sp_win;
+        *ofs = 0;
+        *slow = gen_new_label();
+        off = tcg_temp_new();
+        tcg_gen_subi_tl(off, addr, ctx->spr[i].base);
+        tcg_gen_brcondi_tl(TCG_COND_GTU, off, ctx->spr[i].size - size,
+                           *slow);
+    } else {
+        return NULL;
+    }
+
+    host = tcg_temp_new_ptr();
+    tcg_gen_ld_ptr(host, tcg_env, host_ofs + i * sizeof(uint8_t *));
+    if (is_write) {
+        if (!*slow) {
+            *slow = gen_new_label();
+        }
+        tcg_gen_brcondi_ptr(TCG_COND_EQ, host, 0, *slow);
+    }
+    if (off) {
+        off_ptr = tcg_temp_new_ptr();
+        tcg_gen_ext_i32_ptr(off_ptr, off);
+        tcg_gen_add_ptr(host, host, off_ptr);
+    }
+    return host;
+}
+
+/* Emits the jump from the direct access over the TLB access at slow */
+static TCGLabel *gen_spr_access_else(TCGLabel *slow)
+{
+    TCGLabel *done = gen_new_label();
+
+    tcg_gen_br(done);
+    gen_set_label(slow);
+    return done;
+}
+
+static void gen_qemu_ld_tl(DisasContext *ctx, TCGv ret, TCGv addr, MemOp mop)
+{
+    TCGv bus_addr = gen_bus_addr(ctx, ret, addr);
+    TCGLabel *slow, *done = NULL;
+    TCGv_ptr host;
+    intptr_t ofs;
+
+    host = gen_spr_access(ctx, addr, mop, false, &ofs, &slow);
+    if (host) {
+        switch (mop & (MO_SIZE | MO_SIGN)) {
+        case MO_UB:
+            tcg_gen_ld8u_tl(ret, host, ofs);
+            break;
+        case MO_SB:
+            tcg_gen_ld8s_tl(ret, host, ofs);
+            break;
+        case MO_UW:
+            tcg_gen_ld16u_tl(ret, host, ofs);
+            break;
+        case MO_SW:
+            tcg_gen_ld16s_tl(ret, host, ofs);
+            break;
+        default:
+            tcg_gen_ld_tl(ret, host, ofs);
+            break;
+        }
+        if (!slow) {
+            gen_bus_access(ctx, bus_addr, mop, false);
+            return;
+        }
+        done = gen_spr_access_else(slow);
+    }
+    tcg_gen_qemu_ld_tl(ret, addr, ctx->mem_idx, mop);
+    if (done) {
+        gen_set_label(done);
+    }
+    gen_bus_access(ctx, bus_addr, mop, false);
+}
+
+static void gen_qemu_st_tl(DisasContext *ctx, TCGv val, TCGv addr, MemOp mop)
+{
+    TCGLabel *slow, *done = NULL;
+    TCGv_ptr host;
+    intptr_t ofs;
+
+    host = gen_spr_access(ctx, addr, mop, true, &ofs, &slow);
+    if (host) {
+        switch (mop & MO_SIZE) {
+        case MO_8:
+            tcg_gen_st8_tl(val, host, ofs);
+            break;
+        case MO_16:
+            tcg_gen_st16_tl(val, host, ofs);
+            break;
+        default:
+            tcg_gen_st_tl(val, host, ofs);
+            break;
+        }
+        done = gen_spr_access_else(slow);
+    }
+    tcg_gen_qemu_st_tl(val, addr, ctx->mem_idx, mop);
+    if (done) {
+        gen_set_label(done);
+    }
+    gen_bus_access(ctx, addr, mop, true);
+}
+
+static void gen_qemu_ld_i64(DisasContext *ctx, TCGv_i64 ret, TCGv addr,
+                            MemOp mop)
+{
+    TCGLabel *slow, *done = NULL;
+    TCGv_ptr host;
+    intptr_t ofs;
+
+    host = gen_spr_access(ctx, addr, mop, false, &ofs, &slow);
+    if (host) {
+        tcg_gen_ld_i64(ret, host, ofs);
+        if (!slow) {
+            gen_bus_access(ctx, addr, mop, false);
+            return;
+        }
+        done = gen_spr_access_else(slow);
+    }
+    tcg_gen_qemu_ld_i64(ret, addr, ctx->mem_idx, mop);
+    if (done) {
+        gen_set_label(done);
+    }
+    gen_bus_access(ctx, addr, mop, false);
+}
+
+static void gen_qemu_st_i64(DisasContext *ctx, TCGv_i64 val, TCGv addr,
+                            MemOp mop)
+{
+    TCGLabel *slow, *done = NULL;
+    TCGv_ptr host;
+    intptr_t ofs;
+
+    host = gen_spr_access(ctx, addr, mop, true, &ofs, &slow);
+    if (host) {
+        tcg_gen_st_i64(val, host, ofs);
+        done = gen_spr_access_else(slow);
+    }
+    tcg_gen_qemu_st_i64(val, addr, ctx->mem_idx, mop);
+    if (done) {
+        gen_set_label(done);
+    }
+    gen_bus_access(ctx, addr, mop, true);
+}
+
+/* the global address registers, in the order of tricore_gaddr_values() */
+static const int gaddr_regs[4] = { 0, 1, 8, 9 };
+
+/*
+ * Every write to an address register takes its destination from here, so
+ * that a new value of A0, A1, A8 or A9 gets a new key after the
+ * instruction, see tricore_tr_translate_insn().
+ */
+static TCGv dest_a(DisasContext *ctx, int r)
+{
+    if (r == 0 || r == 1 || r == 8 || r == 9) {
+        ctx->gaddr_written = true;
+    }
+    return cpu_gpr_a[r];
+}
+
+/*
+ * Returns base + con. In a specialised TB the global address registers
+ * are constants, so small data accesses get a constant address.
+ */
+static TCGv gen_base_offset(DisasContext *ctx, TCGv base, int32_t con)
+{
+    TCGv temp;
+
+    if (ctx->gaddr) {
+        for (int i = 0; i < ARRAY_SIZE(gaddr_regs); i++) {
+            if (base == cpu_gpr_a[gaddr_regs[i]]) {
+                return gen_const_addr(ctx, ctx->gaddr[i] + con);
+            }
+        }
+    }
+    temp = tcg_temp_new();
+    tcg_gen_addi_tl(temp, base, con);
+    if (base == cpu_gpr_a[10]) {
+        ctx->sp_addr = temp;
+    }
+    return temp;
+}
+
 static inline void gen_offset_ld(DisasContext *ctx, TCGv r1, TCGv r2,
                                  int16_t con, MemOp mop)
 {
-    TCGv temp = tcg_temp_new();
-    tcg_gen_addi_tl(temp, r2, con);
-    tcg_gen_qemu_ld_tl(r1, temp, ctx->mem_idx, mop);
+    gen_qemu_ld_tl(ctx, r1, gen_base_offset(ctx, r2, con), mop);
 }
 
 static inline void gen_offset_st(DisasContext *ctx, TCGv r1, TCGv r2,
                                  int16_t con, MemOp mop)
 {
-    TCGv temp = tcg_temp_new();
-    tcg_gen_addi_tl(temp, r2, con);
-    tcg_gen_qemu_st_tl(r1, temp, ctx->mem_idx, mop);
+    gen_qemu_st_tl(ctx, r1, gen_base_offset(ctx, r2, con), mop);
 }
 
 static void gen_st_2regs_64(TCGv rh, TCGv rl, TCGv address, DisasContext *ctx)
@@ -229,22 +590,20 @@ static void gen_st_2regs_64(TCGv rh, TCGv rl, TCGv address, DisasContext *ctx)
     TCGv_i64 temp = tcg_temp_new_i64();
 
     tcg_gen_concat_i32_i64(temp, rl, rh);
-    tcg_gen_qemu_st_i64(temp, address, ctx->mem_idx, MO_LEUQ);
+    gen_qemu_st_i64(ctx, temp, address, MO_LEUQ);
 }
 
 static void gen_offset_st_2regs(TCGv rh, TCGv rl, TCGv base, int16_t con,
                                 DisasContext *ctx)
 {
-    TCGv temp = tcg_temp_new();
-    tcg_gen_addi_tl(temp, base, con);
-    gen_st_2regs_64(rh, rl, temp, ctx);
+    gen_st_2regs_64(rh, rl, gen_base_offset(ctx, base, con), ctx);
 }
 
 static void gen_ld_2regs_64(TCGv rh, TCGv rl, TCGv address, DisasContext *ctx)
 {
     TCGv_i64 temp = tcg_temp_new_i64();
 
-    tcg_gen_qemu_ld_i64(temp, address, ctx->mem_idx, MO_LEUQ);
+    gen_qemu_ld_i64(ctx, temp, address, MO_LEUQ);
     /* write back to two 32 bit regs */
     tcg_gen_extr_i64_i32(rl, rh, temp);
 }
@@ -252,9 +611,7 @@ static void gen_ld_2regs_64(TCGv rh, TCGv rl, TCGv address, DisasContext *ctx)
 static void gen_offset_ld_2regs(TCGv rh, TCGv rl, TCGv base, int16_t con,
                                 DisasContext *ctx)
 {
-    TCGv temp = tcg_temp_new();
-    tcg_gen_addi_tl(temp, base, con);
-    gen_ld_2regs_64(rh, rl, temp, ctx);
+    gen_ld_2regs_64(rh, rl, gen_base_offset(ctx, base, con), ctx);
 }
 
 static void gen_st_preincr(DisasContext *ctx, TCGv r1, TCGv r2, int16_t off,
@@ -262,7 +619,7 @@ static void gen_st_preincr(DisasContext *ctx, TCGv r1, TCGv r2, int16_t off,
 {
     TCGv temp = tcg_temp_new();
     tcg_gen_addi_tl(temp, r2, off);
-    tcg_gen_qemu_st_tl(r1, temp, ctx->mem_idx, mop);
+    gen_qemu_st_tl(ctx, r1, temp, mop);
     tcg_gen_mov_tl(r2, temp);
 }
 
@@ -271,7 +628,7 @@ static void gen_ld_preincr(DisasContext *ctx, TCGv r1, TCGv r2, int16_t off,
 {
     TCGv temp = tcg_temp_new();
     tcg_gen_addi_tl(temp, r2, off);
-    tcg_gen_qemu_ld_tl(r1, temp, ctx->mem_idx, mop);
+    gen_qemu_ld_tl(ctx, r1, temp, mop);
     tcg_gen_mov_tl(r2, temp);
 }
 
@@ -283,7 +640,7 @@ static void gen_ldmst(DisasContext *ctx, int ereg, TCGv ea)
 
     CHECK_REG_PAIR(ereg);
     /* temp = (M(EA, word) */
-    tcg_gen_qemu_ld_tl(temp, ea, ctx->mem_idx, MO_LEUL);
+    gen_qemu_ld_tl(ctx, temp, ea, MO_LEUL);
     /* temp = temp & ~E[a][63:32]) */
     tcg_gen_andc_tl(temp, temp, cpu_gpr_d[ereg+1]);
     /* temp2 = (E[a][31:0] & E[a][63:32]); */
@@ -291,7 +648,7 @@ static void gen_ldmst(DisasContext *ctx, int ereg, TCGv ea)
     /* temp = temp | temp2; */
     tcg_gen_or_tl(temp, temp, temp2);
     /* M(EA, word) = temp; */
-    tcg_gen_qemu_st_tl(temp, ea, ctx->mem_idx, MO_LEUL);
+    gen_qemu_st_tl(ctx, temp, ea, MO_LEUL);
 }
 
 /* tmp = M(EA, word);
@@ -301,8 +658,8 @@ static void gen_swap(DisasContext *ctx, int reg, TCGv ea)
 {
     TCGv temp = tcg_temp_new();
 
-    tcg_gen_qemu_ld_tl(temp, ea, ctx->mem_idx, MO_LEUL);
-    tcg_gen_qemu_st_tl(cpu_gpr_d[reg], ea, ctx->mem_idx, MO_LEUL);
+    gen_qemu_ld_tl(ctx, temp, ea, MO_LEUL);
+    gen_qemu_st_tl(ctx, cpu_gpr_d[reg], ea, MO_LEUL);
     tcg_gen_mov_tl(cpu_gpr_d[reg], temp);
 }
 
@@ -311,10 +668,10 @@ static void gen_cmpswap(DisasContext *ctx, int reg, TCGv ea)
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     CHECK_REG_PAIR(reg);
-    tcg_gen_qemu_ld_tl(temp, ea, ctx->mem_idx, MO_LEUL);
+    gen_qemu_ld_tl(ctx, temp, ea, MO_LEUL);
     tcg_gen_movcond_tl(TCG_COND_EQ, temp2, cpu_gpr_d[reg+1], temp,
                        cpu_gpr_d[reg], temp);
-    tcg_gen_qemu_st_tl(temp2, ea, ctx->mem_idx, MO_LEUL);
+    gen_qemu_st_tl(ctx, temp2, ea, MO_LEUL);
     tcg_gen_mov_tl(cpu_gpr_d[reg], temp);
 }
 
@@ -324,11 +681,11 @@ static void gen_swapmsk(DisasContext *ctx, int reg, TCGv ea)
     TCGv temp2 = tcg_temp_new();
     TCGv temp3 = tcg_temp_new();
     CHECK_REG_PAIR(reg);
-    tcg_gen_qemu_ld_tl(temp, ea, ctx->mem_idx, MO_LEUL);
+    gen_qemu_ld_tl(ctx, temp, ea, MO_LEUL);
     tcg_gen_and_tl(temp2, cpu_gpr_d[reg], cpu_gpr_d[reg+1]);
     tcg_gen_andc_tl(temp3, temp, cpu_gpr_d[reg+1]);
     tcg_gen_or_tl(temp2, temp2, temp3);
-    tcg_gen_qemu_st_tl(temp2, ea, ctx->mem_idx, MO_LEUL);
+    gen_qemu_st_tl(ctx, temp2, ea, MO_LEUL);
     tcg_gen_mov_tl(cpu_gpr_d[reg], temp);
 }
 
@@ -338,12 +695,18 @@ static void gen_swapmsk(DisasContext *ctx, int reg, TCGv ea)
    These macros also specify in which ISA version the csfr was introduced. */
 #define R(ADDRESS, REG, FEATURE)                                         \
     case ADDRESS:                                                        \
-        if (has_feature(ctx, FEATURE)) {                             \
+        if (has_feature(ctx, FEATURE)) {                                 \
             tcg_gen_ld_tl(ret, tcg_env, offsetof(CPUTriCoreState, REG)); \
         }                                                                \
         break;
 #define A(ADDRESS, REG, FEATURE) R(ADDRESS, REG, FEATURE)
 #define E(ADDRESS, REG, FEATURE) R(ADDRESS, REG, FEATURE)
+#define T(ADDRESS, REG, FEATURE)                                         \
+    case ADDRESS:                                                        \
+        if (!has_feature(ctx, FEATURE)) {                                \
+            tcg_gen_ld_tl(ret, tcg_env, offsetof(CPUTriCoreState, REG)); \
+        }                                                                \
+        break;
 static inline void gen_mfcr(DisasContext *ctx, TCGv ret, int32_t offset)
 {
     /* since we're caching PSW make this a special case */
@@ -358,20 +721,42 @@ static inline void gen_mfcr(DisasContext *ctx, TCGv ret, int32_t offset)
 #undef R
 #undef A
 #undef E
+#undef T
+
+/* Endinit protected registers are only written while the ENDINIT bit of the
+   CPU watchdog, which the SCU mirrors into env->endinit, is cleared. Writes
+   with ENDINIT set are ignored. */
+static inline void gen_mtcr_endinit(TCGv r1, int offset)
+{
+    TCGv endinit = tcg_temp_new();
+    TCGv val = tcg_temp_new();
+
+    tcg_gen_ld_tl(endinit, tcg_env, offsetof(CPUTriCoreState, endinit));
+    tcg_gen_ld_tl(val, tcg_env, offset);
+    tcg_gen_movcond_tl(TCG_COND_EQ, val, endinit, tcg_constant_tl(0), r1, val);
+    tcg_gen_st_tl(val, tcg_env, offset);
+}
 
 #define R(ADDRESS, REG, FEATURE) /* don't gen writes to read-only reg,
                                     since no exception occurs */
 #define A(ADDRESS, REG, FEATURE) R(ADDRESS, REG, FEATURE)                \
     case ADDRESS:                                                        \
-        if (has_feature(ctx, FEATURE)) {                             \
+        if (has_feature(ctx, FEATURE)) {                                 \
+            tcg_gen_st_tl(r1, tcg_env, offsetof(CPUTriCoreState, REG));  \
+        }                                                                \
+        break;
+#define E(ADDRESS, REG, FEATURE)                                         \
+    case ADDRESS:                                                        \
+        if (has_feature(ctx, FEATURE)) {                                 \
+            gen_mtcr_endinit(r1, offsetof(CPUTriCoreState, REG));        \
+        }                                                                \
+        break;
+#define T(ADDRESS, REG, FEATURE)                                         \
+    case ADDRESS:                                                        \
+        if (!has_feature(ctx, FEATURE)) {                                \
             tcg_gen_st_tl(r1, tcg_env, offsetof(CPUTriCoreState, REG));  \
         }                                                                \
         break;
-/* Endinit protected registers
-   TODO: Since the endinit bit is in a register of a not yet implemented
-         watchdog device, we handle endinit protected registers like
-         all-access registers for now. */
-#define E(ADDRESS, REG, FEATURE) A(ADDRESS, REG, FEATURE)
 static inline void gen_mtcr(DisasContext *ctx, TCGv r1,
                             int32_t offset)
 {
@@ -384,11 +769,16 @@ static inline void gen_mtcr(DisasContext *ctx, TCGv r1,
             switch (offset) {
 #include "csfr.h.inc"
             }
+            if (tricore_is_debug_csfr(offset)) {
+                gen_helper_debug_update(tcg_env);
+                ctx->base.is_jmp = DISAS_EXIT_UPDATE;
+            }
         }
     } else {
         generate_trap(ctx, TRAPC_PROT, TIN1_PRIV);
     }
 }
+#undef T
 
 /* Functions for arithmetic instructions  */
 
@@ -601,22 +991,21 @@ static inline void
 gen_madd_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
            TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_extr_i64_i32(temp, temp2, temp64);
@@ -628,22 +1017,21 @@ static inline void
 gen_maddsu_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
              TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_extr_i64_i32(temp, temp2, temp64);
@@ -655,22 +1043,21 @@ static inline void
 gen_maddsum_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
               TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     TCGv_i64 temp64_2 = tcg_temp_new_i64();
     TCGv_i64 temp64_3 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_concat_i32_i64(temp64_3, r1_low, r1_high);
@@ -690,7 +1077,6 @@ static inline void
 gen_madds_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
            TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv temp3 = tcg_temp_new();
@@ -698,16 +1084,16 @@ gen_madds_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
 
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_extr_i64_i32(temp, temp2, temp64);
@@ -727,7 +1113,6 @@ static inline void
 gen_maddsus_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
               TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv temp3 = tcg_temp_new();
@@ -735,16 +1120,16 @@ gen_maddsus_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
 
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_extr_i64_i32(temp, temp2, temp64);
@@ -762,22 +1147,21 @@ static inline void
 gen_maddsums_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
                TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     TCGv_i64 temp64_2 = tcg_temp_new_i64();
 
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_sari_i64(temp64_2, temp64, 32); /* high */
@@ -795,22 +1179,21 @@ static inline void
 gen_maddm_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
            TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     TCGv_i64 temp64_2 = tcg_temp_new_i64();
     TCGv_i64 temp64_3 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mulm_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_concat_i32_i64(temp64_2, r1_low, r1_high);
@@ -823,21 +1206,20 @@ static inline void
 gen_maddms_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
            TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     TCGv_i64 temp64_2 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mulm_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_concat_i32_i64(temp64_2, r1_low, r1_high);
@@ -849,20 +1231,19 @@ static inline void
 gen_maddr64_h(TCGv ret, TCGv r1_low, TCGv r1_high, TCGv r2, TCGv r3, uint32_t n,
               uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     gen_helper_addr_h(ret, tcg_env, temp64, r1_low, r1_high);
@@ -882,22 +1263,21 @@ gen_maddr32_h(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n, uint32_t mode)
 static inline void
 gen_maddsur32_h(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_andi_tl(temp2, r1, 0xffff0000);
@@ -910,20 +1290,19 @@ static inline void
 gen_maddr64s_h(TCGv ret, TCGv r1_low, TCGv r1_high, TCGv r2, TCGv r3,
                uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     gen_helper_addr_h_ssov(ret, tcg_env, temp64, r1_low, r1_high);
@@ -943,22 +1322,21 @@ gen_maddr32s_h(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n, uint32_t mode)
 static inline void
 gen_maddsur32s_h(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_andi_tl(temp2, r1, 0xffff0000);
@@ -973,11 +1351,71 @@ gen_maddr_q(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n)
     gen_helper_maddr_q(ret, tcg_env, r1, r2, r3, t_n);
 }
 
+/*
+ * Saturate the 64 bit result of a Q format operation to 32 bit and set the
+ * V/SV/AV/SAV bits. AV is calculated on the unsaturated result.
+ */
+static void gen_ssov32_i64(TCGv ret, TCGv_i64 arg)
+{
+    TCGv_i64 t1 = tcg_temp_new_i64();
+    TCGv_i64 t2 = tcg_temp_new_i64();
+
+    /* Calc AV/SAV bits */
+    tcg_gen_extrl_i64_i32(ret, arg);
+    tcg_gen_add_tl(cpu_PSW_AV, ret, ret);
+    tcg_gen_xor_tl(cpu_PSW_AV, ret, cpu_PSW_AV);
+    tcg_gen_or_tl(cpu_PSW_SAV, cpu_PSW_SAV, cpu_PSW_AV);
+    /* saturate */
+    tcg_gen_smin_i64(t1, arg, tcg_constant_i64(INT32_MAX));
+    tcg_gen_smax_i64(t1, t1, tcg_constant_i64(INT32_MIN));
+    /* Calc V/SV bits */
+    tcg_gen_setcond_i64(TCG_COND_NE, t2, arg, t1);
+    tcg_gen_extrl_i64_i32(cpu_PSW_V, t2);
+    tcg_gen_shli_tl(cpu_PSW_V, cpu_PSW_V, 31);
+    tcg_gen_or_tl(cpu_PSW_SV, cpu_PSW_SV, cpu_PSW_V);
+    tcg_gen_extrl_i64_i32(ret, t1);
+}
+
+/*
+ * mul = (r2 * r3) << n, where 0x8000 * 0x8000 << 1 gives 0x7fffffff. The
+ * result is t1 + mul + 0x8000 for madd and t1 - mul + 0x8000 for msub.
+ */
+static void gen_mulr_q_ssov(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n,
+                            bool sub)
+{
+    TCGv_i64 t1 = tcg_temp_new_i64();
+    TCGv_i64 t2 = tcg_temp_new_i64();
+    TCGv_i64 t3 = tcg_temp_new_i64();
+
+    tcg_gen_ext_i32_i64(t1, r1);
+    tcg_gen_ext_i32_i64(t2, r2);
+    tcg_gen_ext_i32_i64(t3, r3);
+    tcg_gen_mul_i64(t2, t2, t3);
+    tcg_gen_shli_i64(t2, t2, n);
+    if (n == 1) {
+        TCGv temp = tcg_temp_new();
+        TCGv temp2 = tcg_temp_new();
+
+        tcg_gen_setcondi_tl(TCG_COND_EQ, temp, r2, -0x8000);
+        tcg_gen_setcondi_tl(TCG_COND_EQ, temp2, r3, -0x8000);
+        tcg_gen_and_tl(temp, temp, temp2);
+        tcg_gen_extu_i32_i64(t3, temp);
+        tcg_gen_sub_i64(t2, t2, t3);
+    }
+    if (sub) {
+        tcg_gen_sub_i64(t1, t1, t2);
+    } else {
+        tcg_gen_add_i64(t1, t1, t2);
+    }
+    tcg_gen_addi_i64(t1, t1, 0x8000);
+    gen_ssov32_i64(ret, t1);
+    tcg_gen_andi_tl(ret, ret, 0xffff0000);
+}
+
 static inline void
 gen_maddrs_q(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n)
 {
-    TCGv t_n = tcg_constant_i32(n);
-    gen_helper_maddr_q_ssov(ret, tcg_env, r1, r2, r3, t_n);
+    gen_mulr_q_ssov(ret, r1, r2, r3, n, false);
 }
 
 static inline void
@@ -1165,6 +1603,61 @@ gen_madd64_q(TCGv rl, TCGv rh, TCGv arg1_low, TCGv arg1_high, TCGv arg2,
     tcg_gen_or_tl(cpu_PSW_SAV, cpu_PSW_SAV, cpu_PSW_AV);
 }
 
+/*
+ * r1 +/- (arg2 * arg3) << n, saturated to 64 bit. The product of
+ * 0x80000000 * 0x80000000 << 1 wraps to INT64_MIN on the host, which
+ * inverts the sign of the overflow and of the saturated value.
+ */
+static void gen_mul64_q_ssov(TCGv rl, TCGv rh, TCGv arg1_low, TCGv arg1_high,
+                             TCGv arg2, TCGv arg3, uint32_t n, bool sub)
+{
+    TCGv_i64 t1 = tcg_temp_new_i64();
+    TCGv_i64 mul = tcg_temp_new_i64();
+    TCGv_i64 result = tcg_temp_new_i64();
+    TCGv_i64 ovf = tcg_temp_new_i64();
+    TCGv_i64 temp = tcg_temp_new_i64();
+
+    tcg_gen_concat_i32_i64(t1, arg1_low, arg1_high);
+    tcg_gen_ext_i32_i64(mul, arg2);
+    tcg_gen_ext_i32_i64(temp, arg3);
+    tcg_gen_mul_i64(mul, mul, temp);
+    tcg_gen_shli_i64(mul, mul, n);
+
+    if (sub) {
+        tcg_gen_sub_i64(result, t1, mul);
+        tcg_gen_xor_i64(ovf, result, t1);
+        tcg_gen_xor_i64(temp, t1, mul);
+        tcg_gen_and_i64(ovf, ovf, temp);
+    } else {
+        tcg_gen_add_i64(result, t1, mul);
+        tcg_gen_xor_i64(ovf, result, mul);
+        tcg_gen_xor_i64(temp, mul, t1);
+        tcg_gen_andc_i64(ovf, ovf, temp);
+    }
+    /* Calc AV/SAV bits */
+    tcg_gen_add_i64(temp, result, result);
+    tcg_gen_xor_i64(temp, result, temp);
+    tcg_gen_extrh_i64_i32(cpu_PSW_AV, temp);
+    tcg_gen_or_tl(cpu_PSW_SAV, cpu_PSW_SAV, cpu_PSW_AV);
+
+    if (n == 1) {
+        tcg_gen_setcondi_i64(TCG_COND_EQ, temp, mul, INT64_MIN);
+        tcg_gen_shli_i64(temp, temp, 63);
+        tcg_gen_xor_i64(ovf, ovf, temp);
+        tcg_gen_xor_i64(mul, mul, temp);
+    }
+    /* Calc V/SV bits */
+    tcg_gen_extrh_i64_i32(cpu_PSW_V, ovf);
+    tcg_gen_andi_tl(cpu_PSW_V, cpu_PSW_V, 0x80000000);
+    tcg_gen_or_tl(cpu_PSW_SV, cpu_PSW_SV, cpu_PSW_V);
+    /* saturate towards the sign of the product */
+    tcg_gen_sari_i64(temp, mul, 63);
+    tcg_gen_xori_i64(temp, temp, sub ? INT64_MIN : INT64_MAX);
+    tcg_gen_movcond_i64(TCG_COND_LT, result, ovf, tcg_constant_i64(0),
+                        temp, result);
+    tcg_gen_extr_i64_i32(rl, rh, result);
+}
+
 static inline void
 gen_madds32_q(TCGv ret, TCGv arg1, TCGv arg2, TCGv arg3, uint32_t n,
               uint32_t up_shift)
@@ -1180,19 +1673,15 @@ gen_madds32_q(TCGv ret, TCGv arg1, TCGv arg2, TCGv arg3, uint32_t n,
     tcg_gen_mul_i64(t2, t2, t3);
     tcg_gen_sari_i64(t2, t2, up_shift - n);
 
-    gen_helper_madd32_q_add_ssov(ret, tcg_env, t1, t2);
+    tcg_gen_add_i64(t1, t1, t2);
+    gen_ssov32_i64(ret, t1);
 }
 
 static inline void
 gen_madds64_q(TCGv rl, TCGv rh, TCGv arg1_low, TCGv arg1_high, TCGv arg2,
              TCGv arg3, uint32_t n)
 {
-    TCGv_i64 r1 = tcg_temp_new_i64();
-    TCGv t_n = tcg_constant_i32(n);
-
-    tcg_gen_concat_i32_i64(r1, arg1_low, arg1_high);
-    gen_helper_madd64_q_ssov(r1, tcg_env, r1, arg2, arg3, t_n);
-    tcg_gen_extr_i64_i32(rl, rh, r1);
+    gen_mul64_q_ssov(rl, rh, arg1_low, arg1_high, arg2, arg3, n, false);
 }
 
 /* ret = r2 - (r1 * r3); */
@@ -1528,22 +2017,21 @@ static inline void
 gen_msub_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
            TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_extr_i64_i32(temp, temp2, temp64);
@@ -1555,7 +2043,6 @@ static inline void
 gen_msubs_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
             TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv temp3 = tcg_temp_new();
@@ -1563,16 +2050,16 @@ gen_msubs_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
 
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_extr_i64_i32(temp, temp2, temp64);
@@ -1590,22 +2077,21 @@ static inline void
 gen_msubm_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
             TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     TCGv_i64 temp64_2 = tcg_temp_new_i64();
     TCGv_i64 temp64_3 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mulm_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_concat_i32_i64(temp64_2, r1_low, r1_high);
@@ -1618,21 +2104,20 @@ static inline void
 gen_msubms_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
              TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     TCGv_i64 temp64_2 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mulm_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mulm_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mulm_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_concat_i32_i64(temp64_2, r1_low, r1_high);
@@ -1644,20 +2129,19 @@ static inline void
 gen_msubr64_h(TCGv ret, TCGv r1_low, TCGv r1_high, TCGv r2, TCGv r3, uint32_t n,
               uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     gen_helper_subr_h(ret, tcg_env, temp64, r1_low, r1_high);
@@ -1678,20 +2162,19 @@ static inline void
 gen_msubr64s_h(TCGv ret, TCGv r1_low, TCGv r1_high, TCGv r2, TCGv r3,
                uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     gen_helper_subr_h_ssov(ret, tcg_env, temp64, r1_low, r1_high);
@@ -1718,8 +2201,7 @@ gen_msubr_q(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n)
 static inline void
 gen_msubrs_q(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n)
 {
-    TCGv temp = tcg_constant_i32(n);
-    gen_helper_msubr_q_ssov(ret, tcg_env, r1, r2, r3, temp);
+    gen_mulr_q_ssov(ret, r1, r2, r3, n, true);
 }
 
 static inline void
@@ -1918,41 +2400,36 @@ gen_msubs32_q(TCGv ret, TCGv arg1, TCGv arg2, TCGv arg3, uint32_t n,
     tcg_gen_sari_i64(t3, t2, up_shift - n);
     tcg_gen_add_i64(t3, t3, t4);
 
-    gen_helper_msub32_q_sub_ssov(ret, tcg_env, t1, t3);
+    tcg_gen_sub_i64(t1, t1, t3);
+    gen_ssov32_i64(ret, t1);
 }
 
 static inline void
 gen_msubs64_q(TCGv rl, TCGv rh, TCGv arg1_low, TCGv arg1_high, TCGv arg2,
              TCGv arg3, uint32_t n)
 {
-    TCGv_i64 r1 = tcg_temp_new_i64();
-    TCGv t_n = tcg_constant_i32(n);
-
-    tcg_gen_concat_i32_i64(r1, arg1_low, arg1_high);
-    gen_helper_msub64_q_ssov(r1, tcg_env, r1, arg2, arg3, t_n);
-    tcg_gen_extr_i64_i32(rl, rh, r1);
+    gen_mul64_q_ssov(rl, rh, arg1_low, arg1_high, arg2, arg3, n, true);
 }
 
 static inline void
 gen_msubad_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
              TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_extr_i64_i32(temp, temp2, temp64);
@@ -1964,22 +2441,21 @@ static inline void
 gen_msubadm_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
               TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     TCGv_i64 temp64_2 = tcg_temp_new_i64();
     TCGv_i64 temp64_3 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_concat_i32_i64(temp64_3, r1_low, r1_high);
@@ -1996,22 +2472,21 @@ gen_msubadm_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
 static inline void
 gen_msubadr32_h(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_andi_tl(temp2, r1, 0xffff0000);
@@ -2023,7 +2498,6 @@ static inline void
 gen_msubads_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
               TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv temp3 = tcg_temp_new();
@@ -2031,16 +2505,16 @@ gen_msubads_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
 
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_extr_i64_i32(temp, temp2, temp64);
@@ -2058,22 +2532,21 @@ static inline void
 gen_msubadms_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
                TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv_i64 temp64 = tcg_temp_new_i64();
     TCGv_i64 temp64_2 = tcg_temp_new_i64();
 
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_sari_i64(temp64_2, temp64, 32); /* high */
@@ -2089,22 +2562,21 @@ gen_msubadms_h(TCGv ret_low, TCGv ret_high, TCGv r1_low, TCGv r1_high, TCGv r2,
 static inline void
 gen_msubadr32s_h(TCGv ret, TCGv r1, TCGv r2, TCGv r3, uint32_t n, uint32_t mode)
 {
-    TCGv t_n = tcg_constant_i32(n);
     TCGv temp = tcg_temp_new();
     TCGv temp2 = tcg_temp_new();
     TCGv_i64 temp64 = tcg_temp_new_i64();
     switch (mode) {
     case MODE_LL:
-        GEN_HELPER_LL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_LU:
-        GEN_HELPER_LU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_LU(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UL:
-        GEN_HELPER_UL(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UL(mul_h, temp64, r2, r3, n);
         break;
     case MODE_UU:
-        GEN_HELPER_UU(mul_h, temp64, r2, r3, t_n);
+        GEN_MUL_UU(mul_h, temp64, r2, r3, n);
         break;
     }
     tcg_gen_andi_tl(temp2, r1, 0xffff0000);
@@ -2784,6 +3256,166 @@ gen_dvinit_h(DisasContext *ctx, TCGv rl, TCGv rh, TCGv r1, TCGv r2)
     tcg_gen_extr_i64_i32(rl, rh, ret);
 }
 
+/*
+ * DVSTEP shifts 8 quotient bits into E[c] by restoring division of the
+ * partial remainder in the high word. While that remainder is in range,
+ * which DVINIT without overflow guarantees, the step is a host division
+ * of the top 40 bits of the dividend. A negative remainder counts from
+ * -1 downwards, which complementing maps to the positive case.
+ */
+static void gen_dvstep(TCGv rl, TCGv rh, TCGv al, TCGv ah, TCGv d)
+{
+    TCGLabel *slow = gen_new_label();
+    TCGLabel *done = gen_new_label();
+    TCGv_i64 r = tcg_temp_new_i64();
+    TCGv_i64 s = tcg_temp_new_i64();
+    TCGv_i64 ad = tcg_temp_new_i64();
+    TCGv_i64 n = tcg_temp_new_i64();
+    TCGv_i64 t = tcg_temp_new_i64();
+    TCGv lo = tcg_temp_new();
+    TCGv qs = tcg_temp_new();
+
+    /* the remainder, complemented if negative, must be below abs(d) */
+    tcg_gen_ext_i32_i64(r, ah);
+    tcg_gen_sari_i64(s, r, 63);
+    tcg_gen_ext_i32_i64(ad, d);
+    tcg_gen_abs_i64(ad, ad);
+    tcg_gen_xor_i64(t, r, s);
+    tcg_gen_brcond_i64(TCG_COND_GEU, t, ad, slow);
+
+    tcg_gen_shli_i64(n, r, 8);
+    tcg_gen_extu_i32_i64(t, al);
+    tcg_gen_shri_i64(t, t, 24);
+    tcg_gen_or_i64(n, n, t);
+    tcg_gen_xor_i64(n, n, s);
+    tcg_gen_divu_i64(t, n, ad);
+    tcg_gen_remu_i64(n, n, ad);
+    tcg_gen_xor_i64(n, n, s);
+
+    /* the quotient bits are inverted for a negative quotient */
+    tcg_gen_xor_tl(qs, ah, d);
+    tcg_gen_sari_tl(qs, qs, 31);
+    tcg_gen_andi_tl(qs, qs, 0xff);
+    tcg_gen_extrl_i64_i32(lo, t);
+    tcg_gen_xor_tl(lo, lo, qs);
+    tcg_gen_shli_tl(qs, al, 8);
+    tcg_gen_or_tl(lo, lo, qs);
+    tcg_gen_extrl_i64_i32(rh, n);
+    tcg_gen_mov_tl(rl, lo);
+    tcg_gen_br(done);
+
+    gen_set_label(slow);
+    GEN_HELPER_RRR(dvstep, rl, rh, al, ah, d);
+    gen_set_label(done);
+}
+
+/*
+ * DVSTEP.U, a host division as long as the remainder is below d. The
+ * helper also covers d >= 2^31, where its 32 bit remainder overflows.
+ */
+static void gen_dvstep_u(TCGv rl, TCGv rh, TCGv al, TCGv ah, TCGv d)
+{
+    TCGLabel *slow = gen_new_label();
+    TCGLabel *done = gen_new_label();
+    TCGv_i64 n = tcg_temp_new_i64();
+    TCGv_i64 d64 = tcg_temp_new_i64();
+    TCGv_i64 t = tcg_temp_new_i64();
+    TCGv lo = tcg_temp_new();
+    TCGv temp = tcg_temp_new();
+
+    tcg_gen_brcondi_tl(TCG_COND_LT, d, 0, slow);
+    tcg_gen_brcond_tl(TCG_COND_GEU, ah, d, slow);
+
+    tcg_gen_extu_i32_i64(n, ah);
+    tcg_gen_shli_i64(n, n, 8);
+    tcg_gen_extu_i32_i64(t, al);
+    tcg_gen_shri_i64(t, t, 24);
+    tcg_gen_or_i64(n, n, t);
+    tcg_gen_extu_i32_i64(d64, d);
+    tcg_gen_divu_i64(t, n, d64);
+    tcg_gen_remu_i64(n, n, d64);
+
+    tcg_gen_extrl_i64_i32(lo, t);
+    tcg_gen_shli_tl(temp, al, 8);
+    tcg_gen_or_tl(lo, lo, temp);
+    tcg_gen_extrl_i64_i32(rh, n);
+    tcg_gen_mov_tl(rl, lo);
+    tcg_gen_br(done);
+
+    gen_set_label(slow);
+    GEN_HELPER_RRR(dvstep_u, rl, rh, al, ah, d);
+    gen_set_label(done);
+}
+
+/*
+ * DVADJ turns the ones' complement quotient of a negative result into
+ * two's complement and fixes up exact divisions of a negative dividend,
+ * whose remainder DVSTEP leaves at -abs(d).
+ */
+static void gen_dvadj(TCGv rl, TCGv rh, TCGv al, TCGv ah, TCGv d)
+{
+    TCGv x_sign = tcg_temp_new();
+    TCGv eq_pos = tcg_temp_new();
+    TCGv eq_neg = tcg_temp_new();
+    TCGv temp = tcg_temp_new();
+
+    tcg_gen_shri_tl(x_sign, ah, 31);
+    tcg_gen_setcond_tl(TCG_COND_EQ, eq_pos, ah, d);
+    tcg_gen_and_tl(eq_pos, eq_pos, x_sign);
+    tcg_gen_neg_tl(temp, d);
+    tcg_gen_setcond_tl(TCG_COND_EQ, eq_neg, ah, temp);
+    tcg_gen_and_tl(eq_neg, eq_neg, x_sign);
+
+    /* quotient += (q_sign && !eq_neg) || eq_pos */
+    tcg_gen_xor_tl(temp, ah, d);
+    tcg_gen_shri_tl(temp, temp, 31);
+    tcg_gen_andc_tl(temp, temp, eq_neg);
+    tcg_gen_or_tl(temp, temp, eq_pos);
+    tcg_gen_add_tl(temp, al, temp);
+
+    tcg_gen_or_tl(eq_pos, eq_pos, eq_neg);
+    tcg_gen_movcond_tl(TCG_COND_NE, rh, eq_pos, tcg_constant_tl(0),
+                       tcg_constant_tl(0), ah);
+    tcg_gen_mov_tl(rl, temp);
+}
+
+/*
+ * The DVSTEPs and DVADJ following DVINIT on E[r3], see tricore_dv_fusion().
+ * Unless DVINIT flagged an overflow, they compute the C quotient and
+ * remainder of the dividend by D[r2].
+ */
+static void gen_dv_fused(int r2, int r3, bool is_signed)
+{
+    TCGLabel *slow = gen_new_label();
+    TCGLabel *done = gen_new_label();
+    TCGv rl = cpu_gpr_d[r3];
+    TCGv rh = cpu_gpr_d[r3 + 1];
+    TCGv d = cpu_gpr_d[r2];
+
+    tcg_gen_brcondi_tl(TCG_COND_NE, cpu_PSW_V, 0, slow);
+    if (is_signed) {
+        tcg_gen_rem_tl(rh, rl, d);
+        tcg_gen_div_tl(rl, rl, d);
+    } else {
+        tcg_gen_remu_tl(rh, rl, d);
+        tcg_gen_divu_tl(rl, rl, d);
+    }
+    tcg_gen_br(done);
+
+    gen_set_label(slow);
+    for (int i = 0; i < 4; i++) {
+        if (is_signed) {
+            GEN_HELPER_RRR(dvstep, rl, rh, rl, rh, d);
+        } else {
+            GEN_HELPER_RRR(dvstep_u, rl, rh, rl, rh, d);
+        }
+    }
+    if (is_signed) {
+        GEN_HELPER_RRR(dvadj, rl, rh, rl, rh, d);
+    }
+    gen_set_label(done);
+}
+
 static void gen_calc_usb_mul_h(TCGv arg_low, TCGv arg_high)
 {
     TCGv temp = tcg_temp_new();
@@ -2819,9 +3451,26 @@ static inline void gen_save_pc(target_ulong pc)
     tcg_gen_movi_tl(cpu_PC, pc);
 }
 
+static void gen_debug(DisasContext *ctx)
+{
+    /*
+     * The semihosting call may complete later through the gdbstub, so the
+     * TB ends here and the next instruction sees its result. User mode
+     * always has semihosting enabled.
+     */
+    if (semihosting_enabled(ctx->priv != TRICORE_PRIV_SM)) {
+        gen_save_pc(ctx->pc_succ_insn);
+        gen_helper_semihosting(tcg_env);
+        ctx->base.is_jmp = DISAS_EXIT;
+        return;
+    }
+    gen_helper_debug(tcg_env, tcg_constant_i32(ctx->pc_succ_insn));
+}
+
 static void gen_goto_tb(DisasContext *ctx, int n, target_ulong dest)
 {
-    if (translator_use_goto_tb(&ctx->base, dest)) {
+    /* after a new key the next TB must be looked up, not chained */
+    if (!ctx->gaddr_dirty && translator_use_goto_tb(&ctx->base, dest)) {
         tcg_gen_goto_tb(n);
         gen_save_pc(dest);
         tcg_gen_exit_tb(ctx->base.tb, n);
@@ -2865,7 +3514,12 @@ static void gen_loop(DisasContext *ctx, int r1, int32_t offset)
 {
     TCGLabel *l1 = gen_new_label();
 
-    tcg_gen_subi_tl(cpu_gpr_a[r1], cpu_gpr_a[r1], 1);
+    tcg_gen_subi_tl(dest_a(ctx, r1), cpu_gpr_a[r1], 1);
+    /* the only branch that writes an address register, the key goes first */
+    if (ctx->gaddr_track && ctx->gaddr_written) {
+        gen_helper_gaddr_update(tcg_env);
+        ctx->gaddr_dirty = true;
+    }
     tcg_gen_brcondi_tl(TCG_COND_EQ, cpu_gpr_a[r1], -1, l1);
     gen_goto_tb(ctx, 1, ctx->base.pc_next + offset);
     gen_set_label(l1);
@@ -2877,9 +3531,9 @@ static void gen_fcall_save_ctx(DisasContext *ctx)
     TCGv temp = tcg_temp_new();
 
     tcg_gen_addi_tl(temp, cpu_gpr_a[10], -4);
-    tcg_gen_qemu_st_tl(cpu_gpr_a[11], temp, ctx->mem_idx, MO_LESL);
-    tcg_gen_movi_tl(cpu_gpr_a[11], ctx->pc_succ_insn);
-    tcg_gen_mov_tl(cpu_gpr_a[10], temp);
+    gen_qemu_st_tl(ctx, cpu_gpr_a[11], temp, MO_LESL);
+    tcg_gen_movi_tl(dest_a(ctx, 11), ctx->pc_succ_insn);
+    tcg_gen_mov_tl(dest_a(ctx, 10), temp);
 }
 
 static void gen_fret(DisasContext *ctx)
@@ -2887,8 +3541,8 @@ static void gen_fret(DisasContext *ctx)
     TCGv temp = tcg_temp_new();
 
     tcg_gen_andi_tl(temp, cpu_gpr_a[11], ~0x1);
-    tcg_gen_qemu_ld_tl(cpu_gpr_a[11], cpu_gpr_a[10], ctx->mem_idx, MO_LESL);
-    tcg_gen_addi_tl(cpu_gpr_a[10], cpu_gpr_a[10], 4);
+    gen_qemu_ld_tl(ctx, dest_a(ctx, 11), cpu_gpr_a[10], MO_LESL);
+    tcg_gen_addi_tl(dest_a(ctx, 10), cpu_gpr_a[10], 4);
     tcg_gen_mov_tl(cpu_PC, temp);
     ctx->base.is_jmp = DISAS_EXIT;
 }
@@ -3010,13 +3664,13 @@ static void gen_compute_branch(DisasContext *ctx, uint32_t opc, int r1,
         gen_goto_tb(ctx, 0, EA_B_ABSOLUT(offset));
         break;
     case OPC1_32_B_JLA:
-        tcg_gen_movi_tl(cpu_gpr_a[11], ctx->pc_succ_insn);
+        tcg_gen_movi_tl(dest_a(ctx, 11), ctx->pc_succ_insn);
         /* fall through */
     case OPC1_32_B_JA:
         gen_goto_tb(ctx, 0, EA_B_ABSOLUT(offset));
         break;
     case OPC1_32_B_JL:
-        tcg_gen_movi_tl(cpu_gpr_a[11], ctx->pc_succ_insn);
+        tcg_gen_movi_tl(dest_a(ctx, 11), ctx->pc_succ_insn);
         gen_goto_tb(ctx, 0, ctx->base.pc_next + offset * 2);
         break;
 /* BOL format */
@@ -3150,629 +3804,943 @@ static void gen_compute_branch(DisasContext *ctx, uint32_t opc, int r1,
 
 
 /*
- * Functions for decoding instructions
+ * CMP.F and the float/integer conversions for the common operands. The
+ * helpers handle the rest, including all cases that raise a PSW flag
+ * other than FX.
  */
+static void gen_fcmp(TCGv ret, TCGv r1, TCGv r2)
+{
+    TCGLabel *slow = gen_new_label();
+    TCGLabel *done = gen_new_label();
+    TCGv a1 = tcg_temp_new();
+    TCGv a2 = tcg_temp_new();
+    TCGv k1 = tcg_temp_new();
+    TCGv k2 = tcg_temp_new();
+    TCGv res = tcg_temp_new();
+    TCGv t = tcg_temp_new();
+
+    /* NaNs */
+    tcg_gen_andi_tl(a1, r1, 0x7fffffff);
+    tcg_gen_andi_tl(a2, r2, 0x7fffffff);
+    tcg_gen_brcondi_tl(TCG_COND_GTU, a1, 0x7f800000, slow);
+    tcg_gen_brcondi_tl(TCG_COND_GTU, a2, 0x7f800000, slow);
+
+    /* as two's complement integers, which also makes -0 equal to +0 */
+    tcg_gen_neg_tl(k1, a1);
+    tcg_gen_movcond_tl(TCG_COND_LT, k1, r1, tcg_constant_tl(0), k1, a1);
+    tcg_gen_neg_tl(k2, a2);
+    tcg_gen_movcond_tl(TCG_COND_LT, k2, r2, tcg_constant_tl(0), k2, a2);
+
+    /* less, equal and greater in bits 0-2 */
+    tcg_gen_setcond_tl(TCG_COND_LT, res, k1, k2);
+    tcg_gen_setcond_tl(TCG_COND_EQ, t, k1, k2);
+    tcg_gen_deposit_tl(res, res, t, 1, 1);
+    tcg_gen_setcond_tl(TCG_COND_GT, t, k1, k2);
+    tcg_gen_deposit_tl(res, res, t, 2, 1);
+    /* denormal operands in bits 4 and 5 */
+    tcg_gen_subi_tl(t, a1, 1);
+    tcg_gen_setcondi_tl(TCG_COND_LTU, t, t, 0x7fffff);
+    tcg_gen_deposit_tl(res, res, t, 4, 1);
+    tcg_gen_subi_tl(t, a2, 1);
+    tcg_gen_setcondi_tl(TCG_COND_LTU, t, t, 0x7fffff);
+    tcg_gen_deposit_tl(res, res, t, 5, 1);
+
+    /* FS */
+    tcg_gen_movi_tl(cpu_PSW_C, 0);
+    tcg_gen_mov_tl(ret, res);
+    tcg_gen_br(done);
+
+    gen_set_label(slow);
+    gen_helper_fcmp(ret, tcg_env, r1, r2);
+    gen_set_label(done);
+}
+
+typedef void gen_helper_fconv(TCGv, TCGv_env, TCGv);
 
-static void decode_src_opc(DisasContext *ctx, int op1)
-{
-    int r1;
-    int32_t const4;
-    TCGv temp, temp2;
+/*
+ * FTOI, FTOIZ, FTOU and FTOUZ, rounding to nearest even or, with trunc,
+ * towards zero. Other rounding modes, results out of range, NaNs and
+ * negative FTOU/FTOUZ operands go to the helper.
+ */
+static void gen_ftoi(TCGv ret, TCGv arg, bool is_signed, bool trunc,
+                     gen_helper_fconv *helper)
+{
+    TCGLabel *slow = gen_new_label();
+    TCGLabel *done = gen_new_label();
+    TCGv exp = tcg_temp_new();
+    TCGv man = tcg_temp_new();
+    TCGv sh = tcg_temp_new();
+    TCGv q = tcg_temp_new();
+    TCGv rem = tcg_temp_new();
+    TCGv t = tcg_temp_new();
+
+    if (!trunc) {
+        tcg_gen_andi_tl(t, cpu_PSW, MASK_PSW_FPU_RM);
+        tcg_gen_brcondi_tl(TCG_COND_NE, t, 0, slow);
+    }
+    /* the largest exponent of which all values are in range */
+    tcg_gen_extract_tl(exp, arg, 23, 8);
+    tcg_gen_brcondi_tl(TCG_COND_GTU, exp, is_signed ? 157 : 158, slow);
+    if (!is_signed) {
+        /* -0 and negative denormals convert to 0, the rest is invalid */
+        tcg_gen_brcondi_tl(TCG_COND_GEU, arg, 0x80800000, slow);
+    }
 
-    r1 = MASK_OP_SRC_S1D(ctx->opcode);
-    const4 = MASK_OP_SRC_CONST4_SEXT(ctx->opcode);
+    /* significand with the implicit bit, denormals are flushed to zero */
+    tcg_gen_ori_tl(man, arg, 0x800000);
+    tcg_gen_andi_tl(man, man, 0xffffff);
+    tcg_gen_movcond_tl(TCG_COND_EQ, man, exp, tcg_constant_tl(0),
+                       tcg_constant_tl(0), man);
 
-    switch (op1) {
-    case OPC1_16_SRC_ADD:
-        gen_addi_d(cpu_gpr_d[r1], cpu_gpr_d[r1], const4);
-        break;
-    case OPC1_16_SRC_ADD_A15:
-        gen_addi_d(cpu_gpr_d[r1], cpu_gpr_d[15], const4);
-        break;
-    case OPC1_16_SRC_ADD_15A:
-        gen_addi_d(cpu_gpr_d[15], cpu_gpr_d[r1], const4);
-        break;
-    case OPC1_16_SRC_ADD_A:
-        tcg_gen_addi_tl(cpu_gpr_a[r1], cpu_gpr_a[r1], const4);
-        break;
-    case OPC1_16_SRC_CADD:
-        gen_condi_add(TCG_COND_NE, cpu_gpr_d[r1], const4, cpu_gpr_d[r1],
-                      cpu_gpr_d[15]);
-        break;
-    case OPC1_16_SRC_CADDN:
-        gen_condi_add(TCG_COND_EQ, cpu_gpr_d[r1], const4, cpu_gpr_d[r1],
-                      cpu_gpr_d[15]);
-        break;
-    case OPC1_16_SRC_CMOV:
-        temp = tcg_constant_tl(0);
-        temp2 = tcg_constant_tl(const4);
-        tcg_gen_movcond_tl(TCG_COND_NE, cpu_gpr_d[r1], cpu_gpr_d[15], temp,
-                           temp2, cpu_gpr_d[r1]);
-        break;
-    case OPC1_16_SRC_CMOVN:
-        temp = tcg_constant_tl(0);
-        temp2 = tcg_constant_tl(const4);
-        tcg_gen_movcond_tl(TCG_COND_EQ, cpu_gpr_d[r1], cpu_gpr_d[15], temp,
-                           temp2, cpu_gpr_d[r1]);
-        break;
-    case OPC1_16_SRC_EQ:
-        tcg_gen_setcondi_tl(TCG_COND_EQ, cpu_gpr_d[15], cpu_gpr_d[r1],
-                            const4);
-        break;
-    case OPC1_16_SRC_LT:
-        tcg_gen_setcondi_tl(TCG_COND_LT, cpu_gpr_d[15], cpu_gpr_d[r1],
-                            const4);
-        break;
-    case OPC1_16_SRC_MOV:
-        tcg_gen_movi_tl(cpu_gpr_d[r1], const4);
-        break;
-    case OPC1_16_SRC_MOV_A:
-        const4 = MASK_OP_SRC_CONST4(ctx->opcode);
-        tcg_gen_movi_tl(cpu_gpr_a[r1], const4);
-        break;
-    case OPC1_16_SRC_MOV_E:
-        if (has_feature(ctx, TRICORE_FEATURE_16)) {
-            CHECK_REG_PAIR(r1);
-            tcg_gen_movi_tl(cpu_gpr_d[r1], const4);
-            tcg_gen_sari_tl(cpu_gpr_d[r1+1], cpu_gpr_d[r1], 31);
-        } else {
-            generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
-        }
-        break;
-    case OPC1_16_SRC_SH:
-        gen_shi(cpu_gpr_d[r1], cpu_gpr_d[r1], const4);
-        break;
-    case OPC1_16_SRC_SHA:
-        gen_shaci(cpu_gpr_d[r1], cpu_gpr_d[r1], const4);
-        break;
-    default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
+    /*
+     * Scale by 2^(exp - 150). Right shifts are limited to 25, which
+     * leaves 0 with a remainder below half for all smaller exponents.
+     */
+    tcg_gen_subi_tl(sh, exp, 150);
+    tcg_gen_smax_tl(t, sh, tcg_constant_tl(0));
+    tcg_gen_shl_tl(man, man, t);
+    tcg_gen_neg_tl(sh, sh);
+    tcg_gen_smax_tl(sh, sh, tcg_constant_tl(0));
+    tcg_gen_umin_tl(sh, sh, tcg_constant_tl(25));
+    tcg_gen_shr_tl(q, man, sh);
+    tcg_gen_shl_tl(t, q, sh);
+    tcg_gen_sub_tl(rem, man, t);
+
+    if (!trunc) {
+        TCGv full = tcg_temp_new();
+        TCGv inc = tcg_temp_new();
+
+        /* round up above half and to even at half */
+        tcg_gen_shl_tl(full, tcg_constant_tl(1), sh);
+        tcg_gen_shli_tl(t, rem, 1);
+        tcg_gen_setcond_tl(TCG_COND_GTU, inc, t, full);
+        tcg_gen_setcond_tl(TCG_COND_EQ, t, t, full);
+        tcg_gen_and_tl(t, t, q);
+        tcg_gen_andi_tl(t, t, 1);
+        tcg_gen_or_tl(inc, inc, t);
+        tcg_gen_add_tl(q, q, inc);
     }
+    if (is_signed) {
+        tcg_gen_neg_tl(t, q);
+        tcg_gen_movcond_tl(TCG_COND_LT, q, arg, tcg_constant_tl(0), t, q);
+    }
+
+    /* FS and FX for inexact results */
+    tcg_gen_setcondi_tl(TCG_COND_NE, cpu_PSW_C, rem, 0);
+    tcg_gen_shli_tl(t, cpu_PSW_C, 26);
+    tcg_gen_or_tl(cpu_PSW, cpu_PSW, t);
+    tcg_gen_mov_tl(ret, q);
+    tcg_gen_br(done);
+
+    gen_set_label(slow);
+    helper(ret, tcg_env, arg);
+    gen_set_label(done);
 }
 
-static void decode_srr_opc(DisasContext *ctx, int op1)
+/* ITOF and UTOF of the integers that fit the significand and are exact */
+static void gen_itof(TCGv ret, TCGv arg, bool is_signed,
+                     gen_helper_fconv *helper)
 {
-    int r1, r2;
-    TCGv temp;
+    TCGLabel *slow = gen_new_label();
+    TCGLabel *done = gen_new_label();
+    TCGv a = tcg_temp_new();
+    TCGv n = tcg_temp_new();
+    TCGv res = tcg_temp_new();
+    TCGv t = tcg_temp_new();
 
-    r1 = MASK_OP_SRR_S1D(ctx->opcode);
-    r2 = MASK_OP_SRR_S2(ctx->opcode);
+    if (is_signed) {
+        tcg_gen_abs_tl(a, arg);
+    } else {
+        tcg_gen_mov_tl(a, arg);
+    }
+    tcg_gen_brcondi_tl(TCG_COND_GEU, a, 1 << 24, slow);
 
-    switch (op1) {
-    case OPC1_16_SRR_ADD:
-        gen_add_d(cpu_gpr_d[r1], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_ADD_A15:
-        gen_add_d(cpu_gpr_d[r1], cpu_gpr_d[15], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_ADD_15A:
-        gen_add_d(cpu_gpr_d[15], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_ADD_A:
-        tcg_gen_add_tl(cpu_gpr_a[r1], cpu_gpr_a[r1], cpu_gpr_a[r2]);
-        break;
-    case OPC1_16_SRR_ADDS:
-        gen_adds(cpu_gpr_d[r1], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_AND:
-        tcg_gen_and_tl(cpu_gpr_d[r1], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_CMOV:
-        temp = tcg_constant_tl(0);
-        tcg_gen_movcond_tl(TCG_COND_NE, cpu_gpr_d[r1], cpu_gpr_d[15], temp,
-                           cpu_gpr_d[r2], cpu_gpr_d[r1]);
-        break;
-    case OPC1_16_SRR_CMOVN:
-        temp = tcg_constant_tl(0);
-        tcg_gen_movcond_tl(TCG_COND_EQ, cpu_gpr_d[r1], cpu_gpr_d[15], temp,
-                           cpu_gpr_d[r2], cpu_gpr_d[r1]);
-        break;
-    case OPC1_16_SRR_EQ:
-        tcg_gen_setcond_tl(TCG_COND_EQ, cpu_gpr_d[15], cpu_gpr_d[r1],
-                           cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_LT:
-        tcg_gen_setcond_tl(TCG_COND_LT, cpu_gpr_d[15], cpu_gpr_d[r1],
-                           cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_MOV:
-        tcg_gen_mov_tl(cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_MOV_A:
-        tcg_gen_mov_tl(cpu_gpr_a[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_MOV_AA:
-        tcg_gen_mov_tl(cpu_gpr_a[r1], cpu_gpr_a[r2]);
-        break;
-    case OPC1_16_SRR_MOV_D:
-        tcg_gen_mov_tl(cpu_gpr_d[r1], cpu_gpr_a[r2]);
-        break;
-    case OPC1_16_SRR_MUL:
-        gen_mul_i32s(cpu_gpr_d[r1], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_OR:
-        tcg_gen_or_tl(cpu_gpr_d[r1], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_SUB:
-        gen_sub_d(cpu_gpr_d[r1], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_SUB_A15B:
-        gen_sub_d(cpu_gpr_d[r1], cpu_gpr_d[15], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_SUB_15AB:
-        gen_sub_d(cpu_gpr_d[15], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_SUBS:
-        gen_subs(cpu_gpr_d[r1], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    case OPC1_16_SRR_XOR:
-        tcg_gen_xor_tl(cpu_gpr_d[r1], cpu_gpr_d[r1], cpu_gpr_d[r2]);
-        break;
-    default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
+    /*
+     * Move the leading one to the implicit bit 23, the biased exponent is
+     * 158 - n of which the implicit bit already adds 1.
+     */
+    tcg_gen_clzi_tl(n, a, 32);
+    tcg_gen_subi_tl(t, n, 8);
+    tcg_gen_shl_tl(res, a, t);
+    tcg_gen_subfi_tl(t, 157, n);
+    tcg_gen_shli_tl(t, t, 23);
+    tcg_gen_add_tl(res, res, t);
+    tcg_gen_movcond_tl(TCG_COND_EQ, res, a, tcg_constant_tl(0),
+                       tcg_constant_tl(0), res);
+    if (is_signed) {
+        tcg_gen_andi_tl(t, arg, 0x80000000);
+        tcg_gen_or_tl(res, res, t);
     }
+
+    /* FS */
+    tcg_gen_movi_tl(cpu_PSW_C, 0);
+    tcg_gen_mov_tl(ret, res);
+    tcg_gen_br(done);
+
+    gen_set_label(slow);
+    helper(ret, tcg_env, arg);
+    gen_set_label(done);
 }
 
-static void decode_ssr_opc(DisasContext *ctx, int op1)
+/*
+ * Functions for decoding instructions
+ */
+
+/*
+ * 16 bit instructions, decoded by decode_insn16() from insn16.decode.
+ * The 32 bit instructions further down come from insn32.decode.
+ */
+
+static int times_2(DisasContext *ctx, int x)
 {
-    int r1, r2;
+    return x * 2;
+}
 
-    r1 = MASK_OP_SSR_S1(ctx->opcode);
-    r2 = MASK_OP_SSR_S2(ctx->opcode);
+static int times_4(DisasContext *ctx, int x)
+{
+    return x * 4;
+}
 
-    switch (op1) {
-    case OPC1_16_SSR_ST_A:
-        tcg_gen_qemu_st_tl(cpu_gpr_a[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LEUL);
-        break;
-    case OPC1_16_SSR_ST_A_POSTINC:
-        tcg_gen_qemu_st_tl(cpu_gpr_a[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LEUL);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], 4);
-        break;
-    case OPC1_16_SSR_ST_B:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_UB);
-        break;
-    case OPC1_16_SSR_ST_B_POSTINC:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_UB);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], 1);
-        break;
-    case OPC1_16_SSR_ST_H:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LEUW);
-        break;
-    case OPC1_16_SSR_ST_H_POSTINC:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LEUW);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], 2);
-        break;
-    case OPC1_16_SSR_ST_W:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LEUL);
-        break;
-    case OPC1_16_SSR_ST_W_POSTINC:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LEUL);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], 4);
-        break;
-    default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
-    }
+#include "decode-insn16.c.inc"
+
+/* SRC-format */
+static bool trans_ADD_src(DisasContext *ctx, arg_r1_imm *a)
+{
+    gen_addi_d(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], a->imm);
+    return true;
 }
 
-static void decode_sc_opc(DisasContext *ctx, int op1)
+static bool trans_ADD_src_a15(DisasContext *ctx, arg_r1_imm *a)
 {
-    int32_t const16;
+    gen_addi_d(cpu_gpr_d[a->r1], cpu_gpr_d[15], a->imm);
+    return true;
+}
 
-    const16 = MASK_OP_SC_CONST8(ctx->opcode);
+static bool trans_ADD_src_15a(DisasContext *ctx, arg_r1_imm *a)
+{
+    gen_addi_d(cpu_gpr_d[15], cpu_gpr_d[a->r1], a->imm);
+    return true;
+}
 
-    switch (op1) {
-    case OPC1_16_SC_AND:
-        tcg_gen_andi_tl(cpu_gpr_d[15], cpu_gpr_d[15], const16);
-        break;
-    case OPC1_16_SC_BISR:
-        if (ctx->priv == TRICORE_PRIV_SM) {
-            gen_helper_1arg(bisr, const16 & 0xff);
-        } else {
-            generate_trap(ctx, TRAPC_PROT, TIN1_PRIV);
-        }
-        break;
-    case OPC1_16_SC_LD_A:
-        gen_offset_ld(ctx, cpu_gpr_a[15], cpu_gpr_a[10], const16 * 4, MO_LESL);
-        break;
-    case OPC1_16_SC_LD_W:
-        gen_offset_ld(ctx, cpu_gpr_d[15], cpu_gpr_a[10], const16 * 4, MO_LESL);
-        break;
-    case OPC1_16_SC_MOV:
-        tcg_gen_movi_tl(cpu_gpr_d[15], const16);
-        break;
-    case OPC1_16_SC_OR:
-        tcg_gen_ori_tl(cpu_gpr_d[15], cpu_gpr_d[15], const16);
-        break;
-    case OPC1_16_SC_ST_A:
-        gen_offset_st(ctx, cpu_gpr_a[15], cpu_gpr_a[10], const16 * 4, MO_LESL);
-        break;
-    case OPC1_16_SC_ST_W:
-        gen_offset_st(ctx, cpu_gpr_d[15], cpu_gpr_a[10], const16 * 4, MO_LESL);
-        break;
-    case OPC1_16_SC_SUB_A:
-        tcg_gen_subi_tl(cpu_gpr_a[10], cpu_gpr_a[10], const16);
-        break;
-    default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
-    }
+static bool trans_ADD_A_src(DisasContext *ctx, arg_r1_imm *a)
+{
+    tcg_gen_addi_tl(dest_a(ctx, a->r1), cpu_gpr_a[a->r1], a->imm);
+    return true;
 }
 
-static void decode_slr_opc(DisasContext *ctx, int op1)
+static bool trans_CADD_src(DisasContext *ctx, arg_r1_imm *a)
 {
-    int r1, r2;
+    gen_condi_add(TCG_COND_NE, cpu_gpr_d[a->r1], a->imm, cpu_gpr_d[a->r1],
+                  cpu_gpr_d[15]);
+    return true;
+}
 
-    r1 = MASK_OP_SLR_D(ctx->opcode);
-    r2 = MASK_OP_SLR_S2(ctx->opcode);
+static bool trans_CADDN_src(DisasContext *ctx, arg_r1_imm *a)
+{
+    gen_condi_add(TCG_COND_EQ, cpu_gpr_d[a->r1], a->imm, cpu_gpr_d[a->r1],
+                  cpu_gpr_d[15]);
+    return true;
+}
 
-    switch (op1) {
-/* SLR-format */
-    case OPC1_16_SLR_LD_A:
-        tcg_gen_qemu_ld_tl(cpu_gpr_a[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LESL);
-        break;
-    case OPC1_16_SLR_LD_A_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_a[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LESL);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], 4);
-        break;
-    case OPC1_16_SLR_LD_BU:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_UB);
-        break;
-    case OPC1_16_SLR_LD_BU_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_UB);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], 1);
-        break;
-    case OPC1_16_SLR_LD_H:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LESW);
-        break;
-    case OPC1_16_SLR_LD_H_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LESW);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], 2);
-        break;
-    case OPC1_16_SLR_LD_W:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LESL);
-        break;
-    case OPC1_16_SLR_LD_W_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx, MO_LESL);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], 4);
-        break;
-    default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
-    }
+static bool trans_CMOV_src(DisasContext *ctx, arg_r1_imm *a)
+{
+    tcg_gen_movcond_tl(TCG_COND_NE, cpu_gpr_d[a->r1], cpu_gpr_d[15],
+                       tcg_constant_tl(0), tcg_constant_tl(a->imm),
+                       cpu_gpr_d[a->r1]);
+    return true;
 }
 
-static void decode_sro_opc(DisasContext *ctx, int op1)
+static bool trans_CMOVN_src(DisasContext *ctx, arg_r1_imm *a)
 {
-    int r2;
-    int32_t address;
+    tcg_gen_movcond_tl(TCG_COND_EQ, cpu_gpr_d[a->r1], cpu_gpr_d[15],
+                       tcg_constant_tl(0), tcg_constant_tl(a->imm),
+                       cpu_gpr_d[a->r1]);
+    return true;
+}
 
-    r2 = MASK_OP_SRO_S2(ctx->opcode);
-    address = MASK_OP_SRO_OFF4(ctx->opcode);
+static bool trans_EQ_src(DisasContext *ctx, arg_r1_imm *a)
+{
+    tcg_gen_setcondi_tl(TCG_COND_EQ, cpu_gpr_d[15], cpu_gpr_d[a->r1], a->imm);
+    return true;
+}
 
-/* SRO-format */
-    switch (op1) {
-    case OPC1_16_SRO_LD_A:
-        gen_offset_ld(ctx, cpu_gpr_a[15], cpu_gpr_a[r2], address * 4, MO_LESL);
-        break;
-    case OPC1_16_SRO_LD_BU:
-        gen_offset_ld(ctx, cpu_gpr_d[15], cpu_gpr_a[r2], address, MO_UB);
-        break;
-    case OPC1_16_SRO_LD_H:
-        gen_offset_ld(ctx, cpu_gpr_d[15], cpu_gpr_a[r2], address * 2, MO_LESW);
-        break;
-    case OPC1_16_SRO_LD_W:
-        gen_offset_ld(ctx, cpu_gpr_d[15], cpu_gpr_a[r2], address * 4, MO_LESL);
-        break;
-    case OPC1_16_SRO_ST_A:
-        gen_offset_st(ctx, cpu_gpr_a[15], cpu_gpr_a[r2], address * 4, MO_LESL);
-        break;
-    case OPC1_16_SRO_ST_B:
-        gen_offset_st(ctx, cpu_gpr_d[15], cpu_gpr_a[r2], address, MO_UB);
-        break;
-    case OPC1_16_SRO_ST_H:
-        gen_offset_st(ctx, cpu_gpr_d[15], cpu_gpr_a[r2], address * 2, MO_LESW);
-        break;
-    case OPC1_16_SRO_ST_W:
-        gen_offset_st(ctx, cpu_gpr_d[15], cpu_gpr_a[r2], address * 4, MO_LESL);
-        break;
-    default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
-    }
+static bool trans_LT_src(DisasContext *ctx, arg_r1_imm *a)
+{
+    tcg_gen_setcondi_tl(TCG_COND_LT, cpu_gpr_d[15], cpu_gpr_d[a->r1], a->imm);
+    return true;
 }
 
-static void decode_sr_system(DisasContext *ctx)
+static bool trans_MOV_src(DisasContext *ctx, arg_r1_imm *a)
 {
-    uint32_t op2;
-    op2 = MASK_OP_SR_OP2(ctx->opcode);
+    tcg_gen_movi_tl(cpu_gpr_d[a->r1], a->imm);
+    return true;
+}
 
-    switch (op2) {
-    case OPC2_16_SR_NOP:
-        break;
-    case OPC2_16_SR_RET:
-        gen_compute_branch(ctx, op2, 0, 0, 0, 0);
-        break;
-    case OPC2_16_SR_RFE:
-        gen_helper_rfe(tcg_env);
-        ctx->base.is_jmp = DISAS_EXIT;
-        break;
-    case OPC2_16_SR_DEBUG:
-        /* raise EXCP_DEBUG */
-        break;
-    case OPC2_16_SR_FRET:
-        gen_fret(ctx);
-        break;
-    default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
+/* the only SRC instruction with an unsigned const4 */
+static bool trans_MOV_A_src(DisasContext *ctx, arg_r1_imm *a)
+{
+    tcg_gen_movi_tl(dest_a(ctx, a->r1), a->imm);
+    return true;
+}
+
+static bool trans_MOV_E_src(DisasContext *ctx, arg_r1_imm *a)
+{
+    if (!has_feature(ctx, TRICORE_FEATURE_16)) {
+        return false;
+    }
+    if (a->r1 & 1) {
+        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_OPD);
+        return true;
     }
+    tcg_gen_movi_tl(cpu_gpr_d[a->r1], a->imm);
+    tcg_gen_sari_tl(cpu_gpr_d[a->r1 + 1], cpu_gpr_d[a->r1], 31);
+    return true;
 }
 
-static void decode_sr_accu(DisasContext *ctx)
+static bool trans_SH_src(DisasContext *ctx, arg_r1_imm *a)
 {
-    uint32_t op2;
-    uint32_t r1;
+    gen_shi(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], a->imm);
+    return true;
+}
 
-    r1 = MASK_OP_SR_S1D(ctx->opcode);
-    op2 = MASK_OP_SR_OP2(ctx->opcode);
+static bool trans_SHA_src(DisasContext *ctx, arg_r1_imm *a)
+{
+    gen_shaci(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], a->imm);
+    return true;
+}
 
-    switch (op2) {
-    case OPC2_16_SR_RSUB:
-        /* calc V bit -- overflow only if r1 = -0x80000000 */
-        tcg_gen_setcondi_tl(TCG_COND_EQ, cpu_PSW_V, cpu_gpr_d[r1], -0x80000000);
-        tcg_gen_shli_tl(cpu_PSW_V, cpu_PSW_V, 31);
-        /* calc SV bit */
-        tcg_gen_or_tl(cpu_PSW_SV, cpu_PSW_SV, cpu_PSW_V);
-        /* sub */
-        tcg_gen_neg_tl(cpu_gpr_d[r1], cpu_gpr_d[r1]);
-        /* calc av */
-        tcg_gen_add_tl(cpu_PSW_AV, cpu_gpr_d[r1], cpu_gpr_d[r1]);
-        tcg_gen_xor_tl(cpu_PSW_AV, cpu_gpr_d[r1], cpu_PSW_AV);
-        /* calc sav */
-        tcg_gen_or_tl(cpu_PSW_SAV, cpu_PSW_SAV, cpu_PSW_AV);
-        break;
-    case OPC2_16_SR_SAT_B:
-        gen_saturate(cpu_gpr_d[r1], cpu_gpr_d[r1], 0x7f, -0x80);
-        break;
-    case OPC2_16_SR_SAT_BU:
-        gen_saturate_u(cpu_gpr_d[r1], cpu_gpr_d[r1], 0xff);
-        break;
-    case OPC2_16_SR_SAT_H:
-        gen_saturate(cpu_gpr_d[r1], cpu_gpr_d[r1], 0x7fff, -0x8000);
-        break;
-    case OPC2_16_SR_SAT_HU:
-        gen_saturate_u(cpu_gpr_d[r1], cpu_gpr_d[r1], 0xffff);
-        break;
-    default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
-    }
+/* SRR-format */
+static bool trans_ADD_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    gen_add_d(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
 }
 
-static void decode_16Bit_opc(DisasContext *ctx)
+static bool trans_ADD_srr_a15(DisasContext *ctx, arg_r1_r2 *a)
 {
-    int op1;
-    int r1, r2;
-    int32_t const16;
-    int32_t address;
-    TCGv temp;
+    gen_add_d(cpu_gpr_d[a->r1], cpu_gpr_d[15], cpu_gpr_d[a->r2]);
+    return true;
+}
 
-    op1 = MASK_OP_MAJOR(ctx->opcode);
+static bool trans_ADD_srr_15a(DisasContext *ctx, arg_r1_r2 *a)
+{
+    gen_add_d(cpu_gpr_d[15], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
 
-    /* handle ADDSC.A opcode only being 6 bit long */
-    if (unlikely((op1 & 0x3f) == OPC1_16_SRRS_ADDSC_A)) {
-        op1 = OPC1_16_SRRS_ADDSC_A;
-    }
+static bool trans_ADD_A_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_add_tl(dest_a(ctx, a->r1), cpu_gpr_a[a->r1], cpu_gpr_a[a->r2]);
+    return true;
+}
+
+static bool trans_ADDS_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    gen_adds(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_AND_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_and_tl(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_CMOV_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_movcond_tl(TCG_COND_NE, cpu_gpr_d[a->r1], cpu_gpr_d[15],
+                       tcg_constant_tl(0), cpu_gpr_d[a->r2], cpu_gpr_d[a->r1]);
+    return true;
+}
+
+static bool trans_CMOVN_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_movcond_tl(TCG_COND_EQ, cpu_gpr_d[a->r1], cpu_gpr_d[15],
+                       tcg_constant_tl(0), cpu_gpr_d[a->r2], cpu_gpr_d[a->r1]);
+    return true;
+}
+
+static bool trans_EQ_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_setcond_tl(TCG_COND_EQ, cpu_gpr_d[15], cpu_gpr_d[a->r1],
+                       cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_LT_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_setcond_tl(TCG_COND_LT, cpu_gpr_d[15], cpu_gpr_d[a->r1],
+                       cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_MOV_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_mov_tl(cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_MOV_A_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_mov_tl(dest_a(ctx, a->r1), cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_MOV_AA_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_mov_tl(dest_a(ctx, a->r1), cpu_gpr_a[a->r2]);
+    return true;
+}
+
+static bool trans_MOV_D_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_mov_tl(cpu_gpr_d[a->r1], cpu_gpr_a[a->r2]);
+    return true;
+}
+
+static bool trans_MUL_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    gen_mul_i32s(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_OR_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_or_tl(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_SUB_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    gen_sub_d(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_SUB_srr_a15b(DisasContext *ctx, arg_r1_r2 *a)
+{
+    gen_sub_d(cpu_gpr_d[a->r1], cpu_gpr_d[15], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_SUB_srr_15ab(DisasContext *ctx, arg_r1_r2 *a)
+{
+    gen_sub_d(cpu_gpr_d[15], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_SUBS_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    gen_subs(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+static bool trans_XOR_srr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    tcg_gen_xor_tl(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], cpu_gpr_d[a->r2]);
+    return true;
+}
+
+/* SSR-format */
+static bool do_st_ssr(DisasContext *ctx, TCGv src, int r2, MemOp mop,
+                      int postinc)
+{
+    gen_qemu_st_tl(ctx, src, cpu_gpr_a[r2], mop);
+    if (postinc) {
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], postinc);
+    }
+    return true;
+}
+
+static bool trans_ST_A_ssr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_st_ssr(ctx, cpu_gpr_a[a->r1], a->r2, MO_LEUL, 0);
+}
+
+static bool trans_ST_A_ssr_pi(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_st_ssr(ctx, cpu_gpr_a[a->r1], a->r2, MO_LEUL, 4);
+}
+
+static bool trans_ST_B_ssr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_st_ssr(ctx, cpu_gpr_d[a->r1], a->r2, MO_UB, 0);
+}
+
+static bool trans_ST_B_ssr_pi(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_st_ssr(ctx, cpu_gpr_d[a->r1], a->r2, MO_UB, 1);
+}
+
+static bool trans_ST_H_ssr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_st_ssr(ctx, cpu_gpr_d[a->r1], a->r2, MO_LEUW, 0);
+}
+
+static bool trans_ST_H_ssr_pi(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_st_ssr(ctx, cpu_gpr_d[a->r1], a->r2, MO_LEUW, 2);
+}
+
+static bool trans_ST_W_ssr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_st_ssr(ctx, cpu_gpr_d[a->r1], a->r2, MO_LEUL, 0);
+}
+
+static bool trans_ST_W_ssr_pi(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_st_ssr(ctx, cpu_gpr_d[a->r1], a->r2, MO_LEUL, 4);
+}
+
+/* SRRS-format */
+static bool trans_ADDSC_A_srrs(DisasContext *ctx, arg_r1_r2_n *a)
+{
+    TCGv temp = tcg_temp_new();
+
+    tcg_gen_shli_tl(temp, cpu_gpr_d[15], a->n);
+    tcg_gen_add_tl(dest_a(ctx, a->r1), cpu_gpr_a[a->r2], temp);
+    return true;
+}
+
+/* SLR-format */
+static bool do_ld_slr(DisasContext *ctx, TCGv dst, int r2, MemOp mop,
+                      int postinc)
+{
+    gen_qemu_ld_tl(ctx, dst, cpu_gpr_a[r2], mop);
+    if (postinc) {
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], postinc);
+    }
+    return true;
+}
+
+static bool trans_LD_A_slr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_ld_slr(ctx, dest_a(ctx, a->r1), a->r2, MO_LESL, 0);
+}
+
+static bool trans_LD_A_slr_pi(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_ld_slr(ctx, dest_a(ctx, a->r1), a->r2, MO_LESL, 4);
+}
+
+static bool trans_LD_BU_slr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_ld_slr(ctx, cpu_gpr_d[a->r1], a->r2, MO_UB, 0);
+}
+
+static bool trans_LD_BU_slr_pi(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_ld_slr(ctx, cpu_gpr_d[a->r1], a->r2, MO_UB, 1);
+}
+
+static bool trans_LD_H_slr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_ld_slr(ctx, cpu_gpr_d[a->r1], a->r2, MO_LESW, 0);
+}
+
+static bool trans_LD_H_slr_pi(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_ld_slr(ctx, cpu_gpr_d[a->r1], a->r2, MO_LESW, 2);
+}
+
+static bool trans_LD_W_slr(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_ld_slr(ctx, cpu_gpr_d[a->r1], a->r2, MO_LESL, 0);
+}
+
+static bool trans_LD_W_slr_pi(DisasContext *ctx, arg_r1_r2 *a)
+{
+    return do_ld_slr(ctx, cpu_gpr_d[a->r1], a->r2, MO_LESL, 4);
+}
+
+/* SLRO-format, the offset is already scaled by the access size */
+static bool trans_LD_A_slro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_ld(ctx, dest_a(ctx, a->r), cpu_gpr_a[15], a->off, MO_LESL);
+    return true;
+}
+
+static bool trans_LD_BU_slro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_ld(ctx, cpu_gpr_d[a->r], cpu_gpr_a[15], a->off, MO_UB);
+    return true;
+}
+
+static bool trans_LD_H_slro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_ld(ctx, cpu_gpr_d[a->r], cpu_gpr_a[15], a->off, MO_LESW);
+    return true;
+}
+
+static bool trans_LD_W_slro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_ld(ctx, cpu_gpr_d[a->r], cpu_gpr_a[15], a->off, MO_LESL);
+    return true;
+}
+
+/* SSRO-format */
+static bool trans_ST_A_ssro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_st(ctx, cpu_gpr_a[a->r], cpu_gpr_a[15], a->off, MO_LESL);
+    return true;
+}
+
+static bool trans_ST_B_ssro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_st(ctx, cpu_gpr_d[a->r], cpu_gpr_a[15], a->off, MO_UB);
+    return true;
+}
+
+static bool trans_ST_H_ssro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_st(ctx, cpu_gpr_d[a->r], cpu_gpr_a[15], a->off, MO_LESW);
+    return true;
+}
+
+static bool trans_ST_W_ssro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_st(ctx, cpu_gpr_d[a->r], cpu_gpr_a[15], a->off, MO_LESL);
+    return true;
+}
+
+/* SRO-format */
+static bool trans_LD_A_sro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_ld(ctx, dest_a(ctx, 15), cpu_gpr_a[a->r], a->off, MO_LESL);
+    return true;
+}
+
+static bool trans_LD_BU_sro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_ld(ctx, cpu_gpr_d[15], cpu_gpr_a[a->r], a->off, MO_UB);
+    return true;
+}
+
+static bool trans_LD_H_sro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_ld(ctx, cpu_gpr_d[15], cpu_gpr_a[a->r], a->off, MO_LESW);
+    return true;
+}
+
+static bool trans_LD_W_sro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_ld(ctx, cpu_gpr_d[15], cpu_gpr_a[a->r], a->off, MO_LESL);
+    return true;
+}
+
+static bool trans_ST_A_sro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_st(ctx, cpu_gpr_a[15], cpu_gpr_a[a->r], a->off, MO_LESL);
+    return true;
+}
+
+static bool trans_ST_B_sro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_st(ctx, cpu_gpr_d[15], cpu_gpr_a[a->r], a->off, MO_UB);
+    return true;
+}
+
+static bool trans_ST_H_sro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_st(ctx, cpu_gpr_d[15], cpu_gpr_a[a->r], a->off, MO_LESW);
+    return true;
+}
+
+static bool trans_ST_W_sro(DisasContext *ctx, arg_r_off *a)
+{
+    gen_offset_st(ctx, cpu_gpr_d[15], cpu_gpr_a[a->r], a->off, MO_LESL);
+    return true;
+}
+
+/* SC-format */
+static bool trans_AND_sc(DisasContext *ctx, arg_imm *a)
+{
+    tcg_gen_andi_tl(cpu_gpr_d[15], cpu_gpr_d[15], a->imm);
+    return true;
+}
+
+static bool trans_BISR_sc(DisasContext *ctx, arg_imm *a)
+{
+    if (ctx->priv == TRICORE_PRIV_SM) {
+        gen_helper_1arg(bisr, a->imm);
+    } else {
+        generate_trap(ctx, TRAPC_PROT, TIN1_PRIV);
+    }
+    return true;
+}
+
+static bool trans_LD_A_sc(DisasContext *ctx, arg_imm *a)
+{
+    gen_offset_ld(ctx, dest_a(ctx, 15), cpu_gpr_a[10], a->imm, MO_LESL);
+    return true;
+}
+
+static bool trans_LD_W_sc(DisasContext *ctx, arg_imm *a)
+{
+    gen_offset_ld(ctx, cpu_gpr_d[15], cpu_gpr_a[10], a->imm, MO_LESL);
+    return true;
+}
+
+static bool trans_MOV_sc(DisasContext *ctx, arg_imm *a)
+{
+    tcg_gen_movi_tl(cpu_gpr_d[15], a->imm);
+    return true;
+}
+
+static bool trans_OR_sc(DisasContext *ctx, arg_imm *a)
+{
+    tcg_gen_ori_tl(cpu_gpr_d[15], cpu_gpr_d[15], a->imm);
+    return true;
+}
+
+static bool trans_ST_A_sc(DisasContext *ctx, arg_imm *a)
+{
+    gen_offset_st(ctx, cpu_gpr_a[15], cpu_gpr_a[10], a->imm, MO_LESL);
+    return true;
+}
+
+static bool trans_ST_W_sc(DisasContext *ctx, arg_imm *a)
+{
+    gen_offset_st(ctx, cpu_gpr_d[15], cpu_gpr_a[10], a->imm, MO_LESL);
+    return true;
+}
+
+static bool trans_SUB_A_sc(DisasContext *ctx, arg_imm *a)
+{
+    tcg_gen_subi_tl(dest_a(ctx, 10), cpu_gpr_a[10], a->imm);
+    return true;
+}
 
-    switch (op1) {
-    case OPC1_16_SRC_ADD:
-    case OPC1_16_SRC_ADD_A15:
-    case OPC1_16_SRC_ADD_15A:
-    case OPC1_16_SRC_ADD_A:
-    case OPC1_16_SRC_CADD:
-    case OPC1_16_SRC_CADDN:
-    case OPC1_16_SRC_CMOV:
-    case OPC1_16_SRC_CMOVN:
-    case OPC1_16_SRC_EQ:
-    case OPC1_16_SRC_LT:
-    case OPC1_16_SRC_MOV:
-    case OPC1_16_SRC_MOV_A:
-    case OPC1_16_SRC_MOV_E:
-    case OPC1_16_SRC_SH:
-    case OPC1_16_SRC_SHA:
-        decode_src_opc(ctx, op1);
-        break;
-/* SRR-format */
-    case OPC1_16_SRR_ADD:
-    case OPC1_16_SRR_ADD_A15:
-    case OPC1_16_SRR_ADD_15A:
-    case OPC1_16_SRR_ADD_A:
-    case OPC1_16_SRR_ADDS:
-    case OPC1_16_SRR_AND:
-    case OPC1_16_SRR_CMOV:
-    case OPC1_16_SRR_CMOVN:
-    case OPC1_16_SRR_EQ:
-    case OPC1_16_SRR_LT:
-    case OPC1_16_SRR_MOV:
-    case OPC1_16_SRR_MOV_A:
-    case OPC1_16_SRR_MOV_AA:
-    case OPC1_16_SRR_MOV_D:
-    case OPC1_16_SRR_MUL:
-    case OPC1_16_SRR_OR:
-    case OPC1_16_SRR_SUB:
-    case OPC1_16_SRR_SUB_A15B:
-    case OPC1_16_SRR_SUB_15AB:
-    case OPC1_16_SRR_SUBS:
-    case OPC1_16_SRR_XOR:
-        decode_srr_opc(ctx, op1);
-        break;
-/* SSR-format */
-    case OPC1_16_SSR_ST_A:
-    case OPC1_16_SSR_ST_A_POSTINC:
-    case OPC1_16_SSR_ST_B:
-    case OPC1_16_SSR_ST_B_POSTINC:
-    case OPC1_16_SSR_ST_H:
-    case OPC1_16_SSR_ST_H_POSTINC:
-    case OPC1_16_SSR_ST_W:
-    case OPC1_16_SSR_ST_W_POSTINC:
-        decode_ssr_opc(ctx, op1);
-        break;
-/* SRRS-format */
-    case OPC1_16_SRRS_ADDSC_A:
-        r2 = MASK_OP_SRRS_S2(ctx->opcode);
-        r1 = MASK_OP_SRRS_S1D(ctx->opcode);
-        const16 = MASK_OP_SRRS_N(ctx->opcode);
-        temp = tcg_temp_new();
-        tcg_gen_shli_tl(temp, cpu_gpr_d[15], const16);
-        tcg_gen_add_tl(cpu_gpr_a[r1], cpu_gpr_a[r2], temp);
-        break;
-/* SLRO-format */
-    case OPC1_16_SLRO_LD_A:
-        r1 = MASK_OP_SLRO_D(ctx->opcode);
-        const16 = MASK_OP_SLRO_OFF4(ctx->opcode);
-        gen_offset_ld(ctx, cpu_gpr_a[r1], cpu_gpr_a[15], const16 * 4, MO_LESL);
-        break;
-    case OPC1_16_SLRO_LD_BU:
-        r1 = MASK_OP_SLRO_D(ctx->opcode);
-        const16 = MASK_OP_SLRO_OFF4(ctx->opcode);
-        gen_offset_ld(ctx, cpu_gpr_d[r1], cpu_gpr_a[15], const16, MO_UB);
-        break;
-    case OPC1_16_SLRO_LD_H:
-        r1 = MASK_OP_SLRO_D(ctx->opcode);
-        const16 = MASK_OP_SLRO_OFF4(ctx->opcode);
-        gen_offset_ld(ctx, cpu_gpr_d[r1], cpu_gpr_a[15], const16 * 2, MO_LESW);
-        break;
-    case OPC1_16_SLRO_LD_W:
-        r1 = MASK_OP_SLRO_D(ctx->opcode);
-        const16 = MASK_OP_SLRO_OFF4(ctx->opcode);
-        gen_offset_ld(ctx, cpu_gpr_d[r1], cpu_gpr_a[15], const16 * 4, MO_LESL);
-        break;
 /* SB-format */
-    case OPC1_16_SB_CALL:
-    case OPC1_16_SB_J:
-    case OPC1_16_SB_JNZ:
-    case OPC1_16_SB_JZ:
-        address = MASK_OP_SB_DISP8_SEXT(ctx->opcode);
-        gen_compute_branch(ctx, op1, 0, 0, 0, address);
-        break;
+static bool trans_CALL_sb(DisasContext *ctx, arg_disp *a)
+{
+    gen_compute_branch(ctx, OPC1_16_SB_CALL, 0, 0, 0, a->disp);
+    return true;
+}
+
+static bool trans_J_sb(DisasContext *ctx, arg_disp *a)
+{
+    gen_compute_branch(ctx, OPC1_16_SB_J, 0, 0, 0, a->disp);
+    return true;
+}
+
+static bool trans_JNZ_sb(DisasContext *ctx, arg_disp *a)
+{
+    gen_compute_branch(ctx, OPC1_16_SB_JNZ, 0, 0, 0, a->disp);
+    return true;
+}
+
+static bool trans_JZ_sb(DisasContext *ctx, arg_disp *a)
+{
+    gen_compute_branch(ctx, OPC1_16_SB_JZ, 0, 0, 0, a->disp);
+    return true;
+}
+
 /* SBC-format */
-    case OPC1_16_SBC_JEQ:
-    case OPC1_16_SBC_JNE:
-        address = MASK_OP_SBC_DISP4(ctx->opcode);
-        const16 = MASK_OP_SBC_CONST4_SEXT(ctx->opcode);
-        gen_compute_branch(ctx, op1, 0, 0, const16, address);
-        break;
-    case OPC1_16_SBC_JEQ2:
-    case OPC1_16_SBC_JNE2:
-        if (has_feature(ctx, TRICORE_FEATURE_16)) {
-            address = MASK_OP_SBC_DISP4(ctx->opcode);
-            const16 = MASK_OP_SBC_CONST4_SEXT(ctx->opcode);
-            gen_compute_branch(ctx, op1, 0, 0, const16, address);
-        } else {
-            generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
-        }
-        break;
+static bool trans_JEQ_sbc(DisasContext *ctx, arg_imm_disp *a)
+{
+    gen_compute_branch(ctx, OPC1_16_SBC_JEQ, 0, 0, a->imm, a->disp);
+    return true;
+}
+
+static bool trans_JEQ2_sbc(DisasContext *ctx, arg_imm_disp *a)
+{
+    if (!has_feature(ctx, TRICORE_FEATURE_16)) {
+        return false;
+    }
+    gen_compute_branch(ctx, OPC1_16_SBC_JEQ2, 0, 0, a->imm, a->disp);
+    return true;
+}
+
+static bool trans_JNE_sbc(DisasContext *ctx, arg_imm_disp *a)
+{
+    gen_compute_branch(ctx, OPC1_16_SBC_JNE, 0, 0, a->imm, a->disp);
+    return true;
+}
+
+static bool trans_JNE2_sbc(DisasContext *ctx, arg_imm_disp *a)
+{
+    if (!has_feature(ctx, TRICORE_FEATURE_16)) {
+        return false;
+    }
+    gen_compute_branch(ctx, OPC1_16_SBC_JNE2, 0, 0, a->imm, a->disp);
+    return true;
+}
+
 /* SBRN-format */
-    case OPC1_16_SBRN_JNZ_T:
-    case OPC1_16_SBRN_JZ_T:
-        address = MASK_OP_SBRN_DISP4(ctx->opcode);
-        const16 = MASK_OP_SBRN_N(ctx->opcode);
-        gen_compute_branch(ctx, op1, 0, 0, const16, address);
-        break;
+static bool trans_JNZ_T_sbrn(DisasContext *ctx, arg_imm_disp *a)
+{
+    gen_compute_branch(ctx, OPC1_16_SBRN_JNZ_T, 0, 0, a->imm, a->disp);
+    return true;
+}
+
+static bool trans_JZ_T_sbrn(DisasContext *ctx, arg_imm_disp *a)
+{
+    gen_compute_branch(ctx, OPC1_16_SBRN_JZ_T, 0, 0, a->imm, a->disp);
+    return true;
+}
+
 /* SBR-format */
-    case OPC1_16_SBR_JEQ2:
-    case OPC1_16_SBR_JNE2:
-        if (has_feature(ctx, TRICORE_FEATURE_16)) {
-            r1 = MASK_OP_SBR_S2(ctx->opcode);
-            address = MASK_OP_SBR_DISP4(ctx->opcode);
-            gen_compute_branch(ctx, op1, r1, 0, 0, address);
-        } else {
-            generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
-        }
-        break;
-    case OPC1_16_SBR_JEQ:
-    case OPC1_16_SBR_JGEZ:
-    case OPC1_16_SBR_JGTZ:
-    case OPC1_16_SBR_JLEZ:
-    case OPC1_16_SBR_JLTZ:
-    case OPC1_16_SBR_JNE:
-    case OPC1_16_SBR_JNZ:
-    case OPC1_16_SBR_JNZ_A:
-    case OPC1_16_SBR_JZ:
-    case OPC1_16_SBR_JZ_A:
-    case OPC1_16_SBR_LOOP:
-        r1 = MASK_OP_SBR_S2(ctx->opcode);
-        address = MASK_OP_SBR_DISP4(ctx->opcode);
-        gen_compute_branch(ctx, op1, r1, 0, 0, address);
-        break;
-/* SC-format */
-    case OPC1_16_SC_AND:
-    case OPC1_16_SC_BISR:
-    case OPC1_16_SC_LD_A:
-    case OPC1_16_SC_LD_W:
-    case OPC1_16_SC_MOV:
-    case OPC1_16_SC_OR:
-    case OPC1_16_SC_ST_A:
-    case OPC1_16_SC_ST_W:
-    case OPC1_16_SC_SUB_A:
-        decode_sc_opc(ctx, op1);
-        break;
-/* SLR-format */
-    case OPC1_16_SLR_LD_A:
-    case OPC1_16_SLR_LD_A_POSTINC:
-    case OPC1_16_SLR_LD_BU:
-    case OPC1_16_SLR_LD_BU_POSTINC:
-    case OPC1_16_SLR_LD_H:
-    case OPC1_16_SLR_LD_H_POSTINC:
-    case OPC1_16_SLR_LD_W:
-    case OPC1_16_SLR_LD_W_POSTINC:
-        decode_slr_opc(ctx, op1);
-        break;
-/* SRO-format */
-    case OPC1_16_SRO_LD_A:
-    case OPC1_16_SRO_LD_BU:
-    case OPC1_16_SRO_LD_H:
-    case OPC1_16_SRO_LD_W:
-    case OPC1_16_SRO_ST_A:
-    case OPC1_16_SRO_ST_B:
-    case OPC1_16_SRO_ST_H:
-    case OPC1_16_SRO_ST_W:
-        decode_sro_opc(ctx, op1);
-        break;
-/* SSRO-format */
-    case OPC1_16_SSRO_ST_A:
-        r1 = MASK_OP_SSRO_S1(ctx->opcode);
-        const16 = MASK_OP_SSRO_OFF4(ctx->opcode);
-        gen_offset_st(ctx, cpu_gpr_a[r1], cpu_gpr_a[15], const16 * 4, MO_LESL);
-        break;
-    case OPC1_16_SSRO_ST_B:
-        r1 = MASK_OP_SSRO_S1(ctx->opcode);
-        const16 = MASK_OP_SSRO_OFF4(ctx->opcode);
-        gen_offset_st(ctx, cpu_gpr_d[r1], cpu_gpr_a[15], const16, MO_UB);
-        break;
-    case OPC1_16_SSRO_ST_H:
-        r1 = MASK_OP_SSRO_S1(ctx->opcode);
-        const16 = MASK_OP_SSRO_OFF4(ctx->opcode);
-        gen_offset_st(ctx, cpu_gpr_d[r1], cpu_gpr_a[15], const16 * 2, MO_LESW);
-        break;
-    case OPC1_16_SSRO_ST_W:
-        r1 = MASK_OP_SSRO_S1(ctx->opcode);
-        const16 = MASK_OP_SSRO_OFF4(ctx->opcode);
-        gen_offset_st(ctx, cpu_gpr_d[r1], cpu_gpr_a[15], const16 * 4, MO_LESL);
-        break;
-/* SR-format */
-    case OPCM_16_SR_SYSTEM:
-        decode_sr_system(ctx);
-        break;
-    case OPCM_16_SR_ACCU:
-        decode_sr_accu(ctx);
-        break;
-    case OPC1_16_SR_JI:
-        r1 = MASK_OP_SR_S1D(ctx->opcode);
-        gen_compute_branch(ctx, op1, r1, 0, 0, 0);
-        break;
-    case OPC1_16_SR_NOT:
-        r1 = MASK_OP_SR_S1D(ctx->opcode);
-        tcg_gen_not_tl(cpu_gpr_d[r1], cpu_gpr_d[r1]);
-        break;
-    default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
+static bool do_branch_sbr(DisasContext *ctx, int opc, arg_r_disp *a)
+{
+    gen_compute_branch(ctx, opc, a->r, 0, 0, a->disp);
+    return true;
+}
+
+static bool trans_JEQ_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JEQ, a);
+}
+
+static bool trans_JEQ2_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    if (!has_feature(ctx, TRICORE_FEATURE_16)) {
+        return false;
     }
+    return do_branch_sbr(ctx, OPC1_16_SBR_JEQ2, a);
+}
+
+static bool trans_JGEZ_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JGEZ, a);
+}
+
+static bool trans_JGTZ_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JGTZ, a);
+}
+
+static bool trans_JLEZ_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JLEZ, a);
+}
+
+static bool trans_JLTZ_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JLTZ, a);
+}
+
+static bool trans_JNE_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JNE, a);
+}
+
+static bool trans_JNE2_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    if (!has_feature(ctx, TRICORE_FEATURE_16)) {
+        return false;
+    }
+    return do_branch_sbr(ctx, OPC1_16_SBR_JNE2, a);
+}
+
+static bool trans_JNZ_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JNZ, a);
+}
+
+static bool trans_JNZ_A_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JNZ_A, a);
+}
+
+static bool trans_JZ_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JZ, a);
+}
+
+static bool trans_JZ_A_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_JZ_A, a);
+}
+
+static bool trans_LOOP_sbr(DisasContext *ctx, arg_r_disp *a)
+{
+    return do_branch_sbr(ctx, OPC1_16_SBR_LOOP, a);
+}
+
+/* SR-format */
+static bool trans_NOP_sr(DisasContext *ctx, arg_empty *a)
+{
+    return true;
+}
+
+static bool trans_FRET_sr(DisasContext *ctx, arg_empty *a)
+{
+    gen_fret(ctx);
+    return true;
+}
+
+static bool trans_RFE_sr(DisasContext *ctx, arg_empty *a)
+{
+    gen_helper_rfe(tcg_env);
+    ctx->base.is_jmp = DISAS_EXIT;
+    return true;
+}
+
+static bool trans_RET_sr(DisasContext *ctx, arg_empty *a)
+{
+    gen_compute_branch(ctx, OPC2_16_SR_RET, 0, 0, 0, 0);
+    return true;
+}
+
+static bool trans_DEBUG_sr(DisasContext *ctx, arg_empty *a)
+{
+    gen_debug(ctx);
+    return true;
+}
+
+static bool trans_SAT_B_sr(DisasContext *ctx, arg_r1 *a)
+{
+    gen_saturate(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], 0x7f, -0x80);
+    return true;
+}
+
+static bool trans_SAT_BU_sr(DisasContext *ctx, arg_r1 *a)
+{
+    gen_saturate_u(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], 0xff);
+    return true;
+}
+
+static bool trans_SAT_H_sr(DisasContext *ctx, arg_r1 *a)
+{
+    gen_saturate(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], 0x7fff, -0x8000);
+    return true;
+}
+
+static bool trans_SAT_HU_sr(DisasContext *ctx, arg_r1 *a)
+{
+    gen_saturate_u(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1], 0xffff);
+    return true;
+}
+
+static bool trans_RSUB_sr(DisasContext *ctx, arg_r1 *a)
+{
+    TCGv r1 = cpu_gpr_d[a->r1];
+
+    /* calc V bit -- overflow only if r1 = -0x80000000 */
+    tcg_gen_setcondi_tl(TCG_COND_EQ, cpu_PSW_V, r1, -0x80000000);
+    tcg_gen_shli_tl(cpu_PSW_V, cpu_PSW_V, 31);
+    /* calc SV bit */
+    tcg_gen_or_tl(cpu_PSW_SV, cpu_PSW_SV, cpu_PSW_V);
+    /* sub */
+    tcg_gen_neg_tl(r1, r1);
+    /* calc av */
+    tcg_gen_add_tl(cpu_PSW_AV, r1, r1);
+    tcg_gen_xor_tl(cpu_PSW_AV, r1, cpu_PSW_AV);
+    /* calc sav */
+    tcg_gen_or_tl(cpu_PSW_SAV, cpu_PSW_SAV, cpu_PSW_AV);
+    return true;
+}
+
+static bool trans_JI_sr(DisasContext *ctx, arg_r1 *a)
+{
+    gen_compute_branch(ctx, OPC1_16_SR_JI, a->r1, 0, 0, 0);
+    return true;
+}
+
+static bool trans_NOT_sr(DisasContext *ctx, arg_r1 *a)
+{
+    tcg_gen_not_tl(cpu_gpr_d[a->r1], cpu_gpr_d[a->r1]);
+    return true;
 }
 
 /*
@@ -3791,11 +4759,11 @@ static void decode_abs_ldw(DisasContext *ctx)
     address = MASK_OP_ABS_OFF18(ctx->opcode);
     op2 = MASK_OP_ABS_OP2(ctx->opcode);
 
-    temp = tcg_constant_i32(EA_ABS_FORMAT(address));
+    temp = gen_const_addr(ctx, EA_ABS_FORMAT(address));
 
     switch (op2) {
     case OPC2_32_ABS_LD_A:
-        tcg_gen_qemu_ld_tl(cpu_gpr_a[r1], temp, ctx->mem_idx, MO_LESL);
+        gen_qemu_ld_tl(ctx, dest_a(ctx, r1), temp, MO_LESL);
         break;
     case OPC2_32_ABS_LD_D:
         CHECK_REG_PAIR(r1);
@@ -3803,10 +4771,10 @@ static void decode_abs_ldw(DisasContext *ctx)
         break;
     case OPC2_32_ABS_LD_DA:
         CHECK_REG_PAIR(r1);
-        gen_ld_2regs_64(cpu_gpr_a[r1+1], cpu_gpr_a[r1], temp, ctx);
+        gen_ld_2regs_64(dest_a(ctx, r1 + 1), dest_a(ctx, r1), temp, ctx);
         break;
     case OPC2_32_ABS_LD_W:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_LESL);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp, MO_LESL);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -3824,20 +4792,20 @@ static void decode_abs_ldb(DisasContext *ctx)
     address = MASK_OP_ABS_OFF18(ctx->opcode);
     op2 = MASK_OP_ABS_OP2(ctx->opcode);
 
-    temp = tcg_constant_i32(EA_ABS_FORMAT(address));
+    temp = gen_const_addr(ctx, EA_ABS_FORMAT(address));
 
     switch (op2) {
     case OPC2_32_ABS_LD_B:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_SB);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp, MO_SB);
         break;
     case OPC2_32_ABS_LD_BU:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_UB);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp, MO_UB);
         break;
     case OPC2_32_ABS_LD_H:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_LESW);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp, MO_LESW);
         break;
     case OPC2_32_ABS_LD_HU:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_LEUW);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp, MO_LEUW);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -3855,7 +4823,7 @@ static void decode_abs_ldst_swap(DisasContext *ctx)
     address = MASK_OP_ABS_OFF18(ctx->opcode);
     op2 = MASK_OP_ABS_OP2(ctx->opcode);
 
-    temp = tcg_constant_i32(EA_ABS_FORMAT(address));
+    temp = gen_const_addr(ctx, EA_ABS_FORMAT(address));
 
     switch (op2) {
     case OPC2_32_ABS_LDMST:
@@ -3906,11 +4874,11 @@ static void decode_abs_store(DisasContext *ctx)
     address = MASK_OP_ABS_OFF18(ctx->opcode);
     op2 = MASK_OP_ABS_OP2(ctx->opcode);
 
-    temp = tcg_constant_i32(EA_ABS_FORMAT(address));
+    temp = gen_const_addr(ctx, EA_ABS_FORMAT(address));
 
     switch (op2) {
     case OPC2_32_ABS_ST_A:
-        tcg_gen_qemu_st_tl(cpu_gpr_a[r1], temp, ctx->mem_idx, MO_LESL);
+        gen_qemu_st_tl(ctx, cpu_gpr_a[r1], temp, MO_LESL);
         break;
     case OPC2_32_ABS_ST_D:
         CHECK_REG_PAIR(r1);
@@ -3921,7 +4889,7 @@ static void decode_abs_store(DisasContext *ctx)
         gen_st_2regs_64(cpu_gpr_a[r1+1], cpu_gpr_a[r1], temp, ctx);
         break;
     case OPC2_32_ABS_ST_W:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_LESL);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp, MO_LESL);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -3939,14 +4907,14 @@ static void decode_abs_storeb_h(DisasContext *ctx)
     address = MASK_OP_ABS_OFF18(ctx->opcode);
     op2 = MASK_OP_ABS_OP2(ctx->opcode);
 
-    temp = tcg_constant_i32(EA_ABS_FORMAT(address));
+    temp = gen_const_addr(ctx, EA_ABS_FORMAT(address));
 
     switch (op2) {
     case OPC2_32_ABS_ST_B:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_UB);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp, MO_UB);
         break;
     case OPC2_32_ABS_ST_H:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_LEUW);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp, MO_LEUW);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -4235,14 +5203,14 @@ static void decode_bo_addrmode_post_pre_base(DisasContext *ctx)
     case OPC2_32_BO_CACHEA_I_POSTINC:
         /* instruction to access the cache, but we still need to handle
            the addressing mode */
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_CACHEA_WI_PREINC:
     case OPC2_32_BO_CACHEA_W_PREINC:
     case OPC2_32_BO_CACHEA_I_PREINC:
         /* instruction to access the cache, but we still need to handle
            the addressing mode */
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_CACHEI_WI_SHORTOFF:
     case OPC2_32_BO_CACHEI_W_SHORTOFF:
@@ -4253,7 +5221,7 @@ static void decode_bo_addrmode_post_pre_base(DisasContext *ctx)
     case OPC2_32_BO_CACHEI_W_POSTINC:
     case OPC2_32_BO_CACHEI_WI_POSTINC:
         if (has_feature(ctx, TRICORE_FEATURE_131)) {
-            tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+            tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         } else {
             generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
         }
@@ -4261,7 +5229,7 @@ static void decode_bo_addrmode_post_pre_base(DisasContext *ctx)
     case OPC2_32_BO_CACHEI_W_PREINC:
     case OPC2_32_BO_CACHEI_WI_PREINC:
         if (has_feature(ctx, TRICORE_FEATURE_131)) {
-            tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+            tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         } else {
             generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
         }
@@ -4270,23 +5238,21 @@ static void decode_bo_addrmode_post_pre_base(DisasContext *ctx)
         gen_offset_st(ctx, cpu_gpr_a[r1], cpu_gpr_a[r2], off10, MO_LESL);
         break;
     case OPC2_32_BO_ST_A_POSTINC:
-        tcg_gen_qemu_st_tl(cpu_gpr_a[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_LESL);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_a[r1], cpu_gpr_a[r2], MO_LESL);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_ST_A_PREINC:
-        gen_st_preincr(ctx, cpu_gpr_a[r1], cpu_gpr_a[r2], off10, MO_LESL);
+        gen_st_preincr(ctx, cpu_gpr_a[r1], dest_a(ctx, r2), off10, MO_LESL);
         break;
     case OPC2_32_BO_ST_B_SHORTOFF:
         gen_offset_st(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_UB);
         break;
     case OPC2_32_BO_ST_B_POSTINC:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_UB);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], MO_UB);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_ST_B_PREINC:
-        gen_st_preincr(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_UB);
+        gen_st_preincr(ctx, cpu_gpr_d[r1], dest_a(ctx, r2), off10, MO_UB);
         break;
     case OPC2_32_BO_ST_D_SHORTOFF:
         CHECK_REG_PAIR(r1);
@@ -4296,14 +5262,14 @@ static void decode_bo_addrmode_post_pre_base(DisasContext *ctx)
     case OPC2_32_BO_ST_D_POSTINC:
         CHECK_REG_PAIR(r1);
         gen_st_2regs_64(cpu_gpr_d[r1+1], cpu_gpr_d[r1], cpu_gpr_a[r2], ctx);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_ST_D_PREINC:
         CHECK_REG_PAIR(r1);
         temp = tcg_temp_new();
         tcg_gen_addi_tl(temp, cpu_gpr_a[r2], off10);
         gen_st_2regs_64(cpu_gpr_d[r1+1], cpu_gpr_d[r1], temp, ctx);
-        tcg_gen_mov_tl(cpu_gpr_a[r2], temp);
+        tcg_gen_mov_tl(dest_a(ctx, r2), temp);
         break;
     case OPC2_32_BO_ST_DA_SHORTOFF:
         CHECK_REG_PAIR(r1);
@@ -4313,25 +5279,24 @@ static void decode_bo_addrmode_post_pre_base(DisasContext *ctx)
     case OPC2_32_BO_ST_DA_POSTINC:
         CHECK_REG_PAIR(r1);
         gen_st_2regs_64(cpu_gpr_a[r1+1], cpu_gpr_a[r1], cpu_gpr_a[r2], ctx);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_ST_DA_PREINC:
         CHECK_REG_PAIR(r1);
         temp = tcg_temp_new();
         tcg_gen_addi_tl(temp, cpu_gpr_a[r2], off10);
         gen_st_2regs_64(cpu_gpr_a[r1+1], cpu_gpr_a[r1], temp, ctx);
-        tcg_gen_mov_tl(cpu_gpr_a[r2], temp);
+        tcg_gen_mov_tl(dest_a(ctx, r2), temp);
         break;
     case OPC2_32_BO_ST_H_SHORTOFF:
         gen_offset_st(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUW);
         break;
     case OPC2_32_BO_ST_H_POSTINC:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_LEUW);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], MO_LEUW);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_ST_H_PREINC:
-        gen_st_preincr(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUW);
+        gen_st_preincr(ctx, cpu_gpr_d[r1], dest_a(ctx, r2), off10, MO_LEUW);
         break;
     case OPC2_32_BO_ST_Q_SHORTOFF:
         temp = tcg_temp_new();
@@ -4341,25 +5306,23 @@ static void decode_bo_addrmode_post_pre_base(DisasContext *ctx)
     case OPC2_32_BO_ST_Q_POSTINC:
         temp = tcg_temp_new();
         tcg_gen_shri_tl(temp, cpu_gpr_d[r1], 16);
-        tcg_gen_qemu_st_tl(temp, cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_LEUW);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_st_tl(ctx, temp, cpu_gpr_a[r2], MO_LEUW);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_ST_Q_PREINC:
         temp = tcg_temp_new();
         tcg_gen_shri_tl(temp, cpu_gpr_d[r1], 16);
-        gen_st_preincr(ctx, temp, cpu_gpr_a[r2], off10, MO_LEUW);
+        gen_st_preincr(ctx, temp, dest_a(ctx, r2), off10, MO_LEUW);
         break;
     case OPC2_32_BO_ST_W_SHORTOFF:
         gen_offset_st(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUL);
         break;
     case OPC2_32_BO_ST_W_POSTINC:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_LEUL);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], MO_LEUL);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_ST_W_PREINC:
-        gen_st_preincr(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUL);
+        gen_st_preincr(ctx, cpu_gpr_d[r1], dest_a(ctx, r2), off10, MO_LEUL);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -4389,84 +5352,84 @@ static void decode_bo_addrmode_bitreverse_circular(DisasContext *ctx)
     case OPC2_32_BO_CACHEA_WI_BR:
     case OPC2_32_BO_CACHEA_W_BR:
     case OPC2_32_BO_CACHEA_I_BR:
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_CACHEA_WI_CIRC:
     case OPC2_32_BO_CACHEA_W_CIRC:
     case OPC2_32_BO_CACHEA_I_CIRC:
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_ST_A_BR:
-        tcg_gen_qemu_st_tl(cpu_gpr_a[r1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_st_tl(ctx, cpu_gpr_a[r1], temp2, MO_LEUL);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_ST_A_CIRC:
-        tcg_gen_qemu_st_tl(cpu_gpr_a[r1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_a[r1], temp2, MO_LEUL);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_ST_B_BR:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_UB);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp2, MO_UB);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_ST_B_CIRC:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_UB);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp2, MO_UB);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_ST_D_BR:
         CHECK_REG_PAIR(r1);
         gen_st_2regs_64(cpu_gpr_d[r1+1], cpu_gpr_d[r1], temp2, ctx);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_ST_D_CIRC:
         CHECK_REG_PAIR(r1);
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUL);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUL);
         tcg_gen_shri_tl(temp2, cpu_gpr_a[r2+1], 16);
         tcg_gen_addi_tl(temp, temp, 4);
         tcg_gen_rem_tl(temp, temp, temp2);
         tcg_gen_add_tl(temp2, cpu_gpr_a[r2], temp);
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1+1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1+1], temp2, MO_LEUL);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_ST_DA_BR:
         CHECK_REG_PAIR(r1);
         gen_st_2regs_64(cpu_gpr_a[r1+1], cpu_gpr_a[r1], temp2, ctx);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_ST_DA_CIRC:
         CHECK_REG_PAIR(r1);
-        tcg_gen_qemu_st_tl(cpu_gpr_a[r1], temp2, ctx->mem_idx, MO_LEUL);
+        gen_qemu_st_tl(ctx, cpu_gpr_a[r1], temp2, MO_LEUL);
         tcg_gen_shri_tl(temp2, cpu_gpr_a[r2+1], 16);
         tcg_gen_addi_tl(temp, temp, 4);
         tcg_gen_rem_tl(temp, temp, temp2);
         tcg_gen_add_tl(temp2, cpu_gpr_a[r2], temp);
-        tcg_gen_qemu_st_tl(cpu_gpr_a[r1+1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_a[r1+1], temp2, MO_LEUL);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_ST_H_BR:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUW);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUW);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_ST_H_CIRC:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUW);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUW);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_ST_Q_BR:
         tcg_gen_shri_tl(temp, cpu_gpr_d[r1], 16);
-        tcg_gen_qemu_st_tl(temp, temp2, ctx->mem_idx, MO_LEUW);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_st_tl(ctx, temp, temp2, MO_LEUW);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_ST_Q_CIRC:
         tcg_gen_shri_tl(temp, cpu_gpr_d[r1], 16);
-        tcg_gen_qemu_st_tl(temp, temp2, ctx->mem_idx, MO_LEUW);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_st_tl(ctx, temp, temp2, MO_LEUW);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_ST_W_BR:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUL);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_ST_W_CIRC:
-        tcg_gen_qemu_st_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_st_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUL);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -4487,37 +5450,34 @@ static void decode_bo_addrmode_ld_post_pre_base(DisasContext *ctx)
 
     switch (op2) {
     case OPC2_32_BO_LD_A_SHORTOFF:
-        gen_offset_ld(ctx, cpu_gpr_a[r1], cpu_gpr_a[r2], off10, MO_LEUL);
+        gen_offset_ld(ctx, dest_a(ctx, r1), cpu_gpr_a[r2], off10, MO_LEUL);
         break;
     case OPC2_32_BO_LD_A_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_a[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_LEUL);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_ld_tl(ctx, dest_a(ctx, r1), cpu_gpr_a[r2], MO_LEUL);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LD_A_PREINC:
-        gen_ld_preincr(ctx, cpu_gpr_a[r1], cpu_gpr_a[r2], off10, MO_LEUL);
+        gen_ld_preincr(ctx, dest_a(ctx, r1), dest_a(ctx, r2), off10, MO_LEUL);
         break;
     case OPC2_32_BO_LD_B_SHORTOFF:
         gen_offset_ld(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_SB);
         break;
     case OPC2_32_BO_LD_B_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_SB);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], MO_SB);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LD_B_PREINC:
-        gen_ld_preincr(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_SB);
+        gen_ld_preincr(ctx, cpu_gpr_d[r1], dest_a(ctx, r2), off10, MO_SB);
         break;
     case OPC2_32_BO_LD_BU_SHORTOFF:
         gen_offset_ld(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_UB);
         break;
     case OPC2_32_BO_LD_BU_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_UB);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], MO_UB);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LD_BU_PREINC:
-        gen_ld_preincr(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_UB);
+        gen_ld_preincr(ctx, cpu_gpr_d[r1], dest_a(ctx, r2), off10, MO_UB);
         break;
     case OPC2_32_BO_LD_D_SHORTOFF:
         CHECK_REG_PAIR(r1);
@@ -4527,78 +5487,75 @@ static void decode_bo_addrmode_ld_post_pre_base(DisasContext *ctx)
     case OPC2_32_BO_LD_D_POSTINC:
         CHECK_REG_PAIR(r1);
         gen_ld_2regs_64(cpu_gpr_d[r1+1], cpu_gpr_d[r1], cpu_gpr_a[r2], ctx);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LD_D_PREINC:
         CHECK_REG_PAIR(r1);
         temp = tcg_temp_new();
         tcg_gen_addi_tl(temp, cpu_gpr_a[r2], off10);
         gen_ld_2regs_64(cpu_gpr_d[r1+1], cpu_gpr_d[r1], temp, ctx);
-        tcg_gen_mov_tl(cpu_gpr_a[r2], temp);
+        tcg_gen_mov_tl(dest_a(ctx, r2), temp);
         break;
     case OPC2_32_BO_LD_DA_SHORTOFF:
         CHECK_REG_PAIR(r1);
-        gen_offset_ld_2regs(cpu_gpr_a[r1+1], cpu_gpr_a[r1], cpu_gpr_a[r2],
+        gen_offset_ld_2regs(dest_a(ctx, r1 + 1), dest_a(ctx, r1), cpu_gpr_a[r2],
                             off10, ctx);
         break;
     case OPC2_32_BO_LD_DA_POSTINC:
         CHECK_REG_PAIR(r1);
-        gen_ld_2regs_64(cpu_gpr_a[r1+1], cpu_gpr_a[r1], cpu_gpr_a[r2], ctx);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_ld_2regs_64(dest_a(ctx, r1 + 1), dest_a(ctx, r1), cpu_gpr_a[r2],
+                        ctx);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LD_DA_PREINC:
         CHECK_REG_PAIR(r1);
         temp = tcg_temp_new();
         tcg_gen_addi_tl(temp, cpu_gpr_a[r2], off10);
-        gen_ld_2regs_64(cpu_gpr_a[r1+1], cpu_gpr_a[r1], temp, ctx);
-        tcg_gen_mov_tl(cpu_gpr_a[r2], temp);
+        gen_ld_2regs_64(dest_a(ctx, r1 + 1), dest_a(ctx, r1), temp, ctx);
+        tcg_gen_mov_tl(dest_a(ctx, r2), temp);
         break;
     case OPC2_32_BO_LD_H_SHORTOFF:
         gen_offset_ld(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LESW);
         break;
     case OPC2_32_BO_LD_H_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_LESW);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], MO_LESW);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LD_H_PREINC:
-        gen_ld_preincr(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LESW);
+        gen_ld_preincr(ctx, cpu_gpr_d[r1], dest_a(ctx, r2), off10, MO_LESW);
         break;
     case OPC2_32_BO_LD_HU_SHORTOFF:
         gen_offset_ld(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUW);
         break;
     case OPC2_32_BO_LD_HU_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_LEUW);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], MO_LEUW);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LD_HU_PREINC:
-        gen_ld_preincr(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUW);
+        gen_ld_preincr(ctx, cpu_gpr_d[r1], dest_a(ctx, r2), off10, MO_LEUW);
         break;
     case OPC2_32_BO_LD_Q_SHORTOFF:
         gen_offset_ld(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUW);
         tcg_gen_shli_tl(cpu_gpr_d[r1], cpu_gpr_d[r1], 16);
         break;
     case OPC2_32_BO_LD_Q_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_LEUW);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], MO_LEUW);
         tcg_gen_shli_tl(cpu_gpr_d[r1], cpu_gpr_d[r1], 16);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LD_Q_PREINC:
-        gen_ld_preincr(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUW);
+        gen_ld_preincr(ctx, cpu_gpr_d[r1], dest_a(ctx, r2), off10, MO_LEUW);
         tcg_gen_shli_tl(cpu_gpr_d[r1], cpu_gpr_d[r1], 16);
         break;
     case OPC2_32_BO_LD_W_SHORTOFF:
         gen_offset_ld(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUL);
         break;
     case OPC2_32_BO_LD_W_POSTINC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], cpu_gpr_a[r2], ctx->mem_idx,
-                           MO_LEUL);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], MO_LEUL);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LD_W_PREINC:
-        gen_ld_preincr(ctx, cpu_gpr_d[r1], cpu_gpr_a[r2], off10, MO_LEUL);
+        gen_ld_preincr(ctx, cpu_gpr_d[r1], dest_a(ctx, r2), off10, MO_LEUL);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -4627,92 +5584,92 @@ static void decode_bo_addrmode_ld_bitreverse_circular(DisasContext *ctx)
 
     switch (op2) {
     case OPC2_32_BO_LD_A_BR:
-        tcg_gen_qemu_ld_tl(cpu_gpr_a[r1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_ld_tl(ctx, dest_a(ctx, r1), temp2, MO_LEUL);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LD_A_CIRC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_a[r1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_ld_tl(ctx, dest_a(ctx, r1), temp2, MO_LEUL);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_LD_B_BR:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_SB);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_SB);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LD_B_CIRC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_SB);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_SB);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_LD_BU_BR:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_UB);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_UB);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LD_BU_CIRC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_UB);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_UB);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_LD_D_BR:
         CHECK_REG_PAIR(r1);
         gen_ld_2regs_64(cpu_gpr_d[r1+1], cpu_gpr_d[r1], temp2, ctx);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LD_D_CIRC:
         CHECK_REG_PAIR(r1);
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUL);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUL);
         tcg_gen_shri_tl(temp2, cpu_gpr_a[r2+1], 16);
         tcg_gen_addi_tl(temp, temp, 4);
         tcg_gen_rem_tl(temp, temp, temp2);
         tcg_gen_add_tl(temp2, cpu_gpr_a[r2], temp);
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1+1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1+1], temp2, MO_LEUL);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_LD_DA_BR:
         CHECK_REG_PAIR(r1);
-        gen_ld_2regs_64(cpu_gpr_a[r1+1], cpu_gpr_a[r1], temp2, ctx);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_ld_2regs_64(dest_a(ctx, r1 + 1), dest_a(ctx, r1), temp2, ctx);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LD_DA_CIRC:
         CHECK_REG_PAIR(r1);
-        tcg_gen_qemu_ld_tl(cpu_gpr_a[r1], temp2, ctx->mem_idx, MO_LEUL);
+        gen_qemu_ld_tl(ctx, dest_a(ctx, r1), temp2, MO_LEUL);
         tcg_gen_shri_tl(temp2, cpu_gpr_a[r2+1], 16);
         tcg_gen_addi_tl(temp, temp, 4);
         tcg_gen_rem_tl(temp, temp, temp2);
         tcg_gen_add_tl(temp2, cpu_gpr_a[r2], temp);
-        tcg_gen_qemu_ld_tl(cpu_gpr_a[r1+1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_ld_tl(ctx, dest_a(ctx, r1 + 1), temp2, MO_LEUL);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_LD_H_BR:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LESW);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_LESW);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LD_H_CIRC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LESW);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_LESW);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_LD_HU_BR:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUW);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUW);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LD_HU_CIRC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUW);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUW);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_LD_Q_BR:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUW);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUW);
         tcg_gen_shli_tl(cpu_gpr_d[r1], cpu_gpr_d[r1], 16);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LD_Q_CIRC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUW);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUW);
         tcg_gen_shli_tl(cpu_gpr_d[r1], cpu_gpr_d[r1], 16);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_LD_W_BR:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUL);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LD_W_CIRC:
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp2, ctx->mem_idx, MO_LEUL);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp2, MO_LEUL);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -4746,10 +5703,10 @@ static void decode_bo_addrmode_stctx_post_pre_base(DisasContext *ctx)
         break;
     case OPC2_32_BO_LDMST_POSTINC:
         gen_ldmst(ctx, r1, cpu_gpr_a[r2]);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_LDMST_PREINC:
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         gen_ldmst(ctx, r1, cpu_gpr_a[r2]);
         break;
     case OPC2_32_BO_LDUCX_SHORTOFF:
@@ -4757,7 +5714,7 @@ static void decode_bo_addrmode_stctx_post_pre_base(DisasContext *ctx)
         gen_helper_lducx(tcg_env, temp);
         break;
     case OPC2_32_BO_LEA_SHORTOFF:
-        tcg_gen_addi_tl(cpu_gpr_a[r1], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r1), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_STLCX_SHORTOFF:
         tcg_gen_addi_tl(temp, cpu_gpr_a[r2], off10);
@@ -4773,10 +5730,10 @@ static void decode_bo_addrmode_stctx_post_pre_base(DisasContext *ctx)
         break;
     case OPC2_32_BO_SWAP_W_POSTINC:
         gen_swap(ctx, r1, cpu_gpr_a[r2]);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_SWAP_W_PREINC:
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         gen_swap(ctx, r1, cpu_gpr_a[r2]);
         break;
     case OPC2_32_BO_CMPSWAP_W_SHORTOFF:
@@ -4785,10 +5742,10 @@ static void decode_bo_addrmode_stctx_post_pre_base(DisasContext *ctx)
         break;
     case OPC2_32_BO_CMPSWAP_W_POSTINC:
         gen_cmpswap(ctx, r1, cpu_gpr_a[r2]);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_CMPSWAP_W_PREINC:
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         gen_cmpswap(ctx, r1, cpu_gpr_a[r2]);
         break;
     case OPC2_32_BO_SWAPMSK_W_SHORTOFF:
@@ -4797,10 +5754,10 @@ static void decode_bo_addrmode_stctx_post_pre_base(DisasContext *ctx)
         break;
     case OPC2_32_BO_SWAPMSK_W_POSTINC:
         gen_swapmsk(ctx, r1, cpu_gpr_a[r2]);
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         break;
     case OPC2_32_BO_SWAPMSK_W_PREINC:
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r2], off10);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r2], off10);
         gen_swapmsk(ctx, r1, cpu_gpr_a[r2]);
         break;
     default:
@@ -4830,35 +5787,35 @@ static void decode_bo_addrmode_ldmst_bitreverse_circular(DisasContext *ctx)
     switch (op2) {
     case OPC2_32_BO_LDMST_BR:
         gen_ldmst(ctx, r1, temp2);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_LDMST_CIRC:
         gen_ldmst(ctx, r1, temp2);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_SWAP_W_BR:
         gen_swap(ctx, r1, temp2);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_SWAP_W_CIRC:
         gen_swap(ctx, r1, temp2);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_CMPSWAP_W_BR:
         gen_cmpswap(ctx, r1, temp2);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_CMPSWAP_W_CIRC:
         gen_cmpswap(ctx, r1, temp2);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     case OPC2_32_BO_SWAPMSK_W_BR:
         gen_swapmsk(ctx, r1, temp2);
-        gen_helper_br_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1]);
+        gen_helper_br_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1]);
         break;
     case OPC2_32_BO_SWAPMSK_W_CIRC:
         gen_swapmsk(ctx, r1, temp2);
-        gen_helper_circ_update(cpu_gpr_a[r2+1], cpu_gpr_a[r2+1], t_off10);
+        gen_helper_circ_update(dest_a(ctx, r2 + 1), cpu_gpr_a[r2 + 1], t_off10);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -4877,17 +5834,16 @@ static void decode_bol_opc(DisasContext *ctx, int32_t op1)
 
     switch (op1) {
     case OPC1_32_BOL_LD_A_LONGOFF:
-        temp = tcg_temp_new();
-        tcg_gen_addi_tl(temp, cpu_gpr_a[r2], address);
-        tcg_gen_qemu_ld_tl(cpu_gpr_a[r1], temp, ctx->mem_idx, MO_LEUL);
+        temp = gen_base_offset(ctx, cpu_gpr_a[r2], address);
+        gen_qemu_ld_tl(ctx, dest_a(ctx, r1), temp, MO_LEUL);
         break;
     case OPC1_32_BOL_LD_W_LONGOFF:
-        temp = tcg_temp_new();
-        tcg_gen_addi_tl(temp, cpu_gpr_a[r2], address);
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_LEUL);
+        temp = gen_base_offset(ctx, cpu_gpr_a[r2], address);
+        gen_qemu_ld_tl(ctx, cpu_gpr_d[r1], temp, MO_LEUL);
         break;
     case OPC1_32_BOL_LEA_LONGOFF:
-        tcg_gen_addi_tl(cpu_gpr_a[r1], cpu_gpr_a[r2], address);
+        tcg_gen_mov_tl(dest_a(ctx, r1), gen_base_offset(ctx, cpu_gpr_a[r2],
+                                                      address));
         break;
     case OPC1_32_BOL_ST_A_LONGOFF:
         if (has_feature(ctx, TRICORE_FEATURE_16)) {
@@ -5535,7 +6491,7 @@ static void decode_rlc_opc(DisasContext *ctx,
         gen_addi_d(cpu_gpr_d[r2], cpu_gpr_d[r1], const16 << 16);
         break;
     case OPC1_32_RLC_ADDIH_A:
-        tcg_gen_addi_tl(cpu_gpr_a[r2], cpu_gpr_a[r1], const16 << 16);
+        tcg_gen_addi_tl(dest_a(ctx, r2), cpu_gpr_a[r1], const16 << 16);
         break;
     case OPC1_32_RLC_MFCR:
         const16 = MASK_OP_RLC_CONST16(ctx->opcode);
@@ -5561,7 +6517,7 @@ static void decode_rlc_opc(DisasContext *ctx,
         tcg_gen_movi_tl(cpu_gpr_d[r2], const16 << 16);
         break;
     case OPC1_32_RLC_MOVH_A:
-        tcg_gen_movi_tl(cpu_gpr_a[r2], const16 << 16);
+        tcg_gen_movi_tl(dest_a(ctx, r2), const16 << 16);
         break;
     case OPC1_32_RLC_MTCR:
         const16 = MASK_OP_RLC_CONST16(ctx->opcode);
@@ -6004,18 +6960,18 @@ static void decode_rr_address(DisasContext *ctx)
 
     switch (op2) {
     case OPC2_32_RR_ADD_A:
-        tcg_gen_add_tl(cpu_gpr_a[r3], cpu_gpr_a[r1], cpu_gpr_a[r2]);
+        tcg_gen_add_tl(dest_a(ctx, r3), cpu_gpr_a[r1], cpu_gpr_a[r2]);
         break;
     case OPC2_32_RR_ADDSC_A:
         temp = tcg_temp_new();
         tcg_gen_shli_tl(temp, cpu_gpr_d[r1], n);
-        tcg_gen_add_tl(cpu_gpr_a[r3], cpu_gpr_a[r2], temp);
+        tcg_gen_add_tl(dest_a(ctx, r3), cpu_gpr_a[r2], temp);
         break;
     case OPC2_32_RR_ADDSC_AT:
         temp = tcg_temp_new();
         tcg_gen_sari_tl(temp, cpu_gpr_d[r1], 3);
         tcg_gen_add_tl(temp, cpu_gpr_a[r2], temp);
-        tcg_gen_andi_tl(cpu_gpr_a[r3], temp, 0xFFFFFFFC);
+        tcg_gen_andi_tl(dest_a(ctx, r3), temp, 0xFFFFFFFC);
         break;
     case OPC2_32_RR_EQ_A:
         tcg_gen_setcond_tl(TCG_COND_EQ, cpu_gpr_d[r3], cpu_gpr_a[r1],
@@ -6033,10 +6989,10 @@ static void decode_rr_address(DisasContext *ctx)
                            cpu_gpr_a[r2]);
         break;
     case OPC2_32_RR_MOV_A:
-        tcg_gen_mov_tl(cpu_gpr_a[r3], cpu_gpr_d[r2]);
+        tcg_gen_mov_tl(dest_a(ctx, r3), cpu_gpr_d[r2]);
         break;
     case OPC2_32_RR_MOV_AA:
-        tcg_gen_mov_tl(cpu_gpr_a[r3], cpu_gpr_a[r2]);
+        tcg_gen_mov_tl(dest_a(ctx, r3), cpu_gpr_a[r2]);
         break;
     case OPC2_32_RR_MOV_D:
         tcg_gen_mov_tl(cpu_gpr_d[r3], cpu_gpr_a[r2]);
@@ -6049,7 +7005,7 @@ static void decode_rr_address(DisasContext *ctx)
         tcg_gen_setcondi_tl(TCG_COND_NE, cpu_gpr_d[r3], cpu_gpr_a[r1], 0);
         break;
     case OPC2_32_RR_SUB_A:
-        tcg_gen_sub_tl(cpu_gpr_a[r3], cpu_gpr_a[r1], cpu_gpr_a[r2]);
+        tcg_gen_sub_tl(dest_a(ctx, r3), cpu_gpr_a[r1], cpu_gpr_a[r2]);
         break;
     default:
         generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
@@ -6070,7 +7026,7 @@ static void decode_rr_idirect(DisasContext *ctx)
         break;
     case OPC2_32_RR_JLI:
         tcg_gen_andi_tl(cpu_PC, cpu_gpr_a[r1], ~0x1);
-        tcg_gen_movi_tl(cpu_gpr_a[11], ctx->pc_succ_insn);
+        tcg_gen_movi_tl(dest_a(ctx, 11), ctx->pc_succ_insn);
         break;
     case OPC2_32_RR_CALLI:
         gen_helper_1arg(call, ctx->pc_succ_insn);
@@ -6185,6 +7141,9 @@ static void decode_rr_divide(DisasContext *ctx)
         tcg_gen_mov_tl(cpu_gpr_d[r3], cpu_gpr_d[r1]);
         /* sign extend to high reg */
         tcg_gen_sari_tl(cpu_gpr_d[r3+1], cpu_gpr_d[r1], 31);
+        if (ctx->fused) {
+            gen_dv_fused(r2, r3, true);
+        }
         break;
     case OPC2_32_RR_DVINIT_U:
         CHECK_REG_PAIR(r3);
@@ -6199,6 +7158,9 @@ static void decode_rr_divide(DisasContext *ctx)
         tcg_gen_mov_tl(cpu_gpr_d[r3], cpu_gpr_d[r1]);
         /* zero extend to high reg*/
         tcg_gen_movi_tl(cpu_gpr_d[r3+1], 0);
+        if (ctx->fused) {
+            gen_dv_fused(r2, r3, false);
+        }
         break;
     case OPC2_32_RR_PARITY:
         gen_helper_parity(cpu_gpr_d[r3], cpu_gpr_d[r1]);
@@ -6275,20 +7237,23 @@ static void decode_rr_divide(DisasContext *ctx)
         }
         break;
     case OPC2_32_RR_CMP_F:
-        gen_helper_fcmp(cpu_gpr_d[r3], tcg_env, cpu_gpr_d[r1], cpu_gpr_d[r2]);
+        gen_fcmp(cpu_gpr_d[r3], cpu_gpr_d[r1], cpu_gpr_d[r2]);
         break;
     case OPC2_32_RR_FTOI:
-        gen_helper_ftoi(cpu_gpr_d[r3], tcg_env, cpu_gpr_d[r1]);
+        gen_ftoi(cpu_gpr_d[r3], cpu_gpr_d[r1], true, false,
+                 gen_helper_ftoi);
         break;
     case OPC2_32_RR_ITOF:
-        gen_helper_itof(cpu_gpr_d[r3], tcg_env, cpu_gpr_d[r1]);
+        gen_itof(cpu_gpr_d[r3], cpu_gpr_d[r1], true, gen_helper_itof);
         break;
     case OPC2_32_RR_FTOU:
-        gen_helper_ftou(cpu_gpr_d[r3], tcg_env, cpu_gpr_d[r1]);
+        gen_ftoi(cpu_gpr_d[r3], cpu_gpr_d[r1], false, false,
+                 gen_helper_ftou);
         break;
     case OPC2_32_RR_FTOUZ:
         if (has_feature(ctx, TRICORE_FEATURE_131)) {
-            gen_helper_ftouz(cpu_gpr_d[r3], tcg_env, cpu_gpr_d[r1]);
+            gen_ftoi(cpu_gpr_d[r3], cpu_gpr_d[r1], false, true,
+                     gen_helper_ftouz);
         } else {
             generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
         }
@@ -6297,10 +7262,11 @@ static void decode_rr_divide(DisasContext *ctx)
         gen_helper_updfl(tcg_env, cpu_gpr_d[r1]);
         break;
     case OPC2_32_RR_UTOF:
-        gen_helper_utof(cpu_gpr_d[r3], tcg_env, cpu_gpr_d[r1]);
+        gen_itof(cpu_gpr_d[r3], cpu_gpr_d[r1], false, gen_helper_utof);
         break;
     case OPC2_32_RR_FTOIZ:
-        gen_helper_ftoiz(cpu_gpr_d[r3], tcg_env, cpu_gpr_d[r1]);
+        gen_ftoi(cpu_gpr_d[r3], cpu_gpr_d[r1], true, true,
+                 gen_helper_ftoiz);
         break;
     case OPC2_32_RR_QSEED_F:
         gen_helper_qseed(cpu_gpr_d[r3], tcg_env, cpu_gpr_d[r1]);
@@ -6316,48 +7282,48 @@ static void decode_rr1_mul(DisasContext *ctx)
     uint32_t op2;
 
     int r1, r2, r3;
-    TCGv n;
+    uint32_t n;
     TCGv_i64 temp64;
 
     r1 = MASK_OP_RR1_S1(ctx->opcode);
     r2 = MASK_OP_RR1_S2(ctx->opcode);
     r3 = MASK_OP_RR1_D(ctx->opcode);
-    n  = tcg_constant_i32(MASK_OP_RR1_N(ctx->opcode));
+    n  = MASK_OP_RR1_N(ctx->opcode);
     op2 = MASK_OP_RR1_OP2(ctx->opcode);
 
     switch (op2) {
     case OPC2_32_RR1_MUL_H_32_LL:
         temp64 = tcg_temp_new_i64();
         CHECK_REG_PAIR(r3);
-        GEN_HELPER_LL(mul_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_LL(mul_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         tcg_gen_extr_i64_i32(cpu_gpr_d[r3], cpu_gpr_d[r3+1], temp64);
         gen_calc_usb_mul_h(cpu_gpr_d[r3], cpu_gpr_d[r3+1]);
         break;
     case OPC2_32_RR1_MUL_H_32_LU:
         temp64 = tcg_temp_new_i64();
         CHECK_REG_PAIR(r3);
-        GEN_HELPER_LU(mul_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_LU(mul_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         tcg_gen_extr_i64_i32(cpu_gpr_d[r3], cpu_gpr_d[r3+1], temp64);
         gen_calc_usb_mul_h(cpu_gpr_d[r3], cpu_gpr_d[r3+1]);
         break;
     case OPC2_32_RR1_MUL_H_32_UL:
         temp64 = tcg_temp_new_i64();
         CHECK_REG_PAIR(r3);
-        GEN_HELPER_UL(mul_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_UL(mul_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         tcg_gen_extr_i64_i32(cpu_gpr_d[r3], cpu_gpr_d[r3+1], temp64);
         gen_calc_usb_mul_h(cpu_gpr_d[r3], cpu_gpr_d[r3+1]);
         break;
     case OPC2_32_RR1_MUL_H_32_UU:
         temp64 = tcg_temp_new_i64();
         CHECK_REG_PAIR(r3);
-        GEN_HELPER_UU(mul_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_UU(mul_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         tcg_gen_extr_i64_i32(cpu_gpr_d[r3], cpu_gpr_d[r3+1], temp64);
         gen_calc_usb_mul_h(cpu_gpr_d[r3], cpu_gpr_d[r3+1]);
         break;
     case OPC2_32_RR1_MULM_H_64_LL:
         temp64 = tcg_temp_new_i64();
         CHECK_REG_PAIR(r3);
-        GEN_HELPER_LL(mulm_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_LL(mulm_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         tcg_gen_extr_i64_i32(cpu_gpr_d[r3], cpu_gpr_d[r3+1], temp64);
         /* reset V bit */
         tcg_gen_movi_tl(cpu_PSW_V, 0);
@@ -6367,7 +7333,7 @@ static void decode_rr1_mul(DisasContext *ctx)
     case OPC2_32_RR1_MULM_H_64_LU:
         temp64 = tcg_temp_new_i64();
         CHECK_REG_PAIR(r3);
-        GEN_HELPER_LU(mulm_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_LU(mulm_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         tcg_gen_extr_i64_i32(cpu_gpr_d[r3], cpu_gpr_d[r3+1], temp64);
         /* reset V bit */
         tcg_gen_movi_tl(cpu_PSW_V, 0);
@@ -6377,7 +7343,7 @@ static void decode_rr1_mul(DisasContext *ctx)
     case OPC2_32_RR1_MULM_H_64_UL:
         temp64 = tcg_temp_new_i64();
         CHECK_REG_PAIR(r3);
-        GEN_HELPER_UL(mulm_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_UL(mulm_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         tcg_gen_extr_i64_i32(cpu_gpr_d[r3], cpu_gpr_d[r3+1], temp64);
         /* reset V bit */
         tcg_gen_movi_tl(cpu_PSW_V, 0);
@@ -6387,7 +7353,7 @@ static void decode_rr1_mul(DisasContext *ctx)
     case OPC2_32_RR1_MULM_H_64_UU:
         temp64 = tcg_temp_new_i64();
         CHECK_REG_PAIR(r3);
-        GEN_HELPER_UU(mulm_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_UU(mulm_h, temp64, cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         tcg_gen_extr_i64_i32(cpu_gpr_d[r3], cpu_gpr_d[r3+1], temp64);
         /* reset V bit */
         tcg_gen_movi_tl(cpu_PSW_V, 0);
@@ -6395,19 +7361,19 @@ static void decode_rr1_mul(DisasContext *ctx)
         tcg_gen_mov_tl(cpu_PSW_AV, cpu_PSW_V);
         break;
     case OPC2_32_RR1_MULR_H_16_LL:
-        GEN_HELPER_LL(mulr_h, cpu_gpr_d[r3], cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_LL(mulr_h, cpu_gpr_d[r3], cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         gen_calc_usb_mulr_h(cpu_gpr_d[r3]);
         break;
     case OPC2_32_RR1_MULR_H_16_LU:
-        GEN_HELPER_LU(mulr_h, cpu_gpr_d[r3], cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_LU(mulr_h, cpu_gpr_d[r3], cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         gen_calc_usb_mulr_h(cpu_gpr_d[r3]);
         break;
     case OPC2_32_RR1_MULR_H_16_UL:
-        GEN_HELPER_UL(mulr_h, cpu_gpr_d[r3], cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_UL(mulr_h, cpu_gpr_d[r3], cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         gen_calc_usb_mulr_h(cpu_gpr_d[r3]);
         break;
     case OPC2_32_RR1_MULR_H_16_UU:
-        GEN_HELPER_UU(mulr_h, cpu_gpr_d[r3], cpu_gpr_d[r1], cpu_gpr_d[r2], n);
+        GEN_MUL_UU(mulr_h, cpu_gpr_d[r3], cpu_gpr_d[r1], cpu_gpr_d[r2], n);
         gen_calc_usb_mulr_h(cpu_gpr_d[r3]);
         break;
     default:
@@ -6637,20 +7603,20 @@ static void decode_rrr_divide(DisasContext *ctx)
     case OPC2_32_RRR_DVADJ:
         CHECK_REG_PAIR(r3);
         CHECK_REG_PAIR(r4);
-        GEN_HELPER_RRR(dvadj, cpu_gpr_d[r4], cpu_gpr_d[r4+1], cpu_gpr_d[r3],
-                       cpu_gpr_d[r3+1], cpu_gpr_d[r2]);
+        gen_dvadj(cpu_gpr_d[r4], cpu_gpr_d[r4+1], cpu_gpr_d[r3],
+                  cpu_gpr_d[r3+1], cpu_gpr_d[r2]);
         break;
     case OPC2_32_RRR_DVSTEP:
         CHECK_REG_PAIR(r3);
         CHECK_REG_PAIR(r4);
-        GEN_HELPER_RRR(dvstep, cpu_gpr_d[r4], cpu_gpr_d[r4+1], cpu_gpr_d[r3],
-                       cpu_gpr_d[r3+1], cpu_gpr_d[r2]);
+        gen_dvstep(cpu_gpr_d[r4], cpu_gpr_d[r4+1], cpu_gpr_d[r3],
+                   cpu_gpr_d[r3+1], cpu_gpr_d[r2]);
         break;
     case OPC2_32_RRR_DVSTEP_U:
         CHECK_REG_PAIR(r3);
         CHECK_REG_PAIR(r4);
-        GEN_HELPER_RRR(dvstep_u, cpu_gpr_d[r4], cpu_gpr_d[r4+1], cpu_gpr_d[r3],
-                       cpu_gpr_d[r3+1], cpu_gpr_d[r2]);
+        gen_dvstep_u(cpu_gpr_d[r4], cpu_gpr_d[r4+1], cpu_gpr_d[r3],
+                     cpu_gpr_d[r3+1], cpu_gpr_d[r2]);
         break;
     case OPC2_32_RRR_IXMAX:
         CHECK_REG_PAIR(r3);
@@ -7911,7 +8877,7 @@ static void decode_sys_interrupts(DisasContext *ctx)
 
     switch (op2) {
     case OPC2_32_SYS_DEBUG:
-        /* raise EXCP_DEBUG */
+        gen_debug(ctx);
         break;
     case OPC2_32_SYS_DISABLE:
         if (ctx->priv == TRICORE_PRIV_SM || ctx->priv == TRICORE_PRIV_UM1) {
@@ -8007,142 +8973,463 @@ static void decode_sys_interrupts(DisasContext *ctx)
     }
 }
 
-static void decode_32Bit_opc(DisasContext *ctx)
+/*
+ * 32 bit instructions, decoded by decode_insn32() from insn32.decode. The
+ * groups sharing a major opcode are still told apart by their decode_*()
+ * function above.
+ */
+
+#include "decode-insn32.c.inc"
+
+#define TRANS_GROUP(NAME, FUNC)                                   \
+    static bool trans_##NAME(DisasContext *ctx, arg_empty *a)     \
+    {                                                             \
+        FUNC(ctx);                                                \
+        return true;                                              \
+    }
+
+#define TRANS_OP1(NAME, FUNC, OP1)                                \
+    static bool trans_##NAME(DisasContext *ctx, arg_empty *a)     \
+    {                                                             \
+        FUNC(ctx, OP1);                                           \
+        return true;                                              \
+    }
+
+/* ABS-format */
+TRANS_GROUP(LDW_abs, decode_abs_ldw)
+TRANS_GROUP(LDB_abs, decode_abs_ldb)
+TRANS_GROUP(LDMST_SWAP_abs, decode_abs_ldst_swap)
+TRANS_GROUP(LDST_CONTEXT_abs, decode_abs_ldst_context)
+TRANS_GROUP(STORE_abs, decode_abs_store)
+TRANS_GROUP(STOREB_H_abs, decode_abs_storeb_h)
+
+static bool trans_STOREQ_abs(DisasContext *ctx, arg_r_off *a)
 {
-    int op1, op2;
-    int32_t r1, r2, r3;
-    int32_t address, const16;
-    int8_t b, const4;
-    int32_t bpos;
-    TCGv temp, temp2, temp3;
+    TCGv temp = gen_const_addr(ctx, EA_ABS_FORMAT(a->off));
+    TCGv temp2 = tcg_temp_new();
+
+    tcg_gen_shri_tl(temp2, cpu_gpr_d[a->r], 16);
+    gen_qemu_st_tl(ctx, temp2, temp, MO_LEUW);
+    return true;
+}
+
+static bool trans_LD_Q_abs(DisasContext *ctx, arg_r_off *a)
+{
+    TCGv temp = gen_const_addr(ctx, EA_ABS_FORMAT(a->off));
+
+    gen_qemu_ld_tl(ctx, cpu_gpr_d[a->r], temp, MO_LEUW);
+    tcg_gen_shli_tl(cpu_gpr_d[a->r], cpu_gpr_d[a->r], 16);
+    return true;
+}
+
+static bool trans_LEA_LHA_abs(DisasContext *ctx, arg_abs_op2 *a)
+{
+    if (has_feature(ctx, TRICORE_FEATURE_162) && a->op2 == OPC2_32_ABS_LHA) {
+        tcg_gen_movi_tl(dest_a(ctx, a->r), a->off << 14);
+    } else {
+        tcg_gen_movi_tl(dest_a(ctx, a->r), EA_ABS_FORMAT(a->off));
+    }
+    return true;
+}
+
+/* ABSB-format */
+static bool trans_ST_T_absb(DisasContext *ctx, arg_absb *a)
+{
+    TCGv temp = gen_const_addr(ctx, EA_ABS_FORMAT(a->off));
+    TCGv temp2 = tcg_temp_new();
+
+    gen_qemu_ld_tl(ctx, temp2, temp, MO_UB);
+    tcg_gen_andi_tl(temp2, temp2, ~(0x1u << a->bpos));
+    tcg_gen_ori_tl(temp2, temp2, (a->b << a->bpos));
+    gen_qemu_st_tl(ctx, temp2, temp, MO_UB);
+    return true;
+}
+
+/* B-format */
+static bool do_branch_b(DisasContext *ctx, int opc, arg_disp *a)
+{
+    gen_compute_branch(ctx, opc, 0, 0, 0, a->disp);
+    return true;
+}
+
+static bool trans_CALL_b(DisasContext *ctx, arg_disp *a)
+{
+    return do_branch_b(ctx, OPC1_32_B_CALL, a);
+}
+
+static bool trans_CALLA_b(DisasContext *ctx, arg_disp *a)
+{
+    return do_branch_b(ctx, OPC1_32_B_CALLA, a);
+}
+
+static bool trans_FCALL_b(DisasContext *ctx, arg_disp *a)
+{
+    return do_branch_b(ctx, OPC1_32_B_FCALL, a);
+}
+
+static bool trans_FCALLA_b(DisasContext *ctx, arg_disp *a)
+{
+    return do_branch_b(ctx, OPC1_32_B_FCALLA, a);
+}
+
+static bool trans_J_b(DisasContext *ctx, arg_disp *a)
+{
+    return do_branch_b(ctx, OPC1_32_B_J, a);
+}
+
+static bool trans_JA_b(DisasContext *ctx, arg_disp *a)
+{
+    return do_branch_b(ctx, OPC1_32_B_JA, a);
+}
+
+static bool trans_JL_b(DisasContext *ctx, arg_disp *a)
+{
+    return do_branch_b(ctx, OPC1_32_B_JL, a);
+}
+
+static bool trans_JLA_b(DisasContext *ctx, arg_disp *a)
+{
+    return do_branch_b(ctx, OPC1_32_B_JLA, a);
+}
+
+/* BIT-format */
+TRANS_GROUP(ANDACC_bit, decode_bit_andacc)
+TRANS_GROUP(LOGICAL_T1_bit, decode_bit_logical_t)
+TRANS_GROUP(INSERT_bit, decode_bit_insert)
+TRANS_GROUP(LOGICAL_T2_bit, decode_bit_logical_t2)
+TRANS_GROUP(ORAND_bit, decode_bit_orand)
+TRANS_GROUP(SH_LOGIC1_bit, decode_bit_sh_logic1)
+TRANS_GROUP(SH_LOGIC2_bit, decode_bit_sh_logic2)
+
+/* BO-format */
+TRANS_GROUP(POST_PRE_BASE_bo, decode_bo_addrmode_post_pre_base)
+TRANS_GROUP(BITREVERSE_CIRCULAR_bo, decode_bo_addrmode_bitreverse_circular)
+TRANS_GROUP(LD_POST_PRE_BASE_bo, decode_bo_addrmode_ld_post_pre_base)
+TRANS_GROUP(LD_BITREVERSE_CIRCULAR_bo,
+            decode_bo_addrmode_ld_bitreverse_circular)
+TRANS_GROUP(STCTX_POST_PRE_BASE_bo, decode_bo_addrmode_stctx_post_pre_base)
+TRANS_GROUP(LDMST_BITREVERSE_CIRCULAR_bo,
+            decode_bo_addrmode_ldmst_bitreverse_circular)
+
+/* BOL-format */
+TRANS_OP1(LD_A_bol, decode_bol_opc, OPC1_32_BOL_LD_A_LONGOFF)
+TRANS_OP1(LD_W_bol, decode_bol_opc, OPC1_32_BOL_LD_W_LONGOFF)
+TRANS_OP1(LEA_bol, decode_bol_opc, OPC1_32_BOL_LEA_LONGOFF)
+TRANS_OP1(ST_W_bol, decode_bol_opc, OPC1_32_BOL_ST_W_LONGOFF)
+TRANS_OP1(ST_A_bol, decode_bol_opc, OPC1_32_BOL_ST_A_LONGOFF)
+TRANS_OP1(LD_B_bol, decode_bol_opc, OPC1_32_BOL_LD_B_LONGOFF)
+TRANS_OP1(LD_BU_bol, decode_bol_opc, OPC1_32_BOL_LD_BU_LONGOFF)
+TRANS_OP1(LD_H_bol, decode_bol_opc, OPC1_32_BOL_LD_H_LONGOFF)
+TRANS_OP1(LD_HU_bol, decode_bol_opc, OPC1_32_BOL_LD_HU_LONGOFF)
+TRANS_OP1(ST_B_bol, decode_bol_opc, OPC1_32_BOL_ST_B_LONGOFF)
+TRANS_OP1(ST_H_bol, decode_bol_opc, OPC1_32_BOL_ST_H_LONGOFF)
+
+/* BRC-format */
+static bool do_branch_brc(DisasContext *ctx, int opc, arg_r1_imm_disp *a)
+{
+    gen_compute_branch(ctx, opc, a->r1, 0, a->imm, a->disp);
+    return true;
+}
+
+static bool trans_EQ_NEQ_brc(DisasContext *ctx, arg_r1_imm_disp *a)
+{
+    return do_branch_brc(ctx, OPCM_32_BRC_EQ_NEQ, a);
+}
+
+static bool trans_GE_brc(DisasContext *ctx, arg_r1_imm_disp *a)
+{
+    return do_branch_brc(ctx, OPCM_32_BRC_GE, a);
+}
+
+static bool trans_JLT_brc(DisasContext *ctx, arg_r1_imm_disp *a)
+{
+    return do_branch_brc(ctx, OPCM_32_BRC_JLT, a);
+}
+
+static bool trans_JNE_brc(DisasContext *ctx, arg_r1_imm_disp *a)
+{
+    return do_branch_brc(ctx, OPCM_32_BRC_JNE, a);
+}
+
+/* BRN-format */
+static bool trans_JTT_brn(DisasContext *ctx, arg_r_disp *a)
+{
+    gen_compute_branch(ctx, OPCM_32_BRN_JTT, a->r, 0, 0, a->disp);
+    return true;
+}
+
+/* BRR-format */
+static bool do_branch_brr(DisasContext *ctx, int opc, arg_r1_r2_disp *a)
+{
+    gen_compute_branch(ctx, opc, a->r1, a->r2, 0, a->disp);
+    return true;
+}
+
+static bool trans_EQ_NEQ_brr(DisasContext *ctx, arg_r1_r2_disp *a)
+{
+    return do_branch_brr(ctx, OPCM_32_BRR_EQ_NEQ, a);
+}
+
+static bool trans_ADDR_EQ_NEQ_brr(DisasContext *ctx, arg_r1_r2_disp *a)
+{
+    return do_branch_brr(ctx, OPCM_32_BRR_ADDR_EQ_NEQ, a);
+}
+
+static bool trans_GE_brr(DisasContext *ctx, arg_r1_r2_disp *a)
+{
+    return do_branch_brr(ctx, OPCM_32_BRR_GE, a);
+}
+
+static bool trans_JLT_brr(DisasContext *ctx, arg_r1_r2_disp *a)
+{
+    return do_branch_brr(ctx, OPCM_32_BRR_JLT, a);
+}
+
+static bool trans_JNE_brr(DisasContext *ctx, arg_r1_r2_disp *a)
+{
+    return do_branch_brr(ctx, OPCM_32_BRR_JNE, a);
+}
+
+static bool trans_JNZ_brr(DisasContext *ctx, arg_r1_r2_disp *a)
+{
+    return do_branch_brr(ctx, OPCM_32_BRR_JNZ, a);
+}
+
+static bool trans_LOOP_brr(DisasContext *ctx, arg_r1_r2_disp *a)
+{
+    return do_branch_brr(ctx, OPCM_32_BRR_LOOP, a);
+}
+
+/* RC-format */
+TRANS_GROUP(LOGICAL_SHIFT_rc, decode_rc_logical_shift)
+TRANS_GROUP(ACCUMULATOR_rc, decode_rc_accumulator)
+TRANS_GROUP(SERVICEROUTINE_rc, decode_rc_serviceroutine)
+TRANS_GROUP(MUL_rc, decode_rc_mul)
+
+/* RCPW-format */
+TRANS_GROUP(INSERT_rcpw, decode_rcpw_insert)
+
+/* RCRR-format */
+static bool trans_INSERT_rcrr(DisasContext *ctx, arg_rcrr *a)
+{
+    TCGv temp = tcg_constant_i32(a->const4);
+    TCGv temp2 = tcg_temp_new(); /* width*/
+    TCGv temp3 = tcg_temp_new(); /* pos */
+
+    CHECK_REG_PAIR(a->s3);
+
+    tcg_gen_andi_tl(temp2, cpu_gpr_d[a->s3 + 1], 0x1f);
+    tcg_gen_andi_tl(temp3, cpu_gpr_d[a->s3], 0x1f);
+
+    gen_insert(cpu_gpr_d[a->d], cpu_gpr_d[a->s1], temp, temp2, temp3);
+    return true;
+}
+
+/* RCRW-format */
+TRANS_GROUP(INSERT_rcrw, decode_rcrw_insert)
+
+/* RCR-format */
+TRANS_GROUP(COND_SELECT_rcr, decode_rcr_cond_select)
+TRANS_GROUP(MADD_rcr, decode_rcr_madd)
+TRANS_GROUP(MSUB_rcr, decode_rcr_msub)
+
+/* RLC-format */
+TRANS_OP1(ADDI_rlc, decode_rlc_opc, OPC1_32_RLC_ADDI)
+TRANS_OP1(ADDIH_rlc, decode_rlc_opc, OPC1_32_RLC_ADDIH)
+TRANS_OP1(ADDIH_A_rlc, decode_rlc_opc, OPC1_32_RLC_ADDIH_A)
+TRANS_OP1(MFCR_rlc, decode_rlc_opc, OPC1_32_RLC_MFCR)
+TRANS_OP1(MOV_rlc, decode_rlc_opc, OPC1_32_RLC_MOV)
+TRANS_OP1(MOV_64_rlc, decode_rlc_opc, OPC1_32_RLC_MOV_64)
+TRANS_OP1(MOV_U_rlc, decode_rlc_opc, OPC1_32_RLC_MOV_U)
+TRANS_OP1(MOV_H_rlc, decode_rlc_opc, OPC1_32_RLC_MOV_H)
+TRANS_OP1(MOVH_A_rlc, decode_rlc_opc, OPC1_32_RLC_MOVH_A)
+TRANS_OP1(MTCR_rlc, decode_rlc_opc, OPC1_32_RLC_MTCR)
+
+/* RR-format */
+TRANS_GROUP(ACCUMULATOR_rr, decode_rr_accumulator)
+TRANS_GROUP(LOGICAL_SHIFT_rr, decode_rr_logical_shift)
+TRANS_GROUP(ADDRESS_rr, decode_rr_address)
+TRANS_GROUP(IDIRECT_rr, decode_rr_idirect)
+TRANS_GROUP(DIVIDE_rr, decode_rr_divide)
+
+/* RR1-format */
+TRANS_GROUP(MUL_rr1, decode_rr1_mul)
+TRANS_GROUP(MULQ_rr1, decode_rr1_mulq)
+
+/* RR2-format */
+TRANS_GROUP(MUL_rr2, decode_rr2_mul)
+
+/* RRPW-format */
+TRANS_GROUP(EXTRACT_INSERT_rrpw, decode_rrpw_extract_insert)
+
+static bool trans_DEXTR_rrpw(DisasContext *ctx, arg_rrpw *a)
+{
+    tcg_gen_extract2_tl(cpu_gpr_d[a->d], cpu_gpr_d[a->s2], cpu_gpr_d[a->s1],
+                        32 - a->pos);
+    return true;
+}
+
+/* RRR-format */
+TRANS_GROUP(COND_SELECT_rrr, decode_rrr_cond_select)
+TRANS_GROUP(DIVIDE_rrr, decode_rrr_divide)
+
+/* RRR2-format */
+TRANS_GROUP(MADD_rrr2, decode_rrr2_madd)
+TRANS_GROUP(MSUB_rrr2, decode_rrr2_msub)
+
+/* RRR1-format */
+TRANS_GROUP(MADD_rrr1, decode_rrr1_madd)
+TRANS_GROUP(MADDQ_H_rrr1, decode_rrr1_maddq_h)
+TRANS_GROUP(MADDSU_H_rrr1, decode_rrr1_maddsu_h)
+TRANS_GROUP(MSUB_H_rrr1, decode_rrr1_msub)
+TRANS_GROUP(MSUB_Q_rrr1, decode_rrr1_msubq_h)
+TRANS_GROUP(MSUBAD_H_rrr1, decode_rrr1_msubad_h)
+
+/* RRRR-format */
+TRANS_GROUP(EXTRACT_INSERT_rrrr, decode_rrrr_extract_insert)
+
+/* RRRW-format */
+TRANS_GROUP(EXTRACT_INSERT_rrrw, decode_rrrw_extract_insert)
+
+/* SYS-format */
+TRANS_GROUP(INTERRUPTS_sys, decode_sys_interrupts)
 
-    op1 = MASK_OP_MAJOR(ctx->opcode);
+static bool trans_RSTV_sys(DisasContext *ctx, arg_empty *a)
+{
+    tcg_gen_movi_tl(cpu_PSW_V, 0);
+    tcg_gen_mov_tl(cpu_PSW_SV, cpu_PSW_V);
+    tcg_gen_mov_tl(cpu_PSW_AV, cpu_PSW_V);
+    tcg_gen_mov_tl(cpu_PSW_SAV, cpu_PSW_V);
+    return true;
+}
+
+#undef TRANS_GROUP
+#undef TRANS_OP1
+
+static bool tricore_insn_is_16bit(uint32_t insn)
+{
+    return (insn & 0x1) == 0;
+}
+
+/*
+ * Approximate TC1.6.2 pipeline costs, in cycles, used to scale icount when
+ * the CPU "pipeline-timing" property is set. Costs are kept per major
+ * opcode group; only the divide/float groups are refined by op2.
+ * Instructions that run on the load/store pipeline are flagged in @ls so
+ * the caller can model dual issue behind an integer pipeline instruction.
+ */
+static uint32_t tricore_insn_cost_16(uint32_t opcode, bool *ls)
+{
+    uint32_t op1 = MASK_OP_MAJOR(opcode);
+
+    *ls = false;
 
-    /* handle JNZ.T opcode only being 7 bit long */
-    if (unlikely((op1 & 0x7f) == OPCM_32_BRN_JTT)) {
-        op1 = OPCM_32_BRN_JTT;
+    /* ADDSC.A only uses 6 bits of the major opcode, see insn16.decode */
+    if ((op1 & 0x3f) == OPC1_16_SRRS_ADDSC_A) {
+        op1 = OPC1_16_SRRS_ADDSC_A;
     }
 
     switch (op1) {
-/* ABS-format */
-    case OPCM_32_ABS_LDW:
-        decode_abs_ldw(ctx);
-        break;
-    case OPCM_32_ABS_LDB:
-        decode_abs_ldb(ctx);
-        break;
-    case OPCM_32_ABS_LDMST_SWAP:
-        decode_abs_ldst_swap(ctx);
-        break;
-    case OPCM_32_ABS_LDST_CONTEXT:
-        decode_abs_ldst_context(ctx);
-        break;
+    case OPC1_16_SC_LD_A:
+    case OPC1_16_SC_LD_W:
+    case OPC1_16_SC_ST_A:
+    case OPC1_16_SC_ST_W:
+    case OPC1_16_SLR_LD_A:
+    case OPC1_16_SLR_LD_A_POSTINC:
+    case OPC1_16_SLR_LD_BU:
+    case OPC1_16_SLR_LD_BU_POSTINC:
+    case OPC1_16_SLR_LD_H:
+    case OPC1_16_SLR_LD_H_POSTINC:
+    case OPC1_16_SLR_LD_W:
+    case OPC1_16_SLR_LD_W_POSTINC:
+    case OPC1_16_SLRO_LD_A:
+    case OPC1_16_SLRO_LD_BU:
+    case OPC1_16_SLRO_LD_H:
+    case OPC1_16_SLRO_LD_W:
+    case OPC1_16_SRO_LD_A:
+    case OPC1_16_SRO_LD_BU:
+    case OPC1_16_SRO_LD_H:
+    case OPC1_16_SRO_LD_W:
+    case OPC1_16_SRO_ST_A:
+    case OPC1_16_SRO_ST_B:
+    case OPC1_16_SRO_ST_H:
+    case OPC1_16_SRO_ST_W:
+    case OPC1_16_SSR_ST_A:
+    case OPC1_16_SSR_ST_A_POSTINC:
+    case OPC1_16_SSR_ST_B:
+    case OPC1_16_SSR_ST_B_POSTINC:
+    case OPC1_16_SSR_ST_H:
+    case OPC1_16_SSR_ST_H_POSTINC:
+    case OPC1_16_SSR_ST_W:
+    case OPC1_16_SSR_ST_W_POSTINC:
+    case OPC1_16_SSRO_ST_A:
+    case OPC1_16_SSRO_ST_B:
+    case OPC1_16_SSRO_ST_H:
+    case OPC1_16_SSRO_ST_W:
+    case OPC1_16_SRC_ADD_A:
+    case OPC1_16_SRR_ADD_A:
+    case OPC1_16_SRRS_ADDSC_A:
+    case OPC1_16_SRR_MOV_A:
+    case OPC1_16_SRR_MOV_AA:
+        *ls = true;
+        return 1;
+    case OPC1_16_SRR_MUL:
+        return 2;
+    case OPC1_16_SB_CALL:
+        return 4;
+    case OPC1_16_SB_J:
+    case OPC1_16_SB_JNZ:
+    case OPC1_16_SB_JZ:
+    case OPC1_16_SBC_JEQ:
+    case OPC1_16_SBC_JEQ2:
+    case OPC1_16_SBC_JNE:
+    case OPC1_16_SBC_JNE2:
+    case OPC1_16_SBR_JEQ:
+    case OPC1_16_SBR_JEQ2:
+    case OPC1_16_SBR_JGEZ:
+    case OPC1_16_SBR_JGTZ:
+    case OPC1_16_SBR_JLEZ:
+    case OPC1_16_SBR_JLTZ:
+    case OPC1_16_SBR_JNE:
+    case OPC1_16_SBR_JNE2:
+    case OPC1_16_SBR_JNZ:
+    case OPC1_16_SBR_JNZ_A:
+    case OPC1_16_SBR_JZ:
+    case OPC1_16_SBR_JZ_A:
+    case OPC1_16_SBRN_JNZ_T:
+    case OPC1_16_SBRN_JZ_T:
+    case OPC1_16_SR_JI:
+        return 2;
+    case OPCM_16_SR_SYSTEM:
+        switch (MASK_OP_SR_OP2(opcode)) {
+        case OPC2_16_SR_RET:
+        case OPC2_16_SR_RFE:
+        case OPC2_16_SR_FRET:
+            return 4;
+        }
+        return 1;
+    default:
+        return 1;
+    }
+}
+
+static uint32_t tricore_insn_cost_32(uint32_t opcode, bool *ls)
+{
+    *ls = false;
+
+    switch (MASK_OP_MAJOR(opcode)) {
+    case OPCM_32_ABS_LDW:
+    case OPCM_32_ABS_LDB:
     case OPCM_32_ABS_STORE:
-        decode_abs_store(ctx);
-        break;
     case OPCM_32_ABS_STOREB_H:
-        decode_abs_storeb_h(ctx);
-        break;
     case OPC1_32_ABS_STOREQ:
-        address = MASK_OP_ABS_OFF18(ctx->opcode);
-        r1 = MASK_OP_ABS_S1D(ctx->opcode);
-        temp = tcg_constant_i32(EA_ABS_FORMAT(address));
-        temp2 = tcg_temp_new();
-
-        tcg_gen_shri_tl(temp2, cpu_gpr_d[r1], 16);
-        tcg_gen_qemu_st_tl(temp2, temp, ctx->mem_idx, MO_LEUW);
-        break;
     case OPC1_32_ABS_LD_Q:
-        address = MASK_OP_ABS_OFF18(ctx->opcode);
-        r1 = MASK_OP_ABS_S1D(ctx->opcode);
-        temp = tcg_constant_i32(EA_ABS_FORMAT(address));
-
-        tcg_gen_qemu_ld_tl(cpu_gpr_d[r1], temp, ctx->mem_idx, MO_LEUW);
-        tcg_gen_shli_tl(cpu_gpr_d[r1], cpu_gpr_d[r1], 16);
-        break;
     case OPCM_32_ABS_LEA_LHA:
-        address = MASK_OP_ABS_OFF18(ctx->opcode);
-        r1 = MASK_OP_ABS_S1D(ctx->opcode);
-
-        if (has_feature(ctx, TRICORE_FEATURE_162)) {
-            op2 = MASK_OP_ABS_OP2(ctx->opcode);
-            if (op2 == OPC2_32_ABS_LHA) {
-                tcg_gen_movi_tl(cpu_gpr_a[r1], address << 14);
-                break;
-            }
-            /* otherwise translate regular LEA */
-        }
-
-        tcg_gen_movi_tl(cpu_gpr_a[r1], EA_ABS_FORMAT(address));
-        break;
-/* ABSB-format */
     case OPC1_32_ABSB_ST_T:
-        address = MASK_OP_ABS_OFF18(ctx->opcode);
-        b = MASK_OP_ABSB_B(ctx->opcode);
-        bpos = MASK_OP_ABSB_BPOS(ctx->opcode);
-
-        temp = tcg_constant_i32(EA_ABS_FORMAT(address));
-        temp2 = tcg_temp_new();
-
-        tcg_gen_qemu_ld_tl(temp2, temp, ctx->mem_idx, MO_UB);
-        tcg_gen_andi_tl(temp2, temp2, ~(0x1u << bpos));
-        tcg_gen_ori_tl(temp2, temp2, (b << bpos));
-        tcg_gen_qemu_st_tl(temp2, temp, ctx->mem_idx, MO_UB);
-        break;
-/* B-format */
-    case OPC1_32_B_CALL:
-    case OPC1_32_B_CALLA:
-    case OPC1_32_B_FCALL:
-    case OPC1_32_B_FCALLA:
-    case OPC1_32_B_J:
-    case OPC1_32_B_JA:
-    case OPC1_32_B_JL:
-    case OPC1_32_B_JLA:
-        address = MASK_OP_B_DISP24_SEXT(ctx->opcode);
-        gen_compute_branch(ctx, op1, 0, 0, 0, address);
-        break;
-/* Bit-format */
-    case OPCM_32_BIT_ANDACC:
-        decode_bit_andacc(ctx);
-        break;
-    case OPCM_32_BIT_LOGICAL_T1:
-        decode_bit_logical_t(ctx);
-        break;
-    case OPCM_32_BIT_INSERT:
-        decode_bit_insert(ctx);
-        break;
-    case OPCM_32_BIT_LOGICAL_T2:
-        decode_bit_logical_t2(ctx);
-        break;
-    case OPCM_32_BIT_ORAND:
-        decode_bit_orand(ctx);
-        break;
-    case OPCM_32_BIT_SH_LOGIC1:
-        decode_bit_sh_logic1(ctx);
-        break;
-    case OPCM_32_BIT_SH_LOGIC2:
-        decode_bit_sh_logic2(ctx);
-        break;
-    /* BO Format */
     case OPCM_32_BO_ADDRMODE_POST_PRE_BASE:
-        decode_bo_addrmode_post_pre_base(ctx);
-        break;
     case OPCM_32_BO_ADDRMODE_BITREVERSE_CIRCULAR:
-        decode_bo_addrmode_bitreverse_circular(ctx);
-        break;
     case OPCM_32_BO_ADDRMODE_LD_POST_PRE_BASE:
-        decode_bo_addrmode_ld_post_pre_base(ctx);
-        break;
     case OPCM_32_BO_ADDRMODE_LD_BITREVERSE_CIRCULAR:
-        decode_bo_addrmode_ld_bitreverse_circular(ctx);
-        break;
-    case OPCM_32_BO_ADDRMODE_STCTX_POST_PRE_BASE:
-        decode_bo_addrmode_stctx_post_pre_base(ctx);
-        break;
-    case OPCM_32_BO_ADDRMODE_LDMST_BITREVERSE_CIRCULAR:
-        decode_bo_addrmode_ldmst_bitreverse_circular(ctx);
-        break;
-/* BOL-format */
     case OPC1_32_BOL_LD_A_LONGOFF:
     case OPC1_32_BOL_LD_W_LONGOFF:
     case OPC1_32_BOL_LEA_LONGOFF:
@@ -8154,197 +9441,132 @@ static void decode_32Bit_opc(DisasContext *ctx)
     case OPC1_32_BOL_LD_HU_LONGOFF:
     case OPC1_32_BOL_ST_B_LONGOFF:
     case OPC1_32_BOL_ST_H_LONGOFF:
-        decode_bol_opc(ctx, op1);
-        break;
-/* BRC Format */
-    case OPCM_32_BRC_EQ_NEQ:
-    case OPCM_32_BRC_GE:
-    case OPCM_32_BRC_JLT:
-    case OPCM_32_BRC_JNE:
-        const4 = MASK_OP_BRC_CONST4_SEXT(ctx->opcode);
-        address = MASK_OP_BRC_DISP15_SEXT(ctx->opcode);
-        r1 = MASK_OP_BRC_S1(ctx->opcode);
-        gen_compute_branch(ctx, op1, r1, 0, const4, address);
-        break;
-/* BRN Format */
-    case OPCM_32_BRN_JTT:
-        address = MASK_OP_BRN_DISP15_SEXT(ctx->opcode);
-        r1 = MASK_OP_BRN_S1(ctx->opcode);
-        gen_compute_branch(ctx, op1, r1, 0, 0, address);
-        break;
-/* BRR Format */
-    case OPCM_32_BRR_EQ_NEQ:
-    case OPCM_32_BRR_ADDR_EQ_NEQ:
-    case OPCM_32_BRR_GE:
-    case OPCM_32_BRR_JLT:
-    case OPCM_32_BRR_JNE:
-    case OPCM_32_BRR_JNZ:
-    case OPCM_32_BRR_LOOP:
-        address = MASK_OP_BRR_DISP15_SEXT(ctx->opcode);
-        r2 = MASK_OP_BRR_S2(ctx->opcode);
-        r1 = MASK_OP_BRR_S1(ctx->opcode);
-        gen_compute_branch(ctx, op1, r1, r2, 0, address);
-        break;
-/* RC Format */
-    case OPCM_32_RC_LOGICAL_SHIFT:
-        decode_rc_logical_shift(ctx);
-        break;
-    case OPCM_32_RC_ACCUMULATOR:
-        decode_rc_accumulator(ctx);
-        break;
-    case OPCM_32_RC_SERVICEROUTINE:
-        decode_rc_serviceroutine(ctx);
-        break;
-    case OPCM_32_RC_MUL:
-        decode_rc_mul(ctx);
-        break;
-/* RCPW Format */
-    case OPCM_32_RCPW_MASK_INSERT:
-        decode_rcpw_insert(ctx);
-        break;
-/* RCRR Format */
-    case OPC1_32_RCRR_INSERT:
-        r1 = MASK_OP_RCRR_S1(ctx->opcode);
-        r2 = MASK_OP_RCRR_S3(ctx->opcode);
-        r3 = MASK_OP_RCRR_D(ctx->opcode);
-        const16 = MASK_OP_RCRR_CONST4(ctx->opcode);
-        temp = tcg_constant_i32(const16);
-        temp2 = tcg_temp_new(); /* width*/
-        temp3 = tcg_temp_new(); /* pos */
-
-        CHECK_REG_PAIR(r2);
-
-        tcg_gen_andi_tl(temp2, cpu_gpr_d[r2 + 1], 0x1f);
-        tcg_gen_andi_tl(temp3, cpu_gpr_d[r2], 0x1f);
-
-        gen_insert(cpu_gpr_d[r3], cpu_gpr_d[r1], temp, temp2, temp3);
-        break;
-/* RCRW Format */
-    case OPCM_32_RCRW_MASK_INSERT:
-        decode_rcrw_insert(ctx);
-        break;
-/* RCR Format */
-    case OPCM_32_RCR_COND_SELECT:
-        decode_rcr_cond_select(ctx);
-        break;
-    case OPCM_32_RCR_MADD:
-        decode_rcr_madd(ctx);
-        break;
-    case OPCM_32_RCR_MSUB:
-        decode_rcr_msub(ctx);
-        break;
-/* RLC Format */
-    case OPC1_32_RLC_ADDI:
-    case OPC1_32_RLC_ADDIH:
+    case OPCM_32_RR_ADDRESS:
     case OPC1_32_RLC_ADDIH_A:
-    case OPC1_32_RLC_MFCR:
-    case OPC1_32_RLC_MOV:
-    case OPC1_32_RLC_MOV_64:
-    case OPC1_32_RLC_MOV_U:
-    case OPC1_32_RLC_MOV_H:
     case OPC1_32_RLC_MOVH_A:
-    case OPC1_32_RLC_MTCR:
-        decode_rlc_opc(ctx, op1);
-        break;
-/* RR Format */
-    case OPCM_32_RR_ACCUMULATOR:
-        decode_rr_accumulator(ctx);
-        break;
-    case OPCM_32_RR_LOGICAL_SHIFT:
-        decode_rr_logical_shift(ctx);
-        break;
-    case OPCM_32_RR_ADDRESS:
-        decode_rr_address(ctx);
-        break;
-    case OPCM_32_RR_IDIRECT:
-        decode_rr_idirect(ctx);
-        break;
-    case OPCM_32_RR_DIVIDE:
-        decode_rr_divide(ctx);
-        break;
-/* RR1 Format */
+        *ls = true;
+        return 1;
+    /* read-modify-write and context save/restore */
+    case OPCM_32_ABS_LDMST_SWAP:
+    case OPCM_32_BO_ADDRMODE_LDMST_BITREVERSE_CIRCULAR:
+        *ls = true;
+        return 2;
+    case OPCM_32_ABS_LDST_CONTEXT:
+    case OPCM_32_BO_ADDRMODE_STCTX_POST_PRE_BASE:
+        *ls = true;
+        return 4;
+    case OPCM_32_RC_MUL:
     case OPCM_32_RR1_MUL:
-        decode_rr1_mul(ctx);
-        break;
     case OPCM_32_RR1_MULQ:
-        decode_rr1_mulq(ctx);
-        break;
-/* RR2 format */
     case OPCM_32_RR2_MUL:
-        decode_rr2_mul(ctx);
-        break;
-/* RRPW format */
-    case OPCM_32_RRPW_EXTRACT_INSERT:
-        decode_rrpw_extract_insert(ctx);
-        break;
-    case OPC1_32_RRPW_DEXTR:
-        r1 = MASK_OP_RRPW_S1(ctx->opcode);
-        r2 = MASK_OP_RRPW_S2(ctx->opcode);
-        r3 = MASK_OP_RRPW_D(ctx->opcode);
-        const16 = MASK_OP_RRPW_POS(ctx->opcode);
-
-        tcg_gen_extract2_tl(cpu_gpr_d[r3], cpu_gpr_d[r2], cpu_gpr_d[r1],
-                            32 - const16);
-        break;
-/* RRR Format */
-    case OPCM_32_RRR_COND_SELECT:
-        decode_rrr_cond_select(ctx);
-        break;
-    case OPCM_32_RRR_DIVIDE:
-        decode_rrr_divide(ctx);
-        break;
-/* RRR2 Format */
-    case OPCM_32_RRR2_MADD:
-        decode_rrr2_madd(ctx);
-        break;
-    case OPCM_32_RRR2_MSUB:
-        decode_rrr2_msub(ctx);
-        break;
-/* RRR1 format */
+    case OPCM_32_RCR_MADD:
+    case OPCM_32_RCR_MSUB:
     case OPCM_32_RRR1_MADD:
-        decode_rrr1_madd(ctx);
-        break;
     case OPCM_32_RRR1_MADDQ_H:
-        decode_rrr1_maddq_h(ctx);
-        break;
     case OPCM_32_RRR1_MADDSU_H:
-        decode_rrr1_maddsu_h(ctx);
-        break;
     case OPCM_32_RRR1_MSUB_H:
-        decode_rrr1_msub(ctx);
-        break;
     case OPCM_32_RRR1_MSUB_Q:
-        decode_rrr1_msubq_h(ctx);
-        break;
     case OPCM_32_RRR1_MSUBAD_H:
-        decode_rrr1_msubad_h(ctx);
-        break;
-/* RRRR format */
-    case OPCM_32_RRRR_EXTRACT_INSERT:
-        decode_rrrr_extract_insert(ctx);
-        break;
-/* RRRW format */
-    case OPCM_32_RRRW_EXTRACT_INSERT:
-        decode_rrrw_extract_insert(ctx);
-        break;
-/* SYS format */
+    case OPCM_32_RRR2_MADD:
+    case OPCM_32_RRR2_MSUB:
+        return 2;
+    case OPCM_32_RR_DIVIDE:
+        switch (MASK_OP_RR_OP2(opcode)) {
+        case OPC2_32_RR_DIV:
+        case OPC2_32_RR_DIV_U:
+        case OPC2_32_RR_DIV_F:
+            return 8;
+        case OPC2_32_RR_MUL_F:
+        case OPC2_32_RR_FTOI:
+        case OPC2_32_RR_FTOIZ:
+        case OPC2_32_RR_FTOU:
+        case OPC2_32_RR_FTOUZ:
+        case OPC2_32_RR_FTOQ31:
+        case OPC2_32_RR_FTOQ31Z:
+        case OPC2_32_RR_FTOHP:
+        case OPC2_32_RR_HPTOF:
+        case OPC2_32_RR_ITOF:
+        case OPC2_32_RR_UTOF:
+        case OPC2_32_RR_Q31TOF:
+            return 2;
+        }
+        return 1;
+    case OPCM_32_RRR_DIVIDE:
+        switch (MASK_OP_RRR_OP2(opcode)) {
+        case OPC2_32_RRR_DVSTEP:
+        case OPC2_32_RRR_DVSTEP_U:
+            return 5;
+        case OPC2_32_RRR_MADD_F:
+        case OPC2_32_RRR_MSUB_F:
+            return 3;
+        case OPC2_32_RRR_ADD_F:
+        case OPC2_32_RRR_SUB_F:
+            return 2;
+        }
+        return 1;
+    case OPC1_32_B_CALL:
+    case OPC1_32_B_CALLA:
+    case OPC1_32_B_FCALL:
+    case OPC1_32_B_FCALLA:
+    case OPCM_32_RC_SERVICEROUTINE:
+        return 4;
+    case OPCM_32_RR_IDIRECT:
+        switch (MASK_OP_RR_OP2(opcode)) {
+        case OPC2_32_RR_CALLI:
+        case OPC2_32_RR_FCALLI:
+            return 4;
+        }
+        return 2;
     case OPCM_32_SYS_INTERRUPTS:
-        decode_sys_interrupts(ctx);
-        break;
-    case OPC1_32_SYS_RSTV:
-        tcg_gen_movi_tl(cpu_PSW_V, 0);
-        tcg_gen_mov_tl(cpu_PSW_SV, cpu_PSW_V);
-        tcg_gen_mov_tl(cpu_PSW_AV, cpu_PSW_V);
-        tcg_gen_mov_tl(cpu_PSW_SAV, cpu_PSW_V);
-        break;
+        switch (MASK_OP_SYS_OP2(opcode)) {
+        case OPC2_32_SYS_RET:
+        case OPC2_32_SYS_RFE:
+        case OPC2_32_SYS_RFM:
+        case OPC2_32_SYS_FRET:
+        case OPC2_32_SYS_RSLCX:
+        case OPC2_32_SYS_SVLCX:
+            return 4;
+        }
+        return 1;
+    case OPC1_32_B_J:
+    case OPC1_32_B_JA:
+    case OPC1_32_B_JL:
+    case OPC1_32_B_JLA:
+    case OPCM_32_BRC_EQ_NEQ:
+    case OPCM_32_BRC_GE:
+    case OPCM_32_BRC_JLT:
+    case OPCM_32_BRC_JNE:
+    case OPCM_32_BRN_JTT:
+    case OPCM_32_BRR_EQ_NEQ:
+    case OPCM_32_BRR_ADDR_EQ_NEQ:
+    case OPCM_32_BRR_GE:
+    case OPCM_32_BRR_JLT:
+    case OPCM_32_BRR_JNE:
+    case OPCM_32_BRR_JNZ:
+        return 2;
     default:
-        generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
+        return 1;
     }
 }
 
-static bool tricore_insn_is_16bit(uint32_t insn)
+/* account the cost of ctx->opcode, a load/store behind an IP insn is free */
+static void tricore_insn_cost(DisasContext *ctx, bool is_16bit)
 {
-    return (insn & 0x1) == 0;
+    uint32_t cost;
+    bool ls;
+
+    if (is_16bit) {
+        cost = tricore_insn_cost_16(ctx->opcode, &ls);
+    } else {
+        cost = tricore_insn_cost_32(ctx->opcode, &ls);
+    }
+
+    if (ls && ctx->prev_ip) {
+        ctx->prev_ip = false;
+        return;
+    }
+    ctx->prev_ip = !ls;
+    ctx->cycles += cost;
 }
 
 static void tricore_tr_init_disas_context(DisasContextBase *dcbase,
@@ -8355,6 +9577,7 @@ static void tricore_tr_init_disas_context(DisasContextBase *dcbase,
     ctx->mem_idx = cpu_mmu_index(cs, false);
 
     uint32_t tb_flags = (uint32_t)ctx->base.tb->flags;
+    uint32_t gaddr_key;
     ctx->priv = FIELD_EX32(tb_flags, TB_FLAGS, PRIV);
 
     ctx->features = env->features;
@@ -8365,10 +9588,89 @@ static void tricore_tr_init_disas_context(DisasContextBase *dcbase,
         ctx->icr_ie_mask = R_ICR_IE_13_MASK;
         ctx->icr_ie_offset = R_ICR_IE_13_SHIFT;
     }
+    ctx->bus_timing = env->bus_timing != NULL;
+
+    /* realize rejects the property on 32 bit hosts */
+    ctx->pipeline_timing = (tb_cflags(ctx->base.tb) & CF_USE_ICOUNT) &&
+                           env_archcpu(env)->pipeline_timing;
+    ctx->prev_ip = false;
+    ctx->cycles = 0;
+    ctx->cov_area = env_archcpu(env)->cov_area;
+    ctx->dbg_code_triggers = env->dbg_code_triggers;
+    ctx->decode_count = env_archcpu(env)->decode_stats ?
+                        env_archcpu(env)->decode_count : NULL;
+    ctx->fused = 0;
+    ctx->gaddr_track = env_archcpu(env)->gaddr_const;
+    gaddr_key = FIELD_EX32(tb_flags, TB_FLAGS, GADDR);
+    ctx->gaddr = gaddr_key ? tricore_gaddr_values(gaddr_key) : NULL;
+    ctx->gaddr_dirty = false;
+    ctx->spr = NULL;
+    ctx->spr_count = 0;
+    ctx->sp_win = -1;
+    ctx->sp_addr = NULL;
+    ctx->const_addr = NULL;
+    if (FIELD_EX32(tb_flags, TB_FLAGS, SPR)) {
+        ctx->spr = env_archcpu(env)->spr;
+        ctx->spr_count = env_archcpu(env)->spr_count;
+        /* a guess only, A10 based accesses are range checked */
+        ctx->sp_win = spr_window(ctx, env->gpr_a[10] - 1, 1);
+    }
+#ifndef CONFIG_USER_ONLY
+    if (env_archcpu(env)->spr_count && tb_page_addr0(ctx->base.tb) != -1) {
+        tricore_spr_translate(tb_page_addr0(ctx->base.tb));
+    }
+#endif
+}
+
+/*
+ * AFL style edge coverage: the bitmap entry indexed by the hashed location
+ * of this TB xor the shifted location of the previous one is incremented.
+ * The location hash is a translation time constant.
+ */
+static void gen_edge_coverage(DisasContext *ctx)
+{
+    uint32_t pc = ctx->base.pc_first;
+    uint32_t cur_loc = ((pc >> 1) ^ (pc << 7)) & (TRICORE_COV_MAP_SIZE - 1);
+    TCGv_i32 idx = tcg_temp_new_i32();
+    TCGv_i32 hits = tcg_temp_new_i32();
+    TCGv_ptr ptr = tcg_temp_new_ptr();
+
+    tcg_gen_ld_i32(idx, tcg_env, offsetof(CPUTriCoreState, cov_prev_loc));
+    tcg_gen_xori_i32(idx, idx, cur_loc);
+    tcg_gen_extu_i32_ptr(ptr, idx);
+    tcg_gen_add_ptr(ptr, ptr, tcg_constant_ptr(ctx->cov_area));
+    tcg_gen_ld8u_i32(hits, ptr, 0);
+    tcg_gen_addi_i32(hits, hits, 1);
+    tcg_gen_st8_i32(hits, ptr, 0);
+    tcg_gen_st_i32(tcg_constant_i32(cur_loc >> 1), tcg_env,
+                   offsetof(CPUTriCoreState, cov_prev_loc));
 }
 
 static void tricore_tr_tb_start(DisasContextBase *db, CPUState *cpu)
 {
+    DisasContext *ctx = container_of(db, DisasContext, base);
+    TCGv_i64 budget;
+
+    if (ctx->cov_area) {
+        gen_edge_coverage(ctx);
+    }
+
+    if (!ctx->pipeline_timing) {
+        return;
+    }
+
+    /*
+     * The generic icount code already charges one unit per insn, so add
+     * the difference to the estimated cycle count. The addend is not known
+     * yet and gets patched in tricore_tr_tb_stop().
+     */
+    budget = tcg_temp_new_i64();
+    tcg_gen_ld_i64(budget, tcg_env, offsetof(ArchCPU, parent_obj.icount_budget)
+                                    - offsetof(ArchCPU, env));
+    tcg_gen_add_i64(budget, budget, tcg_constant_i64(0));
+    ctx->cycles_op = tcg_last_op();
+    tcg_gen_st_i64(budget, tcg_env, offsetof(ArchCPU, parent_obj.icount_budget)
+                                    - offsetof(ArchCPU, env));
 }
 
 static void tricore_tr_insn_start(DisasContextBase *dcbase, CPUState *cpu)
@@ -8378,6 +9680,59 @@ static void tricore_tr_insn_start(DisasContextBase *dcbase, CPUState *cpu)
     tcg_gen_insn_start(ctx->base.pc_next);
 }
 
+/*
+ * Compilers divide with DVINIT or DVINIT.U on E[c], followed by four
+ * DVSTEPs or DVSTEP.Us of E[c] by the same D[b] and, if signed, DVADJ.
+ * Returns the number of instructions after the DVINIT at pc_next that
+ * complete such a sequence, which is then translated as a whole by
+ * gen_dv_fused(). Not with anything that needs to see each instruction.
+ */
+static int tricore_dv_fusion(CPUTriCoreState *env, DisasContext *ctx)
+{
+    vaddr pc = ctx->base.pc_next;
+    uint32_t step;
+    int c, b, n;
+
+    if (MASK_OP_MAJOR(ctx->opcode) != OPCM_32_RR_DIVIDE) {
+        return 0;
+    }
+    switch (MASK_OP_RR_OP2(ctx->opcode)) {
+    case OPC2_32_RR_DVINIT:
+        step = OPC2_32_RRR_DVSTEP;
+        n = 5;
+        break;
+    case OPC2_32_RR_DVINIT_U:
+        step = OPC2_32_RRR_DVSTEP_U;
+        n = 4;
+        break;
+    default:
+        return 0;
+    }
+
+    c = MASK_OP_RR_D(ctx->opcode);
+    b = MASK_OP_RR_S2(ctx->opcode);
+    if ((c & 1) || b == c || b == c + 1) {
+        return 0;
+    }
+    if (ctx->base.plugin_enabled || ctx->dbg_code_triggers ||
+        ctx->base.num_insns + n > ctx->base.max_insns ||
+        ((pc + 4 * n + 3) ^ pc) & TARGET_PAGE_MASK) {
+        return 0;
+    }
+
+    for (int i = 1; i <= n; i++) {
+        uint32_t insn = translator_ldl(env, &ctx->base, pc + 4 * i);
+
+        if (MASK_OP_MAJOR(insn) != OPCM_32_RRR_DIVIDE ||
+            MASK_OP_RRR_OP2(insn) != (i < 5 ? step : OPC2_32_RRR_DVADJ) ||
+            MASK_OP_RRR_D(insn) != c || MASK_OP_RRR_S3(insn) != c ||
+            MASK_OP_RRR_S2(insn) != b) {
+            return 0;
+        }
+    }
+    return n;
+}
+
 static bool insn_crosses_page(CPUTriCoreState *env, DisasContext *ctx)
 {
     /*
@@ -8392,6 +9747,279 @@ static bool insn_crosses_page(CPUTriCoreState *env, DisasContext *ctx)
     return !tricore_insn_is_16bit(insn);
 }
 
+/*
+ * Instruction format statistics. The major opcode in bits 0-7 determines
+ * the format, except for ADDSC.A which only uses bits 0-5.
+ */
+static const char * const tricore_insn_format_names[TRICORE_FMT_COUNT] = {
+    [TRICORE_FMT_INVALID] = "invalid",
+    [TRICORE_FMT_SB] = "SB",
+    [TRICORE_FMT_SBC] = "SBC",
+    [TRICORE_FMT_SBR] = "SBR",
+    [TRICORE_FMT_SBRN] = "SBRN",
+    [TRICORE_FMT_SC] = "SC",
+    [TRICORE_FMT_SLR] = "SLR",
+    [TRICORE_FMT_SLRO] = "SLRO",
+    [TRICORE_FMT_SR] = "SR",
+    [TRICORE_FMT_SRC] = "SRC",
+    [TRICORE_FMT_SRO] = "SRO",
+    [TRICORE_FMT_SRR] = "SRR",
+    [TRICORE_FMT_SRRS] = "SRRS",
+    [TRICORE_FMT_SSR] = "SSR",
+    [TRICORE_FMT_SSRO] = "SSRO",
+    [TRICORE_FMT_ABS] = "ABS",
+    [TRICORE_FMT_ABSB] = "ABSB",
+    [TRICORE_FMT_B] = "B",
+    [TRICORE_FMT_BIT] = "BIT",
+    [TRICORE_FMT_BO] = "BO",
+    [TRICORE_FMT_BOL] = "BOL",
+    [TRICORE_FMT_BRC] = "BRC",
+    [TRICORE_FMT_BRN] = "BRN",
+    [TRICORE_FMT_BRR] = "BRR",
+    [TRICORE_FMT_RC] = "RC",
+    [TRICORE_FMT_RCPW] = "RCPW",
+    [TRICORE_FMT_RCR] = "RCR",
+    [TRICORE_FMT_RCRR] = "RCRR",
+    [TRICORE_FMT_RCRW] = "RCRW",
+    [TRICORE_FMT_RLC] = "RLC",
+    [TRICORE_FMT_RR] = "RR",
+    [TRICORE_FMT_RR1] = "RR1",
+    [TRICORE_FMT_RR2] = "RR2",
+    [TRICORE_FMT_RRPW] = "RRPW",
+    [TRICORE_FMT_RRR] = "RRR",
+    [TRICORE_FMT_RRR1] = "RRR1",
+    [TRICORE_FMT_RRR2] = "RRR2",
+    [TRICORE_FMT_RRRR] = "RRRR",
+    [TRICORE_FMT_RRRW] = "RRRW",
+    [TRICORE_FMT_SYS] = "SYS",
+};
+
+static const uint8_t tricore_insn16_format[256] = {
+    [OPC1_16_SB_CALL] = TRICORE_FMT_SB,
+    [OPC1_16_SB_J] = TRICORE_FMT_SB,
+    [OPC1_16_SB_JNZ] = TRICORE_FMT_SB,
+    [OPC1_16_SB_JZ] = TRICORE_FMT_SB,
+    [OPC1_16_SBC_JEQ] = TRICORE_FMT_SBC,
+    [OPC1_16_SBC_JEQ2] = TRICORE_FMT_SBC,
+    [OPC1_16_SBC_JNE] = TRICORE_FMT_SBC,
+    [OPC1_16_SBC_JNE2] = TRICORE_FMT_SBC,
+    [OPC1_16_SBR_JEQ] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JEQ2] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JGEZ] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JGTZ] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JLEZ] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JLTZ] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JNE] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JNE2] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JNZ] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JNZ_A] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JZ] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_JZ_A] = TRICORE_FMT_SBR,
+    [OPC1_16_SBR_LOOP] = TRICORE_FMT_SBR,
+    [OPC1_16_SBRN_JNZ_T] = TRICORE_FMT_SBRN,
+    [OPC1_16_SBRN_JZ_T] = TRICORE_FMT_SBRN,
+    [OPC1_16_SC_AND] = TRICORE_FMT_SC,
+    [OPC1_16_SC_BISR] = TRICORE_FMT_SC,
+    [OPC1_16_SC_LD_A] = TRICORE_FMT_SC,
+    [OPC1_16_SC_LD_W] = TRICORE_FMT_SC,
+    [OPC1_16_SC_MOV] = TRICORE_FMT_SC,
+    [OPC1_16_SC_OR] = TRICORE_FMT_SC,
+    [OPC1_16_SC_ST_A] = TRICORE_FMT_SC,
+    [OPC1_16_SC_ST_W] = TRICORE_FMT_SC,
+    [OPC1_16_SC_SUB_A] = TRICORE_FMT_SC,
+    [OPC1_16_SLR_LD_A] = TRICORE_FMT_SLR,
+    [OPC1_16_SLR_LD_A_POSTINC] = TRICORE_FMT_SLR,
+    [OPC1_16_SLR_LD_BU] = TRICORE_FMT_SLR,
+    [OPC1_16_SLR_LD_BU_POSTINC] = TRICORE_FMT_SLR,
+    [OPC1_16_SLR_LD_H] = TRICORE_FMT_SLR,
+    [OPC1_16_SLR_LD_H_POSTINC] = TRICORE_FMT_SLR,
+    [OPC1_16_SLR_LD_W] = TRICORE_FMT_SLR,
+    [OPC1_16_SLR_LD_W_POSTINC] = TRICORE_FMT_SLR,
+    [OPC1_16_SLRO_LD_A] = TRICORE_FMT_SLRO,
+    [OPC1_16_SLRO_LD_BU] = TRICORE_FMT_SLRO,
+    [OPC1_16_SLRO_LD_H] = TRICORE_FMT_SLRO,
+    [OPC1_16_SLRO_LD_W] = TRICORE_FMT_SLRO,
+    [OPC1_16_SR_JI] = TRICORE_FMT_SR,
+    [OPC1_16_SR_NOT] = TRICORE_FMT_SR,
+    [OPCM_16_SR_ACCU] = TRICORE_FMT_SR,
+    [OPCM_16_SR_SYSTEM] = TRICORE_FMT_SR,
+    [OPC1_16_SRC_ADD] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_ADD_15A] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_ADD_A] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_ADD_A15] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_CADD] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_CADDN] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_CMOV] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_CMOVN] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_EQ] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_LT] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_MOV] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_MOV_A] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_MOV_E] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_SH] = TRICORE_FMT_SRC,
+    [OPC1_16_SRC_SHA] = TRICORE_FMT_SRC,
+    [OPC1_16_SRO_LD_A] = TRICORE_FMT_SRO,
+    [OPC1_16_SRO_LD_BU] = TRICORE_FMT_SRO,
+    [OPC1_16_SRO_LD_H] = TRICORE_FMT_SRO,
+    [OPC1_16_SRO_LD_W] = TRICORE_FMT_SRO,
+    [OPC1_16_SRO_ST_A] = TRICORE_FMT_SRO,
+    [OPC1_16_SRO_ST_B] = TRICORE_FMT_SRO,
+    [OPC1_16_SRO_ST_H] = TRICORE_FMT_SRO,
+    [OPC1_16_SRO_ST_W] = TRICORE_FMT_SRO,
+    [OPC1_16_SRR_ADD] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_ADDS] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_ADD_15A] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_ADD_A] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_ADD_A15] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_AND] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_CMOV] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_CMOVN] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_EQ] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_LT] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_MOV] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_MOV_A] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_MOV_AA] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_MOV_D] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_MUL] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_OR] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_SUB] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_SUBS] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_SUB_15AB] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_SUB_A15B] = TRICORE_FMT_SRR,
+    [OPC1_16_SRR_XOR] = TRICORE_FMT_SRR,
+    [OPC1_16_SRRS_ADDSC_A] = TRICORE_FMT_SRRS,
+    [OPC1_16_SSR_ST_A] = TRICORE_FMT_SSR,
+    [OPC1_16_SSR_ST_A_POSTINC] = TRICORE_FMT_SSR,
+    [OPC1_16_SSR_ST_B] = TRICORE_FMT_SSR,
+    [OPC1_16_SSR_ST_B_POSTINC] = TRICORE_FMT_SSR,
+    [OPC1_16_SSR_ST_H] = TRICORE_FMT_SSR,
+    [OPC1_16_SSR_ST_H_POSTINC] = TRICORE_FMT_SSR,
+    [OPC1_16_SSR_ST_W] = TRICORE_FMT_SSR,
+    [OPC1_16_SSR_ST_W_POSTINC] = TRICORE_FMT_SSR,
+    [OPC1_16_SSRO_ST_A] = TRICORE_FMT_SSRO,
+    [OPC1_16_SSRO_ST_B] = TRICORE_FMT_SSRO,
+    [OPC1_16_SSRO_ST_H] = TRICORE_FMT_SSRO,
+    [OPC1_16_SSRO_ST_W] = TRICORE_FMT_SSRO,
+};
+
+static const uint8_t tricore_insn32_format[256] = {
+    [OPC1_32_ABS_LD_Q] = TRICORE_FMT_ABS,
+    [OPC1_32_ABS_STOREQ] = TRICORE_FMT_ABS,
+    [OPCM_32_ABS_LDB] = TRICORE_FMT_ABS,
+    [OPCM_32_ABS_LDMST_SWAP] = TRICORE_FMT_ABS,
+    [OPCM_32_ABS_LDST_CONTEXT] = TRICORE_FMT_ABS,
+    [OPCM_32_ABS_LDW] = TRICORE_FMT_ABS,
+    [OPCM_32_ABS_LEA_LHA] = TRICORE_FMT_ABS,
+    [OPCM_32_ABS_STORE] = TRICORE_FMT_ABS,
+    [OPCM_32_ABS_STOREB_H] = TRICORE_FMT_ABS,
+    [OPC1_32_ABSB_ST_T] = TRICORE_FMT_ABSB,
+    [OPC1_32_B_CALL] = TRICORE_FMT_B,
+    [OPC1_32_B_CALLA] = TRICORE_FMT_B,
+    [OPC1_32_B_FCALL] = TRICORE_FMT_B,
+    [OPC1_32_B_FCALLA] = TRICORE_FMT_B,
+    [OPC1_32_B_J] = TRICORE_FMT_B,
+    [OPC1_32_B_JA] = TRICORE_FMT_B,
+    [OPC1_32_B_JL] = TRICORE_FMT_B,
+    [OPC1_32_B_JLA] = TRICORE_FMT_B,
+    [OPCM_32_BIT_ANDACC] = TRICORE_FMT_BIT,
+    [OPCM_32_BIT_INSERT] = TRICORE_FMT_BIT,
+    [OPCM_32_BIT_LOGICAL_T1] = TRICORE_FMT_BIT,
+    [OPCM_32_BIT_LOGICAL_T2] = TRICORE_FMT_BIT,
+    [OPCM_32_BIT_ORAND] = TRICORE_FMT_BIT,
+    [OPCM_32_BIT_SH_LOGIC1] = TRICORE_FMT_BIT,
+    [OPCM_32_BIT_SH_LOGIC2] = TRICORE_FMT_BIT,
+    [OPCM_32_BO_ADDRMODE_BITREVERSE_CIRCULAR] = TRICORE_FMT_BO,
+    [OPCM_32_BO_ADDRMODE_LDMST_BITREVERSE_CIRCULAR] = TRICORE_FMT_BO,
+    [OPCM_32_BO_ADDRMODE_LD_BITREVERSE_CIRCULAR] = TRICORE_FMT_BO,
+    [OPCM_32_BO_ADDRMODE_LD_POST_PRE_BASE] = TRICORE_FMT_BO,
+    [OPCM_32_BO_ADDRMODE_POST_PRE_BASE] = TRICORE_FMT_BO,
+    [OPCM_32_BO_ADDRMODE_STCTX_POST_PRE_BASE] = TRICORE_FMT_BO,
+    [OPC1_32_BOL_LD_A_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_LD_BU_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_LD_B_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_LD_HU_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_LD_H_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_LD_W_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_LEA_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_ST_A_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_ST_B_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_ST_H_LONGOFF] = TRICORE_FMT_BOL,
+    [OPC1_32_BOL_ST_W_LONGOFF] = TRICORE_FMT_BOL,
+    [OPCM_32_BRC_EQ_NEQ] = TRICORE_FMT_BRC,
+    [OPCM_32_BRC_GE] = TRICORE_FMT_BRC,
+    [OPCM_32_BRC_JLT] = TRICORE_FMT_BRC,
+    [OPCM_32_BRC_JNE] = TRICORE_FMT_BRC,
+    [OPCM_32_BRN_JTT] = TRICORE_FMT_BRN,
+    [OPCM_32_BRR_ADDR_EQ_NEQ] = TRICORE_FMT_BRR,
+    [OPCM_32_BRR_EQ_NEQ] = TRICORE_FMT_BRR,
+    [OPCM_32_BRR_GE] = TRICORE_FMT_BRR,
+    [OPCM_32_BRR_JLT] = TRICORE_FMT_BRR,
+    [OPCM_32_BRR_JNE] = TRICORE_FMT_BRR,
+    [OPCM_32_BRR_JNZ] = TRICORE_FMT_BRR,
+    [OPCM_32_BRR_LOOP] = TRICORE_FMT_BRR,
+    [OPCM_32_RC_ACCUMULATOR] = TRICORE_FMT_RC,
+    [OPCM_32_RC_LOGICAL_SHIFT] = TRICORE_FMT_RC,
+    [OPCM_32_RC_MUL] = TRICORE_FMT_RC,
+    [OPCM_32_RC_SERVICEROUTINE] = TRICORE_FMT_RC,
+    [OPCM_32_RCPW_MASK_INSERT] = TRICORE_FMT_RCPW,
+    [OPCM_32_RCR_COND_SELECT] = TRICORE_FMT_RCR,
+    [OPCM_32_RCR_MADD] = TRICORE_FMT_RCR,
+    [OPCM_32_RCR_MSUB] = TRICORE_FMT_RCR,
+    [OPC1_32_RCRR_INSERT] = TRICORE_FMT_RCRR,
+    [OPCM_32_RCRW_MASK_INSERT] = TRICORE_FMT_RCRW,
+    [OPC1_32_RLC_ADDI] = TRICORE_FMT_RLC,
+    [OPC1_32_RLC_ADDIH] = TRICORE_FMT_RLC,
+    [OPC1_32_RLC_ADDIH_A] = TRICORE_FMT_RLC,
+    [OPC1_32_RLC_MFCR] = TRICORE_FMT_RLC,
+    [OPC1_32_RLC_MOV] = TRICORE_FMT_RLC,
+    [OPC1_32_RLC_MOVH_A] = TRICORE_FMT_RLC,
+    [OPC1_32_RLC_MOV_64] = TRICORE_FMT_RLC,
+    [OPC1_32_RLC_MOV_H] = TRICORE_FMT_RLC,
+    [OPC1_32_RLC_MOV_U] = TRICORE_FMT_RLC,
+    [OPC1_32_RLC_MTCR] = TRICORE_FMT_RLC,
+    [OPCM_32_RR_ACCUMULATOR] = TRICORE_FMT_RR,
+    [OPCM_32_RR_ADDRESS] = TRICORE_FMT_RR,
+    [OPCM_32_RR_DIVIDE] = TRICORE_FMT_RR,
+    [OPCM_32_RR_IDIRECT] = TRICORE_FMT_RR,
+    [OPCM_32_RR_LOGICAL_SHIFT] = TRICORE_FMT_RR,
+    [OPCM_32_RR1_MUL] = TRICORE_FMT_RR1,
+    [OPCM_32_RR1_MULQ] = TRICORE_FMT_RR1,
+    [OPCM_32_RR2_MUL] = TRICORE_FMT_RR2,
+    [OPC1_32_RRPW_DEXTR] = TRICORE_FMT_RRPW,
+    [OPCM_32_RRPW_EXTRACT_INSERT] = TRICORE_FMT_RRPW,
+    [OPCM_32_RRR_COND_SELECT] = TRICORE_FMT_RRR,
+    [OPCM_32_RRR_DIVIDE] = TRICORE_FMT_RRR,
+    [OPCM_32_RRR1_MADD] = TRICORE_FMT_RRR1,
+    [OPCM_32_RRR1_MADDQ_H] = TRICORE_FMT_RRR1,
+    [OPCM_32_RRR1_MADDSU_H] = TRICORE_FMT_RRR1,
+    [OPCM_32_RRR1_MSUBAD_H] = TRICORE_FMT_RRR1,
+    [OPCM_32_RRR1_MSUB_H] = TRICORE_FMT_RRR1,
+    [OPCM_32_RRR1_MSUB_Q] = TRICORE_FMT_RRR1,
+    [OPCM_32_RRR2_MADD] = TRICORE_FMT_RRR2,
+    [OPCM_32_RRR2_MSUB] = TRICORE_FMT_RRR2,
+    [OPCM_32_RRRR_EXTRACT_INSERT] = TRICORE_FMT_RRRR,
+    [OPCM_32_RRRW_EXTRACT_INSERT] = TRICORE_FMT_RRRW,
+    [OPC1_32_SYS_RSTV] = TRICORE_FMT_SYS,
+    [OPCM_32_SYS_INTERRUPTS] = TRICORE_FMT_SYS,
+};
+
+const char *tricore_insn_format_name(TriCoreInsnFormat fmt)
+{
+    return tricore_insn_format_names[fmt];
+}
+
+static TriCoreInsnFormat tricore_insn_format(uint32_t opcode, bool is_16bit)
+{
+    uint32_t op1 = MASK_OP_MAJOR(opcode);
+
+    if (!is_16bit) {
+        return tricore_insn32_format[op1];
+    }
+    if ((op1 & 0x3f) == OPC1_16_SRRS_ADDSC_A) {
+        return TRICORE_FMT_SRRS;
+    }
+    return tricore_insn16_format[op1];
+}
 
 static void tricore_tr_translate_insn(DisasContextBase *dcbase, CPUState *cpu)
 {
@@ -8399,22 +10027,81 @@ static void tricore_tr_translate_insn(DisasContextBase *dcbase, CPUState *cpu)
     CPUTriCoreState *env = cpu_env(cpu);
     uint16_t insn_lo;
     bool is_16bit;
+    int trigger = -1;
+
+    ctx->gaddr_written = false;
+    if (unlikely(ctx->dbg_code_triggers)) {
+        trigger = tricore_debug_code_trigger(env, ctx->base.pc_next);
+        if (trigger >= 0) {
+            gen_helper_debug_trigger(tcg_env, tcg_constant_i32(trigger),
+                                     tcg_constant_i32(ctx->base.pc_next));
+        }
+    }
 
     insn_lo = translator_lduw(env, &ctx->base, ctx->base.pc_next);
     is_16bit = tricore_insn_is_16bit(insn_lo);
     if (is_16bit) {
         ctx->opcode = insn_lo;
         ctx->pc_succ_insn = ctx->base.pc_next + 2;
-        decode_16Bit_opc(ctx);
+        if (!decode_insn16(ctx, insn_lo)) {
+            generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
+        }
     } else {
         uint32_t insn_hi = translator_lduw(env, &ctx->base,
                                            ctx->base.pc_next + 2);
         ctx->opcode = insn_hi << 16 | insn_lo;
-        ctx->pc_succ_insn = ctx->base.pc_next + 4;
-        decode_32Bit_opc(ctx);
+        ctx->fused = tricore_dv_fusion(env, ctx);
+        ctx->pc_succ_insn = ctx->base.pc_next + 4 * (1 + ctx->fused);
+        if (!decode_insn32(ctx, ctx->opcode)) {
+            generate_trap(ctx, TRAPC_INSN_ERR, TIN2_IOPC);
+        }
+    }
+    if (unlikely(ctx->decode_count)) {
+        ctx->decode_count[tricore_insn_format(ctx->opcode, is_16bit)]++;
+    }
+    if (ctx->pipeline_timing) {
+        tricore_insn_cost(ctx, is_16bit);
+    }
+
+    /*
+     * Account for the instructions a fused sequence covers, with an
+     * insn_start each as the TB's instruction count must match.
+     */
+    for (int i = 1; i <= ctx->fused; i++) {
+        vaddr pc = ctx->base.pc_next + 4 * i;
+
+        ctx->opcode = translator_ldl(env, &ctx->base, pc);
+        tcg_gen_insn_start(pc);
+        ctx->base.insn_start = tcg_last_op();
+        ctx->base.num_insns++;
+        if (unlikely(ctx->decode_count)) {
+            ctx->decode_count[tricore_insn_format(ctx->opcode, false)]++;
+        }
+        if (ctx->pipeline_timing) {
+            tricore_insn_cost(ctx, false);
+        }
     }
+    ctx->fused = 0;
     ctx->base.pc_next = ctx->pc_succ_insn;
 
+    /*
+     * A new value of a global address register gets a new key, which the
+     * TBs after this instruction have to be looked up with. gen_loop()
+     * handles LOOP, the only branch writing one.
+     */
+    if (ctx->gaddr_track && !ctx->gaddr_dirty && ctx->gaddr_written) {
+        gen_helper_gaddr_update(tcg_env);
+        if (ctx->base.is_jmp == DISAS_NEXT ||
+            ctx->base.is_jmp == DISAS_TOO_MANY) {
+            ctx->base.is_jmp = DISAS_EXIT_UPDATE;
+        }
+    }
+
+    /* an event after the instruction is taken before the next TB */
+    if (trigger >= 0 && ctx->base.is_jmp == DISAS_NEXT) {
+        ctx->base.is_jmp = DISAS_TOO_MANY;
+    }
+
     if (ctx->base.is_jmp == DISAS_NEXT) {
         target_ulong page_start;
 
@@ -8431,6 +10118,20 @@ static void tricore_tr_tb_stop(DisasContextBase *dcbase, CPUState *cpu)
 {
     DisasContext *ctx = container_of(dcbase, DisasContext, base);
 
+#ifndef CONFIG_USER_ONLY
+    /* the second page is only known once the TB has crossed into it */
+    if (TRICORE_CPU(cpu)->spr_count && tb_page_addr1(ctx->base.tb) != -1) {
+        tricore_spr_translate(tb_page_addr1(ctx->base.tb));
+    }
+#endif
+
+    if (ctx->pipeline_timing) {
+        int64_t extra = (int64_t)ctx->cycles - ctx->base.num_insns;
+
+        tcg_set_insn_param(ctx->cycles_op, 2,
+                           tcgv_i64_arg(tcg_constant_i64(extra)));
+    }
+
     switch (ctx->base.is_jmp) {
     case DISAS_TOO_MANY:
         gen_goto_tb(ctx, 0, ctx->base.pc_next);
@@ -8479,6 +10180,7 @@ void cpu_state_reset(CPUTriCoreState *env)
     /* Reset Regs to Default Value */
     env->PSW = 0xb80;
     fpu_set_state(env);
+    tricore_gaddr_update(env);
 }
 
 static void tricore_tcg_init_csfr(void)
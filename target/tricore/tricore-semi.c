@@ -0,0 +1,142 @@
+/*
+ * TriCore semihosting syscall interface
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ *
+ * The semihosting call is the DEBUG instruction, which the core executes
+ * as a no-op while no debugger has enabled debug mode. D15 selects the
+ * operation, so "mov d15, #op; debug" fits in two 16 bit instructions.
+ * The arguments are in D4, D5 and A4, LSEEK takes its 64 bit offset in E6
+ * (D6 low, D7 high). The result or a negative GDB errno is returned in
+ * D2, or in E2 for the 64 bit results:
+ *
+ *   0 EXIT   D4 = exit status
+ *   1 OPEN   A4 = NUL terminated path, D4 = GDB open flags, D5 = mode
+ *   2 CLOSE  D4 = fd
+ *   3 READ   D4 = fd, A4 = buffer, D5 = length
+ *   4 WRITE  D4 = fd, A4 = buffer, D5 = length
+ *   5 LSEEK  D4 = fd, D5 = GDB whence, E6 = offset; E2 = new offset
+ *   6 CLOCK  E2 = nanoseconds of virtual time
+ *
+ * The fds 0, 1 and 2 are the semihosting console. READ and WRITE lock the
+ * whole guest buffer at once, so a bulk transfer costs a single call.
+ *
+ * qemu-tricore implements the same calls, so the newlib system call stubs
+ * of a bare-metal program work unchanged in system and user mode.
+ */
+
+#include "qemu/osdep.h"
+
+#include "cpu.h"
+#include "gdbstub/syscalls.h"
+#include "semihosting/syscalls.h"
+#include "qemu/log.h"
+#include "qemu/timer.h"
+
+#define TRICORE_SEMI_EXIT   0
+#define TRICORE_SEMI_OPEN   1
+#define TRICORE_SEMI_CLOSE  2
+#define TRICORE_SEMI_READ   3
+#define TRICORE_SEMI_WRITE  4
+#define TRICORE_SEMI_LSEEK  5
+#define TRICORE_SEMI_CLOCK  6
+
+static int host_to_gdb_errno(int err)
+{
+#define E(X)  case E##X: return GDB_E##X
+    switch (err) {
+    E(PERM);
+    E(NOENT);
+    E(INTR);
+    E(BADF);
+    E(ACCES);
+    E(FAULT);
+    E(BUSY);
+    E(EXIST);
+    E(NODEV);
+    E(NOTDIR);
+    E(ISDIR);
+    E(INVAL);
+    E(NFILE);
+    E(MFILE);
+    E(FBIG);
+    E(NOSPC);
+    E(SPIPE);
+    E(ROFS);
+    E(NAMETOOLONG);
+    default:
+        return GDB_EUNKNOWN;
+    }
+#undef E
+}
+
+static void tricore_semi_cb(CPUState *cs, uint64_t ret, int err)
+{
+    CPUTriCoreState *env = cpu_env(cs);
+
+    if (err) {
+        ret = -(int64_t)host_to_gdb_errno(err);
+    }
+    env->gpr_d[2] = ret;
+}
+
+/* LSEEK and CLOCK return 64 bits in E2, the others leave D3 alone */
+static void tricore_semi_cb64(CPUState *cs, uint64_t ret, int err)
+{
+    CPUTriCoreState *env = cpu_env(cs);
+
+    if (err) {
+        ret = -(int64_t)host_to_gdb_errno(err);
+    }
+    env->gpr_d[2] = ret;
+    env->gpr_d[3] = ret >> 32;
+}
+
+void tricore_semihosting(CPUTriCoreState *env)
+{
+    CPUState *cs = env_cpu(env);
+    uint32_t nr = env->gpr_d[15];
+
+    switch (nr) {
+    case TRICORE_SEMI_EXIT:
+        gdb_exit(env->gpr_d[4]);
+        exit(env->gpr_d[4]);
+
+    case TRICORE_SEMI_OPEN:
+        semihost_sys_open(cs, tricore_semi_cb, env->gpr_a[4], 0,
+                          env->gpr_d[4], env->gpr_d[5]);
+        break;
+
+    case TRICORE_SEMI_CLOSE:
+        semihost_sys_close(cs, tricore_semi_cb, env->gpr_d[4]);
+        break;
+
+    case TRICORE_SEMI_READ:
+        semihost_sys_read(cs, tricore_semi_cb, env->gpr_d[4], env->gpr_a[4],
+                          env->gpr_d[5]);
+        break;
+
+    case TRICORE_SEMI_WRITE:
+        semihost_sys_write(cs, tricore_semi_cb, env->gpr_d[4], env->gpr_a[4],
+                           env->gpr_d[5]);
+        break;
+
+    case TRICORE_SEMI_LSEEK:
+        semihost_sys_lseek(cs, tricore_semi_cb64, env->gpr_d[4],
+                           deposit64(env->gpr_d[6], 32, 32, env->gpr_d[7]),
+                           env->gpr_d[5]);
+        break;
+
+    case TRICORE_SEMI_CLOCK:
+        tricore_semi_cb64(cs, qemu_clock_get_ns(QEMU_CLOCK_VIRTUAL), 0);
+        break;
+
+    default:
+        qemu_log_mask(LOG_GUEST_ERROR, "tricore-semihosting: unknown "
+                      "operation %u\n", nr);
+        tricore_semi_cb(cs, -1, EINVAL);
+        break;
+    }
+}
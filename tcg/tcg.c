@@ -783,6 +783,12 @@ void tcg_register_thread(void)
     tcg_ctx = &tcg_init_ctx;
 }
 #else
+void tcg_register_thread_after_fork(unsigned int n)
+{
+    g_assert(n < qatomic_read(&tcg_cur_ctxs));
+    tcg_ctx = tcg_ctxs[n];
+}
+
 void tcg_register_thread(void)
 {
     TCGContext *s = g_malloc(sizeof(*s));
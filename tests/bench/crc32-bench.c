@@ -0,0 +1,79 @@
+/*
+ * QEMU crc32_ieee and crc_table_update speed benchmark
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or
+ * (at your option) any later version.  See the COPYING file in the
+ * top-level directory.
+ */
+#include "qemu/osdep.h"
+#include "qemu/crc32.h"
+#include "qemu/units.h"
+
+static void test_crc32(const void *opaque)
+{
+    size_t max = 64 * KiB;
+    uint8_t *buf = g_malloc(max);
+    int accel_index = 0;
+
+    for (size_t i = 0; i < max; i++) {
+        buf[i] = i * 7;
+    }
+
+    do {
+        if (accel_index != 0) {
+            g_test_message("%s", "");  /* gnu_printf Werror for simple "" */
+        }
+        /* single instruction sized updates up to whole blocks */
+        for (size_t len = 4; len <= max; len *= 4) {
+            double total = 0.0;
+            uint32_t crc = 0;
+
+            g_test_timer_start();
+            do {
+                crc = crc32_ieee(crc, buf, len);
+                total += len;
+            } while (g_test_timer_elapsed() < 0.5);
+
+            total /= MiB;
+            g_test_message("crc32_ieee #%d: %6zuB %8.0f MB/sec",
+                           accel_index, len, total / g_test_timer_last());
+        }
+        accel_index++;
+    } while (test_crc32_ieee_next_accel());
+
+    g_free(buf);
+}
+
+static void test_crc_table(const void *opaque)
+{
+    CRCTable t;
+
+    /* CRC-16/CCITT, as used for CAN payloads */
+    crc_table_init(&t, 16, 0x1021);
+
+    for (unsigned bits = 1; bits <= 32; bits *= 2) {
+        double total = 0.0;
+        uint32_t crc = 0xffff;
+        uint32_t data = 0;
+
+        g_test_timer_start();
+        do {
+            for (int i = 0; i < 1024; i++) {
+                crc = crc_table_update(&t, crc, data++, bits);
+            }
+            total += 1024 * bits / 8;
+        } while (g_test_timer_elapsed() < 0.5);
+
+        total /= MiB;
+        g_test_message("crc_table_update: %2u bits %8.1f MB/sec",
+                       bits, total / g_test_timer_last());
+    }
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_data_func("/crc32/ieee/speed", NULL, test_crc32);
+    g_test_add_data_func("/crc32/table/speed", NULL, test_crc_table);
+    return g_test_run();
+}
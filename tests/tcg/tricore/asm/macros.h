@@ -8,6 +8,10 @@
     LI(DREG_TEMP, val)       \
     mov.a reg, DREG_TEMP;
 
+/* Half-word selection suffix, e.g. SEL(DREG_RS2, ll) is %d2ll */
+#define SEL(reg, sel) SEL_(reg, sel)
+#define SEL_(reg, sel) reg ## sel
+
 /* Address definitions */
 #define TESTDEV_ADDR 0xf0000000
 /* Register definitions */
@@ -69,6 +73,12 @@ test_ ## num:                                                      \
     mov DREG_TEST_NUM, num;                                        \
     jne DREG_CALC_PSW, DREG_CORRECT_PSW, fail;
 
+#define TEST_CASE_E_PSW(num, correct_lo, correct_hi, correct_psw, code...) \
+    TEST_CASE_E(num, correct_lo, correct_hi, code)                       \
+    mfcr DREG_CALC_PSW, $psw;                                            \
+    LI(DREG_CORRECT_PSW, correct_psw)                                    \
+    jne DREG_CALC_PSW, DREG_CORRECT_PSW, fail;
+
 #define TEST_LD(insn, num, result, addr_result, ld_pattern) \
 test_ ## num:                                               \
     LIA(AREG_ADDR, test_data)                               \
@@ -109,7 +119,19 @@ test_ ## num:                                                    \
     TEST_CASE_PSW(num, DREG_CALC_RESULT, result, psw, \
     LI(DREG_RS1, rs1);                                \
     rstv;                                             \
-    insn DREG_CORRECT_RESULT, DREG_RS1;               \
+    insn DREG_CALC_RESULT, DREG_RS1;                  \
+    )
+
+/* PSW.RM set to rm and PSW.FX cleared before insn */
+#define TEST_D_D_RM_PSW(insn, num, result, psw, rm, rs1) \
+    TEST_CASE_PSW(num, DREG_CALC_RESULT, result, psw,    \
+    LI(DREG_RS1, rs1);                                   \
+    mfcr DREG_TEMP, $psw;                                \
+    insert DREG_TEMP, DREG_TEMP, rm, 24, 3;              \
+    mtcr $psw, DREG_TEMP;                                \
+    isync;                                               \
+    rstv;                                                \
+    insn DREG_CALC_RESULT, DREG_RS1;                     \
     )
 
 #define TEST_D_DDD(insn, num, result, rs1, rs2, rs3)        \
@@ -154,6 +176,25 @@ test_ ## num:                                                    \
     insn DREG_CALC_RESULT, DREG_RS1, DREG_RS2, imm;           \
     )
 
+#define TEST_D_DDI_SEL_PSW(insn, num, result, psw, rs1, rs2, sel, imm) \
+    TEST_CASE_PSW(num, DREG_CALC_RESULT, result, psw,                 \
+    LI(DREG_RS1, rs1);                                                \
+    LI(DREG_RS2, rs2);                                                \
+    rstv;                                                             \
+    insn DREG_CALC_RESULT, DREG_RS1, SEL(DREG_RS2, sel), imm;         \
+    )
+
+#define TEST_D_DDDI_SEL_PSW(insn, num, result, psw, rs1, rs2, sel2, rs3, \
+                            sel3, imm)                                   \
+    TEST_CASE_PSW(num, DREG_CALC_RESULT, result, psw,                    \
+    LI(DREG_RS1, rs1);                                                   \
+    LI(DREG_RS2, rs2);                                                   \
+    LI(DREG_RS3, rs3);                                                   \
+    rstv;                                                                \
+    insn DREG_CALC_RESULT, DREG_RS1, SEL(DREG_RS2, sel2),                \
+         SEL(DREG_RS3, sel3), imm;                                       \
+    )
+
 #define TEST_D_DIDI(insn, num, result, rs1, imm1, rs2, imm2) \
     TEST_CASE(num, DREG_CALC_RESULT, result,                 \
     LI(DREG_RS1, rs1);                                       \
@@ -194,6 +235,54 @@ test_ ## num:                                                    \
     insn EREG_CALC_RESULT, EREG_RS1, DREG_RS2;                    \
     )
 
+#define TEST_E_DDI_SEL_PSW(insn, num, res_hi, res_lo, psw, rs1, rs2, sel, \
+                           imm)                                           \
+    TEST_CASE_E_PSW(num, res_lo, res_hi, psw,                             \
+    LI(DREG_RS1, rs1);                                                    \
+    LI(DREG_RS2, rs2);                                                    \
+    rstv;                                                                 \
+    insn EREG_CALC_RESULT, DREG_RS1, SEL(DREG_RS2, sel), imm;             \
+    )
+
+#define TEST_E_EDDI_SEL_PSW(insn, num, res_hi, res_lo, psw, rs1_hi, rs1_lo, \
+                            rs2, sel2, rs3, sel3, imm)                      \
+    TEST_CASE_E_PSW(num, res_lo, res_hi, psw,                               \
+    LI(EREG_RS1_LO, rs1_lo);                                                \
+    LI(EREG_RS1_HI, rs1_hi);                                                \
+    LI(DREG_RS2, rs2);                                                      \
+    LI(DREG_RS3, rs3);                                                      \
+    rstv;                                                                   \
+    insn EREG_CALC_RESULT, EREG_RS1, SEL(DREG_RS2, sel2),                   \
+         SEL(DREG_RS3, sel3), imm;                                          \
+    )
+
+/* DVINIT, four DVSTEPs and DVADJ, the signed division compilers emit */
+#define TEST_DV_PSW(num, res_hi, res_lo, psw, rs1, rs2)        \
+    TEST_CASE_E_PSW(num, res_lo, res_hi, psw,                  \
+    LI(DREG_RS1, rs1);                                         \
+    LI(DREG_RS2, rs2);                                         \
+    rstv;                                                      \
+    dvinit EREG_CALC_RESULT, DREG_RS1, DREG_RS2;               \
+    dvstep EREG_CALC_RESULT, EREG_CALC_RESULT, DREG_RS2;       \
+    dvstep EREG_CALC_RESULT, EREG_CALC_RESULT, DREG_RS2;       \
+    dvstep EREG_CALC_RESULT, EREG_CALC_RESULT, DREG_RS2;       \
+    dvstep EREG_CALC_RESULT, EREG_CALC_RESULT, DREG_RS2;       \
+    dvadj EREG_CALC_RESULT, EREG_CALC_RESULT, DREG_RS2;        \
+    )
+
+/* DVINIT.U and four DVSTEP.Us, the unsigned division */
+#define TEST_DV_U_PSW(num, res_hi, res_lo, psw, rs1, rs2)      \
+    TEST_CASE_E_PSW(num, res_lo, res_hi, psw,                  \
+    LI(DREG_RS1, rs1);                                         \
+    LI(DREG_RS2, rs2);                                         \
+    rstv;                                                      \
+    dvinit.u EREG_CALC_RESULT, DREG_RS1, DREG_RS2;             \
+    dvstep.u EREG_CALC_RESULT, EREG_CALC_RESULT, DREG_RS2;     \
+    dvstep.u EREG_CALC_RESULT, EREG_CALC_RESULT, DREG_RS2;     \
+    dvstep.u EREG_CALC_RESULT, EREG_CALC_RESULT, DREG_RS2;     \
+    dvstep.u EREG_CALC_RESULT, EREG_CALC_RESULT, DREG_RS2;     \
+    )
+
 #define TEST_E_IDI(insn, num, res_hi, res_lo, imm1, rs1, imm2) \
     TEST_CASE_E(num, res_lo, res_hi,                           \
     LI(DREG_RS1, rs1);                                         \
@@ -0,0 +1,109 @@
+/*
+ * QEMU crc32_ieee and crc_table_update test
+ *
+ * This work is licensed under the terms of the GNU GPL, version 2 or
+ * (at your option) any later version.  See the COPYING file in the
+ * top-level directory.
+ */
+
+#include "qemu/osdep.h"
+#include "qemu/bswap.h"
+#include "qemu/host-utils.h"
+#include "qemu/crc32.h"
+
+static const uint8_t check[] = "123456789";
+
+/* bitwise reference */
+static uint32_t crc32_ref(uint32_t crc, const uint8_t *p, size_t len)
+{
+    crc = ~crc;
+    while (len--) {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++) {
+            crc = (crc >> 1) ^ (crc & 1 ? 0xedb88320 : 0);
+        }
+    }
+    return ~crc;
+}
+
+static void test_ieee_1(void)
+{
+    static uint8_t buf[1024];
+    size_t a, l;
+
+    for (size_t i = 0; i < sizeof(buf); i++) {
+        buf[i] = i * 37 + (i >> 3);
+    }
+
+    g_assert_cmphex(crc32_ieee(0, check, 9), ==, 0xcbf43926);
+    g_assert_cmphex(crc32_ieee(crc32_ieee(0, check, 4), check + 4, 5), ==,
+                    0xcbf43926);
+
+    for (a = 0; a < 16; a++) {
+        for (l = 0; l <= sizeof(buf) - 16; l += (l < 160 ? 1 : 37)) {
+            g_assert_cmphex(crc32_ieee(a, buf + a, l), ==,
+                            crc32_ref(a, buf + a, l));
+        }
+    }
+}
+
+static void test_ieee(void)
+{
+    do {
+        test_ieee_1();
+    } while (test_crc32_ieee_next_accel());
+}
+
+static void test_table(void)
+{
+    CRCTable t;
+    uint32_t crc;
+
+    /* CRC-16/XMODEM */
+    crc_table_init(&t, 16, 0x1021);
+    crc = 0;
+    for (int i = 0; i < 9; i++) {
+        crc = crc_table_update(&t, crc, check[i], 8);
+    }
+    g_assert_cmphex(crc, ==, 0x31c3);
+
+    /* the same in nibbles */
+    crc = 0;
+    for (int i = 0; i < 9; i++) {
+        crc = crc_table_update(&t, crc, check[i] >> 4, 4);
+        crc = crc_table_update(&t, crc, check[i] & 0xf, 4);
+    }
+    g_assert_cmphex(crc, ==, 0x31c3);
+
+    /* CRC-8/SMBUS */
+    crc_table_init(&t, 8, 0x07);
+    crc = 0;
+    for (int i = 0; i < 9; i++) {
+        crc = crc_table_update(&t, crc, check[i], 8);
+    }
+    g_assert_cmphex(crc, ==, 0xf4);
+
+    /* CRC-32/MPEG-2, in words */
+    crc_table_init(&t, 32, 0x04c11db7);
+    crc = crc_table_update(&t, 0xffffffff, ldl_be_p(check), 32);
+    crc = crc_table_update(&t, crc, ldl_be_p(check + 4), 32);
+    crc = crc_table_update(&t, crc, check[8], 8);
+    g_assert_cmphex(crc, ==, 0x0376e6e7);
+
+    /* CRC-5/USB without the final inversion, LSB first */
+    crc_table_init(&t, 5, 0x05);
+    crc = 0x1f;
+    for (int i = 0; i < 9; i++) {
+        crc = crc_table_update(&t, crc, revbit32(check[i]) >> 24, 8);
+    }
+    g_assert_cmphex(revbit32(crc) >> 27, ==, 0x19 ^ 0x1f);
+}
+
+int main(int argc, char **argv)
+{
+    g_test_init(&argc, &argv, NULL);
+    g_test_add_func("/crc32/ieee", test_ieee);
+    g_test_add_func("/crc32/table", test_table);
+
+    return g_test_run();
+}
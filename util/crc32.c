@@ -0,0 +1,130 @@
+/*
+ * IEEE 802.3 CRC-32 and table driven CRCs of arbitrary width
+ *
+ * Copyright (c) 2024 Georg Hofstetter <georg.hofstetter@efs-techhub.com>
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later
+ */
+
+#include "qemu/osdep.h"
+#include "qemu/bswap.h"
+#include "qemu/crc32.h"
+#include "host/cpuinfo.h"
+
+/*
+ * The implementations work on the CRC register, crc32_ieee() does the
+ * inversion before and after.
+ */
+typedef uint32_t (*crc32_accel_fn)(uint32_t, const uint8_t *, size_t);
+
+/* slice-by-8 tables of the reflected polynomial */
+static uint32_t crc32_tab[8][256];
+
+static uint32_t crc32_ieee_bytes(uint32_t crc, const uint8_t *p, size_t len)
+{
+    while (len--) {
+        crc = crc32_tab[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static uint32_t crc32_ieee_int(uint32_t crc, const uint8_t *p, size_t len)
+{
+    uint32_t lo, hi;
+
+    for (; len >= 8; p += 8, len -= 8) {
+        lo = ldl_le_p(p) ^ crc;
+        hi = ldl_le_p(p + 4);
+        crc = crc32_tab[7][lo & 0xff] ^ crc32_tab[6][(lo >> 8) & 0xff] ^
+              crc32_tab[5][(lo >> 16) & 0xff] ^ crc32_tab[4][lo >> 24] ^
+              crc32_tab[3][hi & 0xff] ^ crc32_tab[2][(hi >> 8) & 0xff] ^
+              crc32_tab[1][(hi >> 16) & 0xff] ^ crc32_tab[0][hi >> 24];
+    }
+    if (len >= 4) {
+        lo = ldl_le_p(p) ^ crc;
+        crc = crc32_tab[3][lo & 0xff] ^ crc32_tab[2][(lo >> 8) & 0xff] ^
+              crc32_tab[1][(lo >> 16) & 0xff] ^ crc32_tab[0][lo >> 24];
+        p += 4;
+        len -= 4;
+    }
+    return crc32_ieee_bytes(crc, p, len);
+}
+
+#include "host/crc32.c.inc"
+
+static crc32_accel_fn crc32_ieee_accel;
+static unsigned accel_index;
+
+uint32_t crc32_ieee(uint32_t crc, const void *buf, size_t len)
+{
+    return ~crc32_ieee_accel(~crc, buf, len);
+}
+
+bool test_crc32_ieee_next_accel(void)
+{
+    if (accel_index != 0) {
+        crc32_ieee_accel = accel_table[--accel_index];
+        return true;
+    }
+    return false;
+}
+
+static void __attribute__((constructor)) init_accel(void)
+{
+    for (unsigned i = 0; i < 256; i++) {
+        uint32_t c = i;
+
+        for (int k = 0; k < 8; k++) {
+            c = (c >> 1) ^ (c & 1 ? 0xedb88320 : 0);
+        }
+        crc32_tab[0][i] = c;
+    }
+    for (unsigned i = 0; i < 256; i++) {
+        for (int k = 1; k < 8; k++) {
+            uint32_t c = crc32_tab[k - 1][i];
+
+            crc32_tab[k][i] = crc32_tab[0][c & 0xff] ^ (c >> 8);
+        }
+    }
+
+    accel_index = best_accel();
+    crc32_ieee_accel = accel_table[accel_index];
+}
+
+/*
+ * The table holds the effect of shifting in 8 bits. Shifting in m < 8
+ * bits v is the same as shifting in 8 bits of which the top 8 - m are
+ * zero, so the same table serves all chunk sizes.
+ */
+void crc_table_init(CRCTable *t, unsigned width, uint32_t poly)
+{
+    uint32_t top = poly << (32 - width);
+
+    assert(width >= 1 && width <= 32);
+    for (unsigned i = 0; i < 256; i++) {
+        uint32_t c = i << 24;
+
+        for (int k = 0; k < 8; k++) {
+            c = (c << 1) ^ (c & 0x80000000 ? top : 0);
+        }
+        t->tab[i] = c;
+    }
+    t->width = width;
+    t->poly = poly;
+}
+
+uint32_t crc_table_update(const CRCTable *t, uint32_t crc, uint32_t data,
+                          unsigned bits)
+{
+    /* the CRC in the top bits of the register */
+    uint32_t reg = crc << (32 - t->width);
+
+    while (bits) {
+        unsigned m = MIN(bits, 8);
+
+        bits -= m;
+        reg = (reg << m) ^
+              t->tab[(reg >> (32 - m)) ^ extract32(data, bits, m)];
+    }
+    return reg >> (32 - t->width);
+}